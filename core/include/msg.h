@@ -104,6 +104,10 @@
  * If the queue is full and the sending thread has a higher priority than the
  * receiving thread the send-behavior is equivalent to synchronous mode.
  *
+ * With module `core_msg_mpsc`, a thread receiving from many threads can use
+ * @ref msg_init_queue_mpsc() instead, so senders don't need to disable
+ * interrupts while adding their messages to the queue.
+ *
  * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
  * #include <inttypes.h>
  * #include <stdio.h>
@@ -231,6 +235,27 @@ int msg_send(msg_t *m, kernel_pid_t target_pid);
  */
 int msg_try_send(msg_t *m, kernel_pid_t target_pid);
 
+/**
+ * @brief Send several messages to the same thread at once, non-blocking.
+ *
+ * Delivers the messages in @p m in order, as if sent one by one with
+ * @ref msg_try_send(), until the receiver's message queue is full. In
+ * contrast to that, interrupts are disabled only once and the receiver is
+ * woken up (and possibly scheduled) only once for all of them.
+ *
+ * Can be called from an interrupt service routine, too.
+ *
+ * @param[in] m             Array of @p num preallocated ``msg_t`` structures,
+ *                          must not be NULL.
+ * @param[in] num           Number of messages in @p m.
+ * @param[in] target_pid    PID of target thread
+ *
+ * @return  Number of messages delivered (directly or to a queue), the
+ *          remaining ones were dropped.
+ * @return  -1, on error (invalid PID)
+ */
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid);
+
 
 /**
  * @brief Send a message to the current thread.
@@ -309,6 +334,22 @@ int msg_receive(msg_t *m);
  */
 int msg_try_receive(msg_t *m);
 
+/**
+ * @brief Receive all messages available, up to a maximum number.
+ *
+ * Blocks like @ref msg_receive() until a message is available. Then also
+ * takes all messages that are queued (or were sent by blocked senders),
+ * up to @p num in total, without blocking again. Messages queued in the
+ * thread's message queue are taken with interrupts disabled only once.
+ *
+ * @param[out] m    Array of @p num preallocated ``msg_t`` structures, must
+ *                  not be NULL.
+ * @param[in] num   Maximum number of messages to receive, must not be 0.
+ *
+ * @return  Number of messages received.
+ */
+int msg_receive_bulk(msg_t *m, unsigned num);
+
 /**
  * @brief Send a message, block until reply received.
  *
@@ -374,6 +415,30 @@ int msg_avail(void);
  */
 void msg_init_queue(msg_t *array, int num);
 
+#if defined(MODULE_CORE_MSG_MPSC) || defined(DOXYGEN)
+/**
+ * @brief Initialize the current thread's message queue as lock-free
+ *        multi-producer single-consumer queue.
+ *
+ * Behaves like a queue initialized with @ref msg_init_queue(), but threads
+ * sending to it reserve and fill a slot using atomic operations and only
+ * disable interrupts to wake up the receiving thread. This keeps the time
+ * spent with interrupts disabled short when many threads send to the same
+ * receiver. The receiver gets the messages from the queue with interrupts
+ * enabled, too.
+ *
+ * Only available with module `core_msg_mpsc`.
+ *
+ * @pre @p num **MUST BE A POWER OF TWO!**
+ *
+ * @param[in] array Pointer to preallocated array of ``msg_t`` structures, must
+ *                  not be NULL.
+ * @param[in] num   Number of ``msg_t`` structures in array.
+ *                  **MUST BE POWER OF TWO!**
+ */
+void msg_init_queue_mpsc(msg_t *array, int num);
+#endif
+
 /**
  * @brief   Prints the message queue of the current thread.
  */
@@ -11,6 +11,28 @@
  * @defgroup    core_sync_mutex Mutex
  * @ingroup     core_sync
  * @brief       Mutex for thread synchronization
+ *
+ * Threads blocking on a mutex are queued by their priority.
+ *
+ * Priority inheritance
+ * ====================
+ *
+ * When a thread of high priority blocks on a mutex held by a thread of low
+ * priority, any thread of medium priority preempts the holder and thereby
+ * indirectly the high priority thread for an unbounded time (priority
+ * inversion). With module `core_mutex_pi`, every mutex implements priority
+ * inheritance: the holder of a mutex runs with the highest priority of the
+ * threads waiting for it until it unlocks it. This is transitive, so if the
+ * holder itself waits for another mutex, the holder of that one is boosted
+ * as well. This bounds the time a thread waits for a mutex, such as the
+ * global locks of the network stack, to the critical sections of the
+ * threads holding it.
+ *
+ * @note    Mutexes locked in interrupt context have no owner to boost.
+ *          Unlocking them from another thread or an interrupt is fine, e.g.
+ *          to use a locked mutex as a signal. The thread woken by this does
+ *          not become the owner, as it might never unlock the mutex.
+ *
  * @{
  *
  * @file
@@ -25,7 +47,9 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "kernel_types.h"
 #include "list.h"
+#include "sched.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -34,25 +58,43 @@ extern "C" {
 /**
  * @brief Mutex structure. Must never be modified by the user.
  */
-typedef struct {
+typedef struct mutex {
     /**
      * @brief   The process waiting queue of the mutex. **Must never be changed
      *          by the user.**
      * @internal
      */
     list_node_t queue;
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    /**
+     * @brief   The thread holding the mutex, KERNEL_PID_UNDEF if it is
+     *          unlocked or was locked from interrupt context
+     * @internal
+     */
+    kernel_pid_t owner;
+    /**
+     * @brief   Next mutex held by the owner
+     * @internal
+     */
+    struct mutex *next_held;
+#endif
 } mutex_t;
 
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
 /**
  * @brief Static initializer for mutex_t.
  * @details This initializer is preferable to mutex_init().
  */
-#define MUTEX_INIT { { NULL } }
+#define MUTEX_INIT { { NULL }, KERNEL_PID_UNDEF, NULL }
 
 /**
  * @brief Static initializer for mutex_t with a locked mutex
  */
+#define MUTEX_INIT_LOCKED { { MUTEX_LOCKED }, KERNEL_PID_UNDEF, NULL }
+#else
+#define MUTEX_INIT { { NULL } }
 #define MUTEX_INIT_LOCKED { { MUTEX_LOCKED } }
+#endif
 
 /**
  * @cond INTERNAL
@@ -64,6 +106,35 @@ typedef struct {
  * @endcond
  */
 
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+/**
+ * @brief   Priority a thread is entitled to with priority inheritance
+ *
+ * The highest of its base priority and the priorities of the threads waiting
+ * for the mutexes it holds. Must be called with interrupts disabled.
+ *
+ * @internal
+ *
+ * @param[in]   thread      the thread
+ *
+ * @returns     the priority
+ */
+uint8_t mutex_pi_priority(const thread_t *thread);
+
+/**
+ * @brief   Drops the priority the owner of a mutex inherited from a waiter
+ *          removed from its queue without locking it
+ *
+ * For mutex operations with a timeout: the owner keeps only the priority it
+ * is still entitled to, see @ref mutex_pi_priority().
+ *
+ * @internal
+ *
+ * @param[in]   mutex       the mutex
+ */
+void mutex_pi_restore(mutex_t *mutex);
+#endif
+
 /**
  * @brief Initializes a mutex object.
  * @details For initialization of variables use MUTEX_INIT instead.
@@ -73,6 +144,10 @@ typedef struct {
 static inline void mutex_init(mutex_t *mutex)
 {
     mutex->queue.next = NULL;
+#ifdef MODULE_CORE_MUTEX_PI
+    mutex->owner = KERNEL_PID_UNDEF;
+    mutex->next_held = NULL;
+#endif
 }
 
 /**
@@ -162,6 +162,36 @@ void sched_set_status(thread_t *process, thread_status_t status);
  */
 void sched_switch(uint16_t other_prio);
 
+/**
+ * @brief   Change the priority of a thread
+ *
+ * If the thread is on the run queue, it is moved to the run queue of its new
+ * priority. Yields (or requests a context switch when called from an ISR) if
+ * a thread of higher priority than the active one becomes runnable by this,
+ * i.e. if the priority of the active thread is lowered or the one of another
+ * runnable thread is raised above it.
+ *
+ * @note    With module `core_mutex_pi`, this sets thread_t::base_priority.
+ *          The thread keeps a higher priority inherited from the threads
+ *          waiting for mutexes it holds until it unlocks them.
+ *
+ * @param[in]   thread      thread to change the priority of
+ * @param[in]   priority    new priority
+ */
+void sched_change_priority(thread_t *thread, uint8_t priority);
+
+/**
+ * @brief   Change the priority a thread runs with, but not its base priority
+ *
+ * Like sched_change_priority(), for priority inheritance.
+ *
+ * @internal
+ *
+ * @param[in]   thread      thread to change the priority of
+ * @param[in]   priority    new priority
+ */
+void sched_set_priority(thread_t *thread, uint8_t priority);
+
 /**
  * @brief   Call context switching at thread exit
  */
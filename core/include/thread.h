@@ -168,6 +168,20 @@ struct _thread {
     msg_t *msg_array;               /**< memory holding messages sent
                                          to this thread's message queue */
 #endif
+#if defined(MODULE_CORE_MSG_MPSC) || defined(DOXYGEN)
+    uint8_t msg_queue_mpsc;         /**< message queue is lock-free, see
+                                         @ref msg_init_queue_mpsc()     */
+#endif
+#if defined(MODULE_SCHED_EDF) || defined(DOXYGEN)
+    uint32_t deadline;              /**< absolute deadline of the current
+                                         job of an EDF thread, see
+                                         @ref sys_sched_edf             */
+#endif
+#if defined(MODULE_CORE_MUTEX_PI) || defined(DOXYGEN)
+    uint8_t base_priority;          /**< priority without inherited ones */
+    struct mutex *mutex_waiting;    /**< mutex the thread is blocked on */
+    struct mutex *mutexes_held;     /**< mutexes locked by the thread   */
+#endif
 #if defined(DEVELHELP) || defined(SCHED_TEST_STACK) \
     || defined(MODULE_MPU_STACK_GUARD) || defined(DOXYGEN)
     char *stack_start;              /**< thread's stack start address   */
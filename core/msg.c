@@ -32,6 +32,7 @@
 #endif
 #include "irq.h"
 #include "cib.h"
+#include "ktrace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
@@ -40,8 +41,173 @@ static int _msg_receive(msg_t *m, int block);
 static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
                      unsigned state);
 
+static inline bool _has_mpsc_queue(const thread_t *thread)
+{
+#ifdef MODULE_CORE_MSG_MPSC
+    return thread->msg_queue_mpsc;
+#else
+    (void)thread;
+    return false;
+#endif
+}
+
+#ifdef MODULE_CORE_MSG_MPSC
+/*
+ * Lock-free message queue (see msg_init_queue_mpsc()):
+ * Senders reserve a slot by advancing msg_queue.write_count using
+ * compare-and-swap and publish the message by writing its sender_pid last.
+ * Free slots have sender_pid set to KERNEL_PID_UNDEF, which no sender ever
+ * has. The receiver frees a slot before advancing msg_queue.read_count.
+ */
+static int _mpsc_put(thread_t *target, const msg_t *m)
+{
+    cib_t *cib = &target->msg_queue;
+    unsigned int n = __atomic_load_n(&cib->write_count, __ATOMIC_RELAXED);
+
+    do {
+        unsigned int read = __atomic_load_n(&cib->read_count, __ATOMIC_ACQUIRE);
+        if ((int)(n - read) > (int)cib->mask) {
+            return 0;
+        }
+    } while (!__atomic_compare_exchange_n(&cib->write_count, &n, n + 1, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    msg_t *dest = &target->msg_array[n & cib->mask];
+    dest->type = m->type;
+    dest->content = m->content;
+    __atomic_store_n(&dest->sender_pid, m->sender_pid, __ATOMIC_RELEASE);
+    return 1;
+}
+
+static int _mpsc_get(thread_t *me, msg_t *m)
+{
+    cib_t *cib = &me->msg_queue;
+    /* only the receiver itself writes read_count */
+    unsigned int n = cib->read_count;
+    msg_t *src = &me->msg_array[n & cib->mask];
+    kernel_pid_t sender = __atomic_load_n(&src->sender_pid, __ATOMIC_ACQUIRE);
+
+    if (sender == KERNEL_PID_UNDEF) {
+        /* queue is empty or the next message is not published yet */
+        return 0;
+    }
+    m->sender_pid = sender;
+    m->type = src->type;
+    m->content = src->content;
+    __atomic_store_n(&src->sender_pid, KERNEL_PID_UNDEF, __ATOMIC_RELAXED);
+    __atomic_store_n(&cib->read_count, n + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+/* must be called with interrupts disabled */
+static int _mpsc_wake(thread_t *target)
+{
+#if MODULE_CORE_THREAD_FLAGS
+    target->flags |= THREAD_FLAG_MSG_WAITING;
+    thread_flags_wake(target);
+#endif
+    if (target->status == STATUS_RECEIVE_BLOCKED) {
+        /* the receiver takes the message from the queue itself */
+        sched_set_status(target, STATUS_PENDING);
+        return 1;
+    }
+    return 0;
+}
+
+/* moves the message of the first blocked sender (if any) to the queue,
+ * must be called with interrupts disabled */
+static int _mpsc_unblock_sender(thread_t *me, uint16_t *sender_prio)
+{
+    if (me->msg_waiters.next == NULL) {
+        return 0;
+    }
+
+    thread_t *sender = container_of((clist_node_t *)me->msg_waiters.next,
+                                    thread_t, rq_entry);
+
+    if (!_mpsc_put(me, (msg_t *)sender->wait_data)) {
+        return 0;
+    }
+    list_remove_head(&me->msg_waiters);
+    if (sender->status != STATUS_REPLY_BLOCKED) {
+        sender->wait_data = NULL;
+        sched_set_status(sender, STATUS_PENDING);
+        if (sender->priority < *sender_prio) {
+            *sender_prio = sender->priority;
+        }
+    }
+    return 1;
+}
+
+static int _mpsc_receive(thread_t *me, msg_t *m, int block)
+{
+    while (1) {
+        uint16_t sender_prio = THREAD_PRIORITY_IDLE;
+        int res = _mpsc_get(me, m);
+        unsigned state = irq_disable();
+        /* keep the queue filled while senders are blocked on it */
+        int unblocked = _mpsc_unblock_sender(me, &sender_prio);
+
+        if (!res && !unblocked) {
+            cib_t *cib = &me->msg_queue;
+            msg_t *next = &me->msg_array[cib->read_count & cib->mask];
+            if (next->sender_pid != KERNEL_PID_UNDEF) {
+                /* published after _mpsc_get() looked */
+                irq_restore(state);
+                continue;
+            }
+            if (!block) {
+                irq_restore(state);
+                return -1;
+            }
+            DEBUG("_msg_receive(): %" PRIkernel_pid ": No msg in queue. "
+                  "Going blocked.\n", sched_active_thread->pid);
+            /* next sender publishing a message wakes us up */
+            sched_set_status(me, STATUS_RECEIVE_BLOCKED);
+            irq_restore(state);
+            thread_yield_higher();
+            continue;
+        }
+        irq_restore(state);
+        if (sender_prio < THREAD_PRIORITY_IDLE) {
+            sched_switch(sender_prio);
+        }
+        if (res) {
+            return 1;
+        }
+    }
+}
+
+static int _mpsc_send(thread_t *target, msg_t *m)
+{
+    if (!_mpsc_put(target, m)) {
+        return 0;
+    }
+
+    unsigned state = irq_disable();
+    int woken = _mpsc_wake(target);
+    irq_restore(state);
+    if (woken) {
+        thread_yield_higher();
+    }
+    return 1;
+}
+#endif /* MODULE_CORE_MSG_MPSC */
+
 static int queue_msg(thread_t *target, const msg_t *m)
 {
+#ifdef MODULE_CORE_MSG_MPSC
+    if (target->msg_queue_mpsc) {
+        if (!_mpsc_put(target, m)) {
+            DEBUG("queue_msg(): message queue is full\n");
+            return 0;
+        }
+        if (_mpsc_wake(target) && irq_is_in()) {
+            sched_context_switch_request = 1;
+        }
+        return 1;
+    }
+#endif
     int n = cib_put(&(target->msg_queue));
 
     if (n < 0) {
@@ -102,12 +268,26 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
 
     thread_t *me = (thread_t *)sched_active_thread;
 
+#ifdef MODULE_CORE_MSG_MPSC
+    /* reply blocked senders are not on the run queue, so they must not be
+     * preempted before the message is queued */
+    if (target->msg_queue_mpsc && (me->status != STATUS_REPLY_BLOCKED)) {
+        irq_restore(state);
+        if (_mpsc_send(target, m)) {
+            ktrace_msg_send(target_pid, m->type);
+            return 1;
+        }
+        /* queue is full, retry and possibly block with interrupts disabled */
+        state = irq_disable();
+    }
+#endif
+
     DEBUG("msg_send() %s:%i: Sending from %" PRIkernel_pid " to %" PRIkernel_pid
           ". block=%i src->state=%i target->state=%i\n", RIOT_FILE_RELATIVE,
           __LINE__, sched_active_pid, target_pid,
           block, me->status, target->status);
 
-    if (target->status != STATUS_RECEIVE_BLOCKED) {
+    if ((target->status != STATUS_RECEIVE_BLOCKED) || _has_mpsc_queue(target)) {
         DEBUG(
             "msg_send() %s:%i: Target %" PRIkernel_pid " is not RECEIVE_BLOCKED.\n",
             RIOT_FILE_RELATIVE, __LINE__, target_pid);
@@ -116,8 +296,10 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
             DEBUG("msg_send() %s:%i: Target %" PRIkernel_pid
                   " has a msg_queue. Queueing message.\n", RIOT_FILE_RELATIVE,
                   __LINE__, target_pid);
+            ktrace_msg_send(target_pid, m->type);
             irq_restore(state);
-            if (me->status == STATUS_REPLY_BLOCKED) {
+            if ((me->status == STATUS_REPLY_BLOCKED) ||
+                _has_mpsc_queue(target)) {
                 thread_yield_higher();
             }
             return 1;
@@ -134,6 +316,9 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
         DEBUG("msg_send: %" PRIkernel_pid ": going send blocked.\n",
               me->pid);
 
+        /* the receiver takes the message once it is ready */
+        ktrace_msg_send(target_pid, m->type);
+
         me->wait_data = (void *)m;
 
         int newstatus;
@@ -168,6 +353,7 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
         msg_t *target_message = (msg_t *)target->wait_data;
         *target_message = *m;
         sched_set_status(target, STATUS_PENDING);
+        ktrace_msg_send(target_pid, m->type);
 
         irq_restore(state);
         thread_yield_higher();
@@ -176,6 +362,60 @@ static int _msg_send(msg_t *m, kernel_pid_t target_pid, bool block,
     return 1;
 }
 
+int msg_send_bulk(msg_t *m, unsigned num, kernel_pid_t target_pid)
+{
+#ifdef DEVELHELP
+    if (!pid_is_valid(target_pid)) {
+        DEBUG("msg_send_bulk(): target_pid is invalid, continuing anyways\n");
+    }
+#endif /* DEVELHELP */
+
+    unsigned state = irq_disable();
+    thread_t *target = (thread_t *)sched_threads[target_pid];
+    kernel_pid_t sender_pid = irq_is_in() ? KERNEL_PID_ISR : sched_active_pid;
+    unsigned n = 0;
+
+    if (target == NULL) {
+        DEBUG("msg_send_bulk(): target thread does not exist\n");
+        irq_restore(state);
+        return -1;
+    }
+
+    for (unsigned i = 0; i < num; i++) {
+        m[i].sender_pid = sender_pid;
+    }
+
+    if ((num > 0) && (target->status == STATUS_RECEIVE_BLOCKED) &&
+        !_has_mpsc_queue(target)) {
+        DEBUG("msg_send_bulk: Direct msg copy to %" PRIkernel_pid ".\n",
+              target_pid);
+        /* copy first msg to target, the others go to its queue */
+        msg_t *target_message = (msg_t *)target->wait_data;
+        *target_message = m[0];
+        sched_set_status(target, STATUS_PENDING);
+        n++;
+    }
+    while ((n < num) && queue_msg(target, &m[n])) {
+        n++;
+    }
+
+    DEBUG("msg_send_bulk: delivered %u of %u messages to %" PRIkernel_pid
+          ".\n", n, num, target_pid);
+    for (unsigned i = 0; i < n; i++) {
+        ktrace_msg_send(target_pid, m[i].type);
+    }
+    irq_restore(state);
+    if (n > 0) {
+        if (irq_is_in()) {
+            sched_context_switch_request = 1;
+        }
+        else {
+            thread_yield_higher();
+        }
+    }
+    return n;
+}
+
 int msg_send_to_self(msg_t *m)
 {
     unsigned state = irq_disable();
@@ -183,6 +423,9 @@ int msg_send_to_self(msg_t *m)
     m->sender_pid = sched_active_pid;
     int res = queue_msg((thread_t *)sched_active_thread, m);
 
+    if (res) {
+        ktrace_msg_send(sched_active_pid, m->type);
+    }
     irq_restore(state);
     return res;
 }
@@ -203,7 +446,7 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
     }
 
     m->sender_pid = KERNEL_PID_ISR;
-    if (target->status == STATUS_RECEIVE_BLOCKED) {
+    if ((target->status == STATUS_RECEIVE_BLOCKED) && !_has_mpsc_queue(target)) {
         DEBUG("msg_send_int: Direct msg copy from %" PRIkernel_pid " to %"
               PRIkernel_pid ".\n", thread_getpid(), target_pid);
 
@@ -212,13 +455,19 @@ int msg_send_int(msg_t *m, kernel_pid_t target_pid)
         msg_t *target_message = (msg_t *)target->wait_data;
         *target_message = *m;
         sched_set_status(target, STATUS_PENDING);
+        ktrace_msg_send(target_pid, m->type);
 
         sched_context_switch_request = 1;
         return 1;
     }
     else {
         DEBUG("msg_send_int: Receiver not waiting.\n");
-        return (queue_msg(target, m));
+        int res = queue_msg(target, m);
+
+        if (res) {
+            ktrace_msg_send(target_pid, m->type);
+        }
+        return res;
     }
 }
 
@@ -286,12 +535,50 @@ int msg_reply_int(msg_t *m, msg_t *reply)
 
 int msg_try_receive(msg_t *m)
 {
-    return _msg_receive(m, 0);
+    int res = _msg_receive(m, 0);
+
+    if (res == 1) {
+        ktrace_msg_recv(m->sender_pid, m->type);
+    }
+    return res;
 }
 
 int msg_receive(msg_t *m)
 {
-    return _msg_receive(m, 1);
+    int res = _msg_receive(m, 1);
+
+    ktrace_msg_recv(m->sender_pid, m->type);
+    return res;
+}
+
+int msg_receive_bulk(msg_t *m, unsigned num)
+{
+    assert(num > 0);
+
+    _msg_receive(m, 1);
+
+    unsigned n = 1;
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    if (!_has_mpsc_queue(me) && thread_has_msg_queue(me)) {
+        unsigned state = irq_disable();
+        /* blocked senders have to be handled one by one below */
+        while ((n < num) && (me->msg_waiters.next == NULL)) {
+            int queue_index = cib_get(&(me->msg_queue));
+            if (queue_index < 0) {
+                break;
+            }
+            m[n++] = me->msg_array[queue_index];
+        }
+        irq_restore(state);
+    }
+    while ((n < num) && (_msg_receive(&m[n], 0) == 1)) {
+        n++;
+    }
+    for (unsigned i = 0; i < n; i++) {
+        ktrace_msg_recv(m[i].sender_pid, m[i].type);
+    }
+    return n;
 }
 
 static int _msg_receive(msg_t *m, int block)
@@ -303,6 +590,13 @@ static int _msg_receive(msg_t *m, int block)
 
     thread_t *me = (thread_t *)sched_threads[sched_active_pid];
 
+#ifdef MODULE_CORE_MSG_MPSC
+    if (me->msg_queue_mpsc) {
+        irq_restore(state);
+        return _mpsc_receive(me, m, block);
+    }
+#endif
+
     int queue_index = -1;
 
     if (thread_has_msg_queue(me)) {
@@ -411,6 +705,19 @@ void msg_init_queue(msg_t *array, int num)
     cib_init(&(me->msg_queue), num);
 }
 
+#ifdef MODULE_CORE_MSG_MPSC
+void msg_init_queue_mpsc(msg_t *array, int num)
+{
+    thread_t *me = (thread_t *)sched_active_thread;
+
+    for (int i = 0; i < num; i++) {
+        array[i].sender_pid = KERNEL_PID_UNDEF;
+    }
+    msg_init_queue(array, num);
+    me->msg_queue_mpsc = 1;
+}
+#endif
+
 void msg_queue_print(void)
 {
     unsigned state = irq_disable();
@@ -28,10 +28,172 @@
 #include "sched.h"
 #include "irq.h"
 #include "list.h"
+#include "ktrace.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+#ifdef MODULE_CORE_MUTEX_PI
+static thread_t *_waiter(const mutex_t *mutex)
+{
+    if ((mutex->queue.next == NULL) || (mutex->queue.next == MUTEX_LOCKED)) {
+        return NULL;
+    }
+    return container_of((clist_node_t *)mutex->queue.next, thread_t, rq_entry);
+}
+
+/* priority a thread is entitled to: its own one or the one of the highest
+ * priority waiter of any mutex it holds (the waiter queues are sorted) */
+uint8_t mutex_pi_priority(const thread_t *thread)
+{
+    uint8_t priority = thread->base_priority;
+
+    for (const mutex_t *m = thread->mutexes_held; m; m = m->next_held) {
+        thread_t *waiter = _waiter(m);
+        if (waiter && (waiter->priority < priority)) {
+            priority = waiter->priority;
+        }
+    }
+    return priority;
+}
+
+/* must be called with interrupts disabled, might enable them to yield */
+static void _pi_set_priority(thread_t *thread, uint8_t priority,
+                             unsigned irqstate)
+{
+    if (thread->status == STATUS_MUTEX_BLOCKED) {
+        /* keep the queue the thread waits in sorted */
+        mutex_t *mutex = thread->mutex_waiting;
+        list_remove(&mutex->queue, (list_node_t *)&thread->rq_entry);
+        thread->priority = priority;
+        thread_add_to_list(&mutex->queue, thread);
+        irq_restore(irqstate);
+    }
+    else {
+        irq_restore(irqstate);
+        sched_set_priority(thread, priority);
+    }
+}
+
+static void _pi_acquire(mutex_t *mutex, thread_t *thread)
+{
+    if (thread == NULL) {
+        mutex->owner = KERNEL_PID_UNDEF;
+        return;
+    }
+    mutex->owner = thread->pid;
+    mutex->next_held = thread->mutexes_held;
+    thread->mutexes_held = mutex;
+    thread->mutex_waiting = NULL;
+}
+
+static thread_t *_pi_release(mutex_t *mutex)
+{
+    thread_t *owner = (thread_t *)sched_threads[mutex->owner];
+
+    mutex->owner = KERNEL_PID_UNDEF;
+    if (owner) {
+        for (mutex_t **m = &owner->mutexes_held; *m; m = &(*m)->next_held) {
+            if (*m == mutex) {
+                *m = mutex->next_held;
+                break;
+            }
+        }
+    }
+    return owner;
+}
+
+/* called with interrupts disabled when waking process as the next holder of
+ * the mutex released by owner: a mutex unlocked by anyone else, e.g. by an
+ * ISR, is a signal the woken thread might never unlock (e.g. a locked mutex
+ * on the stack of ztimer_sleep()), so it gets no owner */
+static void _pi_hand_over(mutex_t *mutex, thread_t *owner, thread_t *process)
+{
+    process->mutex_waiting = NULL;
+    if (owner && (owner == sched_active_thread) && !irq_is_in()) {
+        _pi_acquire(mutex, process);
+    }
+}
+
+/* called with interrupts disabled by a thread about to block on mutex */
+static void _pi_inherit(mutex_t *mutex, thread_t *me)
+{
+    uint8_t priority = me->priority;
+    thread_t *owner;
+
+    me->mutex_waiting = mutex;
+    if (mutex->owner == me->pid) {
+        /* locking a mutex it holds already, the thread waits for a signal
+         * from whoever unlocks it and won't unlock it itself */
+        _pi_release(mutex);
+        return;
+    }
+    /* the chain ends at a runnable owner or one boosted already (this also
+     * terminates on deadlock cycles) */
+    while ((owner = (thread_t *)sched_threads[mutex->owner]) &&
+           (owner->priority > priority)) {
+        DEBUG("PID[%" PRIkernel_pid "]: boosting %" PRIkernel_pid
+              " to %" PRIu8 "\n", me->pid, owner->pid, priority);
+        if (owner->status == STATUS_MUTEX_BLOCKED) {
+            mutex = owner->mutex_waiting;
+            list_remove(&mutex->queue, (list_node_t *)&owner->rq_entry);
+            owner->priority = priority;
+            thread_add_to_list(&mutex->queue, owner);
+        }
+        else {
+            /* me is still running with priority, so this won't yield */
+            sched_set_priority(owner, priority);
+            break;
+        }
+    }
+}
+
+/* drops inherited priorities the previous owner isn't entitled to anymore */
+static void _pi_restore(thread_t *owner)
+{
+    if (owner) {
+        unsigned irqstate = irq_disable();
+        _pi_set_priority(owner, mutex_pi_priority(owner), irqstate);
+    }
+}
+
+void mutex_pi_restore(mutex_t *mutex)
+{
+    _pi_restore((thread_t *)sched_threads[mutex->owner]);
+}
+#else
+static inline void _pi_inherit(mutex_t *mutex, thread_t *me)
+{
+    (void)mutex;
+    (void)me;
+}
+
+static inline void _pi_acquire(mutex_t *mutex, thread_t *thread)
+{
+    (void)mutex;
+    (void)thread;
+}
+
+static inline thread_t *_pi_release(mutex_t *mutex)
+{
+    (void)mutex;
+    return NULL;
+}
+
+static inline void _pi_hand_over(mutex_t *mutex, thread_t *owner,
+                                 thread_t *process)
+{
+    (void)mutex;
+    (void)owner;
+    (void)process;
+}
+
+static inline void _pi_restore(thread_t *owner)
+{
+    (void)owner;
+}
+#endif
+
 int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
 {
     unsigned irqstate = irq_disable();
@@ -41,6 +203,8 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
     if (mutex->queue.next == NULL) {
         /* mutex is unlocked. */
         mutex->queue.next = MUTEX_LOCKED;
+        _pi_acquire(mutex, irq_is_in() ? NULL
+                                       : (thread_t *)sched_active_thread);
         DEBUG("PID[%" PRIkernel_pid "]: mutex_wait early out.\n",
               sched_active_pid);
         irq_restore(irqstate);
@@ -50,6 +214,7 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
         thread_t *me = (thread_t *)sched_active_thread;
         DEBUG("PID[%" PRIkernel_pid "]: Adding node to mutex queue: prio: %"
               PRIu32 "\n", sched_active_pid, (uint32_t)me->priority);
+        _pi_inherit(mutex, me);
         sched_set_status(me, STATUS_MUTEX_BLOCKED);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = (list_node_t *)&me->rq_entry;
@@ -58,10 +223,12 @@ int _mutex_lock(mutex_t *mutex, volatile uint8_t *blocking)
         else {
             thread_add_to_list(&mutex->queue, me);
         }
+        ktrace_mutex_block(mutex);
         irq_restore(irqstate);
         thread_yield_higher();
         /* We were woken up by scheduler. Waker removed us from queue.
          * We have the mutex now. */
+        ktrace_mutex_acquire(mutex);
         return 1;
     }
     else {
@@ -83,10 +250,13 @@ void mutex_unlock(mutex_t *mutex)
         return;
     }
 
+    thread_t *owner = _pi_release(mutex);
+
     if (mutex->queue.next == MUTEX_LOCKED) {
         mutex->queue.next = NULL;
         /* the mutex was locked and no thread was waiting for it */
         irq_restore(irqstate);
+        _pi_restore(owner);
         return;
     }
 
@@ -97,6 +267,7 @@ void mutex_unlock(mutex_t *mutex)
     DEBUG("mutex_unlock: waking up waiting thread %" PRIkernel_pid "\n",
           process->pid);
     sched_set_status(process, STATUS_PENDING);
+    _pi_hand_over(mutex, owner, process);
 
     if (!mutex->queue.next) {
         mutex->queue.next = MUTEX_LOCKED;
@@ -104,6 +275,7 @@ void mutex_unlock(mutex_t *mutex)
 
     uint16_t process_priority = process->priority;
     irq_restore(irqstate);
+    _pi_restore(owner);
     sched_switch(process_priority);
 }
 
@@ -112,8 +284,10 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
     DEBUG("PID[%" PRIkernel_pid "]: unlocking mutex. queue.next: %p, and "
           "taking a nap\n", sched_active_pid, (void *)mutex->queue.next);
     unsigned irqstate = irq_disable();
+    thread_t *owner = NULL;
 
     if (mutex->queue.next) {
+        owner = _pi_release(mutex);
         if (mutex->queue.next == MUTEX_LOCKED) {
             mutex->queue.next = NULL;
         }
@@ -123,6 +297,7 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
                                              rq_entry);
             DEBUG("PID[%" PRIkernel_pid "]: waking up waiter.\n", process->pid);
             sched_set_status(process, STATUS_PENDING);
+            _pi_hand_over(mutex, owner, process);
             if (!mutex->queue.next) {
                 mutex->queue.next = MUTEX_LOCKED;
             }
@@ -131,6 +306,12 @@ void mutex_unlock_and_sleep(mutex_t *mutex)
 
     DEBUG("PID[%" PRIkernel_pid "]: going to sleep.\n", sched_active_pid);
     sched_set_status((thread_t *)sched_active_thread, STATUS_SLEEPING);
+    if (owner == (thread_t *)sched_active_thread) {
+        /* not on the run queue anymore, so this won't yield */
+        _pi_restore(owner);
+        owner = NULL;
+    }
     irq_restore(irqstate);
+    _pi_restore(owner);
     thread_yield_higher();
 }
@@ -19,19 +19,26 @@
  * @}
  */
 
+#include <assert.h>
 #include <stdint.h>
 
 #include "sched.h"
 #include "clist.h"
 #include "bitarithm.h"
 #include "irq.h"
+#include "mutex.h"
 #include "thread.h"
 #include "log.h"
+#include "ktrace.h"
 
 #ifdef MODULE_MPU_STACK_GUARD
 #include "mpu.h"
 #endif
 
+#ifdef MODULE_SCHED_EDF
+#include "sched_edf.h"
+#endif
+
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
@@ -76,6 +83,23 @@ static void (*sched_cb) (kernel_pid_t active_thread,
                          kernel_pid_t next_thread) = NULL;
 #endif
 
+#ifdef MODULE_SCHED_EDF
+/* picks the thread with the earliest deadline of the EDF run queue */
+static thread_t *_edf_earliest(clist_node_t *runqueue)
+{
+    clist_node_t *first = runqueue->next->next;
+    thread_t *earliest = container_of(first, thread_t, rq_entry);
+
+    for (clist_node_t *node = first->next; node != first; node = node->next) {
+        thread_t *thread = container_of(node, thread_t, rq_entry);
+        if ((int32_t)(thread->deadline - earliest->deadline) < 0) {
+            earliest = thread;
+        }
+    }
+    return earliest;
+}
+#endif
+
 int __attribute__((used)) sched_run(void)
 {
     sched_context_switch_request = 0;
@@ -89,6 +113,12 @@ int __attribute__((used)) sched_run(void)
     thread_t *next_thread = container_of(sched_runqueues[nextrq].next->next,
                                          thread_t, rq_entry);
 
+#ifdef MODULE_SCHED_EDF
+    if (nextrq == SCHED_EDF_PRIORITY) {
+        next_thread = _edf_earliest(&sched_runqueues[nextrq]);
+    }
+#endif
+
     DEBUG(
         "sched_run: active thread: %" PRIkernel_pid ", next thread: %" PRIkernel_pid "\n",
         (kernel_pid_t)((active_thread == NULL)
@@ -125,6 +155,16 @@ int __attribute__((used)) sched_run(void)
     }
 #endif
 
+#ifdef MODULE_SCHED_EDF
+    /* only EDF threads have a budget to account */
+    if ((nextrq == SCHED_EDF_PRIORITY) ||
+        (active_thread && (active_thread->priority == SCHED_EDF_PRIORITY))) {
+        sched_edf_switch(sched_active_pid, next_thread->pid);
+    }
+#endif
+
+    ktrace_sched(next_thread->pid);
+
     next_thread->status = STATUS_RUNNING;
     sched_active_pid = next_thread->pid;
     sched_active_thread = (volatile thread_t *)next_thread;
@@ -198,6 +238,59 @@ void sched_switch(uint16_t other_prio)
     }
 }
 
+void sched_change_priority(thread_t *thread, uint8_t priority)
+{
+    assert(thread && (priority < SCHED_PRIO_LEVELS));
+
+#ifdef MODULE_CORE_MUTEX_PI
+    unsigned irqstate = irq_disable();
+    /* keep the priority inherited from the waiters of mutexes it holds */
+    thread->base_priority = priority;
+    priority = mutex_pi_priority(thread);
+    irq_restore(irqstate);
+#endif
+    sched_set_priority(thread, priority);
+}
+
+void sched_set_priority(thread_t *thread, uint8_t priority)
+{
+    assert(thread && (priority < SCHED_PRIO_LEVELS));
+
+    unsigned irqstate = irq_disable();
+
+    if (thread->priority == priority) {
+        irq_restore(irqstate);
+        return;
+    }
+
+    DEBUG("sched_set_priority: thread %" PRIkernel_pid " from %" PRIu8
+          " to %" PRIu8 "\n", thread->pid, thread->priority, priority);
+
+    int on_runqueue = (thread->status >= STATUS_ON_RUNQUEUE);
+
+    if (on_runqueue) {
+        clist_remove(&sched_runqueues[thread->priority], &thread->rq_entry);
+        if (!sched_runqueues[thread->priority].next) {
+            runqueue_bitcache &= ~(1 << thread->priority);
+        }
+        clist_rpush(&sched_runqueues[priority], &thread->rq_entry);
+        runqueue_bitcache |= 1 << priority;
+    }
+    thread->priority = priority;
+
+    irq_restore(irqstate);
+
+    if (on_runqueue) {
+        if (thread == sched_active_thread) {
+            /* yield if another thread has a higher priority now */
+            sched_switch(bitarithm_lsb(runqueue_bitcache));
+        }
+        else {
+            sched_switch(priority);
+        }
+    }
+}
+
 NORETURN void sched_task_exit(void)
 {
     DEBUG("sched_task_exit: ending thread %" PRIkernel_pid "...\n",
@@ -283,6 +283,17 @@ kernel_pid_t thread_create(char *stack, int stacksize, uint8_t priority,
     cib_init(&(thread->msg_queue), 0);
     thread->msg_array = NULL;
 #endif
+#ifdef MODULE_CORE_MSG_MPSC
+    thread->msg_queue_mpsc = 0;
+#endif
+#ifdef MODULE_SCHED_EDF
+    thread->deadline = 0;
+#endif
+#ifdef MODULE_CORE_MUTEX_PI
+    thread->base_priority = priority;
+    thread->mutex_waiting = NULL;
+    thread->mutexes_held = NULL;
+#endif
 
     sched_num_threads++;
 
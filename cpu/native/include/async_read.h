@@ -26,8 +26,12 @@ extern "C" {
  * @brief   Maximum number of file descriptors
  */
 #ifndef ASYNC_READ_NUMOF
+#ifdef MODULE_NATIVE_SMP
+#define ASYNC_READ_NUMOF 3
+#else
 #define ASYNC_READ_NUMOF 2
 #endif
+#endif
 
 /**
  * @brief   asynchronus read callback type
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    cpu_native_smp  Offloading of CPU-bound work to host cores
+ * @ingroup     cpu_native
+ * @brief       Run CPU-bound jobs of a native instance on all host cores
+ *
+ * RIOT's kernel is single core: all RIOT threads of a native instance run on
+ * one host thread, and disabling interrupts is used as a global lock. To
+ * still make use of all host cores, the `native_smp` module starts a pool of
+ * host worker threads (one per online host core, at most
+ * @ref NATIVE_SMP_NUMOF_MAX) that execute CPU-bound jobs, e.g. crypto or
+ * compression benchmarks.
+ *
+ * A RIOT thread submits a job with @ref native_smp_parallel_for() and blocks
+ * until all iterations have been executed by the workers. Workers pick
+ * iterations dynamically, so a worker that finishes early takes over
+ * remaining work. Meanwhile, all other RIOT threads keep running as usual,
+ * thread_create(), msg_send() etc. keep their single core semantics.
+ *
+ * @warning Job functions run on host threads outside of RIOT. They must not
+ *          call any RIOT API nor any libc function that native wraps
+ *          (e.g. malloc(), printf(), read(), write()). Pure computation on
+ *          memory owned by the submitting thread is safe.
+ *
+ * @{
+ *
+ * @file
+ * @brief       native_smp API
+ */
+#ifndef NATIVE_SMP_H
+#define NATIVE_SMP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Maximum number of host worker threads
+ */
+#ifndef NATIVE_SMP_NUMOF_MAX
+#define NATIVE_SMP_NUMOF_MAX    (16U)
+#endif
+
+/**
+ * @brief   Job function type
+ *
+ * @param[in] arg   argument passed to @ref native_smp_parallel_for()
+ * @param[in] idx   iteration index, 0 <= @p idx < numof
+ */
+typedef void (*native_smp_func_t)(void *arg, unsigned idx);
+
+/**
+ * @brief   Start the host worker threads
+ *
+ * Called once during native's startup.
+ */
+void native_smp_init(void);
+
+/**
+ * @brief   Get the number of host worker threads
+ *
+ * @return  number of worker threads
+ */
+unsigned native_smp_numof(void);
+
+/**
+ * @brief   Execute @p func for every index in [0, @p numof) on the host
+ *          worker threads
+ *
+ * Blocks the calling thread until all iterations are done. Iterations may
+ * run concurrently and in any order.
+ *
+ * @pre     Must not be called from interrupt context
+ *
+ * @param[in] func      function to execute
+ * @param[in] arg       argument passed to @p func
+ * @param[in] numof     number of iterations
+ */
+void native_smp_parallel_for(native_smp_func_t func, void *arg, unsigned numof);
+
+/**
+ * @brief   Execute @p func once on a host worker thread
+ *
+ * @pre     Must not be called from interrupt context
+ *
+ * @param[in] func      function to execute, called with `idx = 0`
+ * @param[in] arg       argument passed to @p func
+ */
+static inline void native_smp_run(native_smp_func_t func, void *arg)
+{
+    native_smp_parallel_for(func, arg, 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NATIVE_SMP_H */
+/** @} */
@@ -24,9 +24,11 @@
 extern "C" {
 #endif
 
+#include <stdbool.h>
 #include <stdint.h>
 #include "net/netdev.h"
 
+#include "net/ethernet.h"
 #include "net/ethernet/hdr.h"
 
 #ifdef __MACH__
@@ -35,6 +37,16 @@ extern "C" {
 #include "net/if.h"
 #endif
 
+/**
+ * @brief   Number of receive buffers per tap interface handed out via
+ *          @ref NETOPT_RX_BUF
+ *
+ * Set to 0 to disable zero-copy reception.
+ */
+#ifndef NETDEV_TAP_RX_BUF_NUMOF
+#define NETDEV_TAP_RX_BUF_NUMOF     (4U)
+#endif
+
 /**
  * @brief tap interface state
  */
@@ -44,6 +56,12 @@ typedef struct netdev_tap {
     int tap_fd;                         /**< host file descriptor for the TAP */
     uint8_t addr[ETHERNET_ADDR_LEN];    /**< The MAC address of the TAP */
     uint8_t promiscuous;                 /**< Flag for promiscuous mode */
+#if NETDEV_TAP_RX_BUF_NUMOF || DOXYGEN
+    /** receive buffers for @ref NETOPT_RX_BUF */
+    uint8_t rx_buf[NETDEV_TAP_RX_BUF_NUMOF][ETHERNET_FRAME_LEN];
+    /** receive buffers currently owned by upper layers */
+    volatile bool rx_buf_used[NETDEV_TAP_RX_BUF_NUMOF];
+#endif
 } netdev_tap_t;
 
 /**
@@ -37,6 +37,7 @@
 #include "irq.h"
 #include "cpu.h"
 #include "periph/pm.h"
+#include "ktrace.h"
 
 #include "native_internal.h"
 
@@ -260,7 +261,9 @@ void native_irq_handler(void)
 
         if (native_irq_handlers[sig] != NULL) {
             DEBUG("native_irq_handler: calling interrupt handler for %i\n", sig);
+            ktrace_isr_enter(sig);
             native_irq_handlers[sig]();
+            ktrace_isr_exit(sig);
         }
         else if (sig == SIGUSR1) {
             warnx("native_irq_handler: ignoring SIGUSR1");
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     cpu_native_smp
+ * @{
+ *
+ * @file
+ * @brief       Offloading of CPU-bound work to host worker threads
+ *
+ * Workers take batches from a queue protected by a pthread mutex. Completion
+ * is signalled back into RIOT by writing the finished batch's address into a
+ * pipe, whose read end is monitored by native's async_read (SIGIO). The
+ * SIGIO handler then unlocks the mutex the submitting thread waits on.
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <err.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "async_read.h"
+#include "irq.h"
+#include "mutex.h"
+#include "native_internal.h"
+#include "native_smp.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+typedef struct batch {
+    struct batch *next;         /**< next batch in queue */
+    native_smp_func_t func;     /**< job function */
+    void *arg;                  /**< job argument */
+    unsigned numof;             /**< number of iterations */
+    unsigned idx;               /**< next iteration to take (atomic) */
+    unsigned active;            /**< workers in this batch (under _lock) */
+    mutex_t done;               /**< unlocked on completion */
+} _batch_t;
+
+static pthread_t _workers[NATIVE_SMP_NUMOF_MAX];
+static unsigned _numof;
+static pthread_mutex_t _lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _cond = PTHREAD_COND_INITIALIZER;
+static _batch_t *_head, *_tail;
+static int _done_pipe[2];
+
+static void _dequeue(_batch_t *batch)
+{
+    /* called with _lock held */
+    if (_head == batch) {
+        _head = batch->next;
+        if (!_head) {
+            _tail = NULL;
+        }
+    }
+}
+
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        pthread_mutex_lock(&_lock);
+        while (!_head) {
+            pthread_cond_wait(&_cond, &_lock);
+        }
+        _batch_t *batch = _head;
+        batch->active++;
+        pthread_mutex_unlock(&_lock);
+
+        unsigned idx;
+        while ((idx = __atomic_fetch_add(&batch->idx, 1, __ATOMIC_RELAXED))
+               < batch->numof) {
+            batch->func(batch->arg, idx);
+        }
+
+        pthread_mutex_lock(&_lock);
+        /* all iterations are taken, so no further worker may join */
+        _dequeue(batch);
+        unsigned last = (--batch->active == 0);
+        pthread_mutex_unlock(&_lock);
+
+        if (last) {
+            /* native wraps write(), use the real one outside of RIOT */
+            if (real_write(_done_pipe[1], &batch, sizeof(batch)) != sizeof(batch)) {
+                err(EXIT_FAILURE, "native_smp: write");
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void _done_isr(int fd, void *arg)
+{
+    (void)arg;
+    _batch_t *batch;
+
+    while (real_read(fd, &batch, sizeof(batch)) == sizeof(batch)) {
+        DEBUG("native_smp: batch %p done\n", (void *)batch);
+        mutex_unlock(&batch->done);
+    }
+    native_async_read_continue(fd);
+}
+
+void native_smp_init(void)
+{
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    sigset_t all, old;
+
+    _numof = (cores < 1) ? 1
+           : ((unsigned long)cores > NATIVE_SMP_NUMOF_MAX) ? NATIVE_SMP_NUMOF_MAX
+           : (unsigned)cores;
+
+    if (real_pipe(_done_pipe) == -1) {
+        err(EXIT_FAILURE, "native_smp_init: pipe");
+    }
+    native_async_read_setup();
+    native_async_read_add_handler(_done_pipe[0], NULL, _done_isr);
+
+    /* workers inherit the signal mask: make sure native's signals are only
+     * ever delivered to the host thread running RIOT */
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    for (unsigned i = 0; i < _numof; i++) {
+        if (pthread_create(&_workers[i], NULL, _worker, NULL) != 0) {
+            err(EXIT_FAILURE, "native_smp_init: pthread_create");
+        }
+    }
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+
+    DEBUG("native_smp: started %u workers\n", _numof);
+}
+
+unsigned native_smp_numof(void)
+{
+    return _numof;
+}
+
+void native_smp_parallel_for(native_smp_func_t func, void *arg, unsigned numof)
+{
+    assert(!irq_is_in());
+
+    if (numof == 0) {
+        return;
+    }
+
+    _batch_t batch = {
+        .func = func,
+        .arg = arg,
+        .numof = numof,
+        .done = MUTEX_INIT_LOCKED,
+    };
+
+    /* keep native's signal handlers (and thus other RIOT threads) from
+     * running while the host mutex is held */
+    unsigned state = irq_disable();
+    pthread_mutex_lock(&_lock);
+    if (_tail) {
+        _tail->next = &batch;
+    }
+    else {
+        _head = &batch;
+    }
+    _tail = &batch;
+    pthread_cond_broadcast(&_cond);
+    pthread_mutex_unlock(&_lock);
+    irq_restore(state);
+
+    mutex_lock(&batch.done);
+}
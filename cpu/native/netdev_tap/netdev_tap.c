@@ -106,6 +106,44 @@ static inline void _isr(netdev_t *netdev)
 #endif
 }
 
+#if NETDEV_TAP_RX_BUF_NUMOF
+static void _rx_buf_release(void *arg, void *data)
+{
+    netdev_tap_t *dev = arg;
+
+    for (unsigned i = 0; i < NETDEV_TAP_RX_BUF_NUMOF; i++) {
+        if (dev->rx_buf[i] == data) {
+            dev->rx_buf_used[i] = false;
+            return;
+        }
+    }
+    assert(false);
+}
+
+static int _recv_buf(netdev_t *netdev, netdev_rx_buf_t *rx_buf)
+{
+    netdev_tap_t *dev = (netdev_tap_t*)netdev;
+
+    for (unsigned i = 0; i < NETDEV_TAP_RX_BUF_NUMOF; i++) {
+        if (!dev->rx_buf_used[i]) {
+            int nread = _recv(netdev, dev->rx_buf[i], ETHERNET_FRAME_LEN, NULL);
+            if (nread <= 0) {
+                /* dropped or nothing to read */
+                return 0;
+            }
+            dev->rx_buf_used[i] = true;
+            rx_buf->data = dev->rx_buf[i];
+            rx_buf->len = nread;
+            rx_buf->release = _rx_buf_release;
+            rx_buf->arg = dev;
+            return sizeof(netdev_rx_buf_t);
+        }
+    }
+    DEBUG("netdev_tap: all receive buffers in use\n");
+    return -ENOBUFS;
+}
+#endif
+
 static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
 {
     int res = 0;
@@ -124,6 +162,16 @@ static int _get(netdev_t *dev, netopt_t opt, void *value, size_t max_len)
             *((bool*)value) = (bool)_get_promiscous(dev);
             res = sizeof(bool);
             break;
+#if NETDEV_TAP_RX_BUF_NUMOF
+        case NETOPT_RX_BUF:
+            if (max_len < sizeof(netdev_rx_buf_t)) {
+                res = -EINVAL;
+            }
+            else {
+                res = _recv_buf(dev, value);
+            }
+            break;
+#endif
         default:
             res = netdev_eth_get(dev, opt, value, max_len);
             break;
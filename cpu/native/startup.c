@@ -81,6 +81,9 @@ netdev_tap_params_t netdev_tap_params[NETDEV_TAP_MAX];
 #ifdef MODULE_PERIPH_SPIDEV_LINUX
 #include "spidev_linux.h"
 #endif
+#ifdef MODULE_NATIVE_SMP
+#include "native_smp.h"
+#endif
 #ifdef MODULE_SOCKET_ZEP
 #include "socket_zep_params.h"
 
@@ -585,6 +588,9 @@ __attribute__((constructor)) static void startup(int argc, char **argv, char **e
 
     periph_init();
     board_init();
+#ifdef MODULE_NATIVE_SMP
+    native_smp_init();
+#endif
 
     register_interrupt(SIGUSR1, _reset_handler);
 
@@ -264,6 +264,20 @@ struct netdev_radio_rx_info {
  */
 typedef struct netdev netdev_t;
 
+/**
+ * @brief   Device owned receive buffer
+ *
+ * Returned by drivers supporting @ref NETOPT_RX_BUF. The buffer holds one
+ * received frame and belongs to the upper layer until @p release is called.
+ */
+typedef struct {
+    void *data;                             /**< received frame */
+    size_t len;                             /**< length of the frame */
+    void (*release)(void *arg, void *data); /**< hands the buffer back to the
+                                             *   driver */
+    void *arg;                              /**< argument for @p release */
+} netdev_rx_buf_t;
+
 /**
  * @brief   Event callback for signaling event to upper layers
  *
@@ -49,6 +49,11 @@ void auto_init(void)
         extern void init_schedstatistics(void);
         init_schedstatistics();
     }
+    if (IS_USED(MODULE_KTRACE)) {
+        LOG_DEBUG("Auto init ktrace.\n");
+        extern void ktrace_init(void);
+        ktrace_init();
+    }
     if (IS_USED(MODULE_EVENT_THREAD)) {
         LOG_DEBUG("Auto init event threads.\n");
         extern void auto_init_event_thread(void);
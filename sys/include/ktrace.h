@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_ktrace Kernel event tracing
+ * @ingroup     sys
+ * @brief       Records scheduler, interrupt, messaging and mutex events
+ *              with timestamps for offline analysis
+ *
+ * When module `ktrace` is used, the kernel records every context switch,
+ * interrupt service routine entry and exit (on CPUs calling
+ * @ref ktrace_isr_enter() and @ref ktrace_isr_exit(), e.g. `native`), every
+ * message sent and received and every thread blocking on a mutex into a ring
+ * buffer of @ref KTRACE_BUF_SIZE events. Once full, the oldest events are
+ * overwritten, so the buffer always holds the latest history.
+ *
+ * Recording an event is lock-free: a slot is reserved with an atomic
+ * increment, so events from interrupts preempting a thread while it records
+ * one are not lost.
+ *
+ * The recorded events can be exported as
+ * - [Chrome Trace Event](https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU)
+ *   JSON, which can be opened in `chrome://tracing` or
+ *   [Perfetto](https://ui.perfetto.dev/): threads show up as tracks with
+ *   their running times, interrupts on a separate track and messages and
+ *   mutex events as instant events.
+ * - [CTF](https://diamon.org/ctf/) (Common Trace Format) streams, e.g. for
+ *   [Trace Compass](https://www.eclipse.org/tracecompass/) or `babeltrace`.
+ *
+ * The `ktrace` shell command (module `shell_commands`) controls the
+ * recording and prints the JSON export. On `native`, both formats can be
+ * written to files on the host.
+ *
+ * Timestamps are taken from the DWT cycle counter on Cortex-M3 and above,
+ * from the host's monotonic clock (nanoseconds) on `native` and from
+ * @ref sys_xtimer otherwise. They have 64 bit, so they don't wrap during a
+ * trace. The 32 bit DWT cycle counter is extended in software, which relies
+ * on events being recorded at least once per period of the counter (e.g.
+ * every 67 seconds at 64 MHz).
+ *
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracing interface
+ */
+
+#ifndef KTRACE_H
+#define KTRACE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_defines.h"
+#include "kernel_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Number of events the trace buffer holds
+ *
+ * @note    Must be a power of two.
+ */
+#ifndef KTRACE_BUF_SIZE
+#define KTRACE_BUF_SIZE     (256U)
+#endif
+
+/**
+ * @brief   Types of trace events
+ */
+typedef enum {
+    KTRACE_SCHED = 0,       /**< context switch, `arg` is the next PID */
+    KTRACE_ISR_ENTER,       /**< ISR entered, `arg` is the IRQ number */
+    KTRACE_ISR_EXIT,        /**< ISR left, `arg` is the IRQ number */
+    KTRACE_MSG_SEND,        /**< message sent, `arg` is target PID (upper
+                             *   16 bit) and message type (lower 16 bit);
+                             *   only recorded if the message was delivered,
+                             *   queued or the sender blocks for it */
+    KTRACE_MSG_RECV,        /**< message received, `arg` is sender PID
+                             *   (upper 16 bit) and message type
+                             *   (lower 16 bit) */
+    KTRACE_MUTEX_BLOCK,     /**< thread blocks on mutex, `arg` is the mutex
+                             *   address */
+    KTRACE_MUTEX_ACQUIRE,   /**< thread acquired mutex it blocked on, `arg`
+                             *   is the mutex address */
+    KTRACE_NUMOF,           /**< number of event types */
+} ktrace_type_t;
+
+/**
+ * @brief   A trace event
+ */
+typedef struct {
+    uint64_t time;          /**< timestamp in ticks of @ref ktrace_clock_hz() */
+    uint32_t arg;           /**< event argument, see @ref ktrace_type_t */
+    kernel_pid_t pid;       /**< PID of the active thread, or KERNEL_PID_ISR
+                             *   when recorded in interrupt context */
+    uint8_t type;           /**< event type, see @ref ktrace_type_t */
+} ktrace_event_t;
+
+/**
+ * @brief   Function the exports write their output with
+ *
+ * @param[in] arg   argument given to the export function
+ * @param[in] data  data to write
+ * @param[in] len   length of @p data
+ */
+typedef void (*ktrace_write_t)(void *arg, const void *data, size_t len);
+
+#if IS_USED(MODULE_KTRACE) || defined(DOXYGEN)
+/**
+ * @brief   Records an event
+ *
+ * @param[in] type  event type
+ * @param[in] arg   event argument, see @ref ktrace_type_t
+ */
+void ktrace_record(ktrace_type_t type, uint32_t arg);
+#else
+static inline void ktrace_record(ktrace_type_t type, uint32_t arg)
+{
+    (void)type;
+    (void)arg;
+}
+#endif
+
+/**
+ * @brief   Records a context switch
+ *
+ * @param[in] next  PID of the thread being scheduled
+ */
+static inline void ktrace_sched(kernel_pid_t next)
+{
+    ktrace_record(KTRACE_SCHED, (uint16_t)next);
+}
+
+/**
+ * @brief   Records the entry of an ISR
+ *
+ * To be called by the CPU implementation.
+ *
+ * @param[in] irq   IRQ number
+ */
+static inline void ktrace_isr_enter(unsigned irq)
+{
+    ktrace_record(KTRACE_ISR_ENTER, irq);
+}
+
+/**
+ * @brief   Records the exit of an ISR
+ *
+ * To be called by the CPU implementation.
+ *
+ * @param[in] irq   IRQ number
+ */
+static inline void ktrace_isr_exit(unsigned irq)
+{
+    ktrace_record(KTRACE_ISR_EXIT, irq);
+}
+
+/**
+ * @brief   Records a message being sent
+ *
+ * To be called once sending the message can't fail anymore.
+ *
+ * @param[in] target    PID of the receiving thread
+ * @param[in] type      message type
+ */
+static inline void ktrace_msg_send(kernel_pid_t target, uint16_t type)
+{
+    ktrace_record(KTRACE_MSG_SEND, ((uint32_t)(uint16_t)target << 16) | type);
+}
+
+/**
+ * @brief   Records a message being received
+ *
+ * @param[in] sender    PID of the sending thread
+ * @param[in] type      message type
+ */
+static inline void ktrace_msg_recv(kernel_pid_t sender, uint16_t type)
+{
+    ktrace_record(KTRACE_MSG_RECV, ((uint32_t)(uint16_t)sender << 16) | type);
+}
+
+/**
+ * @brief   Records the active thread blocking on a mutex
+ *
+ * @param[in] mutex address of the mutex
+ */
+static inline void ktrace_mutex_block(const void *mutex)
+{
+    ktrace_record(KTRACE_MUTEX_BLOCK, (uintptr_t)mutex);
+}
+
+/**
+ * @brief   Records the active thread acquiring a mutex it blocked on
+ *
+ * @param[in] mutex address of the mutex
+ */
+static inline void ktrace_mutex_acquire(const void *mutex)
+{
+    ktrace_record(KTRACE_MUTEX_ACQUIRE, (uintptr_t)mutex);
+}
+
+/**
+ * @brief   Initializes the timestamp source and enables recording
+ *
+ * Called by auto_init. Events recorded before are discarded.
+ */
+void ktrace_init(void);
+
+/**
+ * @brief   Enables or disables recording
+ *
+ * Recording is enabled at startup.
+ *
+ * @param[in] enable    true to enable recording
+ */
+void ktrace_enable(bool enable);
+
+/**
+ * @brief   Drops all recorded events
+ */
+void ktrace_clear(void);
+
+/**
+ * @brief   Gets a recorded event
+ *
+ * @param[in] idx       index of the event, 0 being the oldest event
+ * @param[out] event    the event
+ *
+ * @return  0 on success
+ * @return  -1 if there is no event with index @p idx
+ */
+int ktrace_get(unsigned idx, ktrace_event_t *event);
+
+/**
+ * @brief   Gets the frequency of the event timestamps
+ *
+ * @return  ticks per second of ktrace_event_t::time
+ */
+uint32_t ktrace_clock_hz(void);
+
+/**
+ * @brief   Exports the recorded events as Chrome Trace Event JSON
+ *
+ * Recording is disabled during the export.
+ *
+ * @param[in] write     function to write the output with
+ * @param[in] arg       argument for @p write
+ */
+void ktrace_export_chrome(ktrace_write_t write, void *arg);
+
+/**
+ * @brief   Exports the CTF metadata describing the stream of
+ *          @ref ktrace_export_ctf()
+ *
+ * @param[in] write     function to write the output with
+ * @param[in] arg       argument for @p write
+ */
+void ktrace_export_ctf_metadata(ktrace_write_t write, void *arg);
+
+/**
+ * @brief   Exports the recorded events as (binary) CTF stream
+ *
+ * Recording is disabled during the export.
+ *
+ * @param[in] write     function to write the output with
+ * @param[in] arg       argument for @p write
+ */
+void ktrace_export_ctf(ktrace_write_t write, void *arg);
+
+#if defined(CPU_NATIVE) || defined(DOXYGEN)
+/**
+ * @brief   Writes the recorded events to a file on the host
+ *
+ * Only available on `native`.
+ *
+ * @param[in] path  path of a JSON file to write for Chrome Trace Event
+ *                  format, or of a directory to write the CTF `metadata` and
+ *                  `stream` files to for CTF
+ * @param[in] ctf   true to export CTF, false for Chrome Trace Event JSON
+ *
+ * @return  0 on success
+ * @return  -errno on error
+ */
+int ktrace_export_file(const char *path, bool ctf);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KTRACE_H */
+/** @} */
@@ -90,6 +90,22 @@
  * If no payload, call only gcoap_response() to write the full response. If you
  * need to add Options, follow the first three steps in the list above instead.
  *
+ * ### Request worker pool ###
+ *
+ * By default, gcoap calls the resource handlers on its own thread, so a slow
+ * handler, e.g. one reading a sensor over I2C or a file from VFS, delays all
+ * other requests and responses. With the `gcoap_workers` module, the gcoap
+ * thread only parses a request and handles the Observe registration. The
+ * request is then queued for a pool of CONFIG_GCOAP_WORKERS_NUMOF worker
+ * threads, which call the handler and send the response via gcoap's socket.
+ * Handlers may thus run concurrently and must protect shared state
+ * themselves.
+ *
+ * At most CONFIG_GCOAP_WORKER_QUEUE_SIZE requests are queued or in progress.
+ * Use gcoap_worker_limit() to restrict how many of them may be for a single
+ * resource, so a slow resource can't occupy all workers. If a request can't be
+ * queued, gcoap replies with 5.03 (Service Unavailable).
+ *
  * ### Resource list creation ###
  *
  * gcoap allows customization of the function that provides the list of registered
@@ -154,7 +170,8 @@
  * A CoAP client may register for Observe notifications for any resource that
  * an application has registered with gcoap. An application does not need to
  * take any action to support Observe client registration. However, gcoap
- * limits registration for a given resource to a _single_ observer.
+ * limits registration for a given resource to a _single_ observer, unless the
+ * `gcoap_obs_fanout` module is used (see "Observe fan-out" below).
  *
  * It is [suggested](https://tools.ietf.org/html/rfc7641#section-6) that a
  * server adds the 'obs' attribute to resources that are useful for observation
@@ -206,6 +223,24 @@
  * the Observe option value set to 1. The server does not support cancellation
  * via a reset (RST) response to a non-confirmable notification.
  *
+ * ### Observe fan-out ###
+ *
+ * With the `gcoap_obs_fanout` module, any number of clients may observe a
+ * resource, e.g. on a gateway that forwards sensor data to many clients.
+ * The registrations are kept in a pool the application provides at runtime
+ * with gcoap_obs_pool_init(), sized for the expected number of observers,
+ * and are found via CONFIG_GCOAP_OBS_BUCKETS hash buckets. A client has at
+ * most one registration per resource; registering again only updates the
+ * token.
+ *
+ * Create the notification as above, then call gcoap_obs_notify_all(). It
+ * copies the options and payload once and only writes the header with
+ * message ID and token for each observer. gcoap_obs_send() does the same.
+ * The notifications are paced to CONFIG_GCOAP_OBS_NOTIFY_RATE per second,
+ * after a burst of CONFIG_GCOAP_OBS_NOTIFY_BURST, so they don't flood the
+ * network. gcoap_obs_notify_all() thus may block the calling thread for a
+ * while, but not the gcoap thread.
+ *
  * ## Block Operation ##
  *
  * gcoap provides for both server side and client side blockwise messaging for
@@ -378,6 +413,7 @@
 #ifndef NET_GCOAP_H
 #define NET_GCOAP_H
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "event/callback.h"
@@ -548,6 +584,44 @@ extern "C" {
 #define CONFIG_GCOAP_OBS_REGISTRATIONS_MAX     (2)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of hash buckets for Observe registrations
+ *
+ * Registering or deregistering walks a bucket, so use about one bucket for
+ * every 16 observers.
+ *
+ * @note    Only applicable with the `gcoap_obs_fanout` module
+ */
+#ifndef CONFIG_GCOAP_OBS_BUCKETS
+#define CONFIG_GCOAP_OBS_BUCKETS           (16U)
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Maximum rate of Observe notifications [per second]
+ *
+ * Set to 0 to send notifications as fast as possible.
+ *
+ * @note    Only applicable with the `gcoap_obs_fanout` module
+ */
+#ifndef CONFIG_GCOAP_OBS_NOTIFY_RATE
+#define CONFIG_GCOAP_OBS_NOTIFY_RATE       (200U)
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of Observe notifications sent at once, before they are
+ *          paced to CONFIG_GCOAP_OBS_NOTIFY_RATE
+ *
+ * Must be at least 1.
+ *
+ * @note    Only applicable with the `gcoap_obs_fanout` module
+ */
+#ifndef CONFIG_GCOAP_OBS_NOTIFY_BURST
+#define CONFIG_GCOAP_OBS_NOTIFY_BURST      (8U)
+#endif
+
 /**
  * @name    States for the memo used to track Observe registrations
  * @{
@@ -617,6 +691,55 @@ extern "C" {
 #define CONFIG_GCOAP_RESEND_BUFS_MAX      (1)
 #endif
 
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Number of worker threads handling requests
+ *
+ * @note    Only applicable with the `gcoap_workers` module
+ */
+#ifndef CONFIG_GCOAP_WORKERS_NUMOF
+#define CONFIG_GCOAP_WORKERS_NUMOF        (2)
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Maximum number of requests queued for or handled by the workers
+ *
+ * Each request takes a buffer of CONFIG_GCOAP_PDU_BUF_SIZE. Must be a power
+ * of 2.
+ *
+ * @note    Only applicable with the `gcoap_workers` module
+ */
+#ifndef CONFIG_GCOAP_WORKER_QUEUE_SIZE
+#define CONFIG_GCOAP_WORKER_QUEUE_SIZE    (4)
+#endif
+
+/**
+ * @ingroup net_gcoap_conf
+ * @brief   Maximum number of resources with a limit set by gcoap_worker_limit()
+ *
+ * @note    Only applicable with the `gcoap_workers` module
+ */
+#ifndef CONFIG_GCOAP_WORKER_LIMITS_MAX
+#define CONFIG_GCOAP_WORKER_LIMITS_MAX    (2)
+#endif
+
+/**
+ * @brief   Stack size for a worker thread
+ */
+#ifndef GCOAP_WORKER_STACK_SIZE
+#define GCOAP_WORKER_STACK_SIZE (THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE)
+#endif
+
+/**
+ * @brief   Priority of the worker threads
+ *
+ * The same as the gcoap thread by default, so the workers don't preempt it.
+ */
+#ifndef GCOAP_WORKER_PRIO
+#define GCOAP_WORKER_PRIO       (THREAD_PRIORITY_MAIN - 1)
+#endif
+
 /**
  * @name Bitwise positional flags for encoding resource links
  * @{
@@ -713,6 +836,22 @@ typedef struct {
     unsigned token_len;                 /**< Actual length of token attribute */
 } gcoap_observe_memo_t;
 
+/**
+ * @brief   Observe registration of the `gcoap_obs_fanout` module
+ *
+ * The members are private, the application only provides the storage with
+ * gcoap_obs_pool_init().
+ */
+typedef struct gcoap_obs_entry {
+    struct gcoap_obs_entry *next;       /**< Next entry in hash bucket */
+    const coap_resource_t *resource;    /**< Entity being observed */
+    sock_udp_ep_t observer;             /**< Client endpoint */
+    uint8_t token[GCOAP_TOKENLEN_MAX];  /**< Client token for notifications */
+    uint8_t token_len;                  /**< Actual length of token attribute */
+    bool pending;                       /**< Notification in progress is not
+                                             sent to it yet */
+} gcoap_obs_entry_t;
+
 /**
  * @brief   Initializes the gcoap thread and device
  *
@@ -865,7 +1004,9 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
  * @brief   Sends a buffer containing a CoAP Observe notification to the
  *          observer registered for a resource
  *
- * Assumes a single observer for a resource.
+ * Assumes a single observer for a resource. With the `gcoap_obs_fanout`
+ * module, the notification is sent to all observers as by
+ * gcoap_obs_notify_all().
  *
  * @param[in] buf Buffer containing the PDU
  * @param[in] len Length of the buffer
@@ -877,6 +1018,62 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource);
 
+/**
+ * @brief   Provides the storage for Observe registrations
+ *
+ * Registrations before this call or beyond @p numof are rejected, so the
+ * client receives a response without Observe option. Must be called only
+ * once.
+ *
+ * @note    Only available with the `gcoap_obs_fanout` module
+ *
+ * @param[in] entries   Storage for the registrations
+ * @param[in] numof     Number of elements in @p entries
+ */
+void gcoap_obs_pool_init(gcoap_obs_entry_t *entries, size_t numof);
+
+/**
+ * @brief   Sends a CoAP Observe notification to all observers of a resource
+ *
+ * @p buf is not modified, but copied once. Only the message ID and token are
+ * written for every observer. The notifications are paced as configured by
+ * CONFIG_GCOAP_OBS_NOTIFY_RATE, which may block the calling thread.
+ *
+ * @note    Only available with the `gcoap_obs_fanout` module
+ *
+ * @param[in] buf       Buffer containing the notification, as initialized by
+ *                      gcoap_obs_init()
+ * @param[in] len       Length of the notification
+ * @param[in] resource  Resource the notification is for
+ *
+ * @return  number of observers notified
+ * @return  -EMSGSIZE if @p len exceeds CONFIG_GCOAP_PDU_BUF_SIZE
+ * @return  -EINVAL if @p buf does not contain a CoAP header
+ */
+int gcoap_obs_notify_all(const uint8_t *buf, size_t len,
+                         const coap_resource_t *resource);
+
+/**
+ * @brief   Limits the number of requests for a resource the worker pool takes
+ *
+ * Requests for @p resource beyond @p max, that are queued for or handled by
+ * a worker, are answered with 5.03 (Service Unavailable). A @p max of 0 lets
+ * the gcoap thread call the handler itself as without worker pool, e.g. for
+ * handlers that reply immediately. Resources without limit may use the whole
+ * queue of CONFIG_GCOAP_WORKER_QUEUE_SIZE requests.
+ *
+ * @note    Only available with the `gcoap_workers` module
+ *
+ * @param[in] resource      Resource to limit
+ * @param[in] max           Maximum number of requests for @p resource queued
+ *                          or in progress
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if CONFIG_GCOAP_WORKER_LIMITS_MAX resources already have
+ *          a limit
+ */
+int gcoap_worker_limit(const coap_resource_t *resource, unsigned max);
+
 /**
  * @brief   Provides important operational statistics
  *
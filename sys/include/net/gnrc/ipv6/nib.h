@@ -379,6 +379,25 @@ void gnrc_ipv6_nib_handle_pkt(gnrc_netif_t *netif, const ipv6_hdr_t *ipv6,
  */
 void gnrc_ipv6_nib_handle_timer_event(void *ctx, uint16_t type);
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE || defined(DOXYGEN)
+/**
+ * @brief   Statistics of the flow cache
+ */
+typedef struct {
+    uint32_t hits;      /**< next hops taken from the flow cache */
+    uint32_t misses;    /**< next hops resolved with the NIB */
+} gnrc_ipv6_nib_flow_stats_t;
+
+/**
+ * @brief   Gets the statistics of the flow cache
+ *
+ * @note    Only available with @ref GNRC_IPV6_NIB_CONF_FLOW_CACHE.
+ *
+ * @param[out] stats    Statistics of the flow cache since start-up.
+ */
+void gnrc_ipv6_nib_flow_stats(gnrc_ipv6_nib_flow_stats_t *stats);
+#endif
+
 #if GNRC_IPV6_NIB_CONF_ROUTER || defined(DOXYGEN)
 /**
  * @brief   Changes the state if an interface advertises itself as a router
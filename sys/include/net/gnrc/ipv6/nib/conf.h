@@ -209,6 +209,50 @@ extern "C" {
 #ifndef GNRC_IPV6_NIB_CONF_MULTIHOP_DAD
 #define GNRC_IPV6_NIB_CONF_MULTIHOP_DAD 0
 #endif
+
+/**
+ * @brief   Index off-link entries in a prefix trie
+ *
+ * Route look-ups in the forwarding table then take time proportional to the
+ * prefix length instead of the number of off-link entries. The trie uses
+ * memory for up to 2 * @ref GNRC_IPV6_NIB_OFFL_NUMOF nodes, so this is
+ * only worthwhile for routers with many routes, e.g. RPL border routers.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_OFFL_TRIE
+#if GNRC_IPV6_NIB_CONF_6LBR
+#define GNRC_IPV6_NIB_CONF_OFFL_TRIE    1
+#else
+#define GNRC_IPV6_NIB_CONF_OFFL_TRIE    0
+#endif
+#endif
+
+/**
+ * @brief   Index on-link entries in a hash table by address
+ *
+ * Neighbor cache look-ups, e.g. for address resolution, then take constant
+ * time on average instead of time proportional to @ref GNRC_IPV6_NIB_NUMOF.
+ * The hash table uses 2 * @ref GNRC_IPV6_NIB_NUMOF * 2 bytes, so this is only
+ * worthwhile for routers with many neighbors, e.g. 6LoWPAN border routers.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_NC_INDEX
+#if GNRC_IPV6_NIB_CONF_6LBR
+#define GNRC_IPV6_NIB_CONF_NC_INDEX     1
+#else
+#define GNRC_IPV6_NIB_CONF_NC_INDEX     0
+#endif
+#endif
+
+/**
+ * @brief   Cache the resolved next hops of recent destinations
+ *
+ * @ref gnrc_ipv6_nib_get_next_hop_l2addr() then skips route look-up and
+ * address resolution for packets to a destination resolved before, as long as
+ * the NIB did not change since. This speeds up forwarding on routers at the
+ * cost of @ref GNRC_IPV6_NIB_FLOW_CACHE_NUMOF cache entries of about 60 bytes.
+ */
+#ifndef GNRC_IPV6_NIB_CONF_FLOW_CACHE
+#define GNRC_IPV6_NIB_CONF_FLOW_CACHE   0
+#endif
 /** @} */
 
 /**
@@ -266,6 +310,17 @@ extern "C" {
 #define GNRC_IPV6_NIB_OFFL_NUMOF            (8)
 #endif
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE || defined(DOXYGEN)
+/**
+ * @brief   Number of flow cache entries
+ *
+ * @note    Only used with @ref GNRC_IPV6_NIB_CONF_FLOW_CACHE
+ */
+#ifndef GNRC_IPV6_NIB_FLOW_CACHE_NUMOF
+#define GNRC_IPV6_NIB_FLOW_CACHE_NUMOF      (8)
+#endif
+#endif
+
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C || defined(DOXYGEN)
 /**
  * @brief   Number of authoritative border router entries in NIB
@@ -93,6 +93,14 @@ extern "C" {
  */
 #define GNRC_NETAPI_MSG_TYPE_ACK        (0x0205)
 
+/**
+ * @brief   Maximum number of packets gnrc_netapi_dispatch_bulk() hands to a
+ *          subscriber with a single @ref msg_send_bulk() call
+ */
+#ifndef GNRC_NETAPI_BULK_MAX
+#define GNRC_NETAPI_BULK_MAX            (8U)
+#endif
+
 /**
  * @brief   Data structure to be send for setting (@ref GNRC_NETAPI_MSG_TYPE_SET)
  *          and getting (@ref GNRC_NETAPI_MSG_TYPE_GET) options
@@ -169,6 +177,26 @@ static inline int gnrc_netapi_send(kernel_pid_t pid, gnrc_pktsnip_t *pkt)
 int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx, uint16_t cmd,
                          gnrc_pktsnip_t *pkt);
 
+/**
+ * @brief   Sends @p cmd for several packets to all subscribers to
+ *          (@p type, @p demux_ctx).
+ *
+ * Like calling @ref gnrc_netapi_dispatch() for every packet in @p pkts, but
+ * subscribers that are threads get the packets with @ref msg_send_bulk(), so
+ * they are woken up only once for (up to @ref GNRC_NETAPI_BULK_MAX of) them.
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] cmd       command for all subscribers
+ * @param[in] pkts      array of @p num pointers into the packet buffer
+ * @param[in] num       number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx).
+ */
+int gnrc_netapi_dispatch_bulk(gnrc_nettype_t type, uint32_t demux_ctx,
+                              uint16_t cmd, gnrc_pktsnip_t **pkts,
+                              unsigned num);
+
 /**
  * @brief   Sends a @ref GNRC_NETAPI_MSG_TYPE_SND command to all subscribers to
  *          (@p type, @p demux_ctx).
@@ -215,6 +243,28 @@ static inline int gnrc_netapi_dispatch_receive(gnrc_nettype_t type, uint32_t dem
     return gnrc_netapi_dispatch(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV, pkt);
 }
 
+/**
+ * @brief   Sends a @ref GNRC_NETAPI_MSG_TYPE_RCV command for several packets to
+ *          all subscribers to (@p type, @p demux_ctx).
+ *
+ * @see     gnrc_netapi_dispatch_bulk()
+ *
+ * @param[in] type      protocol type of the targeted network module.
+ * @param[in] demux_ctx demultiplexing context for @p type.
+ * @param[in] pkts      array of @p num pointers into the packet buffer
+ * @param[in] num       number of packets in @p pkts
+ *
+ * @return Number of subscribers to (@p type, @p demux_ctx).
+ */
+static inline int gnrc_netapi_dispatch_receive_bulk(gnrc_nettype_t type,
+                                                    uint32_t demux_ctx,
+                                                    gnrc_pktsnip_t **pkts,
+                                                    unsigned num)
+{
+    return gnrc_netapi_dispatch_bulk(type, demux_ctx, GNRC_NETAPI_MSG_TYPE_RCV,
+                                     pkts, num);
+}
+
 /**
  * @brief   Shortcut function for sending @ref GNRC_NETAPI_MSG_TYPE_GET messages and
  *          parsing the returned @ref GNRC_NETAPI_MSG_TYPE_ACK message
@@ -120,6 +120,16 @@ typedef struct {
 #endif
 #if defined(MODULE_GNRC_SIXLOWPAN) || DOXYGEN
     gnrc_netif_6lo_t sixlo;                 /**< 6Lo component */
+#endif
+#if defined(MODULE_GNRC_NETIF_BATCH_RX) || DOXYGEN
+    /**
+     * @brief   Received packets not handed on yet
+     *
+     * @note    Only available with module `gnrc_netif_batch_rx`.
+     */
+    gnrc_pktsnip_t *rx_batch[CONFIG_GNRC_NETIF_RX_BATCH_SIZE];
+    uint8_t rx_batch_num;                   /**< number of packets in
+                                             *   gnrc_netif_t::rx_batch */
 #endif
     uint8_t cur_hl;                         /**< Current hop-limit for out-going packets */
     uint8_t device_type;                    /**< Device type */
@@ -59,6 +59,22 @@ extern "C" {
 #define CONFIG_GNRC_NETIF_MSG_QUEUE_SIZE  (16U)
 #endif
 
+/**
+ * @brief       Maximum number of received packets handed on at once
+ *
+ * With module `gnrc_netif_batch_rx`, an interface thread takes up to this
+ * many pending messages at once. The packets received while handling them
+ * are handed on to the upper layer with one
+ * @ref gnrc_netapi_dispatch_receive_bulk() call per packet type, so e.g. the
+ * IPv6 thread is woken up only once for a burst of frames.
+ *
+ * @attention   This has influence on the used stack memory of the thread and
+ *              on the size of @ref gnrc_netif_t.
+ */
+#ifndef CONFIG_GNRC_NETIF_RX_BATCH_SIZE
+#define CONFIG_GNRC_NETIF_RX_BATCH_SIZE   (8U)
+#endif
+
 /**
  * @brief   Number of multicast addresses needed for @ref net_gnrc_rpl "RPL".
  *
@@ -35,6 +35,26 @@
 extern "C" {
 #endif
 
+/**
+ * @defgroup    net_gnrc_netreg_conf GNRC network protocol registry compile configurations
+ * @ingroup     net_gnrc_netreg
+ * @ingroup     net_gnrc_conf
+ * @{
+ */
+/**
+ * @brief   Number of hash buckets of the registry
+ *
+ * Entries are hashed by their protocol type and
+ * @ref gnrc_netreg_entry_t::demux_ctx "demux context", so a lookup only walks
+ * the entries of one bucket. Each bucket costs the size of a pointer. With
+ * many registered ports (e.g. many UDP sockets) a larger value keeps the
+ * demultiplexing of incoming packets short.
+ */
+#ifndef CONFIG_GNRC_NETREG_BUCKETS
+#define CONFIG_GNRC_NETREG_BUCKETS  (16U)
+#endif
+/** @} */
+
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS) || \
     defined(DOXYGEN)
 /**
@@ -96,9 +116,11 @@ typedef enum {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
 #define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_DEFAULT, \
-                                                      { pid } }
+                                                      { pid }, \
+                                                      GNRC_NETTYPE_UNDEF }
 #else
-#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid } }
+#define GNRC_NETREG_ENTRY_INIT_PID(demux_ctx, pid)  { NULL, demux_ctx, { pid }, \
+                                                      GNRC_NETTYPE_UNDEF }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(DOXYGEN)
@@ -115,7 +137,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_MBOX(demux_ctx, _mbox) { NULL, demux_ctx, \
                                                        GNRC_NETREG_TYPE_MBOX, \
-                                                       { .mbox = _mbox } }
+                                                       { .mbox = _mbox }, \
+                                                       GNRC_NETTYPE_UNDEF }
 #endif
 
 #if defined(MODULE_GNRC_NETAPI_CALLBACKS) || defined(DOXYGEN)
@@ -132,7 +155,8 @@ typedef enum {
  */
 #define GNRC_NETREG_ENTRY_INIT_CB(demux_ctx, _cbd)   { NULL, demux_ctx, \
                                                       GNRC_NETREG_TYPE_CB, \
-                                                      { .cbd = _cbd } }
+                                                      { .cbd = _cbd }, \
+                                                      GNRC_NETTYPE_UNDEF }
 /** @} */
 
 /**
@@ -210,6 +234,13 @@ typedef struct gnrc_netreg_entry {
         gnrc_netreg_entry_cbd_t *cbd;
 #endif
     } target;                   /**< Target for the registry entry */
+
+    /**
+     * @brief   Protocol type the entry is registered for
+     *
+     * @internal
+     */
+    uint8_t nettype;
 } gnrc_netreg_entry_t;
 
 /**
@@ -58,6 +58,51 @@ extern "C" {
 #define GNRC_PKTBUF_SIZE    (6144)
 #endif  /* GNRC_PKTBUF_SIZE */
 
+/**
+ * @brief   Page size of `gnrc_pktbuf_slab`
+ *
+ * `gnrc_pktbuf_slab` splits @ref GNRC_PKTBUF_SIZE into pages of this size.
+ * A page is either split into fixed size blocks of one size class, for
+ * packet snips and small headers, or part of a run of consecutive pages
+ * holding a larger allocation. Smaller pages waste less of the last page of
+ * a run, larger ones take less time to find a run. Bytes of
+ * @ref GNRC_PKTBUF_SIZE not filling a whole page stay unused.
+ */
+#ifndef GNRC_PKTBUF_SLAB_PAGE_SIZE
+#define GNRC_PKTBUF_SLAB_PAGE_SIZE  (256U)
+#endif
+
+/**
+ * @brief   Maximum number of external buffers (see @ref gnrc_pktbuf_add_ext())
+ *          that can be referenced by the packet buffer at the same time
+ */
+#ifndef GNRC_PKTBUF_EXT_NUMOF
+#define GNRC_PKTBUF_EXT_NUMOF   (4U)
+#endif
+
+/**
+ * @brief   Count the bytes copied within the packet buffer
+ *
+ * If set to 1, @ref gnrc_pktbuf_copied_bytes() reports the number of bytes
+ * the packet buffer copied (on add, mark, reallocation, merge and
+ * copy-on-write).
+ */
+#ifndef GNRC_PKTBUF_COPY_STATS
+#define GNRC_PKTBUF_COPY_STATS  (0)
+#endif
+
+/**
+ * @brief   Release callback for external buffers
+ *
+ * Called when no packet snip references an external buffer anymore. The
+ * callback is called with the packet buffer locked, so it must not call any
+ * packet buffer function.
+ *
+ * @param[in] arg   argument given to @ref gnrc_pktbuf_add_ext()
+ * @param[in] data  start of the external buffer
+ */
+typedef void (*gnrc_pktbuf_ext_release_t)(void *arg, void *data);
+
 /**
  * @brief   Initializes packet buffer module.
  */
@@ -87,6 +132,38 @@ void gnrc_pktbuf_init(void);
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
                                 gnrc_nettype_t type);
 
+/**
+ * @brief   Adds a new gnrc_pktsnip_t referencing externally owned memory.
+ *
+ * Unlike @ref gnrc_pktbuf_add() the data is not copied into the packet
+ * buffer, only the snip header is allocated there. This allows e.g. network
+ * device drivers to hand their receive buffers (DMA rings etc.) up the stack
+ * without copying.
+ *
+ * The external buffer is reference counted: snips created from it by
+ * @ref gnrc_pktbuf_mark() keep pointing into it. Once the last snip
+ * referencing it is released (or its data is reallocated into the packet
+ * buffer), @p release is called.
+ *
+ * @param[in] next      Next gnrc_pktsnip_t in the packet. Leave NULL if you
+ *                      want to create a new packet.
+ * @param[in] data      External data of the new gnrc_pktsnip_t. Must stay
+ *                      valid and writable until @p release is called.
+ * @param[in] size      Length of @p data. Must not be 0.
+ * @param[in] type      Protocol type of the gnrc_pktsnip_t.
+ * @param[in] release   Callback called when @p data is not referenced anymore.
+ * @param[in] arg       Argument for @p release.
+ *
+ * @return  Pointer to the packet part that represents the new gnrc_pktsnip_t.
+ * @return  NULL, if no space is left in the packet buffer or
+ *          @ref GNRC_PKTBUF_EXT_NUMOF external buffers are already in use. In
+ *          that case @p release is **not** called.
+ */
+gnrc_pktsnip_t *gnrc_pktbuf_add_ext(gnrc_pktsnip_t *next, void *data,
+                                    size_t size, gnrc_nettype_t type,
+                                    gnrc_pktbuf_ext_release_t release,
+                                    void *arg);
+
 /**
  * @brief   Marks the first @p size bytes in a received packet with a new
  *          packet snip that is appended to the packet.
@@ -289,6 +366,17 @@ gnrc_pktsnip_t *gnrc_pktbuf_reverse_snips(gnrc_pktsnip_t *pkt);
  */
 int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt);
 
+#if GNRC_PKTBUF_COPY_STATS || DOXYGEN
+/**
+ * @brief   Get the number of bytes copied by the packet buffer
+ *
+ * @note    Only available with @ref GNRC_PKTBUF_COPY_STATS set to 1.
+ *
+ * @return  number of bytes copied since the packet buffer was initialized
+ */
+uint32_t gnrc_pktbuf_copied_bytes(void);
+#endif
+
 #ifdef DEVELHELP
 /**
  * @brief   Prints some statistics about the packet buffer to stdout.
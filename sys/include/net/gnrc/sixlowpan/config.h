@@ -72,6 +72,21 @@ extern "C" {
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE       (4U)
 #endif
 
+/**
+ * @brief   Maximum number of fragments per datagram in the reassembly buffer
+ *
+ * Each reassembly buffer entry keeps the byte intervals of the fragments
+ * received so far in an array of this size, i.e. 4 bytes per interval. A
+ * datagram that arrives in more fragments is discarded. The default suffices
+ * for datagrams of the IPv6 minimum MTU fragmented into IEEE 802.15.4 frames.
+ *
+ * @note    Only applicable with
+ *          [gnrc_sixlowpan_frag_rb](@ref net_gnrc_sixlowpan_frag_rb) module
+ */
+#ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_INTS_NUMOF
+#define CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_INTS_NUMOF (16U)
+#endif
+
 /**
  * @brief   Timeout for reassembly buffer entries in microseconds
  *
@@ -160,9 +175,7 @@ extern "C" {
  * @see     https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
  *
  * @note    Only applicable with
- *          [gnrc_sixlowpan_frag_vrb](@ref net_gnrc_sixlowpan_frag_vrb) module,
- *          but has also a direct influence on the number of available
- *          gnrc_sixlowpan_frag_rb_int_t entries.
+ *          [gnrc_sixlowpan_frag_vrb](@ref net_gnrc_sixlowpan_frag_vrb) module
  */
 #ifndef CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE
 #define CONFIG_GNRC_SIXLOWPAN_FRAG_VRB_SIZE        (16U)
@@ -27,6 +27,9 @@
 #include "net/gnrc/pkt.h"
 
 #include "net/gnrc/sixlowpan/config.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/sixlowpan/sfr.h"
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,11 +49,7 @@ extern "C" {
  *          RFC 4944, section 5.3
  *      </a>
  */
-typedef struct gnrc_sixlowpan_frag_rb_int {
-    /**
-     * @brief   next element in fragment interval list
-     */
-    struct gnrc_sixlowpan_frag_rb_int *next;
+typedef struct {
     uint16_t start;             /**< start byte of the fragment interval */
     uint16_t end;               /**< end byte of the fragment interval */
 } gnrc_sixlowpan_frag_rb_int_t;
@@ -69,7 +68,6 @@ typedef struct gnrc_sixlowpan_frag_rb_int {
  * @see https://tools.ietf.org/html/draft-ietf-lwig-6lowpan-virtual-reassembly-01
  */
 typedef struct {
-    gnrc_sixlowpan_frag_rb_int_t *ints;         /**< intervals of already received fragments */
     uint8_t src[IEEE802154_LONG_ADDRESS_LEN];   /**< source address */
     uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];   /**< destination address */
     uint8_t src_len;                            /**< length of gnrc_sixlowpan_frag_rb_t::src */
@@ -82,6 +80,16 @@ typedef struct {
     uint16_t current_size;
     uint32_t arrival;                           /**< time in microseconds of arrival of
                                                  *   last received fragment */
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Difference between the offset of a fragment in the compressed
+     *          datagram it was received with and its offset in the datagram
+     *          it is reassembled or forwarded as
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+     */
+    int16_t offset_diff;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 } gnrc_sixlowpan_frag_rb_base_t;
 
 /**
@@ -89,6 +97,9 @@ typedef struct {
  *
  * A recipient of a fragment SHALL use
  *
+ * The size of an entry is bounded by
+ * @ref CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_INTS_NUMOF, independent of how many
+ * other datagrams are currently reassembled.
  */
 typedef struct {
     gnrc_sixlowpan_frag_rb_base_t super;        /**< base class */
@@ -96,6 +107,24 @@ typedef struct {
      * @brief   The reassembled packet in the packet buffer
      */
     gnrc_pktsnip_t *pkt;
+    /**
+     * @brief   Intervals of already received fragments
+     *
+     * Sorted by gnrc_sixlowpan_frag_rb_int_t::start and disjoint.
+     */
+    gnrc_sixlowpan_frag_rb_int_t ints[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_INTS_NUMOF];
+    /**
+     * @brief   Number of intervals in gnrc_sixlowpan_frag_rb_t::ints
+     */
+    uint8_t ints_numof;
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Sequence numbers of the recoverable fragments received so far
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+     */
+    BITFIELD(received, SIXLOWPAN_SFR_ACK_BITMAP_SIZE);
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 } gnrc_sixlowpan_frag_rb_t;
 
 /**
@@ -108,7 +137,8 @@ typedef struct {
  *                          destination address set.
  * @param[in] frag          The fragment to add. Will be released by the
  *                          function.
- * @param[in] offset        The fragment's offset.
+ * @param[in] offset        The fragment's offset. For a recoverable
+ *                          fragment, its offset in the uncompressed datagram.
  * @param[in] page          Current 6Lo dispatch parsing page.
  *
  * @return  The reassembly buffer entry the fragment was added to on success.
@@ -139,6 +169,27 @@ gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_add(gnrc_netif_hdr_t *netif_hdr
 bool gnrc_sixlowpan_frag_rb_exists(const gnrc_netif_hdr_t *netif_hdr,
                                    uint16_t tag);
 
+/**
+ * @brief   Gets a reassembly buffer entry with a given link-layer address
+ *          pair and tag
+ *
+ * @pre     `netif_hdr != NULL`
+ *
+ * @param[in] netif_hdr An interface header to provide the (source, destination)
+ *                      link-layer address pair. Must not be NULL.
+ * @param[in] tag       Tag to search for.
+ *
+ * @note    datagram_size is not a search parameter as the primary use case
+ *          for this function is [Selective Fragment Recovery]
+ *          (https://tools.ietf.org/html/draft-ietf-6lo-fragment-recovery-05)
+ *          where this information only exists in the first fragment.
+ *
+ * @return  The reassembly buffer entry with the given tuple.
+ * @return  NULL, if no entry with the given tuple exist.
+ */
+gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_get_by_datagram(
+        const gnrc_netif_hdr_t *netif_hdr, uint16_t tag);
+
 /**
  * @brief   Removes a reassembly buffer entry with a given link-layer address
  *          pair and tag
@@ -229,18 +280,14 @@ int gnrc_sixlowpan_frag_rb_dispatch_when_complete(gnrc_sixlowpan_frag_rb_t *rbuf
  *
  * @pre `rbuf != NULL`
  *
- * This functions sets rbuf_t::super::pkt to NULL and removes all rbuf::ints.
+ * This functions sets rbuf_t::super::pkt to NULL, removes all rbuf::ints,
+ * and removes the entry from the look-up index of the reassembly buffer.
  *
  * @note    Does nothing if module `gnrc_sixlowpan_frag_rb` is not included.
  *
  * @param[in] rbuf  A reassembly buffer entry. Must not be NULL.
  */
-static inline void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf)
-{
-    assert(rbuf != NULL);
-    gnrc_sixlowpan_frag_rb_base_rm(&rbuf->super);
-    rbuf->pkt = NULL;
-}
+void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf);
 #else
 /* NOPs to be used with gnrc_sixlowpan_iphc if gnrc_sixlowpan_frag_rb is not
  * compiled in */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_gnrc_sixlowpan_frag_sfr 6LoWPAN selective fragment recovery
+ * @ingroup     net_gnrc_sixlowpan_frag
+ * @brief       6LoWPAN selective fragment recovery implementation for GNRC
+ * @see         [RFC 8931](https://tools.ietf.org/html/rfc8931)
+ *
+ * When this module is used, all datagrams that do not fit into a single frame
+ * are sent as recoverable fragments (RFRAG). The sender keeps up to
+ * @ref GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE fragments in flight, separated by
+ * @ref GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US, and requests an acknowledgment
+ * with the last fragment of each window. Only the fragments missing from the
+ * bitmap of the RFRAG acknowledgment are sent again.
+ *
+ * Intermediate nodes with module `gnrc_sixlowpan_frag_vrb` forward the
+ * fragments of a datagram along the route of its first fragment without
+ * reassembling it and relay the acknowledgments back to the source.
+ *
+ * Fragments of the original 6LoWPAN fragmentation are still received if
+ * module `gnrc_sixlowpan_frag` is used.
+ *
+ * @note    Fragments that arrive before the first fragment of their datagram
+ *          are dropped and recovered by the sender.
+ * @{
+ *
+ * @file
+ * @brief   6LoWPAN selective fragment recovery definitions for GNRC
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_H
+
+#include "net/gnrc/pkt.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag/fb.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+#include "net/sixlowpan/sfr.h"
+
+#include "net/gnrc/sixlowpan/frag/sfr_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Message type for an expired acknowledgment request
+ */
+#define GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG (0x0227)
+
+/**
+ * @brief   Sends a packet via selective fragment recovery
+ *
+ * @pre `ctx != NULL`
+ * @pre gnrc_sixlowpan_frag_fb_t::pkt of @p ctx is equal to @p pkt or
+ *      `pkt == NULL`.
+ *
+ * @param[in] pkt       A packet. May be NULL.
+ * @param[in] ctx       Fragmentation buffer entry of. Expected to be of type
+ *                      @ref gnrc_sixlowpan_frag_fb_t, with
+ *                      gnrc_sixlowpan_frag_fb_t set to @p pkt. Must not be
+ *                      NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+/**
+ * @brief   Handles a packet containing a selective fragment recovery header
+ *
+ * @param[in] pkt       The packet to handle.
+ * @param[in] ctx       Context for the packet. May be NULL.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ */
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page);
+
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_VRB) || defined(DOXYGEN)
+/**
+ * @brief   Forwards a recompressed first fragment to the next hop of a VRB
+ *          entry
+ *
+ * @pre `(pkt != NULL) && (rfrag != NULL) && (vrbe != NULL)`
+ *
+ * @param[in] pkt       The recompressed payload of the fragment, without any
+ *                      fragmentation or interface header. Will be released
+ *                      by the function.
+ * @param[in] rfrag     The RFRAG header the fragment was received with.
+ * @param[in] vrbe      VRB entry of the datagram.
+ * @param[in] page      Current 6Lo dispatch parsing page.
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_vrb`.
+ *
+ * @return  0, on success.
+ * @return  -ENOMEM, when the packet buffer is full.
+ */
+int gnrc_sixlowpan_frag_sfr_forward(gnrc_pktsnip_t *pkt,
+                                    sixlowpan_sfr_rfrag_t *rfrag,
+                                    gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                    unsigned page);
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+/**
+ * @brief   Handles an expired acknowledgment request
+ *
+ * @see @ref GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG
+ *
+ * @param[in] fbuf  The fragmentation buffer entry of the datagram.
+ */
+void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_H */
+/** @} */
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @addtogroup  net_gnrc_sixlowpan_frag_sfr
+ * @{
+ *
+ * @file
+ * @brief   Selective fragment recovery types
+ *
+ * Separate from @ref net/gnrc/sixlowpan/frag/sfr.h so it can be included by
+ * @ref net/gnrc/sixlowpan/frag/fb.h without a cyclical include.
+ */
+#ifndef NET_GNRC_SIXLOWPAN_FRAG_SFR_TYPES_H
+#define NET_GNRC_SIXLOWPAN_FRAG_SFR_TYPES_H
+
+#include <stdint.h>
+
+#include "clist.h"
+#include "msg.h"
+#include "xtimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   A fragment sent, but not acknowledged yet
+ */
+typedef struct {
+    clist_node_t super;     /**< list parent type */
+    uint16_t offset;        /**< offset of the fragment in the compressed
+                             *   datagram */
+    uint16_t size;          /**< payload size of the fragment */
+    uint8_t seq;            /**< sequence number of the fragment */
+    uint8_t retries;        /**< number of retransmissions of the fragment */
+    uint8_t pending;        /**< fragment is waiting to be (re-)sent */
+} gnrc_sixlowpan_frag_sfr_frag_t;
+
+/**
+ * @brief   Selective fragment recovery state of a fragmentation buffer entry
+ */
+typedef struct {
+    /**
+     * @brief   Fragments of the current window
+     *
+     * Elements are of type @ref gnrc_sixlowpan_frag_sfr_frag_t in order of
+     * their sequence numbers.
+     */
+    clist_node_t window;
+    xtimer_t arq_timer;     /**< timer for the acknowledgment request */
+    msg_t arq_msg;          /**< message for gnrc_sixlowpan_frag_sfr_fb_t::arq_timer */
+    uint32_t arq_deadline;  /**< time in microseconds the acknowledgment is
+                             *   expected by */
+    xtimer_t gap_timer;     /**< timer for the inter-frame gap */
+    msg_t gap_msg;          /**< message for gnrc_sixlowpan_frag_sfr_fb_t::gap_timer */
+    uint16_t arq_timeout;   /**< current ARQ timeout in milliseconds */
+    uint8_t cur_seq;        /**< sequence number of the next new fragment */
+    uint8_t arq_armed;      /**< an acknowledgment was requested */
+} gnrc_sixlowpan_frag_sfr_fb_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_SIXLOWPAN_FRAG_SFR_TYPES_H */
+/** @} */
@@ -54,6 +54,14 @@ typedef struct {
      * @brief   Outgoing tag to gnrc_sixlowpan_frag_rb_base_t::dst
      */
     uint16_t out_tag;
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+    /**
+     * @brief   Incoming interface from gnrc_sixlowpan_frag_rb_base_t::src
+     *
+     * @note    Only available with module `gnrc_sixlowpan_frag_sfr`
+     */
+    gnrc_netif_t *in_netif;
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 } gnrc_sixlowpan_frag_vrb_t;
 
 /**
@@ -117,6 +125,32 @@ void gnrc_sixlowpan_frag_vrb_gc(void);
 gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_get(
         const uint8_t *src, size_t src_len, unsigned src_tag);
 
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR) || defined(DOXYGEN)
+/**
+ * @brief   Reverse VRB lookup
+ *
+ * Used to forward an RFRAG acknowledgment back towards the source of the
+ * datagram.
+ *
+ * @param[in] netif         Interface the acknowledgment was received on.
+ * @param[in] src           Link-layer source address of the acknowledgment.
+ * @param[in] src_len       Length of @p src.
+ * @param[in] tag           Tag of the acknowledgment.
+ *
+ * @note    Only available with module `gnrc_sixlowpan_frag_sfr`. The 8-bit
+ *          tag of recoverable fragments is compared to the 8 least
+ *          significant bits of gnrc_sixlowpan_frag_vrb_t::out_tag.
+ *
+ * @return  The VRB entry with gnrc_sixlowpan_frag_vrb_t::out_netif @p netif,
+ *          gnrc_sixlowpan_frag_rb_base_t::dst @p src and
+ *          gnrc_sixlowpan_frag_vrb_t::out_tag @p tag.
+ * @return  NULL, if there is no such entry.
+ */
+gnrc_sixlowpan_frag_vrb_t *gnrc_sixlowpan_frag_vrb_reverse(
+        const gnrc_netif_t *netif, const uint8_t *src, size_t src_len,
+        unsigned tag);
+#endif /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+
 /**
  * @brief   Removes an entry from the VRB
  *
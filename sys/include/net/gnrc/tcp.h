@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include "net/gnrc/pkt.h"
+#include "net/gnrc/tcp/cc.h"
 #include "net/gnrc/tcp/tcb.h"
 
 #ifdef MODULE_GNRC_IPV6
@@ -162,6 +163,9 @@ int gnrc_tcp_open_passive(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_ep_t *local);
  * @pre @p data must not be NULL.
  *
  * @note Blocks until up to @p len bytes were transmitted or an error occurred.
+ *       With @ref GNRC_TCP_SND_SEGMENTS greater than one, data counts as
+ *       transmitted as soon as it was sent, the function does not wait for
+ *       its acknowledgment unless the maximum number of segments is in flight.
  *
  * @param[in,out] tcb                        TCB holding the connection information.
  * @param[in]     data                       Pointer to the data that should be transmitted.
@@ -230,6 +234,23 @@ void gnrc_tcp_close(gnrc_tcp_tcb_t *tcb);
  */
 void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Select the congestion control algorithm of a connection.
+ *
+ * @pre gnrc_tcp_tcb_init() must have been successfully called.
+ * @pre @p tcb must not be NULL.
+ * @pre @p cc must not be NULL.
+ *
+ * @note New connections use GNRC_TCP_CC_DEFAULT.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ * @param[in]     cc    Congestion control algorithm to use.
+ *
+ * @return   0 on success.
+ * @return   -EISCONN if the connection is not closed.
+ */
+int gnrc_tcp_set_cc(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_cc_t *cc);
+
 /**
  * @brief Calculate and set checksum in TCP header.
  *
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       GNRC TCP congestion control interface
+ *
+ * GNRC TCP limits the data in flight to the congestion window `cwnd` of a
+ * connection (see RFC 5681). Detection of losses, fast retransmit after three
+ * duplicate ACKs and fast recovery (see RFC 6582) are common to all
+ * algorithms. A congestion control algorithm decides how the congestion
+ * window grows on acknowledgments and on which slow start threshold
+ * `ssthresh` a loss leads.
+ *
+ * Two algorithms are provided:
+ * - @ref gnrc_tcp_cc_newreno (default)
+ * - @ref gnrc_tcp_cc_cubic (module `gnrc_tcp_cc_cubic`, see RFC 8312),
+ *   which becomes the default if the module is used
+ *
+ * Other algorithms can be plugged in by implementing @ref gnrc_tcp_cc_t and
+ * selecting it with gnrc_tcp_set_cc().
+ */
+
+#ifndef NET_GNRC_TCP_CC_H
+#define NET_GNRC_TCP_CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/config.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Congestion events
+ */
+typedef enum {
+    GNRC_TCP_CC_FAST_RETRANSMIT,    /**< Loss detected by duplicate ACKs */
+    GNRC_TCP_CC_TIMEOUT,            /**< Loss detected by retransmission timeout */
+} gnrc_tcp_cc_event_t;
+
+/**
+ * @brief Congestion control algorithm
+ */
+typedef struct gnrc_tcp_cc {
+    /**
+     * @brief Initializes the algorithm specific state of a connection
+     *
+     * Called when the connection is established, after `cwnd` was set to the
+     * initial window and `ssthresh` to an arbitrarily high value.
+     *
+     * @param[in,out] tcb   TCB holding the connection information.
+     */
+    void (*init)(gnrc_tcp_tcb_t *tcb);
+
+    /**
+     * @brief Grows the congestion window on an acknowledgment of new data
+     *
+     * Not called during fast recovery.
+     *
+     * @param[in,out] tcb     TCB holding the connection information.
+     * @param[in]     acked   Number of newly acknowledged bytes.
+     */
+    void (*acked)(gnrc_tcp_tcb_t *tcb, uint32_t acked);
+
+    /**
+     * @brief Sets the slow start threshold on a loss
+     *
+     * The congestion window is set afterwards: to `ssthresh` plus three
+     * segments on @ref GNRC_TCP_CC_FAST_RETRANSMIT, to one segment on
+     * @ref GNRC_TCP_CC_TIMEOUT.
+     *
+     * @param[in,out] tcb     TCB holding the connection information.
+     * @param[in]     event   Kind of the loss.
+     */
+    void (*congestion)(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cc_event_t event);
+} gnrc_tcp_cc_t;
+
+/**
+ * @brief NewReno congestion control (see RFC 5681 and RFC 6582)
+ */
+extern const gnrc_tcp_cc_t gnrc_tcp_cc_newreno;
+
+#if defined(MODULE_GNRC_TCP_CC_CUBIC) || defined(DOXYGEN)
+/**
+ * @brief CUBIC congestion control (see RFC 8312)
+ */
+extern const gnrc_tcp_cc_t gnrc_tcp_cc_cubic;
+#endif
+
+/**
+ * @brief Congestion control algorithm of new connections
+ */
+#ifndef GNRC_TCP_CC_DEFAULT
+#ifdef MODULE_GNRC_TCP_CC_CUBIC
+#define GNRC_TCP_CC_DEFAULT (&gnrc_tcp_cc_cubic)
+#else
+#define GNRC_TCP_CC_DEFAULT (&gnrc_tcp_cc_newreno)
+#endif
+#endif
+
+/**
+ * @brief Gets the sender maximum segment size of a connection.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Size of the largest segment sent on the connection.
+ */
+static inline uint32_t gnrc_tcp_cc_smss(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->mss < GNRC_TCP_MSS) ? tcb->mss : GNRC_TCP_MSS;
+}
+
+/**
+ * @brief Gets the amount of data in flight on a connection.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Number of bytes sent but not acknowledged yet.
+ */
+static inline uint32_t gnrc_tcp_cc_flight_size(const gnrc_tcp_tcb_t *tcb)
+{
+    return tcb->snd_nxt - tcb->snd_una;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NET_GNRC_TCP_CC_H */
+/** @} */
@@ -66,7 +66,7 @@ extern "C" {
 #endif
 
 /**
- * @brief Number of preallocated receive buffers
+ * @brief Maximum number of receive buffers, i.e. of open connections
  */
 #ifndef GNRC_TCP_RCV_BUFFERS
 #define GNRC_TCP_RCV_BUFFERS (1U)
@@ -74,11 +74,59 @@ extern "C" {
 
 /**
  * @brief Default receive buffer size
+ *
+ * A connection gets a smaller buffer of at least one MSS if the receive
+ * buffer pool has not enough space left.
  */
 #ifndef GNRC_TCP_RCV_BUF_SIZE
 #define GNRC_TCP_RCV_BUF_SIZE (GNRC_TCP_DEFAULT_WINDOW)
 #endif
 
+/**
+ * @brief Size of the pool the receive buffers are allocated from
+ */
+#ifndef GNRC_TCP_RCV_BUF_POOL_SIZE
+#define GNRC_TCP_RCV_BUF_POOL_SIZE (GNRC_TCP_RCV_BUFFERS * GNRC_TCP_RCV_BUF_SIZE)
+#endif
+
+/**
+ * @brief Number of segments received out of order that are kept per
+ *        connection until the missing data arrives
+ */
+#ifndef GNRC_TCP_RCV_OOO_SEGMENTS
+#define GNRC_TCP_RCV_OOO_SEGMENTS (0U)
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged segments in flight
+ *
+ * The default of 1 waits for the acknowledgment of every segment before
+ * sending the next one.
+ */
+#ifndef GNRC_TCP_SND_SEGMENTS
+#define GNRC_TCP_SND_SEGMENTS (1U)
+#endif
+
+/**
+ * @brief Enable window scaling (see RFC 7323)
+ *
+ * Allows receive buffers larger than 64 KiB to be used as window.
+ */
+#ifndef GNRC_TCP_WINDOW_SCALING
+#define GNRC_TCP_WINDOW_SCALING (0)
+#endif
+
+/**
+ * @brief Enable selective acknowledgments (see RFC 2018)
+ *
+ * Segments received out of order are reported to the peer, if
+ * @ref GNRC_TCP_RCV_OOO_SEGMENTS is not zero. Segments selectively
+ * acknowledged by the peer are not retransmitted after a timeout.
+ */
+#ifndef GNRC_TCP_SACK
+#define GNRC_TCP_SACK (0)
+#endif
+
 /**
  * @brief Lower bound for RTO = 1 sec (see RFC 6298)
  */
@@ -43,6 +43,48 @@ extern "C" {
  */
 #define GNRC_TCP_TCB_MBOX_SIZE (8U)
 
+/**
+ * @brief Size of the retransmission queue: the segments in flight and a FIN
+ */
+#define GNRC_TCP_RTX_QUEUE_SIZE (GNRC_TCP_SND_SEGMENTS + 1)
+
+/**
+ * @brief Segment in the retransmission queue
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;    /**< Packet holding the segment */
+    uint32_t seq;           /**< Sequence number of the segment */
+    uint32_t len;           /**< Sequence number consumption of the segment */
+    uint32_t sent;          /**< Timer value of the first transmission */
+    uint8_t retransmitted;  /**< Flag: Was the segment retransmitted? */
+    uint8_t sacked;         /**< Flag: Was the segment selectively acknowledged? */
+} gnrc_tcp_rtx_t;
+
+/**
+ * @brief Segment received out of order
+ */
+typedef struct {
+    gnrc_pktsnip_t *pkt;    /**< Packet holding the segment */
+    uint32_t seq;           /**< Sequence number of the payload */
+    uint32_t len;           /**< Payload length */
+    uint8_t rank;           /**< Order of reception, 0 for the most recent segment */
+} gnrc_tcp_ooo_t;
+
+/**
+ * @brief State of the CUBIC congestion control algorithm
+ */
+typedef struct {
+    uint32_t w_max;         /**< Window before the last reduction */
+    uint32_t w_last_max;    /**< w_max before the last reduction */
+    uint32_t origin;        /**< Window at the origin of the cubic function */
+    uint32_t w_est;         /**< Window estimate of standard TCP */
+    uint32_t epoch;         /**< Start of the congestion avoidance epoch in ms */
+    uint32_t k;             /**< Time from epoch to origin in ms */
+    uint8_t epoch_started;  /**< Flag: Is the epoch start valid? */
+} gnrc_tcp_cubic_t;
+
+struct gnrc_tcp_cc;
+
 /**
  * @brief Transmission control block of GNRC TCP.
  */
@@ -59,22 +101,38 @@ typedef struct _transmission_control_block {
     uint8_t status;        /**< A connections status flags */
     uint32_t snd_una;      /**< Send unacknowledged */
     uint32_t snd_nxt;      /**< Send next */
-    uint16_t snd_wnd;      /**< Send window */
+    uint32_t snd_wnd;      /**< Send window */
     uint32_t snd_wl1;      /**< SeqNo. from last window update */
     uint32_t snd_wl2;      /**< AckNo. from last window update */
     uint32_t rcv_nxt;      /**< Receive next */
-    uint16_t rcv_wnd;      /**< Receive window */
+    uint32_t rcv_wnd;      /**< Receive window */
     uint32_t iss;          /**< Initial sequence sumber */
     uint32_t irs;          /**< Initial received sequence number */
+    uint32_t recover;      /**< Send next at the start of the last recovery */
     uint16_t mss;          /**< The peers MSS */
-    uint32_t rtt_start;    /**< Timer value for rtt estimation */
+    uint8_t snd_wnd_shift; /**< Window scale shift count of the peer */
+    uint8_t rcv_wnd_shift; /**< Window scale shift count of the receive window */
     int32_t rtt_var;       /**< Round trip time variance */
     int32_t srtt;          /**< Smoothed round trip time */
     int32_t rto;           /**< Retransmission timeout duration */
     uint8_t retries;       /**< Number of retransmissions */
+    const struct gnrc_tcp_cc *cc;  /**< Congestion control algorithm */
+    uint32_t cwnd;         /**< Congestion window */
+    uint32_t ssthresh;     /**< Slow start threshold */
+    uint32_t bytes_acked;  /**< Bytes acknowledged during congestion avoidance */
+    uint8_t dup_acks;      /**< Number of duplicate ACKs received */
+#if defined(MODULE_GNRC_TCP_CC_CUBIC) || defined(DOXYGEN)
+    gnrc_tcp_cubic_t cubic;  /**< State of CUBIC congestion control */
+#endif
     xtimer_t tim_tout;     /**< Timer struct for timeouts */
     msg_t msg_tout;        /**< Message, sent on timeouts */
-    gnrc_pktsnip_t *pkt_retransmit;   /**< Pointer to packet in "retransmit queue" */
+    gnrc_tcp_rtx_t rtx[GNRC_TCP_RTX_QUEUE_SIZE];  /**< Retransmission queue */
+    uint8_t rtx_num;                  /**< Number of segments in the retransmission queue */
+#if (GNRC_TCP_RCV_OOO_SEGMENTS > 0) || defined(DOXYGEN)
+    gnrc_tcp_ooo_t ooo[GNRC_TCP_RCV_OOO_SEGMENTS];  /**< Segments received out of order,
+                                                     *   sorted by sequence number */
+    uint8_t ooo_num;                  /**< Number of segments received out of order */
+#endif
     msg_t mbox_raw[GNRC_TCP_TCB_MBOX_SIZE];   /**< Msg queue for mbox */
     mbox_t mbox;             /**< TCB mbox for synchronization */
     uint8_t *rcv_buf_raw;    /**< Pointer to the receive buffer */
@@ -73,6 +73,63 @@ static inline uint16_t inet_csum(uint16_t sum, const uint8_t *buf, uint16_t len)
     return inet_csum_slice(sum, buf, len, 0);
 }
 
+/**
+ * @brief   Incrementally updates a checksum after a part of its domain changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @details Instead of calculating the checksum over the full domain again, only
+ *          the difference between the old and the new data is applied to the
+ *          checksum. This is useful e.g. when single header fields are rewritten
+ *          when forwarding a packet. The result is identical to recalculating
+ *          the checksum, so for UDP a resulting checksum of 0 still needs to be
+ *          sent as 0xffff.
+ *
+ * @pre     The changed data starts at an even offset within the checksum
+ *          domain.
+ *
+ * @param[in] csum      The normalized checksum (i.e. as found in the header,
+ *                      but in host byte order) before the change.
+ * @param[in] old_data  The data before the change.
+ * @param[in] new_data  The data after the change.
+ * @param[in] len       Length of @p old_data and @p new_data in byte.
+ *
+ * @return  The normalized checksum after the change.
+ */
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_data,
+                          const uint8_t *new_data, uint16_t len);
+
+/**
+ * @brief   Incrementally updates a checksum after a 16-bit word of its domain
+ *          changed
+ *
+ * @see <a href="https://tools.ietf.org/html/rfc1624">
+ *          RFC 1624
+ *      </a>
+ *
+ * @pre     The changed word starts at an even offset within the checksum
+ *          domain.
+ *
+ * @param[in] csum      The normalized checksum (i.e. as found in the header,
+ *                      but in host byte order) before the change.
+ * @param[in] old_word  The word before the change in host byte order.
+ * @param[in] new_word  The word after the change in host byte order.
+ *
+ * @return  The normalized checksum after the change.
+ */
+static inline uint16_t inet_csum_update16(uint16_t csum, uint16_t old_word,
+                                          uint16_t new_word)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum + (uint16_t)~old_word + (uint32_t)new_word;
+
+    sum = (sum & 0xffff) + (sum >> 16);
+    sum = (sum & 0xffff) + (sum >> 16);
+    return (uint16_t)~sum;
+}
+
 #ifdef __cplusplus
 }
 #endif
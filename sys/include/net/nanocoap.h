@@ -1556,6 +1556,31 @@ extern ssize_t coap_well_known_core_default_handler(coap_pkt_t *pkt, \
  */
 int coap_match_path(const coap_resource_t *resource, uint8_t *uri);
 
+/**
+ * @brief   Finds the resource for a URI in an array of resources
+ *
+ * The resources must be sorted by path, as compared by strcmp(). The lookup
+ * then takes a binary search for every path in @p resources that is a prefix
+ * of @p uri, instead of comparing @p uri with every resource. The result is
+ * the same as checking the resources in order with coap_match_path(): the
+ * first resource that matches @p uri, considering @ref COAP_MATCH_SUBTREE,
+ * and allows @p method_flag is found.
+ *
+ * @param[in] resources         Array of resources sorted by path
+ * @param[in] resources_numof   Length of @p resources
+ * @param[in] uri               Null-terminated URI path to look up
+ * @param[in] method_flag       Method of the request as from coap_method2flag()
+ * @param[out] resource         The resource found
+ *
+ * @return  0 if a resource was found
+ * @return  -EPERM if resources match @p uri, but none allows @p method_flag
+ * @return  -ENOENT if no resource matches @p uri
+ */
+int coap_find_resource(const coap_resource_t *resources,
+                       size_t resources_numof, const uint8_t *uri,
+                       coap_method_flags_t method_flag,
+                       const coap_resource_t **resource);
+
 #if defined(MODULE_GCOAP) || defined(DOXYGEN)
 /**
  * @name    Functions -- gcoap specific
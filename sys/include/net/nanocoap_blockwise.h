@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    net_nanocoap_blockwise Nanocoap block-wise transfers
+ * @ingroup     net_nanosock
+ * @brief       Streaming block-wise (RFC 7959) transfers with nanocoap
+ *
+ * The `nanocoap_blockwise` module moves a payload larger than a CoAP message
+ * block by block between the network and a pair of callbacks, so the payload
+ * never needs to be in RAM as a whole. The callbacks address the payload by
+ * its offset, e.g. to read it from or write it to a VFS file or an MTD
+ * device.
+ *
+ * ## Server Operation ##
+ *
+ * In the handler of a resource, nanocoap_blockwise_reply() answers a GET
+ * request with the block (Block2) the client asked for, read by a
+ * ::nanocoap_blockwise_read_cb_t. nanocoap_blockwise_recv() passes the block
+ * (Block1) of a PUT or POST request to a ::nanocoap_blockwise_write_cb_t and
+ * answers it. Both work for handlers called by nanocoap_server() as well as by
+ * gcoap.
+ *
+ * ## Client Operation ##
+ *
+ * nanocoap_blockwise_get() downloads a resource with confirmable requests.
+ * After the first block, which tells the size of the blocks and if there are
+ * more, it keeps up to `window` requests for the following blocks in flight.
+ * Blocks received out of order are kept in the buffer of the caller until the
+ * blocks before them arrived, so the write callback sees the payload in
+ * order. nanocoap_blockwise_upload() sends a payload with Block1, one block
+ * after the other, as the server must process the blocks in order.
+ *
+ * Every request is retransmitted with exponential back-off after
+ * #CONFIG_NANOCOAP_BLOCKWISE_ACK_TIMEOUT_MS, up to @ref COAP_MAX_RETRANSMIT
+ * times. Requests are rebuilt for every retransmission, so the callbacks
+ * must return the same data when called for the same offset again.
+ *
+ * @{
+ *
+ * @file
+ * @brief       nanocoap block-wise transfer API
+ */
+
+#ifndef NET_NANOCOAP_BLOCKWISE_H
+#define NET_NANOCOAP_BLOCKWISE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+
+#include "net/nanocoap.h"
+#include "net/sock/udp.h"
+#include "timex.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup net_nanocoap_blockwise_conf Nanocoap block-wise compile
+ *                                       configurations
+ * @ingroup  net_nanocoap_blockwise
+ * @ingroup  config
+ * @{
+ */
+/**
+ * @brief   Maximum number of Block2 requests in flight
+ *
+ * Limits the `window` of nanocoap_blockwise_get(). Every request in flight
+ * takes 16 bytes of stack.
+ */
+#ifndef CONFIG_NANOCOAP_BLOCKWISE_WINDOW_MAX
+#define CONFIG_NANOCOAP_BLOCKWISE_WINDOW_MAX    (8U)
+#endif
+
+/**
+ * @brief   Time in milliseconds to wait for the response to a request before
+ *          it is sent again
+ *
+ * Doubled for every retransmission of the same request.
+ */
+#ifndef CONFIG_NANOCOAP_BLOCKWISE_ACK_TIMEOUT_MS
+#define CONFIG_NANOCOAP_BLOCKWISE_ACK_TIMEOUT_MS (COAP_ACK_TIMEOUT * MS_PER_SEC)
+#endif
+
+/**
+ * @brief   Space in bytes for the header, token and options of a message
+ *          besides the payload of a block
+ *
+ * Must fit the Uri-Path of the requests as well as the options of the
+ * responses of the server.
+ */
+#ifndef CONFIG_NANOCOAP_BLOCKWISE_HDR_MAX
+#define CONFIG_NANOCOAP_BLOCKWISE_HDR_MAX   (64U)
+#endif
+/** @} */
+
+/**
+ * @brief   Size of the buffer for a client transfer
+ *
+ * One message with a block of @p blksize bytes, and the blocks of a `window`
+ * of requests in flight that may arrive out of order. Use a @p window of 0
+ * for nanocoap_blockwise_upload().
+ *
+ * @param[in]   blksize     size of a block in bytes
+ * @param[in]   window      number of Block2 requests in flight
+ */
+#define NANOCOAP_BLOCKWISE_BUF_SIZE(blksize, window) \
+    (CONFIG_NANOCOAP_BLOCKWISE_HDR_MAX + 1 + ((blksize) * (1 + (window))))
+
+/**
+ * @brief   Callback to read a part of a payload
+ *
+ * Reading less than @p len bytes marks the end of the payload. The engine
+ * asks for one byte more than the block it sends to learn if more blocks
+ * follow.
+ *
+ * @param[in]   arg     argument given to the block-wise function
+ * @param[in]   offset  offset of the part in the payload
+ * @param[out]  buf     buffer to read the part into
+ * @param[in]   len     number of bytes to read
+ *
+ * @returns     number of bytes read on success
+ * @returns     <0 on error
+ */
+typedef ssize_t (*nanocoap_blockwise_read_cb_t)(void *arg, size_t offset,
+                                                uint8_t *buf, size_t len);
+
+/**
+ * @brief   Callback to write a part of a payload
+ *
+ * The parts are written in order.
+ *
+ * @param[in]   arg     argument given to the block-wise function
+ * @param[in]   offset  offset of the part in the payload
+ * @param[in]   buf     the part
+ * @param[in]   len     length of the part in bytes
+ * @param[in]   more    false for the last part of the payload
+ *
+ * @returns     0 on success
+ * @returns     <0 on error, which stops the transfer
+ */
+typedef int (*nanocoap_blockwise_write_cb_t)(void *arg, size_t offset,
+                                             const uint8_t *buf, size_t len,
+                                             bool more);
+
+/**
+ * @brief   Reply to a GET request with the block of a payload it asks for
+ *
+ * Answers with the block size of the Block2 option of the request, capped to
+ * 2 raised to #NANOCOAP_BLOCK_SIZE_EXP_MAX and to the space in @p buf.
+ * Without a Block2 option, the first block has the capped size.
+ *
+ * @param[in]   pkt     the request
+ * @param[out]  buf     buffer for the response, which holds the request
+ * @param[in]   len     size of @p buf
+ * @param[in]   ct      Content-Format of the payload
+ * @param[in]   read_cb callback to read the block
+ * @param[in]   arg     argument for @p read_cb
+ *
+ * @returns     length of the response, also for error responses, e.g. 4.02
+ *              if the block is behind the end of the payload
+ * @returns     <0 if @p buf is too small for a response
+ */
+ssize_t nanocoap_blockwise_reply(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                                 unsigned ct,
+                                 nanocoap_blockwise_read_cb_t read_cb,
+                                 void *arg);
+
+/**
+ * @brief   Write the block of a PUT or POST request and reply to it
+ *
+ * A request with a Block1 option for offset 0, or without a Block1 option,
+ * starts a new payload. Repeated blocks, e.g. if a response was lost, are
+ * answered again but not written. A block that does not follow the blocks
+ * written before is answered with 4.08 (Request Entity Incomplete).
+ *
+ * @param[in]       pkt         the request
+ * @param[out]      buf         buffer for the response, which holds the
+ *                              request
+ * @param[in]       len         size of @p buf
+ * @param[in,out]   offset      offset behind the part of the payload
+ *                              written so far, kept by the caller per
+ *                              resource
+ * @param[in]       write_cb    callback to write the block
+ * @param[in]       arg         argument for @p write_cb
+ *
+ * @returns     length of the response, 2.31 (Continue) if more blocks follow,
+ *              2.04 (Changed) for the last one
+ * @returns     <0 if @p buf is too small for a response
+ */
+ssize_t nanocoap_blockwise_recv(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                                size_t *offset,
+                                nanocoap_blockwise_write_cb_t write_cb,
+                                void *arg);
+
+/**
+ * @brief   Download a resource with pipelined Block2 requests
+ *
+ * @param[in]   remote      remote UDP endpoint, port 0 for @ref COAP_PORT
+ * @param[in]   path        path of the resource
+ * @param[in]   blksize     size of the blocks in bytes, a power of two from
+ *                          16 to 1024; the server may choose smaller blocks
+ * @param[in]   window      number of requests in flight, from 1 to
+ *                          #CONFIG_NANOCOAP_BLOCKWISE_WINDOW_MAX
+ * @param[in]   buf         buffer for the transfer
+ * @param[in]   len         size of @p buf, at least
+ *                          NANOCOAP_BLOCKWISE_BUF_SIZE(@p blksize, @p window)
+ * @param[in]   write_cb    callback to write the payload
+ * @param[in]   arg         argument for @p write_cb
+ *
+ * @returns     length of the payload on success
+ * @returns     -EINVAL if @p blksize or @p window is invalid
+ * @returns     -ENOBUFS if @p buf is too small
+ * @returns     -ETIMEDOUT if a request was not answered
+ * @returns     -EBADMSG if a response does not match its request
+ * @returns     the negative response code, e.g. -404, on an error response
+ * @returns     <0 on other errors, e.g. of sock or @p write_cb
+ */
+ssize_t nanocoap_blockwise_get(const sock_udp_ep_t *remote, const char *path,
+                               size_t blksize, unsigned window,
+                               uint8_t *buf, size_t len,
+                               nanocoap_blockwise_write_cb_t write_cb,
+                               void *arg);
+
+/**
+ * @brief   Send a payload to a resource with Block1 requests
+ *
+ * @param[in]   remote      remote UDP endpoint, port 0 for @ref COAP_PORT
+ * @param[in]   path        path of the resource
+ * @param[in]   method      request method, e.g. COAP_METHOD_PUT
+ * @param[in]   blksize     size of the blocks in bytes, a power of two from
+ *                          16 to 1024; the server may ask for smaller blocks
+ * @param[in]   buf         buffer for the transfer
+ * @param[in]   len         size of @p buf, at least
+ *                          NANOCOAP_BLOCKWISE_BUF_SIZE(@p blksize, 0)
+ * @param[in]   read_cb     callback to read the payload
+ * @param[in]   arg         argument for @p read_cb
+ *
+ * @returns     length of the payload on success
+ * @returns     -EINVAL if @p blksize is invalid
+ * @returns     -ENOBUFS if @p buf is too small
+ * @returns     -ETIMEDOUT if a request was not answered
+ * @returns     the negative response code, e.g. -408, on an error response
+ * @returns     <0 on other errors, e.g. of sock or @p read_cb
+ */
+ssize_t nanocoap_blockwise_upload(const sock_udp_ep_t *remote,
+                                  const char *path, unsigned method,
+                                  size_t blksize, uint8_t *buf, size_t len,
+                                  nanocoap_blockwise_read_cb_t read_cb,
+                                  void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* NET_NANOCOAP_BLOCKWISE_H */
+/** @} */
@@ -693,6 +693,21 @@ typedef enum {
      */
     NETOPT_LINK_CHECK,
 
+    /**
+     * @brief   (@ref netdev_rx_buf_t) Receive the next frame into a device
+     *          owned buffer (get only)
+     *
+     * Allows upper layers to process received frames in place instead of
+     * copying them out of the device. The buffer must be handed back to the
+     * driver via netdev_rx_buf_t::release.
+     *
+     * Returns sizeof(@ref netdev_rx_buf_t) on success, 0 if the frame was
+     * dropped by the device, -ENOBUFS if all device buffers are in use (the
+     * frame is still pending and can be received via netdev_driver_t::recv)
+     * and -ENOTSUP if the device does not support this option.
+     */
+    NETOPT_RX_BUF,
+
     /**
      * @brief   maximum number of options defined here.
      *
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_oaindex Open addressing index
+ * @ingroup     sys
+ * @brief       Hash table with linear probing indexing the entries of a
+ *              fixed array
+ *
+ * The index does not store any keys, only the numbers of the indexed entries
+ * in the array. The user provides a hash function of an entry's number and
+ * compares the keys itself when iterating the probe sequence of a key:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~ {.c}
+ * for (unsigned slot = oaindex_first(&idx, hash);
+ *      !oaindex_free(&idx, slot);
+ *      slot = oaindex_next(&idx, slot)) {
+ *     entry_t *e = &entries[oaindex_entry(&idx, slot)];
+ *     ...
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Slots hold the number of the entry + 1, so 0 marks a free slot. Removed
+ * entries do not leave tombstones, the entries behind them are moved back
+ * instead. With more slots than entries there is thus always a free slot that
+ * ends every probe sequence; twice as many slots as entries keep them short.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Open addressing index definitions
+ */
+#ifndef OAINDEX_H
+#define OAINDEX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Value of a free slot
+ */
+#define OAINDEX_FREE        (0U)
+
+/**
+ * @brief   Hash function of an indexed entry
+ *
+ * @param[in] entry Number of the entry in the indexed array
+ *
+ * @return  Hash of the key of @p entry. Reduced modulo the number of slots
+ *          by the index.
+ */
+typedef uint32_t (*oaindex_hash_t)(unsigned entry);
+
+/**
+ * @brief   Open addressing index
+ */
+typedef struct {
+    uint16_t *slots;        /**< slots of the index */
+    unsigned size;          /**< number of slots */
+    oaindex_hash_t hash;    /**< hash function of the indexed entries */
+} oaindex_t;
+
+/**
+ * @brief   Static initializer for an index
+ *
+ * @param[in] slots An array of `uint16_t` with more elements than the indexed
+ *                  array
+ * @param[in] hash  An @ref oaindex_hash_t
+ */
+#define OAINDEX_INIT(slots, hash)   { (slots), ARRAY_SIZE(slots), (hash) }
+
+/**
+ * @brief   Removes all entries from an index
+ *
+ * @param[in] idx   An index
+ */
+static inline void oaindex_clear(const oaindex_t *idx)
+{
+    memset(idx->slots, 0, idx->size * sizeof(idx->slots[0]));
+}
+
+/**
+ * @brief   Gets the first slot of the probe sequence of a hash
+ *
+ * @param[in] idx   An index
+ * @param[in] hash  A hash, as returned by oaindex_t::hash for the key
+ *
+ * @return  The first slot of the probe sequence of @p hash
+ */
+static inline unsigned oaindex_first(const oaindex_t *idx, uint32_t hash)
+{
+    return hash % idx->size;
+}
+
+/**
+ * @brief   Gets the next slot of a probe sequence
+ *
+ * @param[in] idx   An index
+ * @param[in] slot  A slot of @p idx
+ *
+ * @return  The slot after @p slot
+ */
+static inline unsigned oaindex_next(const oaindex_t *idx, unsigned slot)
+{
+    return (slot + 1) % idx->size;
+}
+
+/**
+ * @brief   Checks if a slot is free, i.e. the end of a probe sequence
+ *
+ * @param[in] idx   An index
+ * @param[in] slot  A slot of @p idx
+ *
+ * @return  true, if @p slot is free
+ */
+static inline bool oaindex_free(const oaindex_t *idx, unsigned slot)
+{
+    return idx->slots[slot] == OAINDEX_FREE;
+}
+
+/**
+ * @brief   Gets the entry in a slot
+ *
+ * @pre     `!oaindex_free(idx, slot)`
+ *
+ * @param[in] idx   An index
+ * @param[in] slot  A slot of @p idx
+ *
+ * @return  The number of the entry in @p slot
+ */
+static inline unsigned oaindex_entry(const oaindex_t *idx, unsigned slot)
+{
+    return idx->slots[slot] - 1;
+}
+
+/**
+ * @brief   Adds an entry to an index
+ *
+ * Does nothing if @p entry is already in @p idx.
+ *
+ * @pre     @p idx has more slots than there are entries in the indexed array.
+ *
+ * @param[in] idx   An index
+ * @param[in] entry Number of the entry in the indexed array
+ */
+void oaindex_add(const oaindex_t *idx, unsigned entry);
+
+/**
+ * @brief   Removes an entry from an index
+ *
+ * Does nothing if @p entry is not in @p idx. oaindex_t::hash must still
+ * return the hash @p entry was added with.
+ *
+ * @param[in] idx   An index
+ * @param[in] entry Number of the entry in the indexed array
+ */
+void oaindex_del(const oaindex_t *idx, unsigned entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OAINDEX_H */
+/** @} */
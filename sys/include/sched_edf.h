@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @defgroup    sys_sched_edf Earliest deadline first scheduling
+ * @ingroup     sys
+ * @brief       Deadline scheduling class for periodic threads
+ *
+ * RIOT's scheduler is strictly fixed priority. Periodic activities with
+ * deadlines, e.g. the slots of a MAC layer or periodic sensor sampling, can
+ * only be mapped to fixed priorities with a lower utilization bound than
+ * earliest deadline first (EDF) scheduling, which meets all deadlines up to a
+ * utilization of 100%.
+ *
+ * With module `sched_edf`, the priority level @ref SCHED_EDF_PRIORITY forms
+ * a deadline scheduling class: among the runnable threads of that level, the
+ * scheduler picks the one with the earliest absolute deadline instead of the
+ * one first in line. Threads of higher priority still preempt EDF threads,
+ * EDF threads preempt all threads of lower priority.
+ *
+ * A thread joins the class with @ref sched_edf_add(), declaring its period,
+ * its execution budget per period and its relative deadline. Every period a
+ * new job is released, its deadline is the release time plus the relative
+ * deadline. The thread signals the completion of a job with
+ * @ref sched_edf_wait_next_period(), which sleeps until the next release.
+ *
+ * Budgets are enforced with @ref sys_ztimer: a budget timer runs while the
+ * thread is scheduled with budget left, i.e. it is armed when the thread is
+ * dispatched and stopped when it is preempted or blocks. Switches not
+ * involving an EDF thread cost the scheduler two comparisons. A thread
+ * exceeding its budget is throttled to the priority it had before joining
+ * the class until its next release, so it cannot make other EDF threads miss
+ * their deadlines.
+ *
+ * The deadline timer of a job is armed on its release and only counts a
+ * deadline miss if the job is not completed by then. The scheduler itself
+ * just compares the deadlines cached in the threads. `ps` shows the number of
+ * missed deadlines and throttled jobs.
+ *
+ * All times are given in microseconds of `ZTIMER_USEC`.
+ *
+ * @note    Only threads added with @ref sched_edf_add() may use
+ *          @ref SCHED_EDF_PRIORITY.
+ *
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling interface
+ */
+
+#ifndef SCHED_EDF_H
+#define SCHED_EDF_H
+
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "sched.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Priority level of the deadline scheduling class
+ *
+ * Defaults to a level above the GNRC network interfaces, as MAC layers are
+ * the main users of deadlines.
+ */
+#ifndef SCHED_EDF_PRIORITY
+#define SCHED_EDF_PRIORITY      (THREAD_PRIORITY_MAIN - 6)
+#endif
+
+/**
+ * @brief   Timing parameters of an EDF thread
+ */
+typedef struct {
+    uint32_t period;        /**< period of job releases in µs */
+    uint32_t budget;        /**< execution time per job in µs */
+    uint32_t deadline;      /**< deadline of a job relative to its
+                             *   release in µs, at most `period` */
+} sched_edf_params_t;
+
+/**
+ * @brief   State of an EDF thread
+ *
+ * @note    All members are private, use @ref sched_edf_stats() to read the
+ *          statistics.
+ */
+typedef struct {
+    sched_edf_params_t params;  /**< timing parameters */
+    ztimer_t release_timer;     /**< releases the next job */
+    ztimer_t deadline_timer;    /**< fires on the deadline of the
+                                     current job */
+    ztimer_t budget_timer;      /**< fires when the budget is exhausted */
+    uint32_t release;           /**< release time of the current job */
+    uint32_t remaining;         /**< budget left for the current job */
+    uint32_t started;           /**< time the thread was last dispatched */
+    uint32_t jobs;              /**< number of released jobs */
+    uint32_t misses;            /**< number of jobs missing the deadline */
+    uint32_t throttled;         /**< number of jobs exceeding the budget */
+    kernel_pid_t pid;           /**< thread */
+    uint8_t priority;           /**< priority outside of the class */
+    uint8_t active;             /**< current job is not completed */
+    uint8_t missed;             /**< current job missed its deadline */
+    uint8_t backlog;            /**< next job was released before the
+                                     current one completed */
+} sched_edf_t;
+
+/**
+ * @brief   Statistics of an EDF thread
+ */
+typedef struct {
+    uint32_t jobs;          /**< number of released jobs */
+    uint32_t misses;        /**< number of jobs missing their deadline */
+    uint32_t throttled;     /**< number of jobs exceeding their budget */
+} sched_edf_stats_t;
+
+/**
+ * @brief   Adds a thread to the deadline scheduling class
+ *
+ * The first job is released immediately.
+ *
+ * @param[out] edf      state of the thread, must stay valid until
+ *                      @ref sched_edf_remove()
+ * @param[in] pid       thread to add
+ * @param[in] params    timing parameters
+ *
+ * @return  0 on success
+ * @return  -EINVAL if @p pid is not a thread or @p params are invalid
+ * @return  -EBUSY if @p pid is in the class already
+ * @return  -ENOSPC if the total utilization of all EDF threads would exceed
+ *          100% with the thread
+ */
+int sched_edf_add(sched_edf_t *edf, kernel_pid_t pid,
+                  const sched_edf_params_t *params);
+
+/**
+ * @brief   Removes a thread from the deadline scheduling class
+ *
+ * The thread continues with the priority it had before
+ * @ref sched_edf_add(). If it is waiting in
+ * @ref sched_edf_wait_next_period(), it is woken up.
+ *
+ * @param[in] edf       state of the thread
+ */
+void sched_edf_remove(sched_edf_t *edf);
+
+/**
+ * @brief   Completes the current job of the calling thread and sleeps until
+ *          the release of the next one
+ *
+ * Returns immediately if the next job was released already.
+ */
+void sched_edf_wait_next_period(void);
+
+/**
+ * @brief   Gets the statistics of an EDF thread
+ *
+ * @param[in] pid       thread
+ * @param[out] stats    the statistics
+ *
+ * @return  0 on success
+ * @return  -1 if @p pid is not in the deadline scheduling class
+ */
+int sched_edf_stats(kernel_pid_t pid, sched_edf_stats_t *stats);
+
+/**
+ * @brief   Accounts the budgets on a context switch
+ *
+ * Called by the scheduler with interrupts disabled, if @p active or @p next
+ * runs at @ref SCHED_EDF_PRIORITY.
+ *
+ * @param[in] active    thread scheduled away from
+ * @param[in] next      thread being scheduled
+ */
+void sched_edf_switch(kernel_pid_t active, kernel_pid_t next);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_EDF_H */
+/** @} */
@@ -122,6 +122,37 @@
  * (now() - B) + T[1]). Thus even though the list is keeping relative offsets,
  * the time keeping is done by keeping track of the absolute times.
  *
+ * With many concurrently set timers, inserting into the sorted list becomes
+ * costly (O(n) with interrupts disabled). The optional module `ztimer_wheel`
+ * replaces the list with a hierarchical timer wheel: each clock then keeps
+ * @ref ZTIMER_WHEEL_LEVELS levels of @ref ZTIMER_WHEEL_SLOTS doubly linked
+ * slots, and every timer stores its absolute target time. A timer is placed
+ * on the level given by the highest digit in which its target differs from
+ * the clock's current time, so ztimer_set() and ztimer_remove() are O(1).
+ * Timers on higher levels are moved ("cascaded") to lower levels when the
+ * clock reaches the beginning of their slot. This costs some RAM per clock
+ * (one pointer per slot) and may cause an additional wakeup per level a timer
+ * is cascaded through.
+ *
+ *
+ * ## Timer coalescing
+ *
+ * Many timers don't need to fire exactly on time, e.g. timeouts of protocol
+ * state machines. With module `ztimer_slack`, such timers can be set using
+ * ztimer_set_slack(), which allows ztimer to fire them up to a given number of
+ * ticks late. ztimer uses this to fire timers whose windows overlap with a
+ * single interrupt, reducing the number of wakeups of the system:
+ *
+ * - The list based core programs the alarm to the earliest end of the windows
+ *   of the timers due first, rather than to the first target, and fires all
+ *   timers due by then.
+ * - With `ztimer_wheel`, the target of a timer is moved to the time in its
+ *   window that is the multiple of the highest power of two, so timers with
+ *   overlapping windows end up with the same target.
+ *
+ * The number of times ztimer_handler() was called for a clock, i.e. the
+ * number of timer interrupts, can be read with ztimer_wakeups().
+ *
  *
  * ## Clock extension
  *
@@ -233,12 +264,34 @@ typedef struct ztimer_base ztimer_base_t;
  */
 typedef struct ztimer_clock ztimer_clock_t;
 
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+/**
+ * @brief   Number of bits of the target time handled by each wheel level
+ */
+#define ZTIMER_WHEEL_BITS       (4U)
+
+/**
+ * @brief   Number of slots per wheel level
+ */
+#define ZTIMER_WHEEL_SLOTS      (1U << ZTIMER_WHEEL_BITS)
+
+/**
+ * @brief   Number of wheel levels needed to cover the 32bit range
+ */
+#define ZTIMER_WHEEL_LEVELS     (32U / ZTIMER_WHEEL_BITS)
+#endif
+
 /**
  * @brief   Minimum information for each timer
  */
 struct ztimer_base {
     ztimer_base_t *next;        /**< next timer in list */
-    uint32_t offset;            /**< offset from last timer in list */
+    uint32_t offset;            /**< offset from last timer in list
+                                     (absolute target with ztimer_wheel) */
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    ztimer_base_t **pprev;      /**< link pointing to this timer, NULL if
+                                     the timer is not set (ztimer_wheel)   */
+#endif
 };
 
 #if MODULE_ZTIMER_NOW64
@@ -257,6 +310,10 @@ typedef struct {
     ztimer_base_t base;             /**< clock list entry */
     void (*callback)(void *arg);    /**< timer callback function pointer */
     void *arg;                      /**< timer callback argument */
+#if (MODULE_ZTIMER_SLACK && !MODULE_ZTIMER_WHEEL) || DOXYGEN
+    uint32_t slack;                 /**< ticks the timer may fire late
+                                         (ztimer_slack without ztimer_wheel) */
+#endif
 } ztimer_t;
 
 /**
@@ -291,12 +348,23 @@ struct ztimer_clock {
     const ztimer_ops_t *ops;        /**< pointer to methods structure       */
     ztimer_base_t *last;            /**< last timer in queue, for _is_set() */
     uint32_t adjust;                /**< will be subtracted on every set()  */
+    uint32_t wakeups;               /**< number of ztimer_handler() calls   */
 #if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_NOW64 || DOXYGEN
     /* values used for checkpointed intervals and 32bit extension */
     uint32_t max_value;             /**< maximum relative timer value       */
     uint32_t lower_last;            /**< timer value at last now() call     */
     ztimer_now_t checkpoint;        /**< cumulated time at last now() call  */
 #endif
+#if (MODULE_ZTIMER_SLACK && !MODULE_ZTIMER_WHEEL) || DOXYGEN
+    uint32_t armed;                 /**< time the lower clock is set to fire
+                                         (ztimer_slack without ztimer_wheel) */
+#endif
+#if MODULE_ZTIMER_WHEEL || DOXYGEN
+    /** timer wheel slots (ztimer_wheel) */
+    ztimer_base_t *wheel[ZTIMER_WHEEL_LEVELS][ZTIMER_WHEEL_SLOTS];
+    /** bitmaps of non-empty slots per level (ztimer_wheel) */
+    uint16_t wheel_map[ZTIMER_WHEEL_LEVELS];
+#endif
 };
 
 /**
@@ -320,6 +388,43 @@ void ztimer_handler(ztimer_clock_t *clock);
  */
 void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val);
 
+#if MODULE_ZTIMER_SLACK || DOXYGEN
+/**
+ * @brief   Set a timer on a clock, allowing it to fire late
+ *
+ * Like ztimer_set(), but the timer may fire up to @p slack ticks after its
+ * target, so ztimer can fire it together with other timers (see
+ * @ref ztimer "Timer coalescing"). Without module `ztimer_slack`, this is
+ * the same as ztimer_set().
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ * @param[in]   timer       timer entry to set
+ * @param[in]   val         timer target (relative ticks from now)
+ * @param[in]   slack       ticks the timer may fire after its target
+ */
+void ztimer_set_slack(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                      uint32_t slack);
+#else
+static inline void ztimer_set_slack(ztimer_clock_t *clock, ztimer_t *timer,
+                                    uint32_t val, uint32_t slack)
+{
+    (void)slack;
+    ztimer_set(clock, timer, val);
+}
+#endif
+
+/**
+ * @brief   Get the number of wakeups of a clock
+ *
+ * @param[in]   clock       ztimer clock to operate on
+ *
+ * @return  number of times the clock's timer interrupt was handled
+ */
+static inline uint32_t ztimer_wakeups(const ztimer_clock_t *clock)
+{
+    return clock->wakeups;
+}
+
 /**
  * @brief   Remove a timer from a clock
  *
@@ -0,0 +1,444 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_ktrace
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracing implementation
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "cpu.h"
+#include "irq.h"
+#include "ktrace.h"
+#include "sched.h"
+#include "thread.h"
+
+#if defined(CPU_NATIVE)
+#include <fcntl.h>
+#include <time.h>
+#include "native_internal.h"
+#elif !defined(DWT_CTRL_CYCCNTENA_Msk)
+#include "xtimer.h"
+#endif
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define KTRACE_BUF_MASK     (KTRACE_BUF_SIZE - 1)
+
+#ifndef KTRACE_EXPORT_LINE_LEN
+#define KTRACE_EXPORT_LINE_LEN  (160U)
+#endif
+
+static ktrace_event_t _buf[KTRACE_BUF_SIZE];
+/* number of slots ever reserved */
+static unsigned _head;
+/* slots before _tail were dropped by ktrace_clear() */
+static unsigned _tail;
+/* recording starts once the timestamp source is initialized */
+static volatile bool _enabled;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && !defined(CPU_NATIVE)
+/* upper 32 bit of the cycle count and its lower 32 bit when last read */
+static uint32_t _cyc_high;
+static uint32_t _cyc_last;
+#endif
+
+static inline uint64_t _now(void)
+{
+#if defined(CPU_NATIVE)
+    struct timespec t;
+
+    _native_syscall_enter();
+    real_clock_gettime(CLOCK_MONOTONIC, &t);
+    _native_syscall_leave();
+    return (uint64_t)t.tv_sec * 1000000000LU + t.tv_nsec;
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+    unsigned state = irq_disable();
+    uint32_t cyc = DWT->CYCCNT;
+
+    if (cyc < _cyc_last) {
+        _cyc_high++;
+    }
+    _cyc_last = cyc;
+    uint64_t now = ((uint64_t)_cyc_high << 32) | cyc;
+    irq_restore(state);
+    return now;
+#else
+    return xtimer_now64().ticks64;
+#endif
+}
+
+uint32_t ktrace_clock_hz(void)
+{
+#if defined(CPU_NATIVE)
+    return 1000000000LU;
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+    return CLOCK_CORECLOCK;
+#else
+    return XTIMER_HZ;
+#endif
+}
+
+void ktrace_init(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk) && !defined(CPU_NATIVE)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    _enabled = true;
+}
+
+void ktrace_record(ktrace_type_t type, uint32_t arg)
+{
+    if (!_enabled) {
+        return;
+    }
+
+    unsigned idx = __atomic_fetch_add(&_head, 1, __ATOMIC_RELAXED);
+    ktrace_event_t *event = &_buf[idx & KTRACE_BUF_MASK];
+
+    event->time = _now();
+    event->arg = arg;
+    /* context switches are attributed to the thread switched away from */
+    event->pid = (irq_is_in() && (type != KTRACE_SCHED)) ? KERNEL_PID_ISR
+                                                         : sched_active_pid;
+    event->type = type;
+}
+
+void ktrace_enable(bool enable)
+{
+    _enabled = enable;
+}
+
+void ktrace_clear(void)
+{
+    unsigned state = irq_disable();
+
+    _tail = _head;
+    irq_restore(state);
+}
+
+static unsigned _numof(void)
+{
+    unsigned numof = _head - _tail;
+
+    return (numof > KTRACE_BUF_SIZE) ? KTRACE_BUF_SIZE : numof;
+}
+
+int ktrace_get(unsigned idx, ktrace_event_t *event)
+{
+    unsigned state = irq_disable();
+    int res = -1;
+
+    if (idx < _numof()) {
+        *event = _buf[(_head - _numof() + idx) & KTRACE_BUF_MASK];
+        res = 0;
+    }
+    irq_restore(state);
+    return res;
+}
+
+/**
+ * @brief   Iterates over the recorded events with monotonic timestamps
+ *
+ * Timestamps are made relative to the first event. An event recorded by an
+ * ISR preempting the recording of another one might have an earlier
+ * timestamp than its predecessor, its timestamp is raised to keep them
+ * monotonic.
+ */
+typedef struct {
+    unsigned idx;
+    uint64_t first;
+    uint64_t time;
+} _iter_t;
+
+static bool _next(_iter_t *iter, ktrace_event_t *event)
+{
+    if (ktrace_get(iter->idx, event) < 0) {
+        return false;
+    }
+    if (iter->idx++ == 0) {
+        iter->first = event->time;
+    }
+    if ((event->time > iter->first) &&
+        ((event->time - iter->first) > iter->time)) {
+        iter->time = event->time - iter->first;
+    }
+    return true;
+}
+
+/* converts ticks to nanoseconds without overflowing for long traces */
+static uint64_t _ticks_to_ns(uint64_t ticks, uint32_t hz)
+{
+    return (ticks / hz) * 1000000000LLU +
+           ((ticks % hz) * 1000000000LLU) / hz;
+}
+
+static void _printf(ktrace_write_t write, void *arg, const char *fmt, ...)
+{
+    char line[KTRACE_EXPORT_LINE_LEN];
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    if (len > 0) {
+        write(arg, line, ((size_t)len < sizeof(line)) ? (size_t)len
+                                                       : sizeof(line) - 1);
+    }
+}
+
+static const char *_thread_name(kernel_pid_t pid)
+{
+#ifdef DEVELHELP
+    const volatile thread_t *thread = thread_get(pid);
+
+    if (thread != NULL) {
+        return thread->name;
+    }
+#else
+    (void)pid;
+#endif
+    return NULL;
+}
+
+static void _chrome_event(ktrace_write_t write, void *arg, const char *sep,
+                          const char *name, char ph, kernel_pid_t tid,
+                          uint64_t ns, const char *args)
+{
+    /* microseconds, printed in two parts as printf might lack 64 bit */
+    uint64_t us = ns / 1000;
+    char ts[24];
+
+    if (us >= 1000000000LLU) {
+        snprintf(ts, sizeof(ts), "%" PRIu32 "%09" PRIu32,
+                 (uint32_t)(us / 1000000000LLU),
+                 (uint32_t)(us % 1000000000LLU));
+    }
+    else {
+        snprintf(ts, sizeof(ts), "%" PRIu32, (uint32_t)us);
+    }
+    _printf(write, arg, "%s\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":0,"
+            "\"tid\":%d,\"ts\":%s.%03u%s%s}", sep, name, ph,
+            (int)tid, ts, (unsigned)(ns % 1000),
+            (ph == 'i') ? ",\"s\":\"t\"" : "", args);
+}
+
+void ktrace_export_chrome(ktrace_write_t write, void *arg)
+{
+    bool enabled = _enabled;
+    uint32_t hz = ktrace_clock_hz();
+    _iter_t iter = { 0 };
+    ktrace_event_t event;
+    char args[48];
+
+    _enabled = false;
+    _printf(write, arg, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+    _printf(write, arg, "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+            "\"tid\":%d,\"args\":{\"name\":\"ISR\"}}", KERNEL_PID_ISR);
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++) {
+        const char *name = _thread_name(pid);
+        if (name != NULL) {
+            _printf(write, arg, ",\n{\"name\":\"thread_name\",\"ph\":\"M\","
+                    "\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    (int)pid, name);
+        }
+    }
+    while (_next(&iter, &event)) {
+        uint64_t ns = _ticks_to_ns(iter.time, hz);
+        kernel_pid_t peer = (kernel_pid_t)(event.arg >> 16);
+
+        args[0] = '\0';
+        switch (event.type) {
+            case KTRACE_SCHED:
+                if (event.pid != KERNEL_PID_UNDEF) {
+                    _chrome_event(write, arg, ",", "running", 'E', event.pid,
+                                  ns, "");
+                }
+                _chrome_event(write, arg, ",", "running", 'B',
+                              (kernel_pid_t)event.arg, ns, "");
+                break;
+            case KTRACE_ISR_ENTER:
+            case KTRACE_ISR_EXIT:
+                snprintf(args, sizeof(args), ",\"args\":{\"irq\":%" PRIu32 "}",
+                         event.arg);
+                _chrome_event(write, arg, ",", "isr",
+                              (event.type == KTRACE_ISR_ENTER) ? 'B' : 'E',
+                              KERNEL_PID_ISR, ns, args);
+                break;
+            case KTRACE_MSG_SEND:
+            case KTRACE_MSG_RECV:
+                snprintf(args, sizeof(args),
+                         ",\"args\":{\"%s\":%d,\"type\":\"0x%04x\"}",
+                         (event.type == KTRACE_MSG_SEND) ? "to" : "from",
+                         (int)peer, (unsigned)(event.arg & 0xffff));
+                _chrome_event(write, arg, ",",
+                              (event.type == KTRACE_MSG_SEND) ? "msg_send"
+                                                              : "msg_receive",
+                              'i', event.pid, ns, args);
+                break;
+            case KTRACE_MUTEX_BLOCK:
+            case KTRACE_MUTEX_ACQUIRE:
+                snprintf(args, sizeof(args),
+                         ",\"args\":{\"mutex\":\"0x%08" PRIx32 "\"}", event.arg);
+                _chrome_event(write, arg, ",",
+                              (event.type == KTRACE_MUTEX_BLOCK) ? "mutex_block"
+                                                                 : "mutex_acquire",
+                              'i', event.pid, ns, args);
+                break;
+            default:
+                break;
+        }
+    }
+    _printf(write, arg, "\n]}\n");
+    _enabled = enabled;
+}
+
+void ktrace_export_ctf_metadata(ktrace_write_t write, void *arg)
+{
+    static const char *_events[] = {
+        "event {\n\tname = \"sched_switch\";\n\tid = 0;\n"
+        "\tfields := struct { int16_t next_pid; };\n};\n\n",
+        "event {\n\tname = \"isr_enter\";\n\tid = 1;\n"
+        "\tfields := struct { uint32_t irq; };\n};\n\n",
+        "event {\n\tname = \"isr_exit\";\n\tid = 2;\n"
+        "\tfields := struct { uint32_t irq; };\n};\n\n",
+        "event {\n\tname = \"msg_send\";\n\tid = 3;\n"
+        "\tfields := struct { int16_t target; uint16_t type; };\n};\n\n",
+        "event {\n\tname = \"msg_receive\";\n\tid = 4;\n"
+        "\tfields := struct { int16_t sender; uint16_t type; };\n};\n\n",
+        "event {\n\tname = \"mutex_block\";\n\tid = 5;\n"
+        "\tfields := struct { uint32_t mutex; };\n};\n\n",
+        "event {\n\tname = \"mutex_acquire\";\n\tid = 6;\n"
+        "\tfields := struct { uint32_t mutex; };\n};\n\n",
+    };
+
+    _printf(write, arg, "/* CTF 1.8 */\n\n"
+            "typealias integer { size = 8; align = 8; signed = false; } "
+            ":= uint8_t;\n"
+            "typealias integer { size = 16; align = 8; signed = false; } "
+            ":= uint16_t;\n");
+    _printf(write, arg,
+            "typealias integer { size = 16; align = 8; signed = true; } "
+            ":= int16_t;\n"
+            "typealias integer { size = 32; align = 8; signed = false; } "
+            ":= uint32_t;\n\n");
+    _printf(write, arg, "trace {\n\tmajor = 1;\n\tminor = 8;\n"
+            "\tbyte_order = %s;\n"
+            "\tpacket.header := struct { uint32_t magic; };\n};\n\n",
+            (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) ? "le" : "be");
+    _printf(write, arg, "clock {\n\tname = ktrace;\n\tfreq = %" PRIu32 ";\n"
+            "};\n\n", ktrace_clock_hz());
+    _printf(write, arg, "typealias integer { size = 64; align = 8; "
+            "signed = false; map = clock.ktrace.value; } := ktrace_clock_t;\n\n");
+    _printf(write, arg, "stream {\n"
+            "\tevent.header := struct { uint8_t id; ktrace_clock_t timestamp; };\n"
+            "\tevent.context := struct { int16_t pid; };\n};\n\n");
+    for (unsigned i = 0; i < ARRAY_SIZE(_events); i++) {
+        write(arg, _events[i], strlen(_events[i]));
+    }
+}
+
+void ktrace_export_ctf(ktrace_write_t write, void *arg)
+{
+    static const uint32_t magic = 0xc1fc1fc1;
+    bool enabled = _enabled;
+    _iter_t iter = { 0 };
+    ktrace_event_t event;
+
+    _enabled = false;
+    write(arg, &magic, sizeof(magic));
+    while (_next(&iter, &event)) {
+        int16_t peer = (int16_t)(event.arg >> 16);
+        uint16_t type = (uint16_t)event.arg;
+        int16_t pid = (int16_t)event.arg;
+
+        write(arg, &event.type, sizeof(event.type));
+        write(arg, &iter.time, sizeof(iter.time));
+        write(arg, &event.pid, sizeof(event.pid));
+        switch (event.type) {
+            case KTRACE_SCHED:
+                write(arg, &pid, sizeof(pid));
+                break;
+            case KTRACE_MSG_SEND:
+            case KTRACE_MSG_RECV:
+                write(arg, &peer, sizeof(peer));
+                write(arg, &type, sizeof(type));
+                break;
+            default:
+                write(arg, &event.arg, sizeof(event.arg));
+                break;
+        }
+    }
+    _enabled = enabled;
+}
+
+#ifdef CPU_NATIVE
+static void _write_fd(void *arg, const void *data, size_t len)
+{
+    int fd = *(int *)arg;
+
+    _native_syscall_enter();
+    while (len > 0) {
+        ssize_t res = real_write(fd, data, len);
+        if (res <= 0) {
+            break;
+        }
+        data = (const uint8_t *)data + res;
+        len -= res;
+    }
+    _native_syscall_leave();
+}
+
+static int _export_file(const char *path, void (*export)(ktrace_write_t, void *))
+{
+    int fd;
+
+    _native_syscall_enter();
+    fd = real_open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    _native_syscall_leave();
+    if (fd < 0) {
+        DEBUG("ktrace: unable to open %s\n", path);
+        return -errno;
+    }
+    export(_write_fd, &fd);
+    _native_syscall_enter();
+    real_close(fd);
+    _native_syscall_leave();
+    return 0;
+}
+
+int ktrace_export_file(const char *path, bool ctf)
+{
+    char name[128];
+    int res;
+
+    if (!ctf) {
+        return _export_file(path, ktrace_export_chrome);
+    }
+    snprintf(name, sizeof(name), "%s/metadata", path);
+    if ((res = _export_file(name, ktrace_export_ctf_metadata)) < 0) {
+        return res;
+    }
+    snprintf(name, sizeof(name), "%s/stream", path);
+    return _export_file(name, ktrace_export_ctf);
+}
+#endif
@@ -26,6 +26,9 @@
 #include <string.h>
 
 #include "assert.h"
+#include "kernel_defines.h"
+#include "mbox.h"
+#include "memarray.h"
 #include "net/gcoap.h"
 #include "net/sock/async/event.h"
 #include "net/sock/util.h"
@@ -55,11 +58,22 @@ static void _find_req_memo(gcoap_request_memo_t **memo_ptr, coap_pkt_t *pdu,
                            const sock_udp_ep_t *remote);
 static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
                                             gcoap_listener_t **listener_ptr);
+#if IS_USED(MODULE_GCOAP_OBS_FANOUT)
+static int _obs_register(coap_pkt_t *pdu, const sock_udp_ep_t *remote,
+                         const coap_resource_t *resource);
+#else
 static int _find_observer(sock_udp_ep_t **observer, sock_udp_ep_t *remote);
 static int _find_obs_memo(gcoap_observe_memo_t **memo, sock_udp_ep_t *remote,
                                                        coap_pkt_t *pdu);
 static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
                                    const coap_resource_t *resource);
+#endif
+#if IS_USED(MODULE_GCOAP_WORKERS)
+static void *_worker(void *arg);
+static ssize_t _queue_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          sock_udp_ep_t *remote,
+                          const coap_resource_t *resource);
+#endif
 
 /* Internal variables */
 const coap_resource_t _default_resources[] = {
@@ -82,11 +96,13 @@ typedef struct {
                                            byte of an entry is zero, the entry
                                            is available */
     atomic_uint next_message_id;        /* Next message ID to use */
+#if !IS_USED(MODULE_GCOAP_OBS_FANOUT)
     sock_udp_ep_t observers[CONFIG_GCOAP_OBS_CLIENTS_MAX];
                                         /* Observe clients; allows reuse for
                                            observe memos */
     gcoap_observe_memo_t observe_memos[CONFIG_GCOAP_OBS_REGISTRATIONS_MAX];
                                         /* Observed resource registrations */
+#endif
     uint8_t resend_bufs[CONFIG_GCOAP_RESEND_BUFS_MAX][CONFIG_GCOAP_PDU_BUF_SIZE];
                                         /* Buffers for PDU for request resends;
                                            if first byte of an entry is zero,
@@ -103,6 +119,47 @@ static event_queue_t _queue;
 static uint8_t _listen_buf[CONFIG_GCOAP_PDU_BUF_SIZE];
 static sock_udp_t _sock;
 
+#if IS_USED(MODULE_GCOAP_WORKERS)
+/* A request queued for or handled by a worker; unused if resource is NULL */
+typedef struct {
+    const coap_resource_t *resource;
+    struct _worker_limit *limit;    /* limit the request counts against */
+    coap_pkt_t pdu;
+    sock_udp_ep_t remote;
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+} _worker_job_t;
+
+/* Limit of requests for a resource; unused if resource is NULL */
+typedef struct _worker_limit {
+    const coap_resource_t *resource;
+    uint8_t max;
+    uint8_t active;
+} _worker_limit_t;
+
+static char _worker_stacks[CONFIG_GCOAP_WORKERS_NUMOF][GCOAP_WORKER_STACK_SIZE];
+static _worker_job_t _worker_jobs[CONFIG_GCOAP_WORKER_QUEUE_SIZE];
+static _worker_limit_t _worker_limits[CONFIG_GCOAP_WORKER_LIMITS_MAX];
+static msg_t _worker_queue[CONFIG_GCOAP_WORKER_QUEUE_SIZE];
+static mbox_t _worker_mbox;
+#endif
+
+#if IS_USED(MODULE_GCOAP_OBS_FANOUT)
+/* Offset of the options in _obs_buf, leaves room for the longest token */
+#define OBS_BODY_OFFSET     (sizeof(coap_hdr_t) + GCOAP_TOKENLEN_MAX)
+
+static memarray_t _obs_pool;
+static gcoap_obs_entry_t *_obs_buckets[CONFIG_GCOAP_OBS_BUCKETS];
+/* Shares the registrations between the gcoap thread and notifying threads */
+static mutex_t _obs_lock = MUTEX_INIT;
+/* Serializes notifying threads, which share _obs_buf and _obs_tat */
+static mutex_t _obs_notify_lock = MUTEX_INIT;
+static uint8_t _obs_buf[OBS_BODY_OFFSET + CONFIG_GCOAP_PDU_BUF_SIZE];
+#if CONFIG_GCOAP_OBS_NOTIFY_RATE
+/* Theoretical arrival time of the next notification for pacing */
+static uint32_t _obs_tat;
+#endif
+#endif
+
 /* Event loop for gcoap _pid thread. */
 static void *_event_loop(void *arg)
 {
@@ -260,9 +317,11 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 {
     const coap_resource_t *resource     = NULL;
     gcoap_listener_t *listener          = NULL;
+#if !IS_USED(MODULE_GCOAP_OBS_FANOUT)
     sock_udp_ep_t *observer             = NULL;
     gcoap_observe_memo_t *memo          = NULL;
     gcoap_observe_memo_t *resource_memo = NULL;
+#endif
 
     switch (_find_resource(pdu, &resource, &listener)) {
         case GCOAP_RESOURCE_WRONG_METHOD:
@@ -270,11 +329,19 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         case GCOAP_RESOURCE_NO_PATH:
             return gcoap_response(pdu, buf, len, COAP_CODE_PATH_NOT_FOUND);
         case GCOAP_RESOURCE_FOUND:
+#if !IS_USED(MODULE_GCOAP_OBS_FANOUT)
             /* find observe registration for resource */
             _find_obs_memo_resource(&resource_memo, resource);
+#endif
             break;
     }
 
+#if IS_USED(MODULE_GCOAP_OBS_FANOUT)
+    if (_obs_register(pdu, remote, resource) < 0) {
+        /* bogus request; don't respond */
+        return -1;
+    }
+#else
     if (coap_get_observe(pdu) == COAP_OBS_REGISTER) {
         /* lookup remote+token */
         int empty_slot = _find_obs_memo(&memo, remote, pdu);
@@ -351,8 +418,18 @@ static size_t _handle_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         DEBUG("gcoap: Observe value unexpected: %" PRIu32 "\n", coap_get_observe(pdu));
         return -1;
     }
+#endif
+
+    ssize_t pdu_len;
 
-    ssize_t pdu_len = resource->handler(pdu, buf, len, resource->context);
+#if IS_USED(MODULE_GCOAP_WORKERS)
+    pdu_len = _queue_req(pdu, buf, len, remote, resource);
+    if (pdu_len >= 0) {
+        /* queued for a worker or rejected */
+        return pdu_len;
+    }
+#endif
+    pdu_len = resource->handler(pdu, buf, len, resource->context);
     if (pdu_len < 0) {
         pdu_len = gcoap_response(pdu, buf, len,
                                  COAP_CODE_INTERNAL_SERVER_ERROR);
@@ -385,30 +462,17 @@ static int _find_resource(coap_pkt_t *pdu, const coap_resource_t **resource_ptr,
     }
 
     while (listener) {
-        const coap_resource_t *resource = listener->resources;
-        for (size_t i = 0; i < listener->resources_len; i++) {
-            if (i) {
-                resource++;
-            }
-
-            int res = coap_match_path(resource, uri);
-            if (res > 0) {
-                continue;
-            }
-            else if (res < 0) {
-                /* resources expected in alphabetical order */
-                break;
-            }
-            else {
-                if (! (resource->methods & method_flag)) {
-                    ret = GCOAP_RESOURCE_WRONG_METHOD;
-                    continue;
-                }
-
-                *resource_ptr = resource;
-                *listener_ptr = listener;
-                return GCOAP_RESOURCE_FOUND;
-            }
+        /* resources expected in alphabetical order */
+        int res = coap_find_resource(listener->resources,
+                                     listener->resources_len, uri,
+                                     method_flag, resource_ptr);
+
+        if (res == 0) {
+            *listener_ptr = listener;
+            return GCOAP_RESOURCE_FOUND;
+        }
+        else if (res == -EPERM) {
+            ret = GCOAP_RESOURCE_WRONG_METHOD;
         }
         listener = listener->next;
     }
@@ -503,6 +567,7 @@ static ssize_t _well_known_core_handler(coap_pkt_t* pdu, uint8_t *buf, size_t le
     return plen;
 }
 
+#if !IS_USED(MODULE_GCOAP_OBS_FANOUT)
 /*
  * Find registered observer for a remote address and port.
  *
@@ -592,6 +657,254 @@ static void _find_obs_memo_resource(gcoap_observe_memo_t **memo,
         }
     }
 }
+#endif /* !IS_USED(MODULE_GCOAP_OBS_FANOUT) */
+
+#if IS_USED(MODULE_GCOAP_OBS_FANOUT)
+/*
+ * Hash bucket for the registration of an endpoint for a resource.
+ */
+static unsigned _obs_bucket(const coap_resource_t *resource,
+                            const sock_udp_ep_t *remote)
+{
+    const uint8_t *addr = remote->addr.ipv4;
+    size_t addr_len = sizeof(remote->addr.ipv4);
+    uint32_t hash = (uintptr_t)resource ^ remote->port;
+
+#ifdef SOCK_HAS_IPV6
+    if (remote->family == AF_INET6) {
+        addr = remote->addr.ipv6;
+        addr_len = sizeof(remote->addr.ipv6);
+    }
+#endif
+    for (size_t i = 0; i < addr_len; i++) {
+        hash = (hash * 33) ^ addr[i];
+    }
+    return hash % CONFIG_GCOAP_OBS_BUCKETS;
+}
+
+/*
+ * Find the registration of an endpoint for a resource.
+ *
+ * Caller must hold _obs_lock.
+ *
+ * return Link to the registration, or the NULL link at the end of its bucket
+ *        if not found
+ */
+static gcoap_obs_entry_t **_obs_find(const coap_resource_t *resource,
+                                     const sock_udp_ep_t *remote)
+{
+    gcoap_obs_entry_t **entry = &_obs_buckets[_obs_bucket(resource, remote)];
+
+    while ((*entry != NULL) &&
+           (((*entry)->resource != resource) ||
+            !sock_udp_ep_equal(&(*entry)->observer, remote))) {
+        entry = &(*entry)->next;
+    }
+    return entry;
+}
+
+/*
+ * Registers or deregisters an observer as requested by the Observe option.
+ * If the registration fails, the Observe option is cleared so the response
+ * does not include it.
+ *
+ * return 0 on success or if no Observe option, -1 on a bogus Observe value
+ */
+static int _obs_register(coap_pkt_t *pdu, const sock_udp_ep_t *remote,
+                         const coap_resource_t *resource)
+{
+    uint32_t observe = coap_get_observe(pdu);
+    gcoap_obs_entry_t **link, *entry;
+
+    if (!coap_has_observe(pdu)) {
+        return 0;
+    }
+    if ((observe != COAP_OBS_REGISTER) && (observe != COAP_OBS_DEREGISTER)) {
+        DEBUG("gcoap: Observe value unexpected: %" PRIu32 "\n", observe);
+        return -1;
+    }
+
+    mutex_lock(&_obs_lock);
+    link = _obs_find(resource, remote);
+    entry = *link;
+    if (observe == COAP_OBS_REGISTER) {
+        if (entry == NULL) {
+            /* append, so a notification in progress does not miss the
+             * entries after it */
+            entry = memarray_alloc(&_obs_pool);
+            if (entry != NULL) {
+                entry->next = NULL;
+                entry->resource = resource;
+                entry->pending = false;
+                memcpy(&entry->observer, remote, sizeof(sock_udp_ep_t));
+                *link = entry;
+            }
+        }
+        if (entry != NULL) {
+            /* a re-registration may use a new token */
+            entry->token_len = coap_get_token_len(pdu);
+            memcpy(entry->token, pdu->token, entry->token_len);
+            DEBUG("gcoap: Registered observer for: %s\n", resource->path);
+        }
+        else {
+            coap_clear_observe(pdu);
+            DEBUG("gcoap: can't register observer\n");
+        }
+    }
+    else {
+        if (entry != NULL) {
+            DEBUG("gcoap: Deregistering observer for: %s\n", resource->path);
+            *link = entry->next;
+            memarray_free(&_obs_pool, entry);
+        }
+        coap_clear_observe(pdu);
+    }
+    mutex_unlock(&_obs_lock);
+
+    return 0;
+}
+
+/*
+ * Time to wait until the next notification may be sent. If none, the
+ * notification is accounted for.
+ *
+ * Caller must hold _obs_notify_lock.
+ *
+ * return Time to wait in usec, or 0 if the notification may be sent now
+ */
+static uint32_t _obs_pace(void)
+{
+#if CONFIG_GCOAP_OBS_NOTIFY_RATE
+    /* generic cell rate algorithm: allows the notification if it is not
+     * earlier than the burst ahead of its theoretical arrival time */
+    const uint32_t interval = US_PER_SEC / CONFIG_GCOAP_OBS_NOTIFY_RATE;
+    const uint32_t tolerance = (CONFIG_GCOAP_OBS_NOTIFY_BURST - 1) * interval;
+    uint32_t now = xtimer_now_usec();
+
+    if ((int32_t)(_obs_tat - now) < 0) {
+        _obs_tat = now;
+    }
+    if ((_obs_tat - now) > tolerance) {
+        return _obs_tat - now - tolerance;
+    }
+    _obs_tat += interval;
+#endif
+    return 0;
+}
+#endif /* IS_USED(MODULE_GCOAP_OBS_FANOUT) */
+
+#if IS_USED(MODULE_GCOAP_WORKERS)
+/*
+ * Find the limit for a resource.
+ *
+ * return the limit, or NULL if the resource has none
+ */
+static _worker_limit_t *_find_worker_limit(const coap_resource_t *resource)
+{
+    for (unsigned i = 0; i < CONFIG_GCOAP_WORKER_LIMITS_MAX; i++) {
+        if (_worker_limits[i].resource == resource) {
+            return &_worker_limits[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Queues a request for the worker pool. Runs on the gcoap thread, after the
+ * Observe registration was handled.
+ *
+ * return 0 if the request was queued,
+ *        length of the 5.03 response in buf if the request was rejected,
+ *        -1 if the gcoap thread shall handle the request itself
+ */
+static ssize_t _queue_req(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                          sock_udp_ep_t *remote,
+                          const coap_resource_t *resource)
+{
+    _worker_job_t *job = NULL;
+    _worker_limit_t *limit;
+    msg_t msg;
+
+    mutex_lock(&_coap_state.lock);
+    limit = _find_worker_limit(resource);
+    if ((limit != NULL) && (limit->max == 0)) {
+        mutex_unlock(&_coap_state.lock);
+        return -1;
+    }
+    if ((limit == NULL) || (limit->active < limit->max)) {
+        for (unsigned i = 0; i < CONFIG_GCOAP_WORKER_QUEUE_SIZE; i++) {
+            if (_worker_jobs[i].resource == NULL) {
+                job = &_worker_jobs[i];
+                job->resource = resource;
+                job->limit = limit;
+                if (limit != NULL) {
+                    limit->active++;
+                }
+                break;
+            }
+        }
+    }
+    mutex_unlock(&_coap_state.lock);
+
+    if (job == NULL) {
+        DEBUG("gcoap: no worker for %s\n", resource->path);
+        return gcoap_response(pdu, buf, len, COAP_CODE_SERVICE_UNAVAILABLE);
+    }
+
+    /* only the received part of buf is of interest */
+    memcpy(job->buf, buf, (pdu->payload - buf) + pdu->payload_len);
+    memcpy(&job->remote, remote, sizeof(sock_udp_ep_t));
+    job->pdu = *pdu;
+    job->pdu.hdr = (coap_hdr_t *)job->buf;
+    job->pdu.token = job->buf + (pdu->token - buf);
+    job->pdu.payload = job->buf + (pdu->payload - buf);
+
+    msg.content.ptr = job;
+    /* there are never more jobs than the mbox can hold */
+    mbox_put(&_worker_mbox, &msg);
+    return 0;
+}
+
+/* Worker thread: calls the resource handler and sends the response. */
+static void *_worker(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        msg_t msg;
+        _worker_job_t *job;
+        const coap_resource_t *resource;
+
+        mbox_get(&_worker_mbox, &msg);
+        job = msg.content.ptr;
+        resource = job->resource;
+
+        ssize_t pdu_len = resource->handler(&job->pdu, job->buf,
+                                            sizeof(job->buf),
+                                            resource->context);
+        if (pdu_len < 0) {
+            pdu_len = gcoap_response(&job->pdu, job->buf, sizeof(job->buf),
+                                     COAP_CODE_INTERNAL_SERVER_ERROR);
+        }
+        if (pdu_len > 0) {
+            ssize_t bytes = sock_udp_send(&_sock, job->buf, pdu_len,
+                                          &job->remote);
+            if (bytes <= 0) {
+                DEBUG("gcoap: send response failed: %d\n", (int)bytes);
+            }
+        }
+
+        mutex_lock(&_coap_state.lock);
+        if (job->limit != NULL) {
+            job->limit->active--;
+        }
+        job->resource = NULL;
+        mutex_unlock(&_coap_state.lock);
+    }
+
+    return NULL;
+}
+#endif
 
 /*
  * gcoap interface functions
@@ -602,14 +915,25 @@ kernel_pid_t gcoap_init(void)
     if (_pid != KERNEL_PID_UNDEF) {
         return -EEXIST;
     }
+#if IS_USED(MODULE_GCOAP_WORKERS)
+    /* the workers must be ready before gcoap receives the first request */
+    mbox_init(&_worker_mbox, _worker_queue, CONFIG_GCOAP_WORKER_QUEUE_SIZE);
+    for (unsigned i = 0; i < CONFIG_GCOAP_WORKERS_NUMOF; i++) {
+        thread_create(_worker_stacks[i], sizeof(_worker_stacks[i]),
+                      GCOAP_WORKER_PRIO, THREAD_CREATE_STACKTEST, _worker,
+                      NULL, "coap_worker");
+    }
+#endif
     _pid = thread_create(_msg_stack, sizeof(_msg_stack), THREAD_PRIORITY_MAIN - 1,
                             THREAD_CREATE_STACKTEST, _event_loop, NULL, "coap");
 
     mutex_init(&_coap_state.lock);
     /* Blank lists so we know if an entry is available. */
     memset(&_coap_state.open_reqs[0], 0, sizeof(_coap_state.open_reqs));
+#if !IS_USED(MODULE_GCOAP_OBS_FANOUT)
     memset(&_coap_state.observers[0], 0, sizeof(_coap_state.observers));
     memset(&_coap_state.observe_memos[0], 0, sizeof(_coap_state.observe_memos));
+#endif
     memset(&_coap_state.resend_bufs[0], 0, sizeof(_coap_state.resend_bufs));
     /* randomize initial value */
     atomic_init(&_coap_state.next_message_id, (unsigned)random_uint32());
@@ -832,6 +1156,31 @@ int gcoap_resp_init(coap_pkt_t *pdu, uint8_t *buf, size_t len, unsigned code)
 int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
                                                   const coap_resource_t *resource)
 {
+    uint8_t *token;
+    size_t token_len;
+
+#if IS_USED(MODULE_GCOAP_OBS_FANOUT)
+    bool observed = false;
+
+    mutex_lock(&_obs_lock);
+    for (unsigned i = 0; !observed && (i < CONFIG_GCOAP_OBS_BUCKETS); i++) {
+        for (gcoap_obs_entry_t *entry = _obs_buckets[i]; entry != NULL;
+             entry = entry->next) {
+            if (entry->resource == resource) {
+                observed = true;
+                break;
+            }
+        }
+    }
+    mutex_unlock(&_obs_lock);
+    if (!observed) {
+        /* Unique return value to specify there is not an observer */
+        return GCOAP_OBS_INIT_UNUSED;
+    }
+    /* token is written for every observer by gcoap_obs_notify_all() */
+    token = NULL;
+    token_len = 0;
+#else
     gcoap_observe_memo_t *memo = NULL;
 
     _find_obs_memo_resource(&memo, resource);
@@ -839,11 +1188,14 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
         /* Unique return value to specify there is not an observer */
         return GCOAP_OBS_INIT_UNUSED;
     }
+    token = &memo->token[0];
+    token_len = memo->token_len;
+#endif
 
     pdu->hdr       = (coap_hdr_t *)buf;
     uint16_t msgid = (uint16_t)atomic_fetch_add(&_coap_state.next_message_id, 1);
-    ssize_t hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, &memo->token[0],
-                                    memo->token_len, COAP_CODE_CONTENT, msgid);
+    ssize_t hdrlen = coap_build_hdr(pdu->hdr, COAP_TYPE_NON, token, token_len,
+                                    COAP_CODE_CONTENT, msgid);
 
     if (hdrlen > 0) {
         coap_pkt_init(pdu, buf, len - CONFIG_GCOAP_OBS_OPTIONS_BUF, hdrlen);
@@ -863,6 +1215,9 @@ int gcoap_obs_init(coap_pkt_t *pdu, uint8_t *buf, size_t len,
 size_t gcoap_obs_send(const uint8_t *buf, size_t len,
                       const coap_resource_t *resource)
 {
+#if IS_USED(MODULE_GCOAP_OBS_FANOUT)
+    return (gcoap_obs_notify_all(buf, len, resource) > 0) ? len : 0;
+#else
     gcoap_observe_memo_t *memo = NULL;
 
     _find_obs_memo_resource(&memo, resource);
@@ -874,7 +1229,121 @@ size_t gcoap_obs_send(const uint8_t *buf, size_t len,
     else {
         return 0;
     }
+#endif
+}
+
+#if IS_USED(MODULE_GCOAP_OBS_FANOUT)
+void gcoap_obs_pool_init(gcoap_obs_entry_t *entries, size_t numof)
+{
+    mutex_lock(&_obs_lock);
+    memarray_init(&_obs_pool, entries, sizeof(gcoap_obs_entry_t), numof);
+    mutex_unlock(&_obs_lock);
+}
+
+int gcoap_obs_notify_all(const uint8_t *buf, size_t len,
+                         const coap_resource_t *resource)
+{
+    const coap_hdr_t *hdr = (const coap_hdr_t *)buf;
+    size_t hdr_len;
+    int numof = 0;
+
+    if (len > CONFIG_GCOAP_PDU_BUF_SIZE) {
+        return -EMSGSIZE;
+    }
+    if (len < sizeof(coap_hdr_t)) {
+        return -EINVAL;
+    }
+    hdr_len = sizeof(coap_hdr_t) + (hdr->ver_t_tkl & 0xf);
+    if ((hdr_len > len) || (hdr_len > OBS_BODY_OFFSET)) {
+        return -EINVAL;
+    }
+
+    mutex_lock(&_obs_notify_lock);
+    /* options and payload are the same for every observer */
+    memcpy(&_obs_buf[OBS_BODY_OFFSET], buf + hdr_len, len - hdr_len);
+    len -= hdr_len;
+
+    for (unsigned i = 0; i < CONFIG_GCOAP_OBS_BUCKETS; i++) {
+        gcoap_obs_entry_t *entry;
+
+        mutex_lock(&_obs_lock);
+        /* mark the observers to notify, so they are found again if the
+         * bucket changes while pacing */
+        for (entry = _obs_buckets[i]; entry != NULL; entry = entry->next) {
+            entry->pending = (entry->resource == resource);
+        }
+        entry = _obs_buckets[i];
+        while (entry != NULL) {
+            if (!entry->pending) {
+                entry = entry->next;
+                continue;
+            }
+
+            uint32_t delay = _obs_pace();
+            if (delay > 0) {
+                /* don't keep the gcoap thread from (de)registering */
+                mutex_unlock(&_obs_lock);
+                xtimer_usleep(delay);
+                mutex_lock(&_obs_lock);
+                /* entry might be deregistered meanwhile */
+                entry = _obs_buckets[i];
+                continue;
+            }
+
+            /* write header and token right before the options */
+            uint8_t *start = &_obs_buf[OBS_BODY_OFFSET - sizeof(coap_hdr_t) -
+                                       entry->token_len];
+            uint16_t msgid = (uint16_t)atomic_fetch_add(
+                    &_coap_state.next_message_id, 1
+                );
+            ssize_t res = coap_build_hdr((coap_hdr_t *)start, COAP_TYPE_NON,
+                                         entry->token, entry->token_len,
+                                         hdr->code, msgid);
+
+            res = sock_udp_send(&_sock, start, res + len, &entry->observer);
+            if (res > 0) {
+                numof++;
+            }
+            else {
+                DEBUG("gcoap: sock send failed: %d\n", (int)res);
+            }
+            entry->pending = false;
+            entry = entry->next;
+        }
+        mutex_unlock(&_obs_lock);
+    }
+    mutex_unlock(&_obs_notify_lock);
+
+    return numof;
 }
+#endif
+
+#if IS_USED(MODULE_GCOAP_WORKERS)
+int gcoap_worker_limit(const coap_resource_t *resource, unsigned max)
+{
+    _worker_limit_t *limit;
+    int res = 0;
+
+    mutex_lock(&_coap_state.lock);
+    limit = _find_worker_limit(resource);
+    if (limit == NULL) {
+        /* find an unused entry */
+        limit = _find_worker_limit(NULL);
+    }
+    if (limit != NULL) {
+        if (limit->resource != resource) {
+            limit->resource = resource;
+            limit->active = 0;
+        }
+        limit->max = (max > UINT8_MAX) ? UINT8_MAX : max;
+    }
+    else {
+        res = -ENOMEM;
+    }
+    mutex_unlock(&_coap_state.lock);
+    return res;
+}
+#endif
 
 uint8_t gcoap_op_state(void)
 {
@@ -0,0 +1,621 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_nanocoap_blockwise
+ * @{
+ *
+ * @file
+ * @brief       Streaming block-wise transfers with nanocoap
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "bitarithm.h"
+#include "net/nanocoap_blockwise.h"
+#include "random.h"
+#include "xtimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Content-Format and Block2 option of a response, payload marker */
+#define REPLY_OPTS_MAX      (3 + 4 + 1)
+/* Block1 option behind the Uri-Path of a request, payload marker */
+#define BLOCK1_OPT_MAX      (1 + 1 + 3 + 1)
+/* the token of a request is the number of its block */
+#define TOKEN_LEN           (sizeof(uint32_t))
+#define ACK_TIMEOUT_US (CONFIG_NANOCOAP_BLOCKWISE_ACK_TIMEOUT_MS * US_PER_MS)
+/* time to wait for a separate response after an empty ACK */
+#define SEPARATE_TIMEOUT_US (ACK_TIMEOUT_US << COAP_MAX_RETRANSMIT)
+
+enum {
+    SLOT_FREE = 0,
+    SLOT_SENT,          /* waiting for the response or an empty ACK */
+    SLOT_ACKED,         /* waiting for the separate response */
+    SLOT_RECEIVED,      /* block received before the blocks in front of it */
+    SLOT_FAILED,        /* error response, reported when the block is due */
+};
+
+/* state of a request in flight */
+typedef struct {
+    uint32_t deadline;  /* of the response in µs */
+    uint32_t timeout;   /* retransmission timeout in µs */
+    uint16_t id;        /* message ID */
+    uint16_t len;       /* payload length, or code of an error response */
+    uint8_t tries_left;
+    uint8_t state;
+} _slot_t;
+
+typedef struct {
+    sock_udp_t sock;
+    const char *path;
+    uint8_t *buf;       /* one message, see NANOCOAP_BLOCKWISE_BUF_SIZE() */
+    size_t len;
+    uint16_t next_id;
+    unsigned szx;
+} _client_t;
+
+static int _szx(size_t blksize)
+{
+    if ((blksize < 16) || (blksize > 1024) || (blksize & (blksize - 1))) {
+        return -EINVAL;
+    }
+    return bitarithm_lsb(blksize) - 4;
+}
+
+static int _client_init(_client_t *c, const sock_udp_ep_t *remote,
+                        const char *path, size_t blksize, uint8_t *buf)
+{
+    sock_udp_ep_t ep = *remote;
+
+    if (!ep.port) {
+        ep.port = COAP_PORT;
+    }
+    c->path = path;
+    c->buf = buf;
+    c->len = NANOCOAP_BLOCKWISE_BUF_SIZE(blksize, 0);
+    c->next_id = random_uint32();
+    c->szx = _szx(blksize);
+
+    return sock_udp_create(&c->sock, NULL, &ep, 0);
+}
+
+static void _slot_start(_client_t *c, _slot_t *slot, uint32_t now)
+{
+    slot->id = c->next_id++;
+    slot->timeout = ACK_TIMEOUT_US;
+    slot->deadline = now + slot->timeout;
+    slot->tries_left = COAP_MAX_RETRANSMIT;
+    slot->state = SLOT_SENT;
+}
+
+static int _slot_retry(_slot_t *slot, uint32_t now)
+{
+    if ((slot->state == SLOT_ACKED) || (slot->tries_left == 0)) {
+        DEBUG("nanocoap_blockwise: timeout of request %u\n", slot->id);
+        return -ETIMEDOUT;
+    }
+    slot->tries_left--;
+    slot->timeout *= 2;
+    slot->deadline = now + slot->timeout;
+    return 0;
+}
+
+static void _slot_acked(_slot_t *slot, uint32_t now)
+{
+    slot->state = SLOT_ACKED;
+    slot->deadline = now + SEPARATE_TIMEOUT_US;
+}
+
+static bool _slot_waiting(const _slot_t *slot)
+{
+    return (slot->state == SLOT_SENT) || (slot->state == SLOT_ACKED);
+}
+
+static ssize_t _init_req(_client_t *c, coap_pkt_t *pkt, unsigned method,
+                         uint16_t id, uint32_t blknum)
+{
+    ssize_t hdr_len = coap_build_hdr((coap_hdr_t *)c->buf, COAP_TYPE_CON,
+                                     (uint8_t *)&blknum, TOKEN_LEN, method,
+                                     id);
+
+    coap_pkt_init(pkt, c->buf, c->len, hdr_len);
+    return coap_opt_add_string(pkt, COAP_OPT_URI_PATH, c->path, '/');
+}
+
+static ssize_t _send_block2_req(_client_t *c, uint16_t id, uint32_t blknum)
+{
+    coap_pkt_t pkt;
+    coap_block1_t block = { .blknum = blknum, .szx = c->szx };
+    ssize_t res = _init_req(c, &pkt, COAP_METHOD_GET, id, blknum);
+
+    if (res >= 0) {
+        res = coap_opt_add_block2_control(&pkt, &block);
+    }
+    if (res >= 0) {
+        res = sock_udp_send(&c->sock, c->buf,
+                            coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE), NULL);
+    }
+    return res;
+}
+
+/* returns the length of the payload of the request */
+static ssize_t _send_block1_req(_client_t *c, unsigned method, uint16_t id,
+                                uint32_t blknum, size_t offset,
+                                nanocoap_blockwise_read_cb_t read_cb,
+                                void *arg, bool *more)
+{
+    coap_pkt_t pkt;
+    size_t blksize = coap_szx2size(c->szx);
+    ssize_t res = _init_req(c, &pkt, method, id, blknum);
+
+    if (res < 0) {
+        return res;
+    }
+    if (pkt.payload_len < BLOCK1_OPT_MAX + blksize + 1) {
+        return -ENOBUFS;
+    }
+
+    /* the length of the Block1 option depends on the payload, so it is read
+     * behind the space for the option first */
+    uint8_t *data = pkt.payload + BLOCK1_OPT_MAX;
+    ssize_t data_len = read_cb(arg, offset, data, blksize + 1);
+
+    if (data_len < 0) {
+        return data_len;
+    }
+    *more = ((size_t)data_len > blksize);
+    if (*more) {
+        data_len = blksize;
+    }
+
+    coap_block1_t block = { .blknum = blknum, .szx = c->szx, .more = *more };
+
+    coap_opt_add_block1_control(&pkt, &block);
+    if (data_len) {
+        coap_opt_finish(&pkt, COAP_OPT_FINISH_PAYLOAD);
+        memmove(pkt.payload, data, data_len);
+    }
+    else {
+        coap_opt_finish(&pkt, COAP_OPT_FINISH_NONE);
+    }
+
+    res = sock_udp_send(&c->sock, c->buf,
+                        (pkt.payload - c->buf) + data_len, NULL);
+    return (res < 0) ? res : data_len;
+}
+
+static void _send_ack(_client_t *c, uint16_t id)
+{
+    coap_hdr_t hdr;
+
+    coap_build_hdr(&hdr, COAP_TYPE_ACK, NULL, 0, COAP_CODE_EMPTY, id);
+    sock_udp_send(&c->sock, &hdr, sizeof(hdr), NULL);
+}
+
+static bool _get_token(coap_pkt_t *pkt, uint32_t *blknum)
+{
+    if (coap_get_token_len(pkt) != TOKEN_LEN) {
+        return false;
+    }
+    memcpy(blknum, pkt->token, TOKEN_LEN);
+    return true;
+}
+
+/* returns if more blocks follow, or -EBADMSG */
+static int _check_block2(_client_t *c, coap_pkt_t *pkt, uint32_t blknum)
+{
+    coap_block1_t block2;
+
+    if (!coap_get_block2(pkt, &block2)) {
+        /* the server sent the whole payload at once */
+        return (blknum == 0) ? 0 : -EBADMSG;
+    }
+    if ((blknum == 0) && (block2.blknum == 0) && (block2.szx < c->szx)) {
+        /* the server chose smaller blocks */
+        c->szx = block2.szx;
+    }
+    if ((block2.blknum != blknum) || (block2.szx != c->szx)) {
+        return -EBADMSG;
+    }
+
+    size_t blksize = coap_szx2size(c->szx);
+
+    if ((pkt->payload_len > blksize) ||
+        (block2.more && (pkt->payload_len != blksize))) {
+        return -EBADMSG;
+    }
+    return block2.more;
+}
+
+ssize_t nanocoap_blockwise_get(const sock_udp_ep_t *remote, const char *path,
+                               size_t blksize, unsigned window,
+                               uint8_t *buf, size_t len,
+                               nanocoap_blockwise_write_cb_t write_cb,
+                               void *arg)
+{
+    _client_t c;
+    _slot_t slots[CONFIG_NANOCOAP_BLOCKWISE_WINDOW_MAX];
+    /* blocks received out of order, one per slot */
+    uint8_t *blocks = buf + NANOCOAP_BLOCKWISE_BUF_SIZE(blksize, 0);
+    /* next block to write, next block to request and the last block */
+    uint32_t next = 0, sent = 0, last = UINT32_MAX;
+    /* only the first block is requested until its response tells the block
+     * size and if there are more blocks */
+    unsigned open = 1;
+    size_t total = 0;
+    ssize_t res;
+
+    if ((_szx(blksize) < 0) || (window == 0) ||
+        (window > CONFIG_NANOCOAP_BLOCKWISE_WINDOW_MAX)) {
+        return -EINVAL;
+    }
+    if (len < NANOCOAP_BLOCKWISE_BUF_SIZE(blksize, window)) {
+        return -ENOBUFS;
+    }
+    res = _client_init(&c, remote, path, blksize, buf);
+    if (res < 0) {
+        return res;
+    }
+    memset(slots, 0, sizeof(slots));
+
+    while (next <= last) {
+        uint32_t now = xtimer_now_usec();
+        uint32_t timeout = UINT32_MAX;
+        coap_pkt_t pkt;
+        _slot_t *slot;
+        uint32_t blknum;
+
+        while (((sent - next) < open) && (sent <= last)) {
+            slot = &slots[sent % window];
+            _slot_start(&c, slot, now);
+            res = _send_block2_req(&c, slot->id, sent);
+            if (res < 0) {
+                goto out;
+            }
+            sent++;
+        }
+
+        /* retransmit the requests that timed out, wait until the next
+         * deadline for responses */
+        for (blknum = next; (blknum < sent) && (blknum <= last); blknum++) {
+            slot = &slots[blknum % window];
+            if (!_slot_waiting(slot)) {
+                continue;
+            }
+            if ((int32_t)(slot->deadline - now) <= 0) {
+                res = _slot_retry(slot, now);
+                if (res == 0) {
+                    res = _send_block2_req(&c, slot->id, blknum);
+                }
+                if (res < 0) {
+                    goto out;
+                }
+            }
+            if ((slot->deadline - now) < timeout) {
+                timeout = slot->deadline - now;
+            }
+        }
+
+        res = sock_udp_recv(&c.sock, c.buf, c.len, timeout, NULL);
+        if ((res == -ETIMEDOUT) || (res == -EAGAIN)) {
+            continue;
+        }
+        if (res < 0) {
+            goto out;
+        }
+        if (coap_parse(&pkt, c.buf, res) < 0) {
+            DEBUG("nanocoap_blockwise: error parsing packet\n");
+            continue;
+        }
+
+        if (coap_get_code_raw(&pkt) == COAP_CODE_EMPTY) {
+            for (blknum = next; blknum < sent; blknum++) {
+                slot = &slots[blknum % window];
+                if ((slot->state != SLOT_SENT) ||
+                    (slot->id != coap_get_id(&pkt))) {
+                    continue;
+                }
+                if (coap_get_type(&pkt) == COAP_TYPE_RST) {
+                    res = -ECONNRESET;
+                    goto out;
+                }
+                if (coap_get_type(&pkt) == COAP_TYPE_ACK) {
+                    _slot_acked(slot, xtimer_now_usec());
+                }
+            }
+            continue;
+        }
+        if (coap_get_type(&pkt) == COAP_TYPE_CON) {
+            /* acknowledge separate responses, also if repeated */
+            _send_ack(&c, coap_get_id(&pkt));
+        }
+        if (!_get_token(&pkt, &blknum) || (blknum < next) ||
+            (blknum >= sent) || (blknum > last)) {
+            continue;
+        }
+        slot = &slots[blknum % window];
+        if (!_slot_waiting(slot)) {
+            continue;
+        }
+
+        if (coap_get_code_class(&pkt) != COAP_CLASS_SUCCESS) {
+            /* an error for a block behind the last one is no error */
+            slot->state = SLOT_FAILED;
+            slot->len = coap_get_code(&pkt);
+        }
+        else {
+            int more = _check_block2(&c, &pkt, blknum);
+
+            if (more < 0) {
+                res = more;
+                goto out;
+            }
+            if (!more) {
+                last = blknum;
+            }
+            if (blknum == 0) {
+                blksize = coap_szx2size(c.szx);
+                open = window;
+            }
+            if (blknum == next) {
+                res = write_cb(arg, total, pkt.payload, pkt.payload_len,
+                               more);
+                if (res < 0) {
+                    goto out;
+                }
+                total += pkt.payload_len;
+                slot->state = SLOT_FREE;
+                next++;
+            }
+            else {
+                memcpy(blocks + ((blknum % window) * blksize), pkt.payload,
+                       pkt.payload_len);
+                slot->len = pkt.payload_len;
+                slot->state = SLOT_RECEIVED;
+            }
+        }
+
+        /* write the blocks that arrived early and are due now */
+        while ((next < sent) && (next <= last)) {
+            slot = &slots[next % window];
+            if (slot->state == SLOT_FAILED) {
+                res = -(ssize_t)slot->len;
+                goto out;
+            }
+            if (slot->state != SLOT_RECEIVED) {
+                break;
+            }
+            res = write_cb(arg, total, blocks + ((next % window) * blksize),
+                           slot->len, next != last);
+            if (res < 0) {
+                goto out;
+            }
+            total += slot->len;
+            slot->state = SLOT_FREE;
+            next++;
+        }
+    }
+    res = total;
+
+out:
+    sock_udp_close(&c.sock);
+    return res;
+}
+
+ssize_t nanocoap_blockwise_upload(const sock_udp_ep_t *remote,
+                                  const char *path, unsigned method,
+                                  size_t blksize, uint8_t *buf, size_t len,
+                                  nanocoap_blockwise_read_cb_t read_cb,
+                                  void *arg)
+{
+    _client_t c;
+    _slot_t slot;
+    uint32_t blknum = 0;
+    size_t offset = 0;
+    bool more = true;
+    ssize_t res;
+
+    if (_szx(blksize) < 0) {
+        return -EINVAL;
+    }
+    if (len < NANOCOAP_BLOCKWISE_BUF_SIZE(blksize, 0)) {
+        return -ENOBUFS;
+    }
+    res = _client_init(&c, remote, path, blksize, buf);
+    if (res < 0) {
+        return res;
+    }
+
+    while (more) {
+        coap_pkt_t pkt;
+        coap_block1_t block1;
+        ssize_t data_len;
+        uint32_t token;
+
+        _slot_start(&c, &slot, xtimer_now_usec());
+        data_len = _send_block1_req(&c, method, slot.id, blknum, offset,
+                                    read_cb, arg, &more);
+        if (data_len < 0) {
+            res = data_len;
+            goto out;
+        }
+
+        while (1) {
+            uint32_t now = xtimer_now_usec();
+
+            if ((int32_t)(slot.deadline - now) <= 0) {
+                res = _slot_retry(&slot, now);
+                if (res == 0) {
+                    res = _send_block1_req(&c, method, slot.id, blknum, offset,
+                                           read_cb, arg, &more);
+                }
+                if (res < 0) {
+                    goto out;
+                }
+            }
+            res = sock_udp_recv(&c.sock, c.buf, c.len, slot.deadline - now,
+                                NULL);
+            if ((res == -ETIMEDOUT) || (res == -EAGAIN)) {
+                continue;
+            }
+            if (res < 0) {
+                goto out;
+            }
+            if (coap_parse(&pkt, c.buf, res) < 0) {
+                DEBUG("nanocoap_blockwise: error parsing packet\n");
+                continue;
+            }
+            if (coap_get_code_raw(&pkt) == COAP_CODE_EMPTY) {
+                if ((slot.state != SLOT_SENT) ||
+                    (slot.id != coap_get_id(&pkt))) {
+                    continue;
+                }
+                if (coap_get_type(&pkt) == COAP_TYPE_RST) {
+                    res = -ECONNRESET;
+                    goto out;
+                }
+                if (coap_get_type(&pkt) == COAP_TYPE_ACK) {
+                    _slot_acked(&slot, xtimer_now_usec());
+                }
+                continue;
+            }
+            if (coap_get_type(&pkt) == COAP_TYPE_CON) {
+                _send_ack(&c, coap_get_id(&pkt));
+            }
+            if (_get_token(&pkt, &token) && (token == blknum)) {
+                break;
+            }
+        }
+
+        if (coap_get_code_class(&pkt) != COAP_CLASS_SUCCESS) {
+            res = -(ssize_t)coap_get_code(&pkt);
+            goto out;
+        }
+        offset += data_len;
+        if (coap_get_block1(&pkt, &block1) && (block1.szx < c.szx)) {
+            /* the server asks for smaller blocks */
+            c.szx = block1.szx;
+        }
+        blknum = offset >> (c.szx + 4);
+    }
+    res = offset;
+
+out:
+    sock_udp_close(&c.sock);
+    return res;
+}
+
+ssize_t nanocoap_blockwise_reply(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                                 unsigned ct,
+                                 nanocoap_blockwise_read_cb_t read_cb,
+                                 void *arg)
+{
+    uint8_t *payload = buf + coap_get_total_hdr_len(pkt);
+    uint8_t *bufpos = payload;
+    uint32_t blknum;
+    unsigned szx;
+    size_t offset, blksize, room;
+    ssize_t data_len;
+
+    if (coap_get_blockopt(pkt, COAP_OPT_BLOCK2, &blknum, &szx) < 0) {
+        szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
+    }
+    offset = blknum << (szx + 4);
+    if (szx > NANOCOAP_BLOCK_SIZE_EXP_MAX - 4) {
+        szx = NANOCOAP_BLOCK_SIZE_EXP_MAX - 4;
+    }
+
+    /* the options, the block and a byte to learn if more blocks follow */
+    if (len < (size_t)(payload - buf) + REPLY_OPTS_MAX + 1) {
+        return -ENOSPC;
+    }
+    room = len - (payload - buf) - REPLY_OPTS_MAX - 1;
+    while ((coap_szx2size(szx) > room) && (szx > 0)) {
+        szx--;
+    }
+    blksize = coap_szx2size(szx);
+    if (blksize > room) {
+        return coap_build_reply(pkt, COAP_CODE_INTERNAL_SERVER_ERROR, buf,
+                                len, 0);
+    }
+    /* the offset of the block in the request is kept if the block is
+     * smaller */
+    blknum = offset >> (szx + 4);
+
+    /* the length of the Block2 option depends on the payload, so it is read
+     * behind the space for the options first */
+    data_len = read_cb(arg, offset, payload + REPLY_OPTS_MAX, blksize + 1);
+    if (data_len < 0) {
+        return coap_build_reply(pkt, COAP_CODE_INTERNAL_SERVER_ERROR, buf,
+                                len, 0);
+    }
+    if ((data_len == 0) && (offset > 0)) {
+        /* the block is behind the end of the payload */
+        return coap_build_reply(pkt, COAP_CODE_BAD_OPTION, buf, len, 0);
+    }
+
+    bool more = ((size_t)data_len > blksize);
+
+    if (more) {
+        data_len = blksize;
+    }
+    bufpos += coap_put_option_ct(bufpos, 0, ct);
+    bufpos += coap_opt_put_uint(bufpos, COAP_OPT_CONTENT_FORMAT,
+                                COAP_OPT_BLOCK2,
+                                (blknum << 4) | (more ? 0x8 : 0) | szx);
+    if (data_len) {
+        *bufpos++ = 0xff;
+        memmove(bufpos, payload + REPLY_OPTS_MAX, data_len);
+    }
+
+    return coap_build_reply(pkt, COAP_CODE_CONTENT, buf, len,
+                            (bufpos - payload) + data_len);
+}
+
+ssize_t nanocoap_blockwise_recv(coap_pkt_t *pkt, uint8_t *buf, size_t len,
+                                size_t *offset,
+                                nanocoap_blockwise_write_cb_t write_cb,
+                                void *arg)
+{
+    uint8_t *payload = buf + coap_get_total_hdr_len(pkt);
+    uint8_t *bufpos = payload;
+    coap_block1_t block1;
+    bool blockwise = coap_get_block1(pkt, &block1);
+    bool more = blockwise && (block1.more == 1);
+    unsigned code = more ? COAP_CODE_CONTINUE : COAP_CODE_CHANGED;
+
+    if (block1.offset == 0) {
+        *offset = 0;
+    }
+    if (block1.offset > *offset) {
+        /* a block in front of this one is missing */
+        code = COAP_CODE_REQUEST_ENTITY_INCOMPLETE;
+    }
+    else if (block1.offset == *offset) {
+        if (write_cb(arg, *offset, pkt->payload, pkt->payload_len, more) < 0) {
+            code = COAP_CODE_INTERNAL_SERVER_ERROR;
+        }
+        else {
+            *offset += pkt->payload_len;
+        }
+    }
+    /* else a repeated block, which is answered again but not written */
+
+    /* the response is written over the request, which was read already */
+    if (blockwise && ((code >> 5) == COAP_CLASS_SUCCESS)) {
+        bufpos += coap_put_option_block1(bufpos, 0, block1.blknum,
+                                         block1.szx, more);
+    }
+
+    return coap_build_reply(pkt, code, buf, len, bufpos - payload);
+}
@@ -163,6 +163,91 @@ int coap_match_path(const coap_resource_t *resource, uint8_t *uri)
     return res;
 }
 
+/* compares path to the first len characters of uri like strcmp() */
+static int _cmp_uri_prefix(const char *path, const uint8_t *uri, size_t len)
+{
+    int res = strncmp(path, (const char *)uri, len);
+
+    if ((res == 0) && (path[len] != '\0')) {
+        /* path continues after the prefix */
+        res = 1;
+    }
+    return res;
+}
+
+/* number of leading characters path and uri have in common */
+static size_t _common_prefix(const char *path, const uint8_t *uri)
+{
+    size_t len = 0;
+
+    while ((path[len] != '\0') && (path[len] == (char)uri[len])) {
+        len++;
+    }
+    return len;
+}
+
+int coap_find_resource(const coap_resource_t *resources,
+                       size_t resources_numof, const uint8_t *uri,
+                       coap_method_flags_t method_flag,
+                       const coap_resource_t **resource)
+{
+    size_t uri_len = strlen((const char *)uri);
+    size_t lo = 0;
+    int res = -ENOENT;
+
+    /* Only the paths that are a prefix of the URI, the URI itself included,
+     * can match. As the resources are sorted, the paths starting with the
+     * first len characters of the URI follow each other, starting with the
+     * shortest. Find the prefixes by binary search, from the shortest to the
+     * longest, as the first matching resource in the array wins. */
+    for (size_t len = 0; (len <= uri_len) && (lo < resources_numof);) {
+        size_t hi = resources_numof;
+        const char *path;
+        size_t common;
+
+        /* every path starts with the empty prefix, so start at the first */
+        while ((len > 0) && (lo < hi)) {
+            size_t mid = lo + ((hi - lo) / 2);
+
+            if (_cmp_uri_prefix(resources[mid].path, uri, len) < 0) {
+                lo = mid + 1;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        if (lo == resources_numof) {
+            break;
+        }
+        path = resources[lo].path;
+        common = _common_prefix(path, uri);
+        if (common < len) {
+            /* no path starts with the first len characters of the URI */
+            break;
+        }
+        if (path[common] == '\0') {
+            /* path is a prefix of the URI, check all resources with it */
+            bool exact = (common == uri_len);
+
+            for (; (lo < resources_numof) &&
+                   (strcmp(resources[lo].path, path) == 0); lo++) {
+                if (!exact && !(resources[lo].methods & COAP_MATCH_SUBTREE)) {
+                    continue;
+                }
+                if (resources[lo].methods & method_flag) {
+                    *resource = &resources[lo];
+                    return 0;
+                }
+                res = -EPERM;
+            }
+        }
+        /* no path shorter than common characters but longer than len
+         * characters is a prefix of the URI */
+        len = common + 1;
+    }
+    return res;
+}
+
 uint8_t *coap_find_option(const coap_pkt_t *pkt, unsigned opt_num)
 {
     const coap_optpos_t *optpos = pkt->options;
@@ -401,22 +486,10 @@ ssize_t coap_tree_handler(coap_pkt_t *pkt, uint8_t *resp_buf,
     }
     DEBUG("nanocoap: URI path: \"%s\"\n", uri);
 
-    for (unsigned i = 0; i < resources_numof; i++) {
-        const coap_resource_t *resource = &resources[i];
-        if (!(resource->methods & method_flag)) {
-            continue;
-        }
-
-        int res = coap_match_path(resource, uri);
-        if (res > 0) {
-            continue;
-        }
-        else if (res < 0) {
-            break;
-        }
-        else {
-            return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
-        }
+    const coap_resource_t *resource;
+    if (coap_find_resource(resources, resources_numof, uri, method_flag,
+                           &resource) == 0) {
+        return resource->handler(pkt, resp_buf, resp_buf_len, resource->context);
     }
 
     return coap_build_reply(pkt, COAP_CODE_404, resp_buf, resp_buf_len, 0);
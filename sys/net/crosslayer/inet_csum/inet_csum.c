@@ -14,12 +14,82 @@
 
 #include <inttypes.h>
 #include <stdio.h>
+#include "byteorder.h"
 #include "od.h"
 #include "net/inet_csum.h"
 
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
+/* 32-bit word accesses are used on 32-bit platforms, 64-bit ones otherwise */
+#if UINTPTR_MAX > UINT32_MAX
+typedef uint64_t _word_t;
+#else
+typedef uint32_t _word_t;
+#endif
+
+static inline uint32_t _fold(uint64_t sum)
+{
+    /* add carries back in until the sum fits into 16 bits */
+    while (sum >> 16) {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return (uint32_t)sum;
+}
+
+/**
+ * @brief   Sums @p len bytes of a 16-bit aligned @p buf up as 16-bit words in
+ *          host byte order (see RFC 1071, section 2 (B)) using the widest
+ *          word access available
+ *
+ * An odd trailing byte is padded as the upper half of a word in network byte
+ * order.
+ *
+ * @return  The sum folded to 16 bits in network byte order.
+ */
+static uint16_t _sum_aligned(const uint8_t *buf, size_t len)
+{
+    uint64_t sum = 0;
+    network_uint16_t res;
+
+    /* advance to alignment of the word type */
+    while ((len >= sizeof(uint16_t)) && ((uintptr_t)buf % sizeof(_word_t))) {
+        sum += *((const uint16_t *)buf);
+        buf += sizeof(uint16_t);
+        len -= sizeof(uint16_t);
+    }
+    /* with 32-bit halves of the words the sum can't overflow for the at most
+     * 2^32 words in a buffer */
+    for (; len >= (4 * sizeof(_word_t)); len -= 4 * sizeof(_word_t)) {
+        const _word_t *words = (const _word_t *)buf;
+
+        for (unsigned i = 0; i < 4; i++) {
+            sum += (uint32_t)words[i];
+#if UINTPTR_MAX > UINT32_MAX
+            sum += (uint32_t)(words[i] >> 32);
+#endif
+        }
+        buf += 4 * sizeof(_word_t);
+    }
+    for (; len >= sizeof(uint32_t); len -= sizeof(uint32_t)) {
+        sum += *((const uint32_t *)buf);
+        buf += sizeof(uint32_t);
+    }
+    if (len >= sizeof(uint16_t)) {
+        sum += *((const uint16_t *)buf);
+        buf += sizeof(uint16_t);
+        len -= sizeof(uint16_t);
+    }
+    res.u16 = _fold(sum);
+    /* the bytes of the folded sum are in network byte order now */
+    res.u16 = byteorder_ntohs(res);
+    if (len) {
+        /* add last byte as top half of 16-byte word */
+        return _fold(res.u16 + (uint32_t)(*buf << 8));
+    }
+    return res.u16;
+}
+
 uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t accum_len)
 {
     uint32_t csum = sum;
@@ -41,25 +111,41 @@ uint16_t inet_csum_slice(uint16_t sum, const uint8_t *buf, uint16_t len, size_t
         csum += *buf;         /* add first byte as bottom half of 16-byte word */
         buf++;
         len--;
-        accum_len++;
     }
 
-    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
-        csum += (uint16_t)(*buf << 8) + *(buf + 1); /* group bytes by 16-byte words */
-                                                    /* and add them */
+    if (len == 0) {
+        /* nothing left to sum up */
     }
+    else if ((uintptr_t)buf & 1) {
+        /* Summing up from the next 16-bit boundary with the first byte as
+         * bottom half of a word results in the byte-swapped sum (see RFC 1071,
+         * section 2 (B)) */
+        uint32_t swapped = *buf;
 
-    if ((accum_len + len) & 1)          /* if accumulated length is odd */
-        csum += (uint16_t)(*buf << 8);  /* add last byte as top half of 16-byte word */
-
-    while (csum >> 16) {
-        uint16_t carry = csum >> 16;
-        csum = (csum & 0xffff) + carry;
+        if (len > 1) {
+            swapped += _sum_aligned(buf + 1, len - 1);
+        }
+        csum += byteorder_swaps(_fold(swapped));
     }
+    else {
+        csum += _sum_aligned(buf, len);
+    }
+    csum = _fold(csum);
 
     DEBUG("inet_sum: new sum = 0x%04" PRIx32 "\n", csum);
 
     return csum;
 }
 
+uint16_t inet_csum_update(uint16_t csum, const uint8_t *old_data,
+                          const uint8_t *new_data, uint16_t len)
+{
+    /* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+    uint32_t sum = (uint16_t)~csum;
+
+    sum += (uint16_t)~inet_csum(0, old_data, len);
+    sum += inet_csum(0, new_data, len);
+    return (uint16_t)~_fold(sum);
+}
+
 /** @} */
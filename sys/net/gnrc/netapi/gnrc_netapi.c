@@ -81,56 +81,128 @@ static inline int _snd_rcv_mbox(mbox_t *mbox, uint16_t type, gnrc_pktsnip_t *pkt
 }
 #endif
 
-int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
-                         uint16_t cmd, gnrc_pktsnip_t *pkt)
+static void _dispatch(const gnrc_netreg_entry_t *sendto, uint16_t cmd,
+                      gnrc_pktsnip_t *pkt)
 {
-    int numof = gnrc_netreg_num(type, demux_ctx);
-
-    if (numof != 0) {
-        gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
-
-        gnrc_pktbuf_hold(pkt, numof - 1);
-
-        while (sendto) {
 #if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
-            uint32_t status = 0;
-            switch (sendto->type) {
-                case GNRC_NETREG_TYPE_DEFAULT:
-                    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt,
-                                               cmd) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
+    uint32_t status = 0;
+    switch (sendto->type) {
+        case GNRC_NETREG_TYPE_DEFAULT:
+            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+                /* unable to dispatch packet */
+                status = EIO;
+            }
+            break;
 #ifdef MODULE_GNRC_NETAPI_MBOX
-                case GNRC_NETREG_TYPE_MBOX:
-                    if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
-                        /* unable to dispatch packet */
-                        status = EIO;
-                    }
-                    break;
+        case GNRC_NETREG_TYPE_MBOX:
+            if (_snd_rcv_mbox(sendto->target.mbox, cmd, pkt) < 1) {
+                /* unable to dispatch packet */
+                status = EIO;
+            }
+            break;
 #endif
 #ifdef MODULE_GNRC_NETAPI_CALLBACKS
-                case GNRC_NETREG_TYPE_CB:
-                    sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
-                    break;
+        case GNRC_NETREG_TYPE_CB:
+            sendto->target.cbd->cb(cmd, pkt, sendto->target.cbd->ctx);
+            break;
 #endif
-                default:
-                    /* unknown dispatch type */
-                    status = ECANCELED;
-                    break;
-            }
-            if (status != 0) {
-                gnrc_pktbuf_release_error(pkt, status);
-            }
+        default:
+            /* unknown dispatch type */
+            status = ECANCELED;
+            break;
+    }
+    if (status != 0) {
+        gnrc_pktbuf_release_error(pkt, status);
+    }
 #else
-            if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
-                /* unable to dispatch packet */
-                gnrc_pktbuf_release_error(pkt, EIO);
+    if (_gnrc_netapi_send_recv(sendto->target.pid, pkt, cmd) < 1) {
+        /* unable to dispatch packet */
+        gnrc_pktbuf_release_error(pkt, EIO);
+    }
+#endif
+}
+
+static void _send_bulk(kernel_pid_t pid, uint16_t cmd, gnrc_pktsnip_t **pkts,
+                       unsigned num)
+{
+    msg_t msgs[GNRC_NETAPI_BULK_MAX];
+
+    while (num > 0) {
+        unsigned n = (num < GNRC_NETAPI_BULK_MAX) ? num : GNRC_NETAPI_BULK_MAX;
+        int sent;
+
+        for (unsigned i = 0; i < n; i++) {
+            msgs[i].type = cmd;
+            msgs[i].content.ptr = (void *)pkts[i];
+        }
+        sent = msg_send_bulk(msgs, n, pid);
+        if (sent < 0) {
+            sent = 0;
+        }
+        if ((unsigned)sent < n) {
+            DEBUG("gnrc_netapi: dropped %u messages to %" PRIkernel_pid "\n",
+                  n - (unsigned)sent, pid);
+        }
+        for (unsigned i = sent; i < n; i++) {
+            /* unable to dispatch packet */
+            gnrc_pktbuf_release_error(pkts[i], EIO);
+        }
+        pkts += n;
+        num -= n;
+    }
+}
+
+int gnrc_netapi_dispatch(gnrc_nettype_t type, uint32_t demux_ctx,
+                         uint16_t cmd, gnrc_pktsnip_t *pkt)
+{
+    int numof = 0;
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+
+    /* count and deliver in one pass over the registry: the packet needs to
+     * be held for the next subscriber before it is handed to the current
+     * one, as that might already release it */
+    while (sendto) {
+        gnrc_netreg_entry_t *next = gnrc_netreg_getnext(sendto);
+
+        if (next) {
+            gnrc_pktbuf_hold(pkt, 1);
+        }
+        _dispatch(sendto, cmd, pkt);
+        numof++;
+        sendto = next;
+    }
+
+    return numof;
+}
+
+int gnrc_netapi_dispatch_bulk(gnrc_nettype_t type, uint32_t demux_ctx,
+                              uint16_t cmd, gnrc_pktsnip_t **pkts,
+                              unsigned num)
+{
+    int numof = 0;
+    gnrc_netreg_entry_t *sendto = gnrc_netreg_lookup(type, demux_ctx);
+
+    while (sendto) {
+        gnrc_netreg_entry_t *next = gnrc_netreg_getnext(sendto);
+
+        if (next) {
+            for (unsigned i = 0; i < num; i++) {
+                gnrc_pktbuf_hold(pkts[i], 1);
+            }
+        }
+#if defined(MODULE_GNRC_NETAPI_MBOX) || defined(MODULE_GNRC_NETAPI_CALLBACKS)
+        if (sendto->type != GNRC_NETREG_TYPE_DEFAULT) {
+            for (unsigned i = 0; i < num; i++) {
+                _dispatch(sendto, cmd, pkts[i]);
             }
+        }
+        else
 #endif
-            sendto = gnrc_netreg_getnext(sendto);
+        {
+            _send_bulk(sendto->target.pid, cmd, pkts, num);
         }
+        numof++;
+        sendto = next;
     }
 
     return numof;
@@ -165,13 +165,52 @@ static int _send(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
     return res;
 }
 
+/**
+ * @brief   Receives a frame into a device owned buffer (see NETOPT_RX_BUF)
+ *          and wraps it into a packet snip without copying
+ *
+ * @return  number of bytes received into @p pkt
+ * @return  0, if the frame needs to be received by copying instead
+ * @return  -1, if no frame was received
+ */
+static int _recv_in_place(netdev_t *dev, gnrc_pktsnip_t **pkt)
+{
+    netdev_rx_buf_t rx_buf;
+    int res = dev->driver->get(dev, NETOPT_RX_BUF, &rx_buf, sizeof(rx_buf));
+
+    if (res < 0) {
+        /* -ENOTSUP, -ENOBUFS: fall back to copying */
+        return 0;
+    }
+    if (res == 0) {
+        return -1;
+    }
+    *pkt = gnrc_pktbuf_add_ext(NULL, rx_buf.data, rx_buf.len,
+                               GNRC_NETTYPE_UNDEF, rx_buf.release, rx_buf.arg);
+    if (*pkt == NULL) {
+        DEBUG("gnrc_netif_ethernet: cannot allocate pktsnip.\n");
+        rx_buf.release(rx_buf.arg, rx_buf.data);
+        return -1;
+    }
+    return rx_buf.len;
+}
+
 static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
 {
     netdev_t *dev = netif->dev;
-    int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
     gnrc_pktsnip_t *pkt = NULL;
+    int nread = _recv_in_place(dev, &pkt);
+
+    if (nread < 0) {
+        goto out;
+    }
+    if (nread == 0) {
+        int bytes_expected = dev->driver->recv(dev, NULL, 0, NULL);
+
+        if (bytes_expected <= 0) {
+            goto out;
+        }
 
-    if (bytes_expected > 0) {
         pkt = gnrc_pktbuf_add(NULL, NULL,
                               bytes_expected,
                               GNRC_NETTYPE_UNDEF);
@@ -185,15 +224,11 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             goto out;
         }
 
-        int nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
+        nread = dev->driver->recv(dev, pkt->data, bytes_expected, NULL);
         if (nread <= 0) {
             DEBUG("gnrc_netif_ethernet: read error.\n");
             goto safe_out;
         }
-#ifdef MODULE_NETSTATS_L2
-        netif->stats.rx_count++;
-        netif->stats.rx_bytes += nread;
-#endif
 
         if (nread < bytes_expected) {
             /* we've got less than the expected packet size,
@@ -202,52 +237,57 @@ static gnrc_pktsnip_t *_recv(gnrc_netif_t *netif)
             DEBUG("gnrc_netif_ethernet: reallocating.\n");
             gnrc_pktbuf_realloc_data(pkt, nread);
         }
+    }
+
+#ifdef MODULE_NETSTATS_L2
+    netif->stats.rx_count++;
+    netif->stats.rx_bytes += nread;
+#endif
 
-        DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
-              gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
-              nread);
+    DEBUG("gnrc_netif_ethernet: received packet from %s of length %d\n",
+          gnrc_netif_addr_to_str(pkt->data, ETHERNET_ADDR_LEN, addr_str),
+          nread);
 #if defined(MODULE_OD) && ENABLE_DEBUG
-        od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
+    od_hex_dump(pkt->data, nread, OD_WIDTH_DEFAULT);
 #endif
-        /* mark ethernet header */
-        gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
-        if (!eth_hdr) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            goto safe_out;
-        }
+    /* mark ethernet header */
+    gnrc_pktsnip_t *eth_hdr = gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF);
+    if (!eth_hdr) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        goto safe_out;
+    }
 
-        ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
+    ethernet_hdr_t *hdr = (ethernet_hdr_t *)eth_hdr->data;
 
 #ifdef MODULE_L2FILTER
-        if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
-            DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
-            goto safe_out;
-        }
+    if (!l2filter_pass(dev->filter, hdr->src, ETHERNET_ADDR_LEN)) {
+        DEBUG("gnrc_netif_ethernet: incoming packet filtered by l2filter\n");
+        goto safe_out;
+    }
 #endif
 
-        /* set payload type from ethertype */
-        pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
+    /* set payload type from ethertype */
+    pkt->type = gnrc_nettype_from_ethertype(byteorder_ntohs(hdr->type));
 
-        /* create netif header */
-        gnrc_pktsnip_t *netif_hdr;
-        netif_hdr = gnrc_pktbuf_add(NULL, NULL,
-                                    sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
-                                    GNRC_NETTYPE_NETIF);
+    /* create netif header */
+    gnrc_pktsnip_t *netif_hdr;
+    netif_hdr = gnrc_pktbuf_add(NULL, NULL,
+                                sizeof(gnrc_netif_hdr_t) + (2 * ETHERNET_ADDR_LEN),
+                                GNRC_NETTYPE_NETIF);
 
-        if (netif_hdr == NULL) {
-            DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
-            pkt = eth_hdr;
-            goto safe_out;
-        }
+    if (netif_hdr == NULL) {
+        DEBUG("gnrc_netif_ethernet: no space left in packet buffer\n");
+        pkt = eth_hdr;
+        goto safe_out;
+    }
 
-        gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
-        gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
+    gnrc_netif_hdr_init(netif_hdr->data, ETHERNET_ADDR_LEN, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_src_addr(netif_hdr->data, hdr->src, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_dst_addr(netif_hdr->data, hdr->dst, ETHERNET_ADDR_LEN);
+    gnrc_netif_hdr_set_netif(netif_hdr->data, netif);
 
-        gnrc_pktbuf_remove_snip(pkt, eth_hdr);
-        LL_APPEND(pkt, netif_hdr);
-    }
+    gnrc_pktbuf_remove_snip(pkt, eth_hdr);
+    LL_APPEND(pkt, netif_hdr);
 
 out:
     return pkt;
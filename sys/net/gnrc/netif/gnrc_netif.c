@@ -29,6 +29,7 @@
 #include "net/netstats.h"
 #endif
 #include "fmt.h"
+#include "kernel_defines.h"
 #include "log.h"
 #include "sched.h"
 #include "xtimer.h"
@@ -43,6 +44,9 @@ static void _update_l2addr_from_dev(gnrc_netif_t *netif);
 static void _configure_netdev(netdev_t *dev);
 static void *_gnrc_netif_thread(void *args);
 static void _event_cb(netdev_t *dev, netdev_event_t event);
+#ifdef MODULE_GNRC_NETIF_BATCH_RX
+static void _flush_rx_batch(gnrc_netif_t *netif);
+#endif
 
 int gnrc_netif_create(gnrc_netif_t *netif, char *stack, int stacksize, char priority,
                       const char *name, netdev_t *netdev, const gnrc_netif_ops_t *ops)
@@ -1339,6 +1343,10 @@ static void *_gnrc_netif_thread(void *args)
     int res;
     msg_t reply = { .type = GNRC_NETAPI_MSG_TYPE_ACK };
     msg_t msg, msg_queue[CONFIG_GNRC_NETIF_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETIF_BATCH_RX
+    msg_t msgs[CONFIG_GNRC_NETIF_RX_BATCH_SIZE];
+    unsigned msgs_num = 0, msgs_idx = 0;
+#endif
 
     DEBUG("gnrc_netif: starting thread %i\n", sched_active_pid);
     netif = args;
@@ -1377,8 +1385,19 @@ static void *_gnrc_netif_thread(void *args)
 #endif
 
     while (1) {
+#ifdef MODULE_GNRC_NETIF_BATCH_RX
+        if (msgs_idx == msgs_num) {
+            /* hand on all packets received for the pending messages */
+            _flush_rx_batch(netif);
+            DEBUG("gnrc_netif: waiting for incoming messages\n");
+            msgs_num = msg_receive_bulk(msgs, ARRAY_SIZE(msgs));
+            msgs_idx = 0;
+        }
+        msg = msgs[msgs_idx++];
+#else
         DEBUG("gnrc_netif: waiting for incoming messages\n");
         msg_receive(&msg);
+#endif
         /* dispatch netdev, MAC and gnrc_netapi messages */
         switch (msg.type) {
             case NETDEV_MSG_TYPE_EVENT:
@@ -1452,8 +1471,46 @@ static void *_gnrc_netif_thread(void *args)
     return NULL;
 }
 
-static void _pass_on_packet(gnrc_pktsnip_t *pkt)
+#ifdef MODULE_GNRC_NETIF_BATCH_RX
+static void _flush_rx_batch(gnrc_netif_t *netif)
+{
+    gnrc_pktsnip_t **pkts = netif->rx_batch;
+    unsigned num = netif->rx_batch_num;
+
+    netif->rx_batch_num = 0;
+    while (num > 0) {
+        unsigned n = 1;
+
+        /* hand on consecutive packets of the same type at once */
+        while ((n < num) && (pkts[n]->type == pkts[0]->type)) {
+            n++;
+        }
+        /* throw away packets if no one is interested */
+        if (!gnrc_netapi_dispatch_receive_bulk(pkts[0]->type,
+                                               GNRC_NETREG_DEMUX_CTX_ALL,
+                                               pkts, n)) {
+            DEBUG("gnrc_netif: unable to forward packets of type %i\n",
+                  pkts[0]->type);
+            for (unsigned i = 0; i < n; i++) {
+                gnrc_pktbuf_release(pkts[i]);
+            }
+        }
+        pkts += n;
+        num -= n;
+    }
+}
+
+static void _pass_on_packet(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
+{
+    netif->rx_batch[netif->rx_batch_num++] = pkt;
+    if (netif->rx_batch_num == ARRAY_SIZE(netif->rx_batch)) {
+        _flush_rx_batch(netif);
+    }
+}
+#else   /* MODULE_GNRC_NETIF_BATCH_RX */
+static void _pass_on_packet(gnrc_netif_t *netif, gnrc_pktsnip_t *pkt)
 {
+    (void)netif;
     /* throw away packet if no one is interested */
     if (!gnrc_netapi_dispatch_receive(pkt->type, GNRC_NETREG_DEMUX_CTX_ALL, pkt)) {
         DEBUG("gnrc_netif: unable to forward packet of type %i\n", pkt->type);
@@ -1461,6 +1518,7 @@ static void _pass_on_packet(gnrc_pktsnip_t *pkt)
         return;
     }
 }
+#endif  /* MODULE_GNRC_NETIF_BATCH_RX */
 
 static void _event_cb(netdev_t *dev, netdev_event_t event)
 {
@@ -1481,7 +1539,7 @@ static void _event_cb(netdev_t *dev, netdev_event_t event)
             case NETDEV_EVENT_RX_COMPLETE:
                 pkt = netif->ops->recv(netif);
                 if (pkt) {
-                    _pass_on_packet(pkt);
+                    _pass_on_packet(netif, pkt);
                 }
                 break;
 #ifdef MODULE_NETSTATS_L2
@@ -28,13 +28,23 @@
 
 #define _INVALID_TYPE(type) (((type) < GNRC_NETTYPE_UNDEF) || ((type) >= GNRC_NETTYPE_NUMOF))
 
-/* The registry as lookup table by gnrc_nettype_t */
-static gnrc_netreg_entry_t *netreg[GNRC_NETTYPE_NUMOF];
+/* The registry as hash table by gnrc_nettype_t and demux context */
+static gnrc_netreg_entry_t *netreg[CONFIG_GNRC_NETREG_BUCKETS];
+
+static inline gnrc_netreg_entry_t **_bucket(gnrc_nettype_t type,
+                                            uint32_t demux_ctx)
+{
+    /* fold the upper half in, so ports as well as GNRC_NETREG_DEMUX_CTX_ALL
+     * spread over the buckets */
+    uint32_t hash = (demux_ctx ^ (demux_ctx >> 16)) + ((uint32_t)type * 0x9e5U);
+
+    return &netreg[hash % CONFIG_GNRC_NETREG_BUCKETS];
+}
 
 void gnrc_netreg_init(void)
 {
     /* set all pointers in registry to NULL */
-    memset(netreg, 0, GNRC_NETTYPE_NUMOF * sizeof(gnrc_netreg_entry_t *));
+    memset(netreg, 0, sizeof(netreg));
 }
 
 int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
@@ -59,7 +69,8 @@ int gnrc_netreg_register(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return -EINVAL;
     }
 
-    LL_PREPEND(netreg[type], entry);
+    entry->nettype = (uint8_t)type;
+    LL_PREPEND(*_bucket(type, entry->demux_ctx), entry);
 
     return 0;
 }
@@ -70,14 +81,14 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
         return;
     }
 
-    LL_DELETE(netreg[type], entry);
+    LL_DELETE(*_bucket(type, entry->demux_ctx), entry);
 }
 
 /**
  * @brief   Searches the next entry in the registry that matches given
- *          parameters, start lookup from beginning or given entry.
+ *          parameters, start lookup from given entry.
  *
- * @param[in] from      A registry entry to lookup from or NULL to start fresh
+ * @param[in] head      The entry to start the lookup from.
  * @param[in] type      Type of the protocol.
  * @param[in] demux_ctx The demultiplexing context for the registered thread.
  *                      See gnrc_netreg_entry_t::demux_ctx.
@@ -85,39 +96,42 @@ void gnrc_netreg_unregister(gnrc_nettype_t type, gnrc_netreg_entry_t *entry)
  * @return  The first entry fitting the given parameters on success
  * @return  NULL if no entry can be found.
  */
-static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *from,
+static gnrc_netreg_entry_t *_netreg_lookup(gnrc_netreg_entry_t *head,
                                            gnrc_nettype_t type,
                                            uint32_t demux_ctx)
 {
-    gnrc_netreg_entry_t *res = NULL;
-
-    if (from || !_INVALID_TYPE(type)) {
-        gnrc_netreg_entry_t *head = (from) ? from->next : netreg[type];
-        LL_SEARCH_SCALAR(head, res, demux_ctx, demux_ctx);
+    /* entries of other types or contexts may share the bucket */
+    while ((head != NULL) &&
+           ((head->demux_ctx != demux_ctx) || (head->nettype != type))) {
+        head = head->next;
     }
-
-    return res;
+    return head;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_lookup(gnrc_nettype_t type, uint32_t demux_ctx)
 {
-    return _netreg_lookup(NULL, type, demux_ctx);
+    if (_INVALID_TYPE(type)) {
+        return NULL;
+    }
+    return _netreg_lookup(*_bucket(type, demux_ctx), type, demux_ctx);
 }
 
 int gnrc_netreg_num(gnrc_nettype_t type, uint32_t demux_ctx)
 {
     int num = 0;
-    gnrc_netreg_entry_t *entry = NULL;
+    gnrc_netreg_entry_t *entry = gnrc_netreg_lookup(type, demux_ctx);
 
-    while((entry = _netreg_lookup(entry, type, demux_ctx)) != NULL) {
+    while (entry != NULL) {
         num++;
+        entry = gnrc_netreg_getnext(entry);
     }
     return num;
 }
 
 gnrc_netreg_entry_t *gnrc_netreg_getnext(gnrc_netreg_entry_t *entry)
 {
-    return (entry ? _netreg_lookup(entry, 0, entry->demux_ctx) : NULL);
+    return (entry ? _netreg_lookup(entry->next, entry->nettype,
+                                   entry->demux_ctx) : NULL);
 }
 
 int gnrc_netreg_calc_csum(gnrc_pktsnip_t *hdr, gnrc_pktsnip_t *pseudo_hdr)
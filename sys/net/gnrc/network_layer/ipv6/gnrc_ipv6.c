@@ -18,6 +18,7 @@
 
 #include "byteorder.h"
 #include "cpu_conf.h"
+#include "kernel_defines.h"
 #include "kernel_types.h"
 #include "net/gnrc.h"
 #include "net/gnrc/icmpv6.h"
@@ -173,6 +174,10 @@ static void _dispatch_next_header(gnrc_pktsnip_t *pkt, unsigned nh,
 static void *_event_loop(void *args)
 {
     msg_t msg, reply, msg_q[CONFIG_GNRC_IPV6_MSG_QUEUE_SIZE];
+#ifdef MODULE_GNRC_NETIF_BATCH_RX
+    msg_t msgs[CONFIG_GNRC_NETIF_RX_BATCH_SIZE];
+    unsigned msgs_num = 0, msgs_idx = 0;
+#endif
     gnrc_netreg_entry_t me_reg = GNRC_NETREG_ENTRY_INIT_PID(GNRC_NETREG_DEMUX_CTX_ALL,
                                                             sched_active_pid);
 
@@ -191,8 +196,18 @@ static void *_event_loop(void *args)
 
     /* start event loop */
     while (1) {
+#ifdef MODULE_GNRC_NETIF_BATCH_RX
+        /* take the packets of a batch from an interface at once */
+        if (msgs_idx == msgs_num) {
+            DEBUG("ipv6: waiting for incoming message.\n");
+            msgs_num = msg_receive_bulk(msgs, ARRAY_SIZE(msgs));
+            msgs_idx = 0;
+        }
+        msg = msgs[msgs_idx++];
+#else
         DEBUG("ipv6: waiting for incoming message.\n");
         msg_receive(&msg);
+#endif
 
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
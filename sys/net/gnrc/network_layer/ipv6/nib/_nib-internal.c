@@ -23,6 +23,7 @@
 #include "net/gnrc/ipv6/nib/nc.h"
 #include "net/gnrc/ipv6/nib.h"
 #include "net/gnrc/netif/internal.h"
+#include "oaindex.h"
 #include "random.h"
 
 #include "_nib-internal.h"
@@ -44,6 +45,49 @@ static _nib_abr_entry_t _abrs[GNRC_IPV6_NIB_ABR_NUMOF];
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 static rmutex_t _nib_mutex = RMUTEX_INIT;
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+uint32_t _nib_gen;
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+
+#if GNRC_IPV6_NIB_CONF_NC_INDEX
+#define _NC_INDEX_SIZE      (2 * GNRC_IPV6_NIB_NUMOF)
+
+static uint32_t _nc_index_hash_entry(unsigned entry);
+
+static uint16_t _nc_index_slots[_NC_INDEX_SIZE];
+
+/**
+ * @brief   Index of _nodes by _nib_onl_entry_t::ipv6
+ *
+ * Entries are indexed from their allocation until they are cleared, including
+ * entries with the unspecified address.
+ */
+static const oaindex_t _nc_index = OAINDEX_INIT(_nc_index_slots,
+                                                _nc_index_hash_entry);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_INDEX */
+
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+/**
+ * @brief   Node of the path-compressed binary trie indexing _dsts by prefix
+ *
+ * Nodes without entry only exist to branch, so they always have two children.
+ * With N prefixes, there are at most N - 1 of them.
+ */
+typedef struct _offl_node {
+    ipv6_addr_t pfx;                    /**< prefix, bits after len are 0 */
+    struct _offl_node *child[2];        /**< children by bit len of their
+                                         *   prefixes */
+    _nib_offl_entry_t *entry;           /**< entry with the prefix (first in
+                                         *   _dsts if there are several) */
+    uint8_t len;                        /**< prefix length */
+} _offl_node_t;
+
+static _offl_node_t _offl_nodes[2 * GNRC_IPV6_NIB_OFFL_NUMOF];
+static _offl_node_t *_offl_root;
+static _offl_node_t *_offl_free;
+static unsigned _offl_nodes_used;   /* nodes never freed start after these */
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
+
 static char addr_str[IPV6_ADDR_MAX_STR_LEN];
 
 evtimer_msg_t _nib_evtimer;
@@ -51,6 +95,11 @@ evtimer_msg_t _nib_evtimer;
 static void _override_node(const ipv6_addr_t *addr, unsigned iface,
                            _nib_onl_entry_t *node);
 static inline bool _node_unreachable(_nib_onl_entry_t *node);
+#ifdef TEST_SUITES
+static void _offl_trie_init(void);
+#endif
+static void _offl_trie_add(_nib_offl_entry_t *dst);
+static void _offl_trie_del(_nib_offl_entry_t *dst);
 
 void _nib_init(void)
 {
@@ -60,9 +109,13 @@ void _nib_init(void)
     memset(_nodes, 0, sizeof(_nodes));
     memset(_def_routers, 0, sizeof(_def_routers));
     memset(_dsts, 0, sizeof(_dsts));
+#if GNRC_IPV6_NIB_CONF_NC_INDEX
+    oaindex_clear(&_nc_index);
+#endif  /* GNRC_IPV6_NIB_CONF_NC_INDEX */
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
     memset(_abrs, 0, sizeof(_abrs));
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
+    _offl_trie_init();
 #endif  /* TEST_SUITES */
     evtimer_init_msg(&_nib_evtimer);
     /* TODO: load ABR information from persistent memory */
@@ -71,8 +124,18 @@ void _nib_init(void)
 void _nib_acquire(void)
 {
     rmutex_lock(&_nib_mutex);
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+    _nib_gen++;
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
 }
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+void _nib_acquire_lookup(void)
+{
+    rmutex_lock(&_nib_mutex);
+}
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+
 void _nib_release(void)
 {
     rmutex_unlock(&_nib_mutex);
@@ -85,13 +148,11 @@ static inline bool _addr_equals(const ipv6_addr_t *addr,
            (ipv6_addr_equal(addr, &node->ipv6));
 }
 
-_nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
+static _nib_onl_entry_t *_nib_onl_alloc_linear(const ipv6_addr_t *addr,
+                                               unsigned iface)
 {
     _nib_onl_entry_t *node = NULL;
 
-    DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
-          (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
-                                                     sizeof(addr_str)), iface);
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *tmp = &_nodes[i];
 
@@ -117,6 +178,111 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
     return node;
 }
 
+#if GNRC_IPV6_NIB_CONF_NC_INDEX
+static uint32_t _nc_index_hash(const ipv6_addr_t *addr)
+{
+    uint32_t hash = addr->u32[0].u32 ^ addr->u32[1].u32 ^ addr->u32[2].u32 ^
+                    addr->u32[3].u32;
+
+    /* mix the bits, so interface identifiers differing only in some bytes
+     * spread over the table */
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bU;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+static uint32_t _nc_index_hash_entry(unsigned entry)
+{
+    return _nc_index_hash(&_nodes[entry].ipv6);
+}
+
+static inline void _nc_index_add(const _nib_onl_entry_t *node)
+{
+    oaindex_add(&_nc_index, node - _nodes);
+}
+
+void _nib_onl_index_del(const _nib_onl_entry_t *node)
+{
+    oaindex_del(&_nc_index, node - _nodes);
+}
+
+/* Gets the indexed entry with address addr that comes first in _nodes, as the
+ * linear searches did. With in_use, only entries in use are considered and
+ * interface 0 is a wildcard (as for _nib_onl_get()), otherwise the interface
+ * must be equal (as for _nib_onl_alloc()). */
+static _nib_onl_entry_t *_nc_index_get(const ipv6_addr_t *addr,
+                                       unsigned iface, bool in_use)
+{
+    _nib_onl_entry_t *res = NULL;
+
+    for (unsigned slot = oaindex_first(&_nc_index, _nc_index_hash(addr));
+         !oaindex_free(&_nc_index, slot);
+         slot = oaindex_next(&_nc_index, slot)) {
+        _nib_onl_entry_t *node = &_nodes[oaindex_entry(&_nc_index, slot)];
+        unsigned node_iface = _nib_onl_get_if(node);
+
+        if (((res == NULL) || (node < res)) &&
+            ipv6_addr_equal(&node->ipv6, addr) &&
+            ((node_iface == iface) ||
+             (in_use && ((node_iface == 0) || (iface == 0)))) &&
+            (!in_use || (node->mode != _EMPTY))) {
+            res = node;
+        }
+    }
+    return res;
+}
+
+_nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
+{
+    _nib_onl_entry_t *node = NULL;
+
+    DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
+          (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
+                                                     sizeof(addr_str)), iface);
+    if ((addr == NULL) || (iface == 0)) {
+        /* any entry on the interface and cleared entries, which are not
+         * indexed, are exact matches in those cases */
+        return _nib_onl_alloc_linear(addr, iface);
+    }
+    /* exact matches are entries with the address or the unspecified one */
+    node = _nc_index_get(addr, iface, false);
+    _nib_onl_entry_t *unspec = _nc_index_get(&ipv6_addr_unspecified, iface,
+                                             false);
+    if ((node == NULL) || ((unspec != NULL) && (unspec < node))) {
+        node = unspec;
+    }
+    for (unsigned i = 0; (node == NULL) && (i < GNRC_IPV6_NIB_NUMOF); i++) {
+        if (_nodes[i].mode == _EMPTY) {
+            node = &_nodes[i];
+        }
+    }
+    if (node != NULL) {
+        DEBUG("  using %p\n", (void *)node);
+        _override_node(addr, iface, node);
+    }
+#if ENABLE_DEBUG
+    else {
+        DEBUG("  NIB full\n");
+    }
+#endif  /* ENABLE_DEBUG */
+    return node;
+}
+#else   /* GNRC_IPV6_NIB_CONF_NC_INDEX */
+static inline void _nc_index_add(const _nib_onl_entry_t *node)
+{
+    (void)node;
+}
+
+_nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface)
+{
+    DEBUG("nib: Allocating on-link node entry (addr = %s, iface = %u)\n",
+          (addr == NULL) ? "NULL" : ipv6_addr_to_str(addr_str, addr,
+                                                     sizeof(addr_str)), iface);
+    return _nib_onl_alloc_linear(addr, iface);
+}
+#endif  /* GNRC_IPV6_NIB_CONF_NC_INDEX */
+
 static inline bool _is_gc(_nib_onl_entry_t *node)
 {
     return ((node->mode & ~(_NC)) == 0) &&
@@ -219,6 +385,13 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     assert(addr != NULL);
     DEBUG("nib: Getting on-link node entry (addr = %s, iface = %u)\n",
           ipv6_addr_to_str(addr_str, addr, sizeof(addr_str)), iface);
+#if GNRC_IPV6_NIB_CONF_NC_INDEX
+    _nib_onl_entry_t *node = _nc_index_get(addr, iface, true);
+
+    DEBUG("  %s %p\n", (node) ? "Found" : "No suitable entry found",
+          (void *)node);
+    return node;
+#else   /* GNRC_IPV6_NIB_CONF_NC_INDEX */
     for (unsigned i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
         _nib_onl_entry_t *node = &_nodes[i];
 
@@ -234,6 +407,7 @@ _nib_onl_entry_t *_nib_onl_get(const ipv6_addr_t *addr, unsigned iface)
     }
     DEBUG("  No suitable entry found\n");
     return NULL;
+#endif  /* GNRC_IPV6_NIB_CONF_NC_INDEX */
 }
 
 void _nib_nc_set_reachable(_nib_onl_entry_t *node)
@@ -290,6 +464,7 @@ void _nib_nc_remove(_nib_onl_entry_t *node)
     /* remove from cache-out procedure */
     clist_remove(&_next_removable, (clist_node_t *)node);
     _nib_onl_clear(node);
+    _nib_changed();
 }
 
 #if GNRC_IPV6_NIB_CONF_6LN || !GNRC_IPV6_NIB_CONF_ARSM
@@ -379,6 +554,7 @@ void _nib_drl_remove(_nib_dr_entry_t *nib_dr)
         nib_dr->next_hop->mode &= ~(_DRL);
         _nib_onl_clear(nib_dr->next_hop);
         memset(nib_dr, 0, sizeof(_nib_dr_entry_t));
+        _nib_changed();
     }
     if (nib_dr == _prime_def_router) {
         _prime_def_router = NULL;
@@ -491,7 +667,9 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
             /* exact match (or next hop address was previously unset) */
             DEBUG("  %p is an exact match\n", (void *)tmp);
             if (next_hop != NULL) {
+                _nib_onl_index_del(tmp_node);
                 memcpy(&tmp_node->ipv6, next_hop, sizeof(tmp_node->ipv6));
+                _nc_index_add(tmp_node);
             }
             tmp->next_hop->mode |= _DST;
             return tmp;
@@ -512,6 +690,7 @@ _nib_offl_entry_t *_nib_offl_alloc(const ipv6_addr_t *next_hop, unsigned iface,
         dst->next_hop->mode |= _DST;
         ipv6_addr_init_prefix(&dst->pfx, pfx, pfx_len);
         dst->pfx_len = pfx_len;
+        _offl_trie_add(dst);
     }
     return dst;
 }
@@ -548,7 +727,9 @@ void _nib_offl_clear(_nib_offl_entry_t *dst)
             dst->next_hop->mode &= ~(_DST);
             _nib_onl_clear(dst->next_hop);
         }
+        _offl_trie_del(dst);
         memset(dst, 0, sizeof(_nib_offl_entry_t));
+        _nib_changed();
     }
 }
 
@@ -571,6 +752,188 @@ bool _nib_offl_is_entry(const _nib_offl_entry_t *entry)
     return (entry >= _dsts) && _in_dsts(entry);
 }
 
+#if GNRC_IPV6_NIB_CONF_OFFL_TRIE
+static inline unsigned _pfx_bit(const ipv6_addr_t *addr, unsigned pos)
+{
+    return bf_isset((uint8_t *)addr->u8, pos) ? 1 : 0;
+}
+
+/* checks if the first len bits of addr equal pfx (with bits after len 0) */
+static bool _pfx_match(const ipv6_addr_t *pfx, const ipv6_addr_t *addr,
+                       unsigned len)
+{
+    unsigned bytes = len / 8;
+
+    if (memcmp(pfx->u8, addr->u8, bytes) != 0) {
+        return false;
+    }
+    if (len % 8) {
+        uint8_t mask = 0xff << (8 - (len % 8));
+        return (addr->u8[bytes] & mask) == pfx->u8[bytes];
+    }
+    return true;
+}
+
+static _offl_node_t *_offl_node_alloc(void)
+{
+    _offl_node_t *node = _offl_free;
+
+    if (node != NULL) {
+        _offl_free = node->child[0];
+    }
+    else {
+        /* there are never more than 2 * GNRC_IPV6_NIB_OFFL_NUMOF - 1 nodes */
+        assert(_offl_nodes_used < ARRAY_SIZE(_offl_nodes));
+        node = &_offl_nodes[_offl_nodes_used++];
+    }
+    memset(node, 0, sizeof(*node));
+    return node;
+}
+
+static void _offl_node_free(_offl_node_t *node)
+{
+    node->child[0] = _offl_free;
+    _offl_free = node;
+}
+
+#ifdef TEST_SUITES
+static void _offl_trie_init(void)
+{
+    _offl_root = NULL;
+    _offl_free = NULL;
+    _offl_nodes_used = 0;
+}
+#endif
+
+static void _offl_trie_add(_nib_offl_entry_t *dst)
+{
+    _offl_node_t **link = &_offl_root;
+    _offl_node_t *node;
+    unsigned common = 0;
+
+    while ((node = *link) != NULL) {
+        common = ipv6_addr_match_prefix(&node->pfx, &dst->pfx);
+        common = (common < node->len) ? common : node->len;
+        common = (common < dst->pfx_len) ? common : dst->pfx_len;
+        if (common < node->len) {
+            /* dst branches off above node */
+            break;
+        }
+        if (node->len == dst->pfx_len) {
+            /* prefix is known already, keep the first entry of _dsts as the
+             * linear search did */
+            if ((node->entry == NULL) || (dst < node->entry)) {
+                node->entry = dst;
+            }
+            return;
+        }
+        link = &node->child[_pfx_bit(&dst->pfx, node->len)];
+    }
+
+    _offl_node_t *leaf = _offl_node_alloc();
+
+    leaf->pfx = dst->pfx;
+    leaf->len = dst->pfx_len;
+    leaf->entry = dst;
+    if (node == NULL) {
+        *link = leaf;
+    }
+    else if (common == dst->pfx_len) {
+        /* dst is a prefix of node */
+        leaf->child[_pfx_bit(&node->pfx, common)] = node;
+        *link = leaf;
+    }
+    else {
+        _offl_node_t *branch = _offl_node_alloc();
+
+        ipv6_addr_init_prefix(&branch->pfx, &dst->pfx, common);
+        branch->len = common;
+        branch->child[_pfx_bit(&dst->pfx, common)] = leaf;
+        branch->child[_pfx_bit(&node->pfx, common)] = node;
+        *link = branch;
+    }
+}
+
+static void _offl_trie_del(_nib_offl_entry_t *dst)
+{
+    _offl_node_t **parent_link = NULL;
+    _offl_node_t **link = &_offl_root;
+    _offl_node_t *node;
+
+    while (((node = *link) != NULL) && (node->len < dst->pfx_len)) {
+        parent_link = link;
+        link = &node->child[_pfx_bit(&dst->pfx, node->len)];
+    }
+    if ((node == NULL) || (node->entry != dst)) {
+        /* dst is not the indexed entry for its prefix */
+        return;
+    }
+
+    /* another entry with the same prefix takes over */
+    node->entry = NULL;
+    for (_nib_offl_entry_t *ptr = _dsts; _in_dsts(ptr); ptr++) {
+        if ((ptr != dst) && (ptr->next_hop != NULL) &&
+            (ptr->pfx_len == dst->pfx_len) &&
+            ipv6_addr_equal(&ptr->pfx, &dst->pfx)) {
+            node->entry = ptr;
+            return;
+        }
+    }
+    if (node->child[0] && node->child[1]) {
+        /* node still branches */
+        return;
+    }
+
+    _offl_node_t *child = node->child[0] ? node->child[0] : node->child[1];
+
+    *link = child;
+    _offl_node_free(node);
+    if ((child == NULL) && (parent_link != NULL) &&
+        ((*parent_link)->entry == NULL)) {
+        /* parent does not branch anymore */
+        _offl_node_t *parent = *parent_link;
+
+        *parent_link = parent->child[0] ? parent->child[0] : parent->child[1];
+        _offl_node_free(parent);
+    }
+}
+
+static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
+{
+    _nib_offl_entry_t *res = NULL;
+
+    DEBUG("nib: get match for destination %s from NIB\n",
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
+    for (const _offl_node_t *node = _offl_root;
+         (node != NULL) && _pfx_match(&node->pfx, dst, node->len);
+         node = (node->len < IPV6_ADDR_BIT_LEN)
+              ? node->child[_pfx_bit(dst, node->len)] : NULL) {
+        if ((node->entry != NULL) && (node->entry->mode != _EMPTY)) {
+            DEBUG("nib: %s/%u matches\n",
+                  ipv6_addr_to_str(addr_str, &node->pfx, sizeof(addr_str)),
+                  node->len);
+            res = node->entry;
+        }
+    }
+    return res;
+}
+#else   /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
+#ifdef TEST_SUITES
+static inline void _offl_trie_init(void)
+{
+}
+#endif
+
+static inline void _offl_trie_add(_nib_offl_entry_t *dst)
+{
+    (void)dst;
+}
+
+static inline void _offl_trie_del(_nib_offl_entry_t *dst)
+{
+    (void)dst;
+}
+
 static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
 {
     _nib_offl_entry_t *res = NULL;
@@ -599,6 +962,7 @@ static _nib_offl_entry_t *_nib_offl_get_match(const ipv6_addr_t *dst)
     }
     return res;
 }
+#endif  /* GNRC_IPV6_NIB_CONF_OFFL_TRIE */
 
 void _nib_ft_get(const _nib_offl_entry_t *dst, gnrc_ipv6_nib_ft_t *fte)
 {
@@ -826,9 +1190,11 @@ static void _override_node(const ipv6_addr_t *addr, unsigned iface,
 {
     _nib_onl_clear(node);
     if (addr != NULL) {
+        _nib_onl_index_del(node);
         memcpy(&node->ipv6, addr, sizeof(node->ipv6));
     }
     _nib_onl_set_if(node, iface);
+    _nc_index_add(node);
 }
 
 static inline bool _node_unreachable(_nib_onl_entry_t *node)
@@ -271,6 +271,41 @@ void _nib_acquire(void);
  */
 void _nib_release(void);
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE || DOXYGEN
+/**
+ * @brief   Generation of the NIB
+ *
+ * Incremented by @ref _nib_acquire(), as any access that way might change
+ * the NIB, and by @ref _nib_changed() when entries are removed during a
+ * look-up. Flows resolved with an older generation might be stale.
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_FLOW_CACHE.
+ */
+extern uint32_t _nib_gen;
+
+/**
+ * @brief   Acquire exclusive access to the NIB for a look-up only
+ *
+ * Unlike @ref _nib_acquire(), this keeps @ref _nib_gen.
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_FLOW_CACHE.
+ */
+void _nib_acquire_lookup(void);
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+
+/**
+ * @brief   Invalidates the flows resolved so far
+ *
+ * For changes to the NIB made during a look-up, e.g. when an entry is
+ * removed to make room for a new one.
+ */
+static inline void _nib_changed(void)
+{
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+    _nib_gen++;
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+}
+
 /**
  * @brief   Gets interface identifier from a NIB entry
  *
@@ -309,6 +344,24 @@ static inline void _nib_onl_set_if(_nib_onl_entry_t *node, unsigned iface)
  */
 _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 
+#if GNRC_IPV6_NIB_CONF_NC_INDEX || DOXYGEN
+/**
+ * @brief   Removes an on-link entry from the address index
+ *
+ * Must be called before _nib_onl_entry_t::ipv6 of an entry is changed.
+ *
+ * @note    Only available if @ref GNRC_IPV6_NIB_CONF_NC_INDEX.
+ *
+ * @param[in] node  An entry.
+ */
+void _nib_onl_index_del(const _nib_onl_entry_t *node);
+#else   /* GNRC_IPV6_NIB_CONF_NC_INDEX */
+static inline void _nib_onl_index_del(const _nib_onl_entry_t *node)
+{
+    (void)node;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_NC_INDEX */
+
 /**
  * @brief   Clears out a NIB entry (on-link version)
  *
@@ -320,6 +373,7 @@ _nib_onl_entry_t *_nib_onl_alloc(const ipv6_addr_t *addr, unsigned iface);
 static inline bool _nib_onl_clear(_nib_onl_entry_t *node)
 {
     if (node->mode == _EMPTY) {
+        _nib_onl_index_del(node);
         memset(node, 0, sizeof(_nib_onl_entry_t));
         return true;
     }
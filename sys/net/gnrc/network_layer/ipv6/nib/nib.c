@@ -54,6 +54,25 @@ static gnrc_pktqueue_t _queue_pool[GNRC_IPV6_NIB_NUMOF];
 static evtimer_msg_event_t _rdnss_timeout;
 #endif
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+/**
+ * @brief   Next hop resolved for a destination
+ */
+typedef struct {
+    ipv6_addr_t dst;            /**< destination */
+    gnrc_ipv6_nib_nc_t nce;     /**< neighbor cache entry of the next hop */
+    ipv6_addr_t route;          /**< prefix of the route to _nib_flow_t::dst
+                                 *   if off-link */
+    uint32_t gen;               /**< _nib_gen at resolution, 0 if unused */
+    uint8_t iface;              /**< interface the look-up was restricted to */
+    uint8_t route_len;          /**< length of _nib_flow_t::route */
+    bool offl;                  /**< _nib_flow_t::dst is off-link */
+} _nib_flow_t;
+
+static _nib_flow_t _flows[GNRC_IPV6_NIB_FLOW_CACHE_NUMOF];
+static gnrc_ipv6_nib_flow_stats_t _flow_stats;
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+
 /**
  * @internal
  * @{
@@ -183,17 +202,111 @@ static bool _on_link(const ipv6_addr_t *dst, unsigned *iface)
     return ipv6_addr_is_link_local(dst);
 }
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+static _nib_flow_t *_flow_slot(const ipv6_addr_t *dst, unsigned iface)
+{
+    uint32_t hash = dst->u32[0].u32 ^ dst->u32[1].u32 ^ dst->u32[2].u32 ^
+                    dst->u32[3].u32 ^ iface;
+
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3bU;
+    hash ^= hash >> 16;
+    return &_flows[hash % GNRC_IPV6_NIB_FLOW_CACHE_NUMOF];
+}
+
+/* must be called with the NIB acquired */
+static bool _flow_get(const ipv6_addr_t *dst, gnrc_netif_t *netif,
+                      gnrc_ipv6_nib_nc_t *nce)
+{
+    unsigned iface = (netif == NULL) ? 0 : netif->pid;
+    _nib_flow_t *flow = _flow_slot(dst, iface);
+
+    if ((flow->gen != _nib_gen) || (flow->iface != iface) ||
+        !ipv6_addr_equal(&flow->dst, dst)) {
+        _flow_stats.misses++;
+        return false;
+    }
+    _flow_stats.hits++;
+    *nce = flow->nce;
+    if (flow->offl) {
+        /* repeat the side effects of a full resolution */
+        iface = gnrc_ipv6_nib_nc_get_iface(nce);
+        netif = gnrc_netif_get_by_pid(iface);
+        if (netif != NULL) {
+            _call_route_info_cb(netif, GNRC_IPV6_NIB_ROUTE_INFO_TYPE_RN,
+                                &flow->route,
+                                (void *)((intptr_t)flow->route_len));
+        }
+#if GNRC_IPV6_NIB_CONF_DC
+        _nib_dc_add(&nce->ipv6, iface, dst);
+#endif  /* GNRC_IPV6_NIB_CONF_DC */
+    }
+    return true;
+}
+
+/* must be called with the NIB acquired */
+static void _flow_set(const ipv6_addr_t *dst, unsigned iface,
+                      const gnrc_ipv6_nib_nc_t *nce,
+                      const gnrc_ipv6_nib_ft_t *route)
+{
+    _nib_flow_t *flow = _flow_slot(dst, iface);
+
+    /* a generation of 0 marks unused entries */
+    if (_nib_gen == 0) {
+        _nib_gen++;
+    }
+    flow->dst = *dst;
+    flow->nce = *nce;
+    flow->gen = _nib_gen;
+    flow->iface = iface;
+    flow->offl = (route != NULL);
+    if (route != NULL) {
+        flow->route = route->dst;
+        flow->route_len = route->dst_len;
+    }
+}
+
+void gnrc_ipv6_nib_flow_stats(gnrc_ipv6_nib_flow_stats_t *stats)
+{
+    _nib_acquire_lookup();
+    *stats = _flow_stats;
+    _nib_release();
+}
+#else   /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+static inline void _flow_set(const ipv6_addr_t *dst, unsigned iface,
+                             const gnrc_ipv6_nib_nc_t *nce,
+                             const gnrc_ipv6_nib_ft_t *route)
+{
+    (void)dst;
+    (void)iface;
+    (void)nce;
+    (void)route;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+
 int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
                                       gnrc_netif_t *netif, gnrc_pktsnip_t *pkt,
                                       gnrc_ipv6_nib_nc_t *nce)
 {
+    unsigned iface = (netif == NULL) ? 0 : netif->pid;
+    gnrc_ipv6_nib_ft_t route;
+    bool offl = false;
     int res = 0;
 
     DEBUG("nib: get next hop link-layer address of %s%%%u\n",
-          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)),
-          (netif != NULL) ? (unsigned)netif->pid : 0U);
+          ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)), iface);
     gnrc_netif_acquire(netif);
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+    _nib_acquire_lookup();
+    if (_flow_get(dst, netif, nce)) {
+        DEBUG("nib: next hop taken from flow cache\n");
+        _nib_release();
+        gnrc_netif_release(netif);
+        return 0;
+    }
+#else   /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
     _nib_acquire();
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
     do {    /* XXX: hidden goto ;-) */
         _nib_onl_entry_t *node = _nib_onl_get(dst,
                                               (netif == NULL) ? 0 : netif->pid);
@@ -226,8 +339,6 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
             }
         }
         else {
-            gnrc_ipv6_nib_ft_t route;
-
             DEBUG("nib: %s is off-link, resolve route\n",
                   ipv6_addr_to_str(addr_str, dst, sizeof(addr_str)));
             res = _nib_get_route(dst, pkt, &route);
@@ -264,6 +375,7 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
             node = _nib_onl_get(&route.next_hop,
                                 (netif != NULL) ? netif->pid : 0);
             if (_resolve_addr(&route.next_hop, netif, pkt, nce, node)) {
+                offl = true;
                 _call_route_info_cb(netif,
                                     GNRC_IPV6_NIB_ROUTE_INFO_TYPE_RN,
                                     &route.dst,
@@ -279,6 +391,9 @@ int gnrc_ipv6_nib_get_next_hop_l2addr(const ipv6_addr_t *dst,
             }
         }
     } while (0);
+    if (res == 0) {
+        _flow_set(dst, iface, nce, offl ? &route : NULL);
+    }
     _nib_release();
     gnrc_netif_release(netif);
     return res;
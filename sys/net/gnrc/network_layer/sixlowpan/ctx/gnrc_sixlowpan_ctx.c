@@ -27,13 +27,14 @@ static uint32_t _ctx_inval_times[GNRC_SIXLOWPAN_CTX_SIZE];
 static mutex_t _ctx_mutex = MUTEX_INIT;
 
 static uint32_t _current_minute(void);
-static void _update_lifetime(uint8_t id);
+static void _update_lifetime(uint8_t id, uint32_t now);
 
 static char ipv6str[IPV6_ADDR_MAX_STR_LEN];
 
-static inline bool _valid(uint8_t id)
+/* now is the current minute, so it can be read once for all contexts */
+static inline bool _valid(uint8_t id, uint32_t now)
 {
-    _update_lifetime(id);
+    _update_lifetime(id, now);
     return (_ctxs[id].prefix_len > 0);
 }
 
@@ -41,11 +42,12 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_addr(const ipv6_addr_t *addr)
 {
     uint8_t best = 0;
     gnrc_sixlowpan_ctx_t *res = NULL;
+    uint32_t now = _current_minute();
 
     mutex_lock(&_ctx_mutex);
 
     for (unsigned int id = 0; id < GNRC_SIXLOWPAN_CTX_SIZE; id++) {
-        if (_valid(id)) {
+        if (_valid(id, now)) {
             uint8_t match = ipv6_addr_match_prefix(&_ctxs[id].prefix, addr);
 
             if ((_ctxs[id].prefix_len <= match) && (match > best)) {
@@ -78,7 +80,7 @@ gnrc_sixlowpan_ctx_t *gnrc_sixlowpan_ctx_lookup_id(uint8_t id)
 
     mutex_lock(&_ctx_mutex);
 
-    if (_valid(id)) {
+    if (_valid(id, _current_minute())) {
         DEBUG("6lo ctx: found context (%u, %s/%" PRIu8 ")\n", id,
               ipv6_addr_to_str(ipv6str, &_ctxs[id].prefix, sizeof(ipv6str)),
               _ctxs[id].prefix_len);
@@ -134,17 +136,13 @@ static uint32_t _current_minute(void)
     return xtimer_now_usec() / (US_PER_SEC * 60);
 }
 
-static void _update_lifetime(uint8_t id)
+static void _update_lifetime(uint8_t id, uint32_t now)
 {
-    uint32_t now;
-
     if (_ctxs[id].ltime == 0) {
         _ctxs[id].flags_id &= ~GNRC_SIXLOWPAN_CTX_FLAGS_COMP;
         return;
     }
 
-    now = _current_minute();
-
     if (now >= _ctx_inval_times[id]) {
         DEBUG("6lo ctx: context %u was invalidated for compression\n", id);
         _ctxs[id].ltime = 0;
@@ -16,6 +16,7 @@
 #include <inttypes.h>
 #include <stdbool.h>
 
+#include "kernel_defines.h"
 #include "net/ieee802154.h"
 #include "net/ipv6.h"
 #include "net/ipv6/hdr.h"
@@ -29,6 +30,7 @@
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
 #include "net/sixlowpan.h"
+#include "oaindex.h"
 #include "thread.h"
 #include "xtimer.h"
 #include "utlist.h"
@@ -38,23 +40,23 @@
 #define ENABLE_DEBUG    (0)
 #include "debug.h"
 
-/* estimated fragment payload size to determinate RBUF_INT_SIZE, default to
- * MAC payload size - fragment header. */
-#ifndef GNRC_SIXLOWPAN_FRAG_SIZE
-/* assuming 64-bit source/destination address, source PAN ID omitted */
-#define GNRC_SIXLOWPAN_FRAG_SIZE (104 - 5)
-#endif
+#define RBUF_INDEX_SIZE     (2 * CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
 
-#ifndef RBUF_INT_SIZE
-/* same as ((int) ceil((double) N / D)) */
-#define DIV_CEIL(N, D) (((N) + (D) - 1) / (D))
-#define RBUF_INT_SIZE (DIV_CEIL(IPV6_MIN_MTU, GNRC_SIXLOWPAN_FRAG_SIZE) * \
-                       CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE)
-#endif
+static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
 
-static gnrc_sixlowpan_frag_rb_int_t rbuf_int[RBUF_INT_SIZE];
+static uint32_t _rbuf_index_hash_entry(unsigned entry);
 
-static gnrc_sixlowpan_frag_rb_t rbuf[CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE];
+static uint16_t rbuf_index_slots[RBUF_INDEX_SIZE];
+
+/**
+ * @brief   Index of rbuf by the source and destination address and the tag of
+ *          the datagram
+ *
+ * Entries are indexed from their creation in _rbuf_get() until they are
+ * removed with gnrc_sixlowpan_frag_rb_remove().
+ */
+static const oaindex_t rbuf_index = OAINDEX_INIT(rbuf_index_slots,
+                                                 _rbuf_index_hash_entry);
 
 static char l2addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
 
@@ -64,13 +66,11 @@ static msg_t _gc_timer_msg = { .type = GNRC_SIXLOWPAN_FRAG_RB_GC_MSG };
 /* ------------------------------------
  * internal function definitions
  * ------------------------------------*/
-/* checks whether start and end overlaps, but not identical to, given interval i */
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
-                                               uint16_t start, uint16_t end);
-/* gets a free entry from interval buffer */
-static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void);
+/* finds the first interval of entry that ends at or after offset */
+static unsigned _rbuf_int_find(const gnrc_sixlowpan_frag_rb_t *entry,
+                               uint16_t offset);
 /* update interval buffer of entry */
-static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
+static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_t *entry,
                               uint16_t offset, size_t frag_size);
 /* gets an entry identified by its tuple */
 static int _rbuf_get(const void *src, size_t src_len,
@@ -92,30 +92,29 @@ enum {
     RBUF_ADD_DUPLICATE = -3,
 };
 
-static int _check_fragments(gnrc_sixlowpan_frag_rb_base_t *entry,
+static int _check_fragments(const gnrc_sixlowpan_frag_rb_t *entry,
                             size_t frag_size, size_t offset)
 {
-    gnrc_sixlowpan_frag_rb_int_t *ptr = entry->ints;
+    uint16_t end = (uint16_t)(offset + frag_size - 1);
+    unsigned i = _rbuf_int_find(entry, offset);
 
+    /* the intervals are disjoint and sorted, so only the first interval
+     * ending at or after offset may overlap the fragment */
+    if ((i >= entry->ints_numof) || (entry->ints[i].start > end)) {
+        return RBUF_ADD_SUCCESS;
+    }
+    if ((entry->ints[i].start == offset) && (entry->ints[i].end == end)) {
+        DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
+        return RBUF_ADD_DUPLICATE;
+    }
     /* If the fragment overlaps another fragment and differs in either the size
      * or the offset of the overlapped fragment, discards the datagram
+     * https://tools.ietf.org/html/rfc4944#section-5.3
+     *
+     * "A fresh reassembly may be commenced with the most recently
+     * received link fragment"
      * https://tools.ietf.org/html/rfc4944#section-5.3 */
-    while (ptr != NULL) {
-        if (_rbuf_int_overlap_partially(ptr, offset, offset + frag_size - 1)) {
-
-            /* "A fresh reassembly may be commenced with the most recently
-             * received link fragment"
-             * https://tools.ietf.org/html/rfc4944#section-5.3 */
-            return RBUF_ADD_REPEAT;
-        }
-        /* End was already checked in overlap check */
-        if (ptr->start == offset) {
-            DEBUG("6lo rbuf: fragment already in reassembly buffer\n");
-            return RBUF_ADD_DUPLICATE;
-        }
-        ptr = ptr->next;
-    }
-    return RBUF_ADD_SUCCESS;
+    return RBUF_ADD_REPEAT;
 }
 
 gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_add(gnrc_netif_hdr_t *netif_hdr,
@@ -144,6 +143,12 @@ bool gnrc_sixlowpan_frag_rb_exists(const gnrc_netif_hdr_t *netif_hdr,
     return (_rbuf_get_by_tag(netif_hdr, tag) != NULL);
 }
 
+gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_get_by_datagram(
+        const gnrc_netif_hdr_t *netif_hdr, uint16_t tag)
+{
+    return _rbuf_get_by_tag(netif_hdr, tag);
+}
+
 void gnrc_sixlowpan_frag_rb_rm_by_datagram(const gnrc_netif_hdr_t *netif_hdr,
                                            uint16_t tag)
 {
@@ -155,42 +160,124 @@ void gnrc_sixlowpan_frag_rb_rm_by_datagram(const gnrc_netif_hdr_t *netif_hdr,
     }
 }
 
-static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
-                                                  uint16_t tag)
+static uint32_t _fnv1a(uint32_t hash, const uint8_t *data, size_t len)
 {
-    assert(netif_hdr != NULL);
-    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
-    const uint8_t *dst = gnrc_netif_hdr_get_dst_addr(netif_hdr);
-    const uint8_t src_len = netif_hdr->src_l2addr_len;
-    const uint8_t dst_len = netif_hdr->dst_l2addr_len;
+    for (unsigned i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return hash;
+}
 
-    for (unsigned i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        gnrc_sixlowpan_frag_rb_t *e = &rbuf[i];
+static uint32_t _rbuf_index_hash(const void *src, size_t src_len,
+                                 const void *dst, size_t dst_len,
+                                 uint16_t tag)
+{
+    uint32_t hash = 2166136261U;
+
+    hash = _fnv1a(hash, src, src_len);
+    hash = _fnv1a(hash, dst, dst_len);
+    hash = _fnv1a(hash, (uint8_t *)&tag, sizeof(tag));
+    return hash;
+}
+
+static uint32_t _rbuf_index_hash_entry(unsigned entry)
+{
+    const gnrc_sixlowpan_frag_rb_t *e = &rbuf[entry];
+
+    return _rbuf_index_hash(e->super.src, e->super.src_len,
+                            e->super.dst, e->super.dst_len, e->super.tag);
+}
+
+static inline void _rbuf_index_add(const gnrc_sixlowpan_frag_rb_t *e)
+{
+    oaindex_add(&rbuf_index, e - rbuf);
+}
 
-        if ((e->pkt != NULL) && (e->super.tag == tag) &&
+static inline void _rbuf_index_del(const gnrc_sixlowpan_frag_rb_t *e)
+{
+    oaindex_del(&rbuf_index, e - rbuf);
+}
+
+/* Gets the indexed entry for the datagram that comes first in rbuf, as the
+ * linear searches did. A size of 0 matches any datagram size. */
+static gnrc_sixlowpan_frag_rb_t *_rbuf_index_get(const void *src,
+                                                 size_t src_len,
+                                                 const void *dst,
+                                                 size_t dst_len,
+                                                 size_t size, uint16_t tag)
+{
+    gnrc_sixlowpan_frag_rb_t *res = NULL;
+
+    uint32_t hash = _rbuf_index_hash(src, src_len, dst, dst_len, tag);
+
+    for (unsigned slot = oaindex_first(&rbuf_index, hash);
+         !oaindex_free(&rbuf_index, slot);
+         slot = oaindex_next(&rbuf_index, slot)) {
+        gnrc_sixlowpan_frag_rb_t *e = &rbuf[oaindex_entry(&rbuf_index, slot)];
+
+        if (((res == NULL) || (e < res)) && (e->pkt != NULL) &&
+            ((size == 0) || (e->super.datagram_size == size)) &&
+            (e->super.tag == tag) &&
             (e->super.src_len == src_len) &&
             (e->super.dst_len == dst_len) &&
             (memcmp(e->super.src, src, src_len) == 0) &&
             (memcmp(e->super.dst, dst, dst_len) == 0)) {
-            return e;
+            res = e;
         }
     }
-    return NULL;
+    return res;
+}
+
+static gnrc_sixlowpan_frag_rb_t *_rbuf_get_by_tag(const gnrc_netif_hdr_t *netif_hdr,
+                                                  uint16_t tag)
+{
+    assert(netif_hdr != NULL);
+    return _rbuf_index_get(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                           netif_hdr->src_l2addr_len,
+                           gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                           netif_hdr->dst_l2addr_len, 0, tag);
+}
+
+static inline bool _is_rfrag(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    return sixlowpan_sfr_rfrag_is(pkt->data);
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+    (void)pkt;
+    return false;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 }
 
 #ifndef NDEBUG
 static bool _valid_offset(gnrc_pktsnip_t *pkt, size_t offset)
 {
-    return (sixlowpan_frag_1_is(pkt->data) && (offset == 0)) ||
+    /* the offset of a recoverable fragment refers to the compressed datagram,
+     * so only the caller can map it */
+    return _is_rfrag(pkt) ||
+           (sixlowpan_frag_1_is(pkt->data) && (offset == 0)) ||
            (sixlowpan_frag_n_is(pkt->data) &&
             (offset == sixlowpan_frag_offset(pkt->data)));
 }
 #endif
 
+/* size of the fragmentation header of a fragment that starts the datagram */
+static size_t _6lo_frag_hdr_size(gnrc_pktsnip_t *pkt)
+{
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (_is_rfrag(pkt)) {
+        return sizeof(sixlowpan_sfr_rfrag_t);
+    }
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+    (void)pkt;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+    return sizeof(sixlowpan_frag_t);
+}
+
 static uint8_t *_6lo_frag_payload(gnrc_pktsnip_t *pkt)
 {
-    if (sixlowpan_frag_1_is(pkt->data)) {
-        return ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_t);
+    if (_is_rfrag(pkt) || sixlowpan_frag_1_is(pkt->data)) {
+        return ((uint8_t *)pkt->data) + _6lo_frag_hdr_size(pkt);
     }
     else {
         return ((uint8_t *)pkt->data) + sizeof(sixlowpan_frag_n_t);
@@ -201,7 +288,13 @@ static size_t _6lo_frag_size(gnrc_pktsnip_t *pkt, size_t offset, uint8_t *data)
 {
     size_t frag_size;
 
-    if (offset == 0) {
+    if (_is_rfrag(pkt)) {
+        frag_size = pkt->size - _6lo_frag_hdr_size(pkt);
+        if ((offset == 0) && (data[0] == SIXLOWPAN_UNCOMP)) {
+            frag_size--;
+        }
+    }
+    else if (offset == 0) {
         frag_size = pkt->size - sizeof(sixlowpan_frag_t);
         if (data[0] == SIXLOWPAN_UNCOMP) {
             /* subtract SIXLOWPAN_UNCOMP byte from fragment size,
@@ -229,8 +322,33 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     assert(_valid_offset(pkt, offset));
     data = _6lo_frag_payload(pkt);
     frag_size = _6lo_frag_size(pkt, offset, data);
-    datagram_size = sixlowpan_frag_datagram_size(pkt->data);
-    datagram_tag = sixlowpan_frag_datagram_tag(pkt->data);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (_is_rfrag(pkt)) {
+        sixlowpan_sfr_rfrag_t *rfrag = pkt->data;
+
+        datagram_tag = rfrag->base.tag;
+        if (sixlowpan_sfr_rfrag_get_seq(rfrag) == 0) {
+            /* the first fragment carries the datagram size in its offset
+             * field */
+            datagram_size = sixlowpan_sfr_rfrag_get_offset(rfrag);
+        }
+        else {
+            /* all other fragments can only be added to an existing entry */
+            entry = _rbuf_get_by_tag(netif_hdr, datagram_tag);
+            if (entry == NULL) {
+                DEBUG("6lo rbuf: no entry for recoverable fragment.\n");
+                gnrc_pktbuf_release(pkt);
+                return RBUF_ADD_ERROR;
+            }
+            datagram_size = entry->super.datagram_size;
+        }
+    }
+    else
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
+    {
+        datagram_size = sixlowpan_frag_datagram_size(pkt->data);
+        datagram_tag = sixlowpan_frag_datagram_tag(pkt->data);
+    }
 
     gnrc_sixlowpan_frag_rb_gc();
     res = _rbuf_get(gnrc_netif_hdr_get_src_addr(netif_hdr), netif_hdr->src_l2addr_len,
@@ -251,7 +369,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
         return RBUF_ADD_ERROR;
     }
 
-    switch (_check_fragments(&entry->super, frag_size, offset)) {
+    switch (_check_fragments(entry, frag_size, offset)) {
         case RBUF_ADD_REPEAT:
             DEBUG("6lo rfrag: overlapping intervals, discarding datagram\n");
             gnrc_pktbuf_release(entry->pkt);
@@ -264,7 +382,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             break;
     }
 
-    if (_rbuf_update_ints(&entry->super, offset, frag_size)) {
+    if (_rbuf_update_ints(entry, offset, frag_size)) {
         DEBUG("6lo rbuf: add fragment data\n");
         entry->super.current_size += (uint16_t)frag_size;
         if (offset == 0) {
@@ -272,7 +390,7 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             if (sixlowpan_iphc_is(data)) {
                 DEBUG("6lo rbuf: detected IPHC header.\n");
                 gnrc_pktsnip_t *frag_hdr = gnrc_pktbuf_mark(pkt,
-                        sizeof(sixlowpan_frag_t), GNRC_NETTYPE_SIXLOWPAN);
+                        _6lo_frag_hdr_size(pkt), GNRC_NETTYPE_SIXLOWPAN);
                 if (frag_hdr == NULL) {
                     DEBUG("6lo rbuf: unable to mark fragment header. "
                           "aborting reassembly.\n");
@@ -297,6 +415,11 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
             if (data[0] == SIXLOWPAN_UNCOMP) {
                 DEBUG("6lo rbuf: detected uncompressed datagram\n");
                 data++;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+                /* later recoverable fragments count the dispatch in their
+                 * offset */
+                entry->super.offset_diff = -1;
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
             }
         }
         memcpy(((uint8_t *)entry->pkt->data) + offset, data,
@@ -313,51 +436,53 @@ static int _rbuf_add(gnrc_netif_hdr_t *netif_hdr, gnrc_pktsnip_t *pkt,
     return res;
 }
 
-static inline bool _rbuf_int_overlap_partially(gnrc_sixlowpan_frag_rb_int_t *i,
-                                               uint16_t start, uint16_t end)
+static unsigned _rbuf_int_find(const gnrc_sixlowpan_frag_rb_t *entry,
+                               uint16_t offset)
 {
-    /* start and ends are both inclusive, so using <= for both */
-    return ((i->start <= end) && (start <= i->end)) && /* overlaps */
-        ((start != i->start) || (end != i->end)); /* not identical */
-}
+    unsigned lo = 0, hi = entry->ints_numof;
 
-static gnrc_sixlowpan_frag_rb_int_t *_rbuf_int_get_free(void)
-{
-    for (unsigned int i = 0; i < RBUF_INT_SIZE; i++) {
-        if (rbuf_int[i].end == 0) { /* start must be smaller than end anyways*/
-            return rbuf_int + i;
+    /* the intervals are disjoint and sorted by start, so they are also sorted
+     * by end */
+    while (lo < hi) {
+        unsigned mid = (lo + hi) / 2;
+
+        if (entry->ints[mid].end < offset) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
         }
     }
-
-    return NULL;
+    return lo;
 }
 
-static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_base_t *entry,
+static bool _rbuf_update_ints(gnrc_sixlowpan_frag_rb_t *entry,
                               uint16_t offset, size_t frag_size)
 {
-    gnrc_sixlowpan_frag_rb_int_t *new;
     uint16_t end = (uint16_t)(offset + frag_size - 1);
+    unsigned i;
 
-    new = _rbuf_int_get_free();
-
-    if (new == NULL) {
+    if (entry->ints_numof >= ARRAY_SIZE(entry->ints)) {
         DEBUG("6lo rfrag: no space left in rbuf interval buffer.\n");
         return false;
     }
-
-    new->start = offset;
-    new->end = end;
+    /* _check_fragments() made sure the fragment does not overlap any
+     * interval */
+    i = _rbuf_int_find(entry, offset);
+    memmove(&entry->ints[i + 1], &entry->ints[i],
+            (entry->ints_numof - i) * sizeof(entry->ints[0]));
+    entry->ints[i].start = offset;
+    entry->ints[i].end = end;
+    entry->ints_numof++;
 
     DEBUG("6lo rfrag: add interval (%" PRIu16 ", %" PRIu16 ") to entry (%s, ",
-          new->start, new->end, gnrc_netif_addr_to_str(entry->src,
-                                                       entry->src_len,
-                                                       l2addr_str));
-    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->dst,
-                                                  entry->dst_len,
+          offset, end, gnrc_netif_addr_to_str(entry->super.src,
+                                              entry->super.src_len,
+                                              l2addr_str));
+    DEBUG("%s, %u, %u)\n", gnrc_netif_addr_to_str(entry->super.dst,
+                                                  entry->super.dst_len,
                                                   l2addr_str),
-          entry->datagram_size, entry->tag);
-
-    LL_PREPEND(entry->ints, new);
+          entry->super.datagram_size, entry->super.tag);
 
     return true;
 }
@@ -417,35 +542,30 @@ static int _rbuf_get(const void *src, size_t src_len,
     gnrc_sixlowpan_frag_rb_t *res = NULL, *oldest = NULL;
     uint32_t now_usec = xtimer_now_usec();
 
-    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
-        /* check first if entry already available */
-        if ((rbuf[i].pkt != NULL) && (rbuf[i].super.datagram_size == size) &&
-            (rbuf[i].super.tag == tag) && (rbuf[i].super.src_len == src_len) &&
-            (rbuf[i].super.dst_len == dst_len) &&
-            (memcmp(rbuf[i].super.src, src, src_len) == 0) &&
-            (memcmp(rbuf[i].super.dst, dst, dst_len) == 0)) {
-            DEBUG("6lo rfrag: entry %p (%s, ", (void *)(&rbuf[i]),
-                  gnrc_netif_addr_to_str(rbuf[i].super.src,
-                                         rbuf[i].super.src_len,
-                                         l2addr_str));
-            DEBUG("%s, %u, %u) found\n",
-                  gnrc_netif_addr_to_str(rbuf[i].super.dst,
-                                         rbuf[i].super.dst_len,
-                                         l2addr_str),
-                  (unsigned)rbuf[i].super.datagram_size, rbuf[i].super.tag);
+    /* check first if entry already available */
+    res = _rbuf_index_get(src, src_len, dst, dst_len, size, tag);
+    if (res != NULL) {
+        DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
+              gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
+                                     l2addr_str));
+        DEBUG("%s, %u, %u) found\n",
+              gnrc_netif_addr_to_str(res->super.dst, res->super.dst_len,
+                                     l2addr_str),
+              (unsigned)res->super.datagram_size, res->super.tag);
 #if CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0
-            if (rbuf[i].super.current_size == 0) {
-                /* ensure that only empty reassembly buffer entries and entries
-                 * scheduled for deletion have `current_size == 0` */
-                DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
-                return -1;
-            }
-#endif
-            rbuf[i].super.arrival = now_usec;
-            _set_rbuf_timeout();
-            return i;
+        if (res->super.current_size == 0) {
+            /* ensure that only empty reassembly buffer entries and entries
+             * scheduled for deletion have `current_size == 0` */
+            DEBUG("6lo rfrag: scheduled for deletion, don't add fragment\n");
+            return -1;
         }
+#endif
+        res->super.arrival = now_usec;
+        _set_rbuf_timeout();
+        return res - &(rbuf[0]);
+    }
 
+    for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         /* if there is a free spot: remember it */
         if ((res == NULL) && gnrc_sixlowpan_frag_rb_entry_empty(&rbuf[i])) {
             res = &(rbuf[i]);
@@ -514,6 +634,11 @@ static int _rbuf_get(const void *src, size_t src_len,
     res->super.dst_len = dst_len;
     res->super.tag = tag;
     res->super.current_size = 0;
+    res->ints_numof = 0;
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    res->super.offset_diff = 0;
+    memset(res->received, 0, sizeof(res->received));
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 
     DEBUG("6lo rfrag: entry %p (%s, ", (void *)res,
           gnrc_netif_addr_to_str(res->super.src, res->super.src_len,
@@ -523,6 +648,7 @@ static int _rbuf_get(const void *src, size_t src_len,
                                  l2addr_str), res->super.datagram_size,
           res->super.tag);
 
+    _rbuf_index_add(res);
     _set_rbuf_timeout();
 
     return res - &(rbuf[0]);
@@ -532,7 +658,7 @@ static int _rbuf_get(const void *src, size_t src_len,
 void gnrc_sixlowpan_frag_rb_reset(void)
 {
     xtimer_remove(&_gc_timer);
-    memset(rbuf_int, 0, sizeof(rbuf_int));
+    oaindex_clear(&rbuf_index);
     for (unsigned int i = 0; i < CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_SIZE; i++) {
         if ((rbuf[i].pkt != NULL) &&
             (rbuf[i].pkt->users > 0)) {
@@ -550,15 +676,18 @@ const gnrc_sixlowpan_frag_rb_t *gnrc_sixlowpan_frag_rb_array(void)
 
 void gnrc_sixlowpan_frag_rb_base_rm(gnrc_sixlowpan_frag_rb_base_t *entry)
 {
-    while (entry->ints != NULL) {
-        gnrc_sixlowpan_frag_rb_int_t *next = entry->ints->next;
+    entry->datagram_size = 0;
+}
 
-        entry->ints->start = 0;
-        entry->ints->end = 0;
-        entry->ints->next = NULL;
-        entry->ints = next;
+void gnrc_sixlowpan_frag_rb_remove(gnrc_sixlowpan_frag_rb_t *rbuf)
+{
+    assert(rbuf != NULL);
+    if (rbuf->pkt != NULL) {
+        _rbuf_index_del(rbuf);
     }
-    entry->datagram_size = 0;
+    gnrc_sixlowpan_frag_rb_base_rm(&rbuf->super);
+    rbuf->ints_numof = 0;
+    rbuf->pkt = NULL;
 }
 
 static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
@@ -583,14 +712,7 @@ static void _tmp_rm(gnrc_sixlowpan_frag_rb_t *rbuf)
 #if IS_USED(MODULE_GNRC_SIXLOWPAN_FRAG_STATS)
 static inline unsigned _count_frags(gnrc_sixlowpan_frag_rb_t *rbuf)
 {
-    unsigned frags = 0;
-    gnrc_sixlowpan_frag_rb_int_t *frag = rbuf->super.ints;
-
-    while (frag) {
-        frag = frag->next;
-        frags++;
-    }
-    return frags;
+    return rbuf->ints_numof;
 }
 #endif
 
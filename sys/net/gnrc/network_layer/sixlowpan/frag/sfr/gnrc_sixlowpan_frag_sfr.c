@@ -0,0 +1,662 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "bitfield.h"
+#include "net/ieee802154.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan.h"
+#include "net/gnrc/sixlowpan/config.h"
+#include "net/gnrc/sixlowpan/frag/fb.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+#include "net/sixlowpan/sfr.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+#define _FRAGS_SIZE     (CONFIG_GNRC_SIXLOWPAN_FRAG_FB_SIZE * \
+                         GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE)
+
+/**
+ * @brief   Descriptors of the fragments in flight, shared by all
+ *          fragmentation buffer entries
+ *
+ * gnrc_sixlowpan_frag_sfr_frag_t::size == 0 marks a free descriptor.
+ */
+static gnrc_sixlowpan_frag_sfr_frag_t _frags[_FRAGS_SIZE];
+
+static char addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
+
+static inline size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static gnrc_sixlowpan_frag_sfr_frag_t *_frag_get_free(void)
+{
+    for (unsigned i = 0; i < _FRAGS_SIZE; i++) {
+        if (_frags[i].size == 0) {
+            return &_frags[i];
+        }
+    }
+    return NULL;
+}
+
+static int _frag_is_pending(clist_node_t *node, void *arg)
+{
+    (void)arg;
+    return ((gnrc_sixlowpan_frag_sfr_frag_t *)node)->pending;
+}
+
+static inline gnrc_sixlowpan_frag_sfr_frag_t *_next_pending(
+        gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    return (gnrc_sixlowpan_frag_sfr_frag_t *)clist_foreach(&fbuf->sfr.window,
+                                                           _frag_is_pending,
+                                                           NULL);
+}
+
+static void _clean_up(gnrc_sixlowpan_frag_fb_t *fbuf, int error)
+{
+    clist_node_t *node;
+
+    xtimer_remove(&fbuf->sfr.arq_timer);
+    xtimer_remove(&fbuf->sfr.gap_timer);
+    while ((node = clist_lpop(&fbuf->sfr.window))) {
+        ((gnrc_sixlowpan_frag_sfr_frag_t *)node)->size = 0;
+    }
+    fbuf->sfr.arq_armed = false;
+    if (error) {
+        gnrc_pktbuf_release_error(fbuf->pkt, error);
+    }
+    else {
+        gnrc_pktbuf_release(fbuf->pkt);
+    }
+    fbuf->pkt = NULL;
+}
+
+static void _copy_pkt(uint8_t *data, const gnrc_pktsnip_t *pkt, size_t offset,
+                      size_t len)
+{
+    while ((pkt != NULL) && (len > 0)) {
+        if (offset >= pkt->size) {
+            offset -= pkt->size;
+        }
+        else {
+            size_t clen = _min(pkt->size - offset, len);
+
+            memcpy(data, ((uint8_t *)pkt->data) + offset, clen);
+            data += clen;
+            len -= clen;
+            offset = 0;
+        }
+        pkt = pkt->next;
+    }
+}
+
+static gnrc_pktsnip_t *_build_frag_pkt(gnrc_sixlowpan_frag_fb_t *fbuf,
+                                       const gnrc_sixlowpan_frag_sfr_frag_t *frag,
+                                       bool ack_req)
+{
+    gnrc_netif_hdr_t *netif_hdr = fbuf->pkt->data, *new_netif_hdr;
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_sfr_rfrag_t *hdr;
+
+    netif = gnrc_netif_hdr_build(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len,
+                                 gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                                 netif_hdr->dst_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: error allocating new link-layer header\n");
+        return NULL;
+    }
+    new_netif_hdr = netif->data;
+    /* src_l2addr_len and dst_l2addr_len are already the same, now copy the rest */
+    *new_netif_hdr = *netif_hdr;
+    if (ack_req) {
+        new_netif_hdr->flags &= ~GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+    else {
+        /* Tell the link layer that we will send more fragments */
+        new_netif_hdr->flags |= GNRC_NETIF_HDR_FLAGS_MORE_DATA;
+    }
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_rfrag_t) + frag->size,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        DEBUG("6lo sfr: error allocating fragment\n");
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    hdr = pkt->data;
+    hdr->base.disp_ecn = 0;
+    sixlowpan_sfr_rfrag_set_disp(&hdr->base);
+    hdr->base.tag = (uint8_t)fbuf->tag;
+    hdr->ar_seq_fs.u16 = 0;
+    if (ack_req) {
+        sixlowpan_sfr_rfrag_set_ack_req(hdr);
+    }
+    sixlowpan_sfr_rfrag_set_seq(hdr, frag->seq);
+    sixlowpan_sfr_rfrag_set_frag_size(hdr, frag->size);
+    /* the first fragment carries the size of the uncompressed datagram
+     * instead of its offset */
+    sixlowpan_sfr_rfrag_set_offset(hdr, (frag->seq == 0) ? fbuf->datagram_size
+                                                         : frag->offset);
+    /* don't copy netif header */
+    _copy_pkt((uint8_t *)(hdr + 1), fbuf->pkt->next, frag->offset, frag->size);
+    LL_PREPEND(pkt, netif);
+    return pkt;
+}
+
+static void _arm_arq_timer(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    uint32_t timeout = fbuf->sfr.arq_timeout * US_PER_MS;
+
+    fbuf->sfr.arq_armed = true;
+    fbuf->sfr.arq_deadline = xtimer_now_usec() + timeout;
+    fbuf->sfr.arq_msg.type = GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG;
+    fbuf->sfr.arq_msg.content.ptr = fbuf;
+    xtimer_set_msg(&fbuf->sfr.arq_timer, timeout, &fbuf->sfr.arq_msg,
+                   gnrc_sixlowpan_get_pid());
+}
+
+static bool _schedule_next(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    if (GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US == 0) {
+        return gnrc_sixlowpan_frag_fb_send(fbuf);
+    }
+    fbuf->sfr.gap_msg.type = GNRC_SIXLOWPAN_FRAG_FB_SND_MSG;
+    fbuf->sfr.gap_msg.content.ptr = fbuf;
+    xtimer_set_msg(&fbuf->sfr.gap_timer, GNRC_SIXLOWPAN_SFR_INTER_FRAME_GAP_US,
+                   &fbuf->sfr.gap_msg, gnrc_sixlowpan_get_pid());
+    return true;
+}
+
+void gnrc_sixlowpan_frag_sfr_send(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    assert(ctx != NULL);
+    gnrc_sixlowpan_frag_fb_t *fbuf = ctx;
+    gnrc_sixlowpan_frag_sfr_frag_t *frag;
+    gnrc_pktsnip_t *frag_pkt;
+    gnrc_netif_t *netif;
+    size_t payload_len;
+    bool window_closed;
+
+    assert((fbuf->pkt == pkt) || (pkt == NULL));
+    (void)pkt;
+    (void)page;
+    if (fbuf->pkt == NULL) {
+        /* datagram was acknowledged or aborted while the inter-frame gap
+         * elapsed */
+        return;
+    }
+    netif = gnrc_netif_hdr_get_netif(fbuf->pkt->data);
+    assert(netif != NULL);
+    payload_len = gnrc_pkt_len(fbuf->pkt->next);
+    /* fragments to be recovered first */
+    if ((frag = _next_pending(fbuf)) == NULL) {
+        size_t max_size = _min(netif->sixlo.max_frag_size,
+                               GNRC_SIXLOWPAN_SFR_OPT_FRAG_SIZE) -
+                          sizeof(sixlowpan_sfr_rfrag_t);
+
+        if ((clist_count(&fbuf->sfr.window) >= GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE) ||
+            (fbuf->offset >= payload_len)) {
+            /* wait for acknowledgment */
+            return;
+        }
+        if (fbuf->sfr.cur_seq > SIXLOWPAN_SFR_SEQ_MAX) {
+            DEBUG("6lo sfr: datagram needs too many fragments\n");
+            _clean_up(fbuf, EMSGSIZE);
+            return;
+        }
+        if ((frag = _frag_get_free()) == NULL) {
+            DEBUG("6lo sfr: no space left for fragment descriptor\n");
+            _clean_up(fbuf, ENOMEM);
+            return;
+        }
+        frag->offset = fbuf->offset;
+        frag->size = _min(max_size, payload_len - fbuf->offset);
+        frag->seq = fbuf->sfr.cur_seq++;
+        frag->retries = 0;
+        clist_rpush(&fbuf->sfr.window, &frag->super);
+        fbuf->offset += frag->size;
+    }
+    frag->pending = false;
+    /* request an acknowledgment with the last fragment of a burst */
+    window_closed = (_next_pending(fbuf) == NULL) &&
+        ((clist_count(&fbuf->sfr.window) >= GNRC_SIXLOWPAN_SFR_OPT_WIN_SIZE) ||
+         (fbuf->offset >= payload_len));
+    if ((frag_pkt = _build_frag_pkt(fbuf, frag, window_closed)) == NULL) {
+        _clean_up(fbuf, ENOMEM);
+        return;
+    }
+    DEBUG("6lo sfr: send fragment (tag: %u, seq: %u, offset: %u, size: %u%s)\n",
+          (unsigned)fbuf->tag, frag->seq, frag->offset, frag->size,
+          (window_closed) ? ", ack requested" : "");
+    gnrc_sixlowpan_dispatch_send(frag_pkt, NULL, 0);
+    if (window_closed) {
+        _arm_arq_timer(fbuf);
+    }
+    else if (!_schedule_next(fbuf)) {
+        DEBUG("6lo sfr: message queue full, can't issue next fragment "
+              "sending\n");
+        _clean_up(fbuf, ENOMEM);
+    }
+}
+
+void gnrc_sixlowpan_frag_sfr_arq_timeout(gnrc_sixlowpan_frag_fb_t *fbuf)
+{
+    gnrc_sixlowpan_frag_sfr_frag_t *last;
+
+    if ((fbuf->pkt == NULL) || !fbuf->sfr.arq_armed ||
+        ((int32_t)(xtimer_now_usec() - fbuf->sfr.arq_deadline) < 0)) {
+        /* stale timeout of an acknowledged or re-armed window */
+        return;
+    }
+    fbuf->sfr.arq_armed = false;
+    last = (gnrc_sixlowpan_frag_sfr_frag_t *)clist_rpeek(&fbuf->sfr.window);
+    if ((last == NULL) || (++last->retries > GNRC_SIXLOWPAN_SFR_FRAG_RETRIES)) {
+        DEBUG("6lo sfr: no acknowledgment for datagram %u, aborting\n",
+              (unsigned)fbuf->tag);
+        _clean_up(fbuf, ETIMEDOUT);
+        return;
+    }
+    /* the acknowledgment or the fragment requesting it was lost: resend the
+     * last fragment to solicit the acknowledgment again */
+    last->pending = true;
+    fbuf->sfr.arq_timeout = _min(fbuf->sfr.arq_timeout * 2U,
+                                 GNRC_SIXLOWPAN_SFR_MAX_ARQ_TIMEOUT_MS);
+    gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, 0);
+}
+
+static bool _bitmap_full(const sixlowpan_sfr_ack_t *ack)
+{
+    for (unsigned i = 0; i < sizeof(ack->bitmap); i++) {
+        if (ack->bitmap[i] != UINT8_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _bitmap_null(const sixlowpan_sfr_ack_t *ack)
+{
+    for (unsigned i = 0; i < sizeof(ack->bitmap); i++) {
+        if (ack->bitmap[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void _handle_ack(gnrc_sixlowpan_frag_fb_t *fbuf,
+                        sixlowpan_sfr_ack_t *ack)
+{
+    clist_node_t *node, *next;
+    bool waiting = fbuf->sfr.arq_armed;
+    size_t count;
+
+    if (_bitmap_null(ack)) {
+        DEBUG("6lo sfr: datagram %u aborted by receiver\n",
+              (unsigned)fbuf->tag);
+        _clean_up(fbuf, ECONNABORTED);
+        return;
+    }
+    if (_bitmap_full(ack)) {
+        DEBUG("6lo sfr: datagram %u completely acknowledged\n",
+              (unsigned)fbuf->tag);
+        _clean_up(fbuf, 0);
+        return;
+    }
+    /* free acknowledged fragments and mark the others for recovery, but only
+     * if they were already sent */
+    count = clist_count(&fbuf->sfr.window);
+    node = clist_lpeek(&fbuf->sfr.window);
+    for (size_t i = 0; i < count; i++, node = next) {
+        gnrc_sixlowpan_frag_sfr_frag_t *frag = (gnrc_sixlowpan_frag_sfr_frag_t *)node;
+
+        next = node->next;
+        if (bf_isset(ack->bitmap, frag->seq)) {
+            clist_remove(&fbuf->sfr.window, node);
+            frag->size = 0;
+        }
+        else if (waiting && !frag->pending) {
+            if (++frag->retries > GNRC_SIXLOWPAN_SFR_FRAG_RETRIES) {
+                DEBUG("6lo sfr: fragment %u of datagram %u lost too often, "
+                      "aborting\n", frag->seq, (unsigned)fbuf->tag);
+                _clean_up(fbuf, ETIMEDOUT);
+                return;
+            }
+            frag->pending = true;
+        }
+    }
+    /* otherwise the burst in progress continues on its own */
+    if (waiting) {
+        xtimer_remove(&fbuf->sfr.arq_timer);
+        fbuf->sfr.arq_armed = false;
+        if ((clist_lpeek(&fbuf->sfr.window) == NULL) &&
+            (fbuf->offset >= gnrc_pkt_len(fbuf->pkt->next))) {
+            _clean_up(fbuf, 0);
+            return;
+        }
+        gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, 0);
+    }
+}
+
+static void _send_ack(gnrc_netif_hdr_t *netif_hdr, uint8_t tag,
+                      const uint8_t *bitmap)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    sixlowpan_sfr_ack_t *ack;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(sixlowpan_sfr_ack_t),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    if (pkt == NULL) {
+        DEBUG("6lo sfr: unable to allocate acknowledgment\n");
+        return;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0,
+                                 gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: unable to allocate netif header for acknowledgment\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    ((gnrc_netif_hdr_t *)netif->data)->if_pid = netif_hdr->if_pid;
+    ack = pkt->data;
+    ack->base.disp_ecn = 0;
+    sixlowpan_sfr_ack_set_disp(&ack->base);
+    ack->base.tag = tag;
+    if (bitmap == NULL) {
+        memset(ack->bitmap, UINT8_MAX, sizeof(ack->bitmap));
+    }
+    else {
+        memcpy(ack->bitmap, bitmap, sizeof(ack->bitmap));
+    }
+    DEBUG("6lo sfr: send acknowledgment for (%s, %u)\n",
+          gnrc_netif_addr_to_str(gnrc_netif_hdr_get_src_addr(netif_hdr),
+                                 netif_hdr->src_l2addr_len, addr_str),
+          tag);
+    LL_PREPEND(pkt, netif);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+}
+
+/* marks the fragment, dispatches the datagram once complete and acknowledges
+ * if requested by the sender or when the datagram is complete */
+static void _rbuf_update(gnrc_sixlowpan_frag_rb_t *rbe,
+                         gnrc_netif_hdr_t *netif_hdr, uint8_t tag, uint8_t seq,
+                         bool ack_req)
+{
+    bf_set(rbe->received, seq);
+    if (gnrc_sixlowpan_frag_rb_dispatch_when_complete(rbe, netif_hdr) != 0) {
+        /* rbe is removed or scheduled for deletion => full bitmap */
+        _send_ack(netif_hdr, tag, NULL);
+    }
+    else if (ack_req) {
+        _send_ack(netif_hdr, tag, rbe->received);
+    }
+}
+
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+static void _forward_rfrag(gnrc_pktsnip_t *pkt, gnrc_netif_hdr_t *netif_hdr,
+                           gnrc_sixlowpan_frag_vrb_t *vrbe)
+{
+    sixlowpan_sfr_rfrag_t *rfrag;
+    gnrc_pktsnip_t *netif;
+    gnrc_netif_hdr_t *new_netif_hdr;
+
+    /* pkt is writable after gnrc_pktbuf_start_write() in _receive() */
+    netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.dst, vrbe->super.dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: unable to allocate netif header for forwarding\n");
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    new_netif_hdr = netif->data;
+    gnrc_netif_hdr_set_netif(new_netif_hdr, vrbe->out_netif);
+    new_netif_hdr->flags = netif_hdr->flags;
+    rfrag = pkt->data;
+    rfrag->base.tag = (uint8_t)vrbe->out_tag;
+    sixlowpan_sfr_rfrag_set_offset(rfrag,
+                                   sixlowpan_sfr_rfrag_get_offset(rfrag) +
+                                   vrbe->super.offset_diff);
+    vrbe->super.arrival = xtimer_now_usec();
+    /* replace received netif header with the one to the next hop */
+    pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+    LL_PREPEND(pkt, netif);
+    DEBUG("6lo sfr: forward fragment %u to (%s, %u)\n",
+          sixlowpan_sfr_rfrag_get_seq(rfrag),
+          gnrc_netif_addr_to_str(vrbe->super.dst, vrbe->super.dst_len,
+                                 addr_str), (unsigned)rfrag->base.tag);
+    gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+}
+
+int gnrc_sixlowpan_frag_sfr_forward(gnrc_pktsnip_t *pkt,
+                                    sixlowpan_sfr_rfrag_t *rfrag,
+                                    gnrc_sixlowpan_frag_vrb_t *vrbe,
+                                    unsigned page)
+{
+    gnrc_pktsnip_t *netif, *frag;
+    sixlowpan_sfr_rfrag_t *new_rfrag;
+    size_t new_size = gnrc_pkt_len(pkt);
+
+    (void)page;
+    if (new_size > SIXLOWPAN_SFR_FRAG_SIZE_MAX) {
+        DEBUG("6lo sfr: recompressed fragment too big\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    frag = gnrc_pktbuf_add(pkt, NULL, sizeof(sixlowpan_sfr_rfrag_t),
+                           GNRC_NETTYPE_SIXLOWPAN);
+    if (frag == NULL) {
+        DEBUG("6lo sfr: unable to allocate forwarded fragment header\n");
+        gnrc_pktbuf_release(pkt);
+        return -ENOMEM;
+    }
+    netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.dst, vrbe->super.dst_len);
+    if (netif == NULL) {
+        DEBUG("6lo sfr: unable to allocate netif header for forwarding\n");
+        gnrc_pktbuf_release(frag);
+        return -ENOMEM;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, vrbe->out_netif);
+    new_rfrag = frag->data;
+    *new_rfrag = *rfrag;
+    new_rfrag->base.tag = (uint8_t)vrbe->out_tag;
+    sixlowpan_sfr_rfrag_set_frag_size(new_rfrag, new_size);
+    /* later fragments are shifted by the change in the size of the compressed
+     * headers */
+    vrbe->super.offset_diff = new_size -
+                              sixlowpan_sfr_rfrag_get_frag_size(rfrag);
+    LL_PREPEND(frag, netif);
+    DEBUG("6lo sfr: forward first fragment to (%s, %u)\n",
+          gnrc_netif_addr_to_str(vrbe->super.dst, vrbe->super.dst_len,
+                                 addr_str), (unsigned)new_rfrag->base.tag);
+    gnrc_sixlowpan_dispatch_send(frag, NULL, 0);
+    return 0;
+}
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+
+static void _recv_rfrag(gnrc_pktsnip_t *pkt, unsigned page)
+{
+    gnrc_pktsnip_t *netif = pkt->next;
+    gnrc_netif_hdr_t *netif_hdr = netif->data;
+    sixlowpan_sfr_rfrag_t *rfrag = pkt->data;
+    gnrc_sixlowpan_frag_rb_t *rbe;
+    uint8_t tag = rfrag->base.tag;
+    uint8_t seq = sixlowpan_sfr_rfrag_get_seq(rfrag);
+    bool ack_req = sixlowpan_sfr_rfrag_ack_req(rfrag);
+
+    rbe = gnrc_sixlowpan_frag_rb_get_by_datagram(netif_hdr, tag);
+    if ((rbe != NULL) && (rbe->super.current_size == 0)) {
+        /* datagram was already completed, but the acknowledgment got lost */
+        DEBUG("6lo sfr: fragment of completed datagram\n");
+        if (ack_req) {
+            _send_ack(netif_hdr, tag, NULL);
+        }
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    gnrc_pktbuf_hold(netif, 1); /* hold netif header to use it for the
+                                 * acknowledgment (rb_add() releases `pkt`) */
+    if (seq == 0) {
+        rbe = gnrc_sixlowpan_frag_rb_add(netif_hdr, pkt, 0, page);
+        if (rbe != NULL) {
+            _rbuf_update(rbe, netif_hdr, tag, seq, ack_req);
+        }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+        else {
+            gnrc_sixlowpan_frag_vrb_t *vrbe;
+
+            /* first fragment was forwarded by IPHC => remember where
+             * acknowledgments need to be relayed to */
+            vrbe = gnrc_sixlowpan_frag_vrb_get(
+                    gnrc_netif_hdr_get_src_addr(netif_hdr),
+                    netif_hdr->src_l2addr_len, tag);
+            if (vrbe != NULL) {
+                vrbe->in_netif = gnrc_netif_hdr_get_netif(netif_hdr);
+            }
+        }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    }
+    else if (rbe != NULL) {
+        int offset = sixlowpan_sfr_rfrag_get_offset(rfrag) +
+                     rbe->super.offset_diff;
+
+        if (offset <= 0) {
+            DEBUG("6lo sfr: invalid offset\n");
+            gnrc_pktbuf_release(pkt);
+        }
+        else if ((rbe = gnrc_sixlowpan_frag_rb_add(netif_hdr, pkt, offset,
+                                                   page)) != NULL) {
+            _rbuf_update(rbe, netif_hdr, tag, seq, ack_req);
+        }
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    else {
+        gnrc_sixlowpan_frag_vrb_t *vrbe = gnrc_sixlowpan_frag_vrb_get(
+                gnrc_netif_hdr_get_src_addr(netif_hdr),
+                netif_hdr->src_l2addr_len, tag);
+
+        if (vrbe != NULL) {
+            _forward_rfrag(pkt, netif_hdr, vrbe);
+        }
+        else {
+            DEBUG("6lo sfr: no state for fragment %u, dropping\n", seq);
+            gnrc_pktbuf_release(pkt);
+        }
+    }
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    else {
+        DEBUG("6lo sfr: no state for fragment %u, dropping\n", seq);
+        gnrc_pktbuf_release(pkt);
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    gnrc_pktbuf_release(netif);
+}
+
+static void _recv_ack(gnrc_pktsnip_t *pkt)
+{
+    gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
+    sixlowpan_sfr_ack_t *ack = pkt->data;
+    const uint8_t *src = gnrc_netif_hdr_get_src_addr(netif_hdr);
+    gnrc_sixlowpan_frag_fb_t *fbuf;
+
+    fbuf = gnrc_sixlowpan_frag_fb_get_by_tag(ack->base.tag);
+    if (fbuf != NULL) {
+        gnrc_netif_hdr_t *fbuf_hdr = fbuf->pkt->data;
+
+        if ((fbuf_hdr->dst_l2addr_len == netif_hdr->src_l2addr_len) &&
+            (memcmp(gnrc_netif_hdr_get_dst_addr(fbuf_hdr), src,
+                    netif_hdr->src_l2addr_len) == 0)) {
+            _handle_ack(fbuf, ack);
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+    }
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
+    gnrc_sixlowpan_frag_vrb_t *vrbe = gnrc_sixlowpan_frag_vrb_reverse(
+            gnrc_netif_hdr_get_netif(netif_hdr), src, netif_hdr->src_l2addr_len,
+            ack->base.tag);
+
+    if ((vrbe != NULL) && (vrbe->in_netif != NULL)) {
+        gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(NULL, 0, vrbe->super.src,
+                                                     vrbe->super.src_len);
+
+        if (netif == NULL) {
+            DEBUG("6lo sfr: unable to allocate netif header for forwarding\n");
+            gnrc_pktbuf_release(pkt);
+            return;
+        }
+        gnrc_netif_hdr_set_netif(netif->data, vrbe->in_netif);
+        ack->base.tag = vrbe->super.tag;
+        /* replace received netif header with the one to the previous hop */
+        pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
+        LL_PREPEND(pkt, netif);
+        if (_bitmap_full(ack) || _bitmap_null(ack)) {
+            /* datagram is done, no more fragments to forward */
+            gnrc_sixlowpan_frag_vrb_rm(vrbe);
+        }
+        else {
+            vrbe->super.arrival = xtimer_now_usec();
+        }
+        DEBUG("6lo sfr: forward acknowledgment to (%s, %u)\n",
+              gnrc_netif_addr_to_str(vrbe->super.src, vrbe->super.src_len,
+                                     addr_str), (unsigned)ack->base.tag);
+        gnrc_sixlowpan_dispatch_send(pkt, NULL, 0);
+        return;
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
+    DEBUG("6lo sfr: no datagram for acknowledgment (%s, %u)\n",
+          gnrc_netif_addr_to_str(src, netif_hdr->src_l2addr_len, addr_str),
+          ack->base.tag);
+    gnrc_pktbuf_release(pkt);
+}
+
+void gnrc_sixlowpan_frag_sfr_recv(gnrc_pktsnip_t *pkt, void *ctx,
+                                  unsigned page)
+{
+    sixlowpan_sfr_t *hdr = pkt->data;
+
+    (void)ctx;
+    assert((pkt->next != NULL) && (pkt->next->type == GNRC_NETTYPE_NETIF));
+    if (sixlowpan_sfr_rfrag_is(hdr) &&
+        (pkt->size > sizeof(sixlowpan_sfr_rfrag_t))) {
+        _recv_rfrag(pkt, page);
+    }
+    else if (sixlowpan_sfr_ack_is(hdr) &&
+             (pkt->size >= sizeof(sixlowpan_sfr_ack_t))) {
+        _recv_ack(pkt);
+    }
+    else {
+        DEBUG("6lo sfr: invalid selective fragment recovery header\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/** @} */
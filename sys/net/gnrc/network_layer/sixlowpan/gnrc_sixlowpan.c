@@ -21,6 +21,9 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/frag.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif
 #include "net/gnrc/sixlowpan/iphc.h"
 #include "net/gnrc/netif.h"
 #include "net/sixlowpan.h"
@@ -117,7 +120,7 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
         DEBUG("6lo: Dispatch for sending\n");
         gnrc_sixlowpan_dispatch_send(pkt, NULL, page);
     }
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG) || defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
     else if (orig_datagram_size <= SIXLOWPAN_FRAG_MAX_LEN) {
         DEBUG("6lo: Send fragmented (%u > %u)\n",
               (unsigned int)datagram_size, netif->sixlo.max_frag_size);
@@ -139,7 +142,17 @@ void gnrc_sixlowpan_multiplex_by_size(gnrc_pktsnip_t *pkt,
         fbuf->hint.fragsz = 0;
 #endif
 
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        /* recoverable fragments only have 8-bit tags */
+        fbuf->tag &= UINT8_MAX;
+        fbuf->sfr.window.next = NULL;
+        fbuf->sfr.cur_seq = 0;
+        fbuf->sfr.arq_armed = false;
+        fbuf->sfr.arq_timeout = GNRC_SIXLOWPAN_SFR_OPT_ARQ_TIMEOUT_MS;
+        gnrc_sixlowpan_frag_sfr_send(pkt, fbuf, page);
+#else   /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
         gnrc_sixlowpan_frag_send(pkt, fbuf, page);
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
     }
 #endif
     else {
@@ -219,6 +232,13 @@ static void _receive(gnrc_pktsnip_t *pkt)
         return;
     }
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    else if (sixlowpan_sfr_is((sixlowpan_sfr_t *)dispatch)) {
+        DEBUG("6lo: received 6LoWPAN recoverable fragment\n");
+        gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+        return;
+    }
+#endif
 #ifdef MODULE_GNRC_SIXLOWPAN_IPHC
     else if (sixlowpan_iphc_is(dispatch)) {
         DEBUG("6lo: received 6LoWPAN IPHC compressed datagram\n");
@@ -346,7 +366,9 @@ static void *_event_loop(void *args)
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_FB
             case GNRC_SIXLOWPAN_FRAG_FB_SND_MSG:
                 DEBUG("6lo: send fragmented event received\n");
-#ifdef MODULE_GNRC_SIXLOWPAN_FRAG
+#if defined(MODULE_GNRC_SIXLOWPAN_FRAG_SFR)
+                gnrc_sixlowpan_frag_sfr_send(NULL, msg.content.ptr, 0);
+#elif defined(MODULE_GNRC_SIXLOWPAN_FRAG)
                 gnrc_sixlowpan_frag_send(NULL, msg.content.ptr, 0);
 #else   /* MODULE_GNRC_SIXLOWPAN_FRAG_FB */
                 DEBUG("6lo: No fragmentation implementation available to sent\n");
@@ -360,6 +382,12 @@ static void *_event_loop(void *args)
                 gnrc_sixlowpan_frag_rb_gc();
                 break;
 #endif
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+            case GNRC_SIXLOWPAN_FRAG_SFR_ARQ_TIMEOUT_MSG:
+                DEBUG("6lo: selective fragment recovery timeout received\n");
+                gnrc_sixlowpan_frag_sfr_arq_timeout(msg.content.ptr);
+                break;
+#endif
 
             default:
                 DEBUG("6lo: operation not supported\n");
@@ -26,6 +26,9 @@
 #include "net/gnrc/sixlowpan.h"
 #include "net/gnrc/sixlowpan/ctx.h"
 #include "net/gnrc/sixlowpan/frag/rb.h"
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
 #include "net/gnrc/sixlowpan/frag/vrb.h"
 #endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_VRB */
@@ -136,6 +139,53 @@ static inline bool _context_overlaps_iid(gnrc_sixlowpan_ctx_t *ctx,
              (iid->uint8[(ctx->prefix_len / 8) - 8] & byte_mask[ctx->prefix_len % 8])));
 }
 
+/**
+ * @brief   Checks if the IID of @p addr is of format 0000:00ff:fe00:XXXX
+ *          (see https://tools.ietf.org/html/rfc6282#section-3.2.2)
+ */
+static inline bool _iid_is_short(const ipv6_addr_t *addr)
+{
+    return (byteorder_ntohl(addr->u32[2]) == 0x000000ff) &&
+           ((byteorder_ntohl(addr->u32[3]) & 0xffff0000) == 0xfe000000);
+}
+
+/**
+ * @brief   Sets the IID of @p addr to 0000:00ff:fe00:XXXX with XXXX taken
+ *          from the 16 bits carried inline at @p inline_id
+ */
+static inline void _iid_set_short(ipv6_addr_t *addr, const uint8_t *inline_id)
+{
+    addr->u32[2] = byteorder_htonl(0x000000ff);
+    addr->u32[3] = byteorder_htonl(0xfe000000 | (inline_id[0] << 8) |
+                                   inline_id[1]);
+}
+
+/**
+ * @brief   Looks up the context to compress the unicast-prefix-based
+ *          multicast address @p addr with
+ *          (see https://tools.ietf.org/html/rfc3306)
+ *
+ * @return  the context, NULL if @p addr can't be compressed with a context
+ */
+static gnrc_sixlowpan_ctx_t *_mcast_ctx_lookup(const ipv6_addr_t *addr)
+{
+    gnrc_sixlowpan_ctx_t *ctx;
+    ipv6_addr_t unicast_prefix = IPV6_ADDR_UNSPECIFIED;
+
+    /* ffXX::XXXX:XXXX:XXXX is compressed without context */
+    if ((addr->u16[1].u16 == 0) && (addr->u32[1].u32 == 0) &&
+        (addr->u16[4].u16 == 0)) {
+        return NULL;
+    }
+    memcpy(&unicast_prefix, &addr->u8[4], 8);
+    ctx = gnrc_sixlowpan_ctx_lookup_addr(&unicast_prefix);
+    if ((ctx != NULL) && (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
+        (ctx->prefix_len == addr->u8[3])) {
+        return ctx;
+    }
+    return NULL;
+}
+
 static gnrc_pktsnip_t *_iphc_encode(gnrc_pktsnip_t *pkt,
                                     const gnrc_netif_hdr_t *netif_hdr,
                                     gnrc_netif_t *netif);
@@ -194,22 +244,14 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
         ipv6_hdr->nh = iphc_hdr[payload_offset++];
     }
 
-    switch (iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_HL) {
-        case IPHC_HL_INLINE:
-            ipv6_hdr->hl = iphc_hdr[payload_offset++];
-            break;
-
-        case IPHC_HL_1:
-            ipv6_hdr->hl = 1;
-            break;
-
-        case IPHC_HL_64:
-            ipv6_hdr->hl = 64;
-            break;
+    if ((iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_HL) == IPHC_HL_INLINE) {
+        ipv6_hdr->hl = iphc_hdr[payload_offset++];
+    }
+    else {
+        /* hop limits indexed by the compressed HLIM field */
+        static const uint8_t hl[] = { 0, 1, 64, 255 };
 
-        case IPHC_HL_255:
-            ipv6_hdr->hl = 255;
-            break;
+        ipv6_hdr->hl = hl[iphc_hdr[IPHC1_IDX] & SIXLOWPAN_IPHC1_HL];
     }
 
     if (iphc_hdr[IPHC2_IDX] & SIXLOWPAN_IPHC2_SAC) {
@@ -246,9 +288,7 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_SAC_SAM_16:
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->src);
-            ipv6_hdr->src.u32[2] = byteorder_htonl(0x000000ff);
-            ipv6_hdr->src.u16[6] = byteorder_htons(0xfe00);
-            memcpy(ipv6_hdr->src.u8 + 14, iphc_hdr + payload_offset, 2);
+            _iid_set_short(&ipv6_hdr->src, iphc_hdr + payload_offset);
             payload_offset += 2;
             break;
 
@@ -276,9 +316,7 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_SAC_SAM_CTX_16:
             assert(ctx != NULL);
-            ipv6_hdr->src.u32[2] = byteorder_htonl(0x000000ff);
-            ipv6_hdr->src.u16[6] = byteorder_htons(0xfe00);
-            memcpy(ipv6_hdr->src.u8 + 14, iphc_hdr + payload_offset, 2);
+            _iid_set_short(&ipv6_hdr->src, iphc_hdr + payload_offset);
             ipv6_addr_init_prefix(&ipv6_hdr->src, &ctx->prefix,
                                   ctx->prefix_len);
             payload_offset += 2;
@@ -330,9 +368,7 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_M_DAC_DAM_U_16:
             ipv6_addr_set_link_local_prefix(&ipv6_hdr->dst);
-            ipv6_hdr->dst.u32[2] = byteorder_htonl(0x000000ff);
-            ipv6_hdr->dst.u16[6] = byteorder_htons(0xfe00);
-            memcpy(ipv6_hdr->dst.u8 + 14, iphc_hdr + payload_offset, 2);
+            _iid_set_short(&ipv6_hdr->dst, iphc_hdr + payload_offset);
             payload_offset += 2;
             break;
 
@@ -355,9 +391,7 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
             break;
 
         case IPHC_M_DAC_DAM_U_CTX_16:
-            ipv6_hdr->dst.u32[2] = byteorder_htonl(0x000000ff);
-            ipv6_hdr->dst.u16[6] = byteorder_htons(0xfe00);
-            memcpy(ipv6_hdr->dst.u8 + 14, iphc_hdr + payload_offset, 2);
+            _iid_set_short(&ipv6_hdr->dst, iphc_hdr + payload_offset);
             assert(ctx != NULL);
             ipv6_addr_init_prefix(&ipv6_hdr->dst, &ctx->prefix,
                                   ctx->prefix_len);
@@ -378,7 +412,6 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_M_DAC_DAM_M_48:
             /* ffXX::00XX:XXXX:XXXX */
-            ipv6_addr_set_unspecified(&ipv6_hdr->dst);
             ipv6_hdr->dst.u8[0] = 0xff;
             ipv6_hdr->dst.u8[1] = iphc_hdr[payload_offset++];
             memcpy(ipv6_hdr->dst.u8 + 11, iphc_hdr + payload_offset, 5);
@@ -387,7 +420,6 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_M_DAC_DAM_M_32:
             /* ffXX::00XX:XXXX */
-            ipv6_addr_set_unspecified(&ipv6_hdr->dst);
             ipv6_hdr->dst.u8[0] = 0xff;
             ipv6_hdr->dst.u8[1] = iphc_hdr[payload_offset++];
             memcpy(ipv6_hdr->dst.u8 + 13, iphc_hdr + payload_offset, 3);
@@ -396,7 +428,6 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_M_DAC_DAM_M_8:
             /* ff02::XX: */
-            ipv6_addr_set_unspecified(&ipv6_hdr->dst);
             ipv6_hdr->dst.u8[0] = 0xff;
             ipv6_hdr->dst.u8[1] = 0x02;
             ipv6_hdr->dst.u8[15] = iphc_hdr[payload_offset++];
@@ -404,26 +435,23 @@ static size_t _iphc_ipv6_decode(const uint8_t *iphc_hdr,
 
         case IPHC_M_DAC_DAM_M_UC_PREFIX:
             do {
-                assert(ctx != NULL);
-                uint8_t orig_ctx_len = ctx->prefix_len;
-
-                ipv6_addr_set_unspecified(&ipv6_hdr->dst);
+                /* ffXX:XXLL:PPPP:PPPP:PPPP:PPPP:XXXX:XXXX */
+                ipv6_addr_t prefix = IPV6_ADDR_UNSPECIFIED;
+                uint8_t prefix_len;
 
-                if (ctx->prefix_len > 64) {
-                    ctx->prefix_len = 64;
-                }
+                assert(ctx != NULL);
+                prefix_len = (ctx->prefix_len > 64) ? 64 : ctx->prefix_len;
+                ipv6_addr_init_prefix(&prefix, &ctx->prefix, prefix_len);
 
                 ipv6_hdr->dst.u8[0] = 0xff;
                 ipv6_hdr->dst.u8[1] = iphc_hdr[payload_offset++];
                 ipv6_hdr->dst.u8[2] = iphc_hdr[payload_offset++];
-                ipv6_hdr->dst.u8[3] = ctx->prefix_len;
-                ipv6_addr_init_prefix((ipv6_addr_t *)ipv6_hdr->dst.u8 + 4,
-                                      &ctx->prefix, ctx->prefix_len);
-                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset + 2, 4);
+                ipv6_hdr->dst.u8[3] = prefix_len;
+                memcpy(ipv6_hdr->dst.u8 + 4, &prefix, 8);
+                memcpy(ipv6_hdr->dst.u8 + 12, iphc_hdr + payload_offset, 4);
 
                 payload_offset += 4;
-                ctx->prefix_len = orig_ctx_len;
-            } while (0);    /* ANSI-C compatible block creation for orig_ctx_len allocation */
+            } while (0);    /* ANSI-C compatible block creation for prefix allocation */
             break;
 
         default:
@@ -822,8 +850,9 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
         payload_len = (sixlo->size + uncomp_hdr_len -
                        payload_offset - sizeof(ipv6_hdr_t));
     }
+    /* payload_len already includes the uncompressed next headers */
     if ((rbuf == NULL) &&
-        (gnrc_pktbuf_realloc_data(ipv6, uncomp_hdr_len + payload_len) != 0)) {
+        (gnrc_pktbuf_realloc_data(ipv6, sizeof(ipv6_hdr_t) + payload_len) != 0)) {
         DEBUG("6lo iphc: no space left to copy payload\n");
         _recv_error_release(sixlo, ipv6, rbuf);
         return;
@@ -836,6 +865,11 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
            sixlo->size - payload_offset);
     if (rbuf != NULL) {
         rbuf->super.current_size += (uncomp_hdr_len - payload_offset);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+        /* later recoverable fragments are placed by their offset in the
+         * compressed datagram */
+        rbuf->super.offset_diff = (uncomp_hdr_len - payload_offset);
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
 #ifdef MODULE_GNRC_SIXLOWPAN_FRAG_VRB
         if (vrbe != NULL) {
             int res = -1;
@@ -846,8 +880,6 @@ void gnrc_sixlowpan_iphc_recv(gnrc_pktsnip_t *sixlo, void *rbuf_ptr,
                 if ((res = _forward_frag(ipv6, sixlo->next, vrbe, page)) == 0) {
                     DEBUG("6lo iphc: successfully recompressed and forwarded "
                           "1st fragment\n");
-                    /* empty list, as it should be in VRB now */
-                    rbuf->super.ints = NULL;
                 }
             }
             if ((ipv6 == NULL) || (res < 0)) {
@@ -915,6 +947,11 @@ static int _forward_frag(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *frag_hdr,
     /* remove rewritten netif header (forwarding implementation must do this
      * anyway) */
     pkt = gnrc_pktbuf_remove_snip(pkt, pkt);
+#ifdef MODULE_GNRC_SIXLOWPAN_FRAG_SFR
+    if (sixlowpan_sfr_rfrag_is(frag_hdr->data)) {
+        return gnrc_sixlowpan_frag_sfr_forward(pkt, frag_hdr->data, vrbe, page);
+    }
+#endif  /* MODULE_GNRC_SIXLOWPAN_FRAG_SFR */
     /* the following is just debug output for testing without any forwarding
      * scheme */
     DEBUG("6lo iphc: Do not know how to forward fragment from (%s, %u) ",
@@ -967,6 +1004,8 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
     ipv6_hdr_t *ipv6_hdr = pkt->next->data;
     bool addr_comp = false;
     uint16_t inline_pos = SIXLOWPAN_IPHC_HDR_LEN;
+    uint32_t v_tc_fl, fl;
+    uint8_t tc;
 
     assert(iface != NULL);
 
@@ -992,6 +1031,11 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             dst_ctx = NULL;
         }
     }
+    else {
+        /* the context of a multicast address also needs the context
+         * identifier extension */
+        dst_ctx = _mcast_ctx_lookup(&ipv6_hdr->dst);
+    }
 
     /* if contexts available and both != 0 */
     /* since this moves inline_pos we have to do this ahead*/
@@ -1007,35 +1051,39 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
         inline_pos += SIXLOWPAN_IPHC_CID_EXT_LEN;
     }
 
-    /* compress flow label and traffic class */
-    if (ipv6_hdr_get_fl(ipv6_hdr) == 0) {
-        if (ipv6_hdr_get_tc(ipv6_hdr) == 0) {
+    /* compress flow label and traffic class, reading the header word only
+     * once */
+    v_tc_fl = byteorder_ntohl(ipv6_hdr->v_tc_fl);
+    tc = (uint8_t)(v_tc_fl >> 20);
+    fl = v_tc_fl & 0x000fffff;
+    if (fl == 0) {
+        if (tc == 0) {
             /* elide both traffic class and flow label */
             iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_ELIDE;
         }
         else {
             /* elide flow label, traffic class (ECN + DSCP) inline (1 byte) */
             iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
+            iphc_hdr[inline_pos++] = tc;
         }
     }
     else {
-        if (ipv6_hdr_get_tc_dscp(ipv6_hdr) == 0) {
+        if ((tc & 0x3f) == 0) {
             /* elide DSCP, ECN + 2-bit pad + flow label inline (3 byte) */
             iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_FL;
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_tc_ecn(ipv6_hdr) << 6) |
-                                               ((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16));
+            iphc_hdr[inline_pos++] = (uint8_t)((tc & 0xc0) |
+                                               ((fl & 0x000f0000) >> 16));
         }
         else {
             /* ECN + DSCP + 4-bit pad + flow label (4 bytes) */
             iphc_hdr[IPHC1_IDX] |= IPHC_TF_ECN_DSCP_FL;
-            iphc_hdr[inline_pos++] = ipv6_hdr_get_tc(ipv6_hdr);
-            iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000f0000) >> 16);
+            iphc_hdr[inline_pos++] = tc;
+            iphc_hdr[inline_pos++] = (uint8_t)((fl & 0x000f0000) >> 16);
         }
 
         /* copy remaining byteos of flow label */
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x0000ff00) >> 8);
-        iphc_hdr[inline_pos++] = (uint8_t)((ipv6_hdr_get_fl(ipv6_hdr) & 0x000000ff) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)((fl & 0x0000ff00) >> 8);
+        iphc_hdr[inline_pos++] = (uint8_t)((fl & 0x000000ff) >> 8);
     }
 
     /* check for compressible next header */
@@ -1097,8 +1145,7 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
                 iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_L2;
                 addr_comp = true;
             }
-            else if ((byteorder_ntohl(ipv6_hdr->src.u32[2]) == 0x000000ff) &&
-                     (byteorder_ntohs(ipv6_hdr->src.u16[6]) == 0xfe00)) {
+            else if (_iid_is_short(&ipv6_hdr->src)) {
                 /* 16 bits. The address is derived using 16 bits carried inline */
                 iphc_hdr[IPHC2_IDX] |= IPHC_SAC_SAM_16;
                 memcpy(iphc_hdr + inline_pos, ipv6_hdr->src.u16 + 7, 2);
@@ -1163,31 +1210,19 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             }
         }
         /* try unicast prefix based compression */
-        else {
-            gnrc_sixlowpan_ctx_t *ctx;
-            ipv6_addr_t unicast_prefix;
-            unicast_prefix.u16[0] = ipv6_hdr->dst.u16[2];
-            unicast_prefix.u16[1] = ipv6_hdr->dst.u16[3];
-            unicast_prefix.u16[2] = ipv6_hdr->dst.u16[4];
-            unicast_prefix.u16[3] = ipv6_hdr->dst.u16[5];
-
-            ctx = gnrc_sixlowpan_ctx_lookup_addr(&unicast_prefix);
-
-            if ((ctx != NULL) && (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_COMP) &&
-                (ctx->prefix_len == ipv6_hdr->dst.u8[3])) {
-                /* Unicast prefix based IPv6 multicast address
-                 * (https://tools.ietf.org/html/rfc3306) with given context
-                 * for unicast prefix -> context based compression */
-                iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
-                if ((ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
-                    iphc_hdr[CID_EXT_IDX] |= (ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
-                }
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
-                iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
-                memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
-                inline_pos += 4;
-                addr_comp = true;
+        else if (dst_ctx != NULL) {
+            /* Unicast prefix based IPv6 multicast address
+             * (https://tools.ietf.org/html/rfc3306) with given context
+             * for unicast prefix -> context based compression */
+            iphc_hdr[IPHC2_IDX] |= SIXLOWPAN_IPHC2_DAC;
+            if ((dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK) != 0) {
+                iphc_hdr[CID_EXT_IDX] |= (dst_ctx->flags_id & GNRC_SIXLOWPAN_CTX_FLAGS_CID_MASK);
             }
+            iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[1];
+            iphc_hdr[inline_pos++] = ipv6_hdr->dst.u8[2];
+            memcpy(iphc_hdr + inline_pos, ipv6_hdr->dst.u16 + 6, 4);
+            inline_pos += 4;
+            addr_comp = true;
         }
     }
     else if (((dst_ctx != NULL) ||
@@ -1214,8 +1249,7 @@ static size_t _iphc_ipv6_encode(gnrc_pktsnip_t *pkt,
             iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_L2;
             addr_comp = true;
         }
-        else if ((byteorder_ntohl(ipv6_hdr->dst.u32[2]) == 0x000000ff) &&
-                 (byteorder_ntohs(ipv6_hdr->dst.u16[6]) == 0xfe00)) {
+        else if (_iid_is_short(&ipv6_hdr->dst)) {
             /* 16 bits. The address is derived using 16 bits carried inline */
             iphc_hdr[IPHC2_IDX] |= IPHC_M_DAC_DAM_U_16;
             memcpy(&(iphc_hdr[inline_pos]), &(ipv6_hdr->dst.u16[7]), 2);
@@ -13,7 +13,91 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <assert.h>
+#include <errno.h>
+
 #include "net/gnrc/pktbuf.h"
+#include "pktbuf_internal.h"
+
+typedef struct {
+    uint8_t *data;                      /**< start of external buffer */
+    size_t size;                        /**< size of external buffer */
+    gnrc_pktbuf_ext_release_t release;  /**< release callback */
+    void *arg;                          /**< argument for release */
+    unsigned refs;                      /**< number of referencing snips */
+} _ext_t;
+
+static _ext_t _ext[GNRC_PKTBUF_EXT_NUMOF];
+
+#if GNRC_PKTBUF_COPY_STATS
+uint32_t gnrc_pktbuf_copied;
+
+uint32_t gnrc_pktbuf_copied_bytes(void)
+{
+    return gnrc_pktbuf_copied;
+}
+#endif
+
+void gnrc_pktbuf_ext_init(void)
+{
+    memset(_ext, 0, sizeof(_ext));
+#if GNRC_PKTBUF_COPY_STATS
+    gnrc_pktbuf_copied = 0;
+#endif
+}
+
+int gnrc_pktbuf_ext_add(void *data, size_t size,
+                        gnrc_pktbuf_ext_release_t release, void *arg)
+{
+    for (unsigned i = 0; i < GNRC_PKTBUF_EXT_NUMOF; i++) {
+        if (_ext[i].refs == 0) {
+            _ext[i].data = data;
+            _ext[i].size = size;
+            _ext[i].release = release;
+            _ext[i].arg = arg;
+            _ext[i].refs = 1;
+            return 0;
+        }
+    }
+    return -ENOMEM;
+}
+
+static _ext_t *_ext_get(const void *ptr)
+{
+    for (unsigned i = 0; i < GNRC_PKTBUF_EXT_NUMOF; i++) {
+        if (_ext[i].refs &&
+            ((size_t)((const uint8_t *)ptr - _ext[i].data) < _ext[i].size)) {
+            return &_ext[i];
+        }
+    }
+    return NULL;
+}
+
+bool gnrc_pktbuf_ext_contains(const void *ptr)
+{
+    return (ptr != NULL) && (_ext_get(ptr) != NULL);
+}
+
+void gnrc_pktbuf_ext_ref(const void *ptr)
+{
+    _ext_t *ext = _ext_get(ptr);
+
+    assert(ext != NULL);
+    ext->refs++;
+}
+
+bool gnrc_pktbuf_ext_unref(const void *ptr)
+{
+    _ext_t *ext = (ptr != NULL) ? _ext_get(ptr) : NULL;
+
+    if (ext == NULL) {
+        return false;
+    }
+    if (--ext->refs == 0) {
+        ext->release(ext->arg, ext->data);
+    }
+    return true;
+}
 
 gnrc_pktsnip_t *gnrc_pktbuf_remove_snip(gnrc_pktsnip_t *pkt,
                                         gnrc_pktsnip_t *snip)
@@ -91,7 +175,7 @@ int gnrc_pktbuf_merge(gnrc_pktsnip_t *pkt)
 
     /* Copy data to new buffer */
     for (gnrc_pktsnip_t *ptr = pkt->next; ptr != NULL; ptr = ptr->next) {
-        memcpy(((uint8_t *)pkt->data) + offset, ptr->data, ptr->size);
+        gnrc_pktbuf_copy(((uint8_t *)pkt->data) + offset, ptr->data, ptr->size);
         offset += ptr->size;
     }
 
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Internal helpers shared by the packet buffer implementations
+ *
+ * @internal
+ */
+#ifndef PKTBUF_INTERNAL_H
+#define PKTBUF_INTERNAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "net/gnrc/pktbuf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if GNRC_PKTBUF_COPY_STATS
+/**
+ * @brief   Bytes copied by the packet buffer
+ */
+extern uint32_t gnrc_pktbuf_copied;
+#endif
+
+/**
+ * @brief   Copy data within the packet buffer, accounting for the copy
+ *          statistics if enabled
+ *
+ * @param[out] dst  destination
+ * @param[in] src   source
+ * @param[in] len   number of bytes to copy
+ */
+static inline void gnrc_pktbuf_copy(void *dst, const void *src, size_t len)
+{
+#if GNRC_PKTBUF_COPY_STATS
+    gnrc_pktbuf_copied += len;
+#endif
+    memcpy(dst, src, len);
+}
+
+/**
+ * @brief   Resets the external buffer table (and the copy statistics)
+ *
+ * @pre     packet buffer is locked
+ */
+void gnrc_pktbuf_ext_init(void);
+
+/**
+ * @brief   Registers an external buffer with one reference
+ *
+ * @pre     packet buffer is locked
+ *
+ * @param[in] data      start of the external buffer
+ * @param[in] size      size of the external buffer
+ * @param[in] release   release callback
+ * @param[in] arg       argument for @p release
+ *
+ * @return  0 on success
+ * @return  -ENOMEM if all @ref GNRC_PKTBUF_EXT_NUMOF slots are in use
+ */
+int gnrc_pktbuf_ext_add(void *data, size_t size,
+                        gnrc_pktbuf_ext_release_t release, void *arg);
+
+/**
+ * @brief   Checks if @p ptr points into a registered external buffer
+ *
+ * @pre     packet buffer is locked
+ *
+ * @param[in] ptr   pointer to check
+ *
+ * @return  true, if @p ptr is within an external buffer
+ */
+bool gnrc_pktbuf_ext_contains(const void *ptr);
+
+/**
+ * @brief   Adds a reference to the external buffer @p ptr points into
+ *
+ * @pre     packet buffer is locked
+ * @pre     gnrc_pktbuf_ext_contains(@p ptr)
+ *
+ * @param[in] ptr   pointer into the external buffer
+ */
+void gnrc_pktbuf_ext_ref(const void *ptr);
+
+/**
+ * @brief   Drops a reference to the external buffer @p ptr points into,
+ *          calling its release callback if it was the last one
+ *
+ * @pre     packet buffer is locked
+ *
+ * @param[in] ptr   pointer into the external buffer
+ *
+ * @return  true, if @p ptr was within an external buffer
+ * @return  false, if @p ptr is not within an external buffer (nothing done)
+ */
+bool gnrc_pktbuf_ext_unref(const void *ptr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PKTBUF_INTERNAL_H */
+/** @} */
@@ -32,6 +32,7 @@
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#include "pktbuf_internal.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -59,6 +60,13 @@ static inline void _free(void *ptr)
 #define _free(ptr)      free(ptr)
 #endif
 
+static inline void _free_data(void *data)
+{
+    if (!gnrc_pktbuf_ext_unref(data)) {
+        _free(data);
+    }
+}
+
 /* internal gnrc_pktbuf functions */
 static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
                                     gnrc_nettype_t type);
@@ -81,6 +89,9 @@ void gnrc_pktbuf_init(void)
 #ifdef TEST_SUITES
     mallocs = 0;
 #endif
+    mutex_lock(&_mutex);
+    gnrc_pktbuf_ext_init();
+    mutex_unlock(&_mutex);
 }
 
 gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
@@ -99,6 +110,31 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_add_ext(gnrc_pktsnip_t *next, void *data,
+                                    size_t size, gnrc_nettype_t type,
+                                    gnrc_pktbuf_ext_release_t release,
+                                    void *arg)
+{
+    gnrc_pktsnip_t *pkt;
+
+    assert((data != NULL) && (size > 0) && (release != NULL));
+    mutex_lock(&_mutex);
+    pkt = _malloc(sizeof(gnrc_pktsnip_t));
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+    }
+    else if (gnrc_pktbuf_ext_add(data, size, release, arg) < 0) {
+        DEBUG("pktbuf: no slot left for external buffer\n");
+        _free(pkt);
+        pkt = NULL;
+    }
+    else {
+        _set_pktsnip(pkt, next, data, size, type);
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
 static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *header;
@@ -122,6 +158,16 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
         _set_pktsnip(pkt, header, NULL, 0, pkt->type);
         return header;
     }
+    if (gnrc_pktbuf_ext_contains(pkt->data)) {
+        /* external data is not malloc'd, so both snips can just point into
+         * it */
+        gnrc_pktbuf_ext_ref(pkt->data);
+        _set_pktsnip(header, pkt->next, pkt->data, size, type);
+        pkt->data = ((uint8_t *)pkt->data) + size;
+        pkt->size -= size;
+        pkt->next = header;
+        return header;
+    }
     /* we can not just "snip off" something from the end of a malloc'd section
      * so we need to realloc for marked snip */
     payload = _malloc(pkt->size - size);
@@ -130,7 +176,7 @@ static gnrc_pktsnip_t *_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t ty
         _free(header);
         return NULL;
     }
-    memcpy(payload, ((uint8_t *)pkt->data) + size, pkt->size - size);
+    gnrc_pktbuf_copy(payload, ((uint8_t *)pkt->data) + size, pkt->size - size);
     header_data = realloc(pkt->data, size);
     if (header_data == NULL) {
         DEBUG("pktbuf: could not reallocate marked section.\n");
@@ -168,9 +214,22 @@ static int _realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     /* new size is 0 and data pointer isn't already NULL */
     if ((size == 0) && (pkt->data != NULL)) {
         /* set data pointer to NULL */
-        _free(pkt->data);
+        _free_data(pkt->data);
         pkt->data = NULL;
     }
+    else if (gnrc_pktbuf_ext_contains(pkt->data)) {
+        if (size > pkt->size) {
+            /* move external data into a malloc'd section */
+            void *data = _malloc(size);
+            if (data == NULL) {
+                DEBUG("pktbuf: error allocating new data section\n");
+                return ENOMEM;
+            }
+            gnrc_pktbuf_copy(data, pkt->data, pkt->size);
+            gnrc_pktbuf_ext_unref(pkt->data);
+            pkt->data = data;
+        }
+    }
     else {
         void *data = (pkt->data) ? realloc(pkt->data, size) : _malloc(size);
         if (data == NULL) {
@@ -210,7 +269,7 @@ static void _release_error_locked(gnrc_pktsnip_t *pkt, uint32_t err)
         tmp = pkt->next;
         if (pkt->users == 1) {
             pkt->users = 0; /* not necessary but to be on the safe side */
-            _free(pkt->data);
+            _free_data(pkt->data);
             _free(pkt);
         }
         else {
@@ -290,7 +349,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
     }
     _set_pktsnip(pkt, next, _data, size, type);
     if (data != NULL) {
-        memcpy(_data, data, size);
+        gnrc_pktbuf_copy(_data, data, size);
     }
     return pkt;
 }
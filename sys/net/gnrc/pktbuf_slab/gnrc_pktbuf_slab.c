@@ -0,0 +1,779 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup net_gnrc_pktbuf
+ * @{
+ *
+ * @file
+ * @brief   Packet buffer implementation using size class slabs
+ *
+ * The packet buffer's @ref GNRC_PKTBUF_SIZE bytes are split into pages of
+ * @ref GNRC_PKTBUF_SLAB_PAGE_SIZE bytes. Small allocations (packet snips and
+ * headers) are served from slabs: a page is assigned to a size class on
+ * demand and split into equally sized blocks, until all of them are free
+ * again. Anything larger takes a run of consecutive pages, so a datagram
+ * wastes less than a page.
+ *
+ * Slab pages are taken from the end of the buffer and runs from its start.
+ * With the short lived small blocks kept apart that way, the free pages
+ * between the runs stay consecutive. Allocating and freeing a block takes
+ * constant time, except for assigning a free page. That one, like allocating
+ * a run, takes time linear in the number of pages; freeing a run in its
+ * length.
+ *
+ * gnrc_pktbuf_mark() does not move any data, so several snips might share a
+ * block. Blocks are reference counted for that; the block of a snip is found
+ * by rounding down its data pointer.
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/types.h>
+
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/nettype.h"
+#include "net/gnrc/pkt.h"
+#include "pktbuf_internal.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define _ALIGNMENT_MASK     (sizeof(uint64_t) - 1)
+
+/* fits size to byte alignment */
+#define _ALIGN(size)        (((size) + _ALIGNMENT_MASK) & ~(_ALIGNMENT_MASK))
+
+#define _PAGE_SIZE          _ALIGN(GNRC_PKTBUF_SLAB_PAGE_SIZE)
+/* bytes not filling a whole page at the end of the buffer stay unused */
+#define _PAGE_NUMOF         (GNRC_PKTBUF_SIZE / _PAGE_SIZE)
+#define _PKTBUF_SIZE        (_PAGE_NUMOF * _PAGE_SIZE)
+
+/* smallest block size, so blocks start at least that far apart */
+#define _BLOCK_SIZE_MIN     _ALIGN(sizeof(gnrc_pktsnip_t))
+#define _BLOCKS_MAX         (_PKTBUF_SIZE / _BLOCK_SIZE_MIN)
+
+/* end of a page list */
+#define _PAGE_NONE          (UINT16_MAX)
+
+typedef struct _block {
+    struct _block *next;
+} _block_t;
+
+typedef struct {
+    _block_t *free;         /**< blocks freed again */
+    uint16_t next;          /**< next page in partial page list */
+    uint16_t prev;          /**< previous page in partial page list */
+    uint16_t carved;        /**< number of blocks ever taken from the page */
+    uint16_t used;          /**< number of blocks in use, for the first
+                             *   page of a run the number of its pages */
+    uint16_t run;           /**< first page of the run the page is part of */
+    uint8_t slab;           /**< size class the page is assigned to */
+} _page_t;
+
+typedef struct {
+    uint16_t partial;       /**< assigned pages with blocks left */
+    uint16_t pages;         /**< number of assigned pages */
+    uint16_t used;          /**< number of blocks (or runs) in use */
+    uint16_t max_used;      /**< maximum of _slab_t::used */
+    uint16_t fails;         /**< allocations finding the slab exhausted */
+    size_t bytes;           /**< bytes used in the blocks in use */
+} _slab_t;
+
+static const uint16_t _block_sizes[] = {
+    _BLOCK_SIZE_MIN,
+    64,
+    128,
+};
+
+#define _SLAB_NUMOF         ARRAY_SIZE(_block_sizes)
+/* pseudo size classes of pages in a run and of free pages */
+#define _SLAB_RUN           (_SLAB_NUMOF)
+#define _SLAB_FREE          (_SLAB_NUMOF + 1)
+
+static mutex_t _mutex = MUTEX_INIT;
+static uint8_t _pktbuf[_PKTBUF_SIZE] __attribute__((aligned(8)));
+static _page_t _pages[_PAGE_NUMOF];
+static unsigned _free_pages;
+/* the slabs and the runs */
+static _slab_t _slabs[_SLAB_NUMOF + 1];
+/* number of snips referencing a block, indexed by the block's offset in
+ * multiples of the smallest block size */
+static uint8_t _refs[_BLOCKS_MAX];
+static unsigned _alloc_fails;
+
+/* internal gnrc_pktbuf functions */
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type);
+static void *_pktbuf_alloc(size_t size);
+static void _pktbuf_free(void *data, size_t size);
+
+static inline void _set_pktsnip(gnrc_pktsnip_t *pkt, gnrc_pktsnip_t *next,
+                                void *data, size_t size, gnrc_nettype_t type)
+{
+    pkt->next = next;
+    pkt->data = data;
+    pkt->size = size;
+    pkt->type = type;
+    pkt->users = 1;
+#ifdef MODULE_GNRC_NETERR
+    pkt->err_sub = KERNEL_PID_UNDEF;
+#endif
+}
+
+static inline bool _pktbuf_contains(const void *ptr)
+{
+    return (size_t)((const uint8_t *)ptr - _pktbuf) < _PKTBUF_SIZE;
+}
+
+static inline _page_t *_page_of(const void *ptr)
+{
+    return &_pages[(size_t)((const uint8_t *)ptr - _pktbuf) / _PAGE_SIZE];
+}
+
+static inline uint8_t *_page_start(const _page_t *page)
+{
+    return &_pktbuf[(size_t)(page - _pages) * _PAGE_SIZE];
+}
+
+static inline unsigned _pages_for(size_t size)
+{
+    return (size + _PAGE_SIZE - 1) / _PAGE_SIZE;
+}
+
+static inline bool _page_full(const _page_t *page)
+{
+    return (page->free == NULL) &&
+           (page->carved == (_PAGE_SIZE / _block_sizes[page->slab]));
+}
+
+static inline _block_t *_block_of(const _page_t *page, const void *ptr)
+{
+    if (page->slab == _SLAB_RUN) {
+        return (_block_t *)_page_start(&_pages[page->run]);
+    }
+
+    size_t offset = (size_t)((const uint8_t *)ptr - _page_start(page));
+
+    offset -= offset % _block_sizes[page->slab];
+    return (_block_t *)(_page_start(page) + offset);
+}
+
+static inline uint8_t *_block_refs(const _block_t *block)
+{
+    return &_refs[(size_t)((const uint8_t *)block - _pktbuf) / _BLOCK_SIZE_MIN];
+}
+
+static void _partial_add(_slab_t *slab, _page_t *page)
+{
+    uint16_t idx = page - _pages;
+
+    page->prev = _PAGE_NONE;
+    page->next = slab->partial;
+    if (page->next != _PAGE_NONE) {
+        _pages[page->next].prev = idx;
+    }
+    slab->partial = idx;
+}
+
+static void _partial_remove(_slab_t *slab, _page_t *page)
+{
+    if (page->prev != _PAGE_NONE) {
+        _pages[page->prev].next = page->next;
+    }
+    else {
+        slab->partial = page->next;
+    }
+    if (page->next != _PAGE_NONE) {
+        _pages[page->next].prev = page->prev;
+    }
+}
+
+static inline void _page_release(_page_t *page)
+{
+    page->slab = _SLAB_FREE;
+    page->used = 0;
+    _free_pages++;
+}
+
+static _page_t *_page_alloc(unsigned slab)
+{
+    _page_t *page = NULL;
+
+    /* the last free page, so slab pages gather at the end of the buffer */
+    for (unsigned i = _PAGE_NUMOF; (page == NULL) && (i > 0); i--) {
+        if (_pages[i - 1].slab == _SLAB_FREE) {
+            page = &_pages[i - 1];
+        }
+    }
+    if (page == NULL) {
+        return NULL;
+    }
+    page->free = NULL;
+    page->carved = 0;
+    page->slab = slab;
+    _partial_add(&_slabs[slab], page);
+    _slabs[slab].pages++;
+    _free_pages--;
+    return page;
+}
+
+static void _slab_used(_slab_t *slab)
+{
+    if (++slab->used > slab->max_used) {
+        slab->max_used = slab->used;
+    }
+}
+
+static void *_block_alloc(unsigned slab)
+{
+    _page_t *page;
+    _block_t *block;
+
+    if (_slabs[slab].partial != _PAGE_NONE) {
+        page = &_pages[_slabs[slab].partial];
+    }
+    else if ((page = _page_alloc(slab)) == NULL) {
+        return NULL;
+    }
+    if (page->free != NULL) {
+        block = page->free;
+        page->free = block->next;
+    }
+    else {
+        /* carve blocks lazily, so assigning a page takes constant time */
+        block = (_block_t *)(_page_start(page) +
+                             ((size_t)page->carved++ * _block_sizes[slab]));
+    }
+    if (_page_full(page)) {
+        _partial_remove(&_slabs[slab], page);
+    }
+    page->used++;
+    *_block_refs(block) = 1;
+    _slab_used(&_slabs[slab]);
+    return block;
+}
+
+static void _run_assign(unsigned first, unsigned from, unsigned to)
+{
+    for (unsigned i = from; i < to; i++) {
+        _pages[i].slab = _SLAB_RUN;
+        _pages[i].run = first;
+        _pages[i].used = 0;
+    }
+    _pages[first].used = to - first;
+    _free_pages -= to - from;
+    _slabs[_SLAB_RUN].pages += to - from;
+}
+
+static void *_run_alloc(unsigned numof)
+{
+    unsigned first = 0;
+
+    /* the first free pages that are enough, so runs gather at the start of
+     * the buffer */
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        if (_pages[i].slab != _SLAB_FREE) {
+            first = i + 1;
+        }
+        else if ((i + 1 - first) == numof) {
+            _block_t *block = (_block_t *)_page_start(&_pages[first]);
+
+            _run_assign(first, first, first + numof);
+            *_block_refs(block) = 1;
+            _slab_used(&_slabs[_SLAB_RUN]);
+            return block;
+        }
+    }
+    return NULL;
+}
+
+/* releases the pages of a run from page number from on */
+static void _run_shrink(_page_t *first, unsigned from)
+{
+    unsigned end = (first - _pages) + first->used;
+
+    for (unsigned i = from; i < end; i++) {
+        _page_release(&_pages[i]);
+    }
+    _slabs[_SLAB_RUN].pages -= end - from;
+    first->used = from - (first - _pages);
+}
+
+/* checks if a run can be extended up to page number to */
+static bool _run_extend(_page_t *first, unsigned to)
+{
+    unsigned end = (first - _pages) + first->used;
+
+    if (to > _PAGE_NUMOF) {
+        return false;
+    }
+    for (unsigned i = end; i < to; i++) {
+        if (_pages[i].slab != _SLAB_FREE) {
+            return false;
+        }
+    }
+    _run_assign(first - _pages, end, to);
+    return true;
+}
+
+/* tries to resize the data of a snip in place */
+static bool _resize(_page_t *page, const void *data, size_t old_size,
+                    size_t size)
+{
+    _block_t *block = _block_of(page, data);
+    size_t end = (size_t)((const uint8_t *)data - (uint8_t *)block) + size;
+
+    if (*_block_refs(block) > 1) {
+        /* other snips might use the data behind */
+        return size < old_size;
+    }
+    if (page->slab == _SLAB_RUN) {
+        _page_t *first = &_pages[page->run];
+
+        if ((size <= _block_sizes[_SLAB_NUMOF - 1]) &&
+            (_slabs[_SLAB_NUMOF - 1].partial != _PAGE_NONE)) {
+            /* rather move to a block, so the pages become free */
+            return false;
+        }
+        if (_pages_for(end) <= first->used) {
+            _run_shrink(first, page->run + _pages_for(end));
+            return true;
+        }
+        return _run_extend(first, page->run + _pages_for(end));
+    }
+    if (end > _block_sizes[page->slab]) {
+        return false;
+    }
+    /* rather move to a smaller block if there is one left already, so the
+     * page might become free for other slabs */
+    return (page->slab == 0) || (size > _block_sizes[page->slab - 1]) ||
+           (_slabs[page->slab - 1].partial == _PAGE_NONE);
+}
+
+void gnrc_pktbuf_init(void)
+{
+    static_assert(_PAGE_SIZE >= 128,
+                  "GNRC_PKTBUF_SLAB_PAGE_SIZE must fit the largest block");
+    mutex_lock(&_mutex);
+    memset(_slabs, 0, sizeof(_slabs));
+    memset(_refs, 0, sizeof(_refs));
+    for (unsigned i = 0; i < ARRAY_SIZE(_slabs); i++) {
+        _slabs[i].partial = _PAGE_NONE;
+    }
+    _free_pages = 0;
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        _page_release(&_pages[i]);
+    }
+    _alloc_fails = 0;
+    gnrc_pktbuf_ext_init();
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (size > GNRC_PKTBUF_SIZE) {
+        DEBUG("pktbuf: size (%u) > GNRC_PKTBUF_SIZE (%u)\n",
+              (unsigned)size, GNRC_PKTBUF_SIZE);
+        return NULL;
+    }
+    mutex_lock(&_mutex);
+    pkt = _create_snip(next, data, size, type);
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_add_ext(gnrc_pktsnip_t *next, void *data,
+                                    size_t size, gnrc_nettype_t type,
+                                    gnrc_pktbuf_ext_release_t release,
+                                    void *arg)
+{
+    gnrc_pktsnip_t *pkt;
+
+    assert((data != NULL) && (size > 0) && (release != NULL));
+    mutex_lock(&_mutex);
+    pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+    }
+    else if (gnrc_pktbuf_ext_add(data, size, release, arg) < 0) {
+        DEBUG("pktbuf: no slot left for external buffer\n");
+        _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        pkt = NULL;
+    }
+    else {
+        _set_pktsnip(pkt, next, data, size, type);
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *marked_snip;
+    void *new_data_marked;
+
+    mutex_lock(&_mutex);
+    if ((size == 0) || (pkt == NULL) || (size > pkt->size) || (pkt->data == NULL)) {
+        DEBUG("pktbuf: size == 0 (was %u) or pkt == NULL (was %p) or "
+              "size > pkt->size (was %u) or pkt->data == NULL (was %p)\n",
+              (unsigned)size, (void *)pkt, (pkt ? (unsigned)pkt->size : 0),
+              (pkt ? pkt->data : NULL));
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    /* create new snip descriptor for marked data */
+    marked_snip = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (marked_snip == NULL) {
+        DEBUG("pktbuf: could not reallocate marked section.\n");
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    new_data_marked = pkt->data;
+    if (pkt->size != size) {
+        /* both snips reference the block or external buffer now */
+        if (_pktbuf_contains(pkt->data)) {
+            uint8_t *refs = _block_refs(_block_of(_page_of(pkt->data),
+                                                  pkt->data));
+            assert(*refs < UINT8_MAX);
+            (*refs)++;
+        }
+        else {
+            gnrc_pktbuf_ext_ref(pkt->data);
+        }
+    }
+    /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
+    pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
+                                      NULL;
+    pkt->size -= size;
+    _set_pktsnip(marked_snip, pkt->next, new_data_marked, size, type);
+    pkt->next = marked_snip;
+    mutex_unlock(&_mutex);
+    return marked_snip;
+}
+
+int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
+{
+    mutex_lock(&_mutex);
+    assert(pkt != NULL);
+    assert(((pkt->size == 0) && (pkt->data == NULL)) ||
+           ((pkt->size > 0) && (pkt->data != NULL) &&
+            (_pktbuf_contains(pkt->data) || gnrc_pktbuf_ext_contains(pkt->data))));
+    /* new size and old size are equal */
+    if (size == pkt->size) {
+        /* nothing to do */
+        mutex_unlock(&_mutex);
+        return 0;
+    }
+    /* new size is 0 and data pointer isn't already NULL */
+    if ((size == 0) && (pkt->data != NULL)) {
+        /* set data pointer to NULL */
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = NULL;
+    }
+    else if (_pktbuf_contains(pkt->data) &&
+             _resize(_page_of(pkt->data), pkt->data, pkt->size, size)) {
+        _slab_t *slab = &_slabs[_page_of(pkt->data)->slab];
+        slab->bytes += size;
+        slab->bytes -= pkt->size;
+    }
+    /* external data only needs to be moved if it grows */
+    else if (_pktbuf_contains(pkt->data) || (size > pkt->size)) {
+        void *new_data = _pktbuf_alloc(size);
+        if (new_data == NULL) {
+            DEBUG("pktbuf: error allocating new data section\n");
+            mutex_unlock(&_mutex);
+            return ENOMEM;
+        }
+        if (pkt->data != NULL) {            /* if old data exist */
+            gnrc_pktbuf_copy(new_data, pkt->data,
+                             (pkt->size < size) ? pkt->size : size);
+        }
+        _pktbuf_free(pkt->data, pkt->size);
+        pkt->data = new_data;
+    }
+    pkt->size = size;
+    mutex_unlock(&_mutex);
+    return 0;
+}
+
+void gnrc_pktbuf_hold(gnrc_pktsnip_t *pkt, unsigned int num)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        pkt->users += num;
+        pkt = pkt->next;
+    }
+    mutex_unlock(&_mutex);
+}
+
+void gnrc_pktbuf_release_error(gnrc_pktsnip_t *pkt, uint32_t err)
+{
+    mutex_lock(&_mutex);
+    while (pkt) {
+        gnrc_pktsnip_t *tmp;
+        assert(_pktbuf_contains(pkt));
+        assert(pkt->users > 0);
+        tmp = pkt->next;
+        if (pkt->users == 1) {
+            pkt->users = 0; /* not necessary but to be on the safe side */
+            _pktbuf_free(pkt->data, pkt->size);
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        }
+        else {
+            pkt->users--;
+        }
+        DEBUG("pktbuf: report status code %" PRIu32 "\n", err);
+        gnrc_neterr_report(pkt, err);
+        pkt = tmp;
+    }
+    mutex_unlock(&_mutex);
+}
+
+gnrc_pktsnip_t *gnrc_pktbuf_start_write(gnrc_pktsnip_t *pkt)
+{
+    mutex_lock(&_mutex);
+    if (pkt == NULL) {
+        mutex_unlock(&_mutex);
+        return NULL;
+    }
+    if (pkt->users > 1) {
+        gnrc_pktsnip_t *new;
+        new = _create_snip(pkt->next, pkt->data, pkt->size, pkt->type);
+        if (new != NULL) {
+            pkt->users--;
+        }
+        mutex_unlock(&_mutex);
+        return new;
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
+#ifdef DEVELHELP
+void gnrc_pktbuf_stats(void)
+{
+    size_t bytes = 0;
+
+    mutex_lock(&_mutex);
+    printf("packet buffer: first byte: %p, last byte: %p (size: %u)\n",
+           (void *)&_pktbuf[0], (void *)&_pktbuf[_PKTBUF_SIZE],
+           (unsigned)_PKTBUF_SIZE);
+    printf("  pages: %u of %u bytes, %u free\n", (unsigned)_PAGE_NUMOF,
+           (unsigned)_PAGE_SIZE, _free_pages);
+    puts("  block size | pages | used | max. used | exhausted | bytes used");
+    for (unsigned i = 0; i < ARRAY_SIZE(_slabs); i++) {
+        _slab_t *slab = &_slabs[i];
+
+        if (i == _SLAB_RUN) {
+            printf("  %10s", "page runs");
+        }
+        else {
+            printf("  %10u", _block_sizes[i]);
+        }
+        printf(" | %5u | %4u | %9u | %9u | %10u\n", slab->pages, slab->used,
+               slab->max_used, slab->fails, (unsigned)slab->bytes);
+        bytes += slab->bytes;
+    }
+    /* memory in assigned pages not holding packet data */
+    printf("  fragmentation: %u of %u bytes\n",
+           (unsigned)(((_PAGE_NUMOF - _free_pages) * _PAGE_SIZE) - bytes),
+           (unsigned)((_PAGE_NUMOF - _free_pages) * _PAGE_SIZE));
+    printf("  failed allocations: %u\n", _alloc_fails);
+    mutex_unlock(&_mutex);
+}
+#endif
+
+#ifdef TEST_SUITES
+bool gnrc_pktbuf_is_empty(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_slabs); i++) {
+        if (_slabs[i].used > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool gnrc_pktbuf_is_sane(void)
+{
+    unsigned used[ARRAY_SIZE(_slabs)] = { 0 };
+    unsigned pages[ARRAY_SIZE(_slabs)] = { 0 };
+    unsigned free_pages = 0;
+
+    /* Invariants of this implementation:
+     *  - forall slab pages: all blocks in its free list are aligned to the
+     *    block size, carved already and not referenced
+     *  - forall slab pages: 0 < used and carved == used + number of freed
+     *    blocks
+     *  - forall runs: all pages of the run point to its first page, which is
+     *    referenced
+     *  - forall slabs: used blocks and pages match the assigned pages
+     */
+    for (unsigned i = 0; i < _PAGE_NUMOF; i++) {
+        _page_t *page = &_pages[i];
+        unsigned freed = 0;
+
+        if (page->slab == _SLAB_FREE) {
+            free_pages++;
+            continue;
+        }
+        if (page->slab == _SLAB_RUN) {
+            if (page->run == i) {
+                if ((page->used == 0) || ((i + page->used) > _PAGE_NUMOF) ||
+                    (*_block_refs((_block_t *)_page_start(page)) == 0)) {
+                    return false;
+                }
+                for (unsigned j = i + 1; j < (i + page->used); j++) {
+                    if ((_pages[j].slab != _SLAB_RUN) || (_pages[j].run != i)) {
+                        return false;
+                    }
+                }
+                used[_SLAB_RUN]++;
+            }
+            else if ((page->run > i) || (_pages[page->run].run != page->run) ||
+                     ((page->run + _pages[page->run].used) <= i)) {
+                return false;
+            }
+            pages[_SLAB_RUN]++;
+            continue;
+        }
+        if ((page->slab >= _SLAB_NUMOF) || (page->used == 0)) {
+            return false;
+        }
+        for (_block_t *ptr = page->free; ptr != NULL; ptr = ptr->next) {
+            if ((_page_of(ptr) != page) || (_block_of(page, ptr) != ptr) ||
+                ((size_t)((uint8_t *)ptr - _page_start(page)) >=
+                 ((size_t)page->carved * _block_sizes[page->slab])) ||
+                (*_block_refs(ptr) != 0) || (++freed > page->carved)) {
+                return false;
+            }
+        }
+        if ((freed + page->used) != page->carved) {
+            return false;
+        }
+        used[page->slab] += page->used;
+        pages[page->slab]++;
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(_slabs); i++) {
+        size_t size = (i == _SLAB_RUN) ? (pages[i] * _PAGE_SIZE)
+                                       : (used[i] * _block_sizes[i]);
+
+        if ((used[i] != _slabs[i].used) || (pages[i] != _slabs[i].pages) ||
+            (_slabs[i].bytes > size)) {
+            return false;
+        }
+    }
+    return free_pages == _free_pages;
+}
+#endif
+
+static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size_t size,
+                                    gnrc_nettype_t type)
+{
+    gnrc_pktsnip_t *pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    void *_data = NULL;
+
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+        return NULL;
+    }
+    if (size > 0) {
+        _data = _pktbuf_alloc(size);
+        if (_data == NULL) {
+            DEBUG("pktbuf: error allocating data for new packet snip\n");
+            _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+            return NULL;
+        }
+        if (data != NULL) {
+            gnrc_pktbuf_copy(_data, data, size);
+        }
+    }
+    _set_pktsnip(pkt, next, _data, size, type);
+    return pkt;
+}
+
+static void *_pktbuf_alloc(size_t size)
+{
+    unsigned i = 0;
+    void *block;
+
+    /* take the best fitting slab ... */
+    while ((i < _SLAB_NUMOF) && (size > _block_sizes[i])) {
+        i++;
+    }
+    if (i == _SLAB_NUMOF) {
+        /* ... or a run of pages for anything larger */
+        if ((block = _run_alloc(_pages_for(size))) == NULL) {
+            _slabs[i].fails++;
+        }
+    }
+    else if ((block = _block_alloc(i)) == NULL) {
+        /* ... or, if no page is left for it, blocks left in larger ones */
+        _slabs[i].fails++;
+        while ((block == NULL) && (++i < _SLAB_NUMOF)) {
+            if (_slabs[i].partial != _PAGE_NONE) {
+                block = _block_alloc(i);
+            }
+        }
+    }
+    if (block == NULL) {
+        DEBUG("pktbuf: no space left in packet buffer\n");
+        _alloc_fails++;
+        return NULL;
+    }
+    _slabs[i].bytes += size;
+    return block;
+}
+
+static void _pktbuf_free(void *data, size_t size)
+{
+    _page_t *page;
+    _slab_t *slab;
+    _block_t *block;
+
+    if (!_pktbuf_contains(data)) {
+        gnrc_pktbuf_ext_unref(data);
+        return;
+    }
+    page = _page_of(data);
+    slab = &_slabs[page->slab];
+    block = _block_of(page, data);
+    assert(*_block_refs(block) > 0);
+    slab->bytes -= size;
+    if (--(*_block_refs(block)) > 0) {
+        return;
+    }
+    slab->used--;
+    if (page->slab == _SLAB_RUN) {
+        _run_shrink(&_pages[page->run], page->run);
+        return;
+    }
+    if (_page_full(page)) {
+        _partial_add(slab, page);
+    }
+    block->next = page->free;
+    page->free = block;
+    if (--page->used == 0) {
+        /* return page to the pool of free pages */
+        _partial_remove(slab, page);
+        slab->pages--;
+        _page_release(page);
+    }
+}
+
+/** @} */
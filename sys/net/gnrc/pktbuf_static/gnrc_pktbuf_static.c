@@ -29,6 +29,7 @@
 #include "net/gnrc/pktbuf.h"
 #include "net/gnrc/nettype.h"
 #include "net/gnrc/pkt.h"
+#include "pktbuf_internal.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -85,6 +86,7 @@ void gnrc_pktbuf_init(void)
     _first_unused = (_unused_t *)_pktbuf;
     _first_unused->next = NULL;
     _first_unused->size = sizeof(_pktbuf);
+    gnrc_pktbuf_ext_init();
     mutex_unlock(&_mutex);
 }
 
@@ -104,6 +106,31 @@ gnrc_pktsnip_t *gnrc_pktbuf_add(gnrc_pktsnip_t *next, const void *data, size_t s
     return pkt;
 }
 
+gnrc_pktsnip_t *gnrc_pktbuf_add_ext(gnrc_pktsnip_t *next, void *data,
+                                    size_t size, gnrc_nettype_t type,
+                                    gnrc_pktbuf_ext_release_t release,
+                                    void *arg)
+{
+    gnrc_pktsnip_t *pkt;
+
+    assert((data != NULL) && (size > 0) && (release != NULL));
+    mutex_lock(&_mutex);
+    pkt = _pktbuf_alloc(sizeof(gnrc_pktsnip_t));
+    if (pkt == NULL) {
+        DEBUG("pktbuf: error allocating new packet snip\n");
+    }
+    else if (gnrc_pktbuf_ext_add(data, size, release, arg) < 0) {
+        DEBUG("pktbuf: no slot left for external buffer\n");
+        _pktbuf_free(pkt, sizeof(gnrc_pktsnip_t));
+        pkt = NULL;
+    }
+    else {
+        _set_pktsnip(pkt, next, data, size, type);
+    }
+    mutex_unlock(&_mutex);
+    return pkt;
+}
+
 gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_t type)
 {
     gnrc_pktsnip_t *marked_snip;
@@ -128,8 +155,9 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
         return NULL;
     }
     /* marked data would not fit _unused_t marker => move data around to allow
-     * for proper free */
-    if ((pkt->size != size) && (size < required_new_size)) {
+     * for proper free (external data is never freed piecewise) */
+    if ((pkt->size != size) && (size < required_new_size) &&
+        _pktbuf_contains(pkt->data)) {
         void *new_data_rest;
         new_data_marked = _pktbuf_alloc(size);
         if (new_data_marked == NULL) {
@@ -146,14 +174,19 @@ gnrc_pktsnip_t *gnrc_pktbuf_mark(gnrc_pktsnip_t *pkt, size_t size, gnrc_nettype_
             mutex_unlock(&_mutex);
             return NULL;
         }
-        memcpy(new_data_marked, pkt->data, size);
-        memcpy(new_data_rest, ((uint8_t *)pkt->data) + size, pkt->size - size);
+        gnrc_pktbuf_copy(new_data_marked, pkt->data, size);
+        gnrc_pktbuf_copy(new_data_rest, ((uint8_t *)pkt->data) + size,
+                         pkt->size - size);
         _pktbuf_free(pkt->data, pkt->size);
         marked_snip->data = new_data_marked;
         pkt->data = new_data_rest;
     }
     else {
         new_data_marked = pkt->data;
+        if ((pkt->size != size) && !_pktbuf_contains(pkt->data)) {
+            /* both snips reference the external buffer now */
+            gnrc_pktbuf_ext_ref(pkt->data);
+        }
         /* if (pkt->size - size) != 0 take remainder of data, otherwise set NULL */
         pkt->data = (pkt->size != size) ? (((uint8_t *)pkt->data) + size) :
                                           NULL;
@@ -172,7 +205,8 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
     mutex_lock(&_mutex);
     assert(pkt != NULL);
     assert(((pkt->size == 0) && (pkt->data == NULL)) ||
-           ((pkt->size > 0) && (pkt->data != NULL) && _pktbuf_contains(pkt->data)));
+           ((pkt->size > 0) && (pkt->data != NULL) &&
+            (_pktbuf_contains(pkt->data) || gnrc_pktbuf_ext_contains(pkt->data))));
     /* new size and old size are equal */
     if (size == pkt->size) {
         /* nothing to do */
@@ -194,12 +228,14 @@ int gnrc_pktbuf_realloc_data(gnrc_pktsnip_t *pkt, size_t size)
             return ENOMEM;
         }
         if (pkt->data != NULL) {            /* if old data exist */
-            memcpy(new_data, pkt->data, (pkt->size < size) ? pkt->size : size);
+            gnrc_pktbuf_copy(new_data, pkt->data,
+                             (pkt->size < size) ? pkt->size : size);
         }
         _pktbuf_free(pkt->data, pkt->size);
         pkt->data = new_data;
     }
-    else if (_align(pkt->size) > aligned_size) {
+    else if ((_align(pkt->size) > aligned_size) &&
+             _pktbuf_contains(pkt->data)) {
         _pktbuf_free(((uint8_t *)pkt->data) + aligned_size,
                      pkt->size - aligned_size);
     }
@@ -394,7 +430,7 @@ static gnrc_pktsnip_t *_create_snip(gnrc_pktsnip_t *next, const void *data, size
             return NULL;
         }
         if (data != NULL) {
-            memcpy(_data, data, size);
+            gnrc_pktbuf_copy(_data, data, size);
         }
     }
     _set_pktsnip(pkt, next, _data, size, type);
@@ -468,6 +504,7 @@ static void _pktbuf_free(void *data, size_t size)
     _unused_t *new = (_unused_t *)data, *prev = NULL, *ptr = _first_unused;
 
     if (!_pktbuf_contains(data)) {
+        gnrc_pktbuf_ext_unref(data);
         return;
     }
     while (ptr && (((void *)ptr) < data)) {
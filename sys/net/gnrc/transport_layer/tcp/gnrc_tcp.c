@@ -406,6 +406,7 @@ void gnrc_tcp_tcb_init(gnrc_tcp_tcb_t *tcb)
     tcb->rtt_var = RTO_UNINITIALIZED;
     tcb->srtt = RTO_UNINITIALIZED;
     tcb->rto = RTO_UNINITIALIZED;
+    tcb->cc = GNRC_TCP_CC_DEFAULT;
     mbox_init(&(tcb->mbox), tcb->mbox_raw, GNRC_TCP_TCB_MBOX_SIZE);
     mutex_init(&(tcb->fsm_lock));
     mutex_init(&(tcb->function_lock));
@@ -501,8 +502,8 @@ ssize_t gnrc_tcp_send(gnrc_tcp_tcb_t *tcb, const void *data, const size_t len,
         _setup_timeout(&user_timeout, timeout_duration_us, _cb_mbox_put_msg, &user_timeout_arg);
     }
 
-    /* Loop until something was sent and acked */
-    while (ret == 0 || tcb->pkt_retransmit != NULL) {
+    /* Loop until something was sent and the retransmission queue has space left */
+    while (ret == 0 || tcb->rtx_num >= GNRC_TCP_SND_SEGMENTS) {
         /* Check if the connections state is closed. If so, a reset was received */
         if (tcb->state == FSM_STATE_CLOSED) {
             ret = -ECONNRESET;
@@ -757,6 +758,25 @@ void gnrc_tcp_abort(gnrc_tcp_tcb_t *tcb)
     mutex_unlock(&(tcb->function_lock));
 }
 
+int gnrc_tcp_set_cc(gnrc_tcp_tcb_t *tcb, const gnrc_tcp_cc_t *cc)
+{
+    assert(tcb != NULL);
+    assert(cc != NULL);
+
+    int ret = 0;
+
+    /* Lock the TCB for this function call */
+    mutex_lock(&(tcb->function_lock));
+    if (tcb->state != FSM_STATE_CLOSED) {
+        ret = -EISCONN;
+    }
+    else {
+        tcb->cc = cc;
+    }
+    mutex_unlock(&(tcb->function_lock));
+    return ret;
+}
+
 int gnrc_tcp_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr)
 {
     uint16_t csum;
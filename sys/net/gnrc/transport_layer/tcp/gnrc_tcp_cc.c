@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       Implementation of internal/cc.h
+ *
+ * @}
+ */
+#include "internal/common.h"
+#include "internal/cc.h"
+#include "internal/pkt.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/**
+ * @brief Lower bound of the initial window in bytes (see RFC 3390).
+ */
+#define CC_IW_BYTES (4380U)
+
+void _cc_init(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+
+    /* Initial window: min(4 * SMSS, max(2 * SMSS, 4380 bytes)) (see RFC 3390) */
+    tcb->cwnd = (2 * smss > CC_IW_BYTES) ? 2 * smss : CC_IW_BYTES;
+    tcb->cwnd = (tcb->cwnd < 4 * smss) ? tcb->cwnd : 4 * smss;
+    tcb->ssthresh = UINT32_MAX;
+    tcb->bytes_acked = 0;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+    tcb->cc->init(tcb);
+    DEBUG("gnrc_tcp_cc.c : _cc_init() : cwnd=%"PRIu32"\n", tcb->cwnd);
+}
+
+void _cc_reset(gnrc_tcp_tcb_t *tcb)
+{
+    tcb->cwnd = 0;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+}
+
+uint32_t _cc_wnd(const gnrc_tcp_tcb_t *tcb)
+{
+    return (tcb->cwnd < tcb->snd_wnd) ? tcb->cwnd : tcb->snd_wnd;
+}
+
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked)
+{
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+
+    /* Connection is not established yet */
+    if (tcb->cwnd == 0) {
+        return;
+    }
+    tcb->dup_acks = 0;
+
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        /* Full acknowledgment: Leave fast recovery (see RFC 6582) */
+        if (LEQ_32_BIT(tcb->recover, tcb->snd_una)) {
+            DEBUG("gnrc_tcp_cc.c : _cc_ack() : Leave fast recovery\n");
+            tcb->cwnd = tcb->ssthresh;
+            tcb->status &= ~STATUS_FAST_RECOVERY;
+        }
+        /* Partial acknowledgment: Deflate window by the acknowledged data */
+        else {
+            tcb->cwnd = (tcb->cwnd > acked) ? tcb->cwnd - acked : 0;
+            if (acked >= smss || tcb->cwnd < smss) {
+                tcb->cwnd += smss;
+            }
+        }
+        return;
+    }
+
+    /* Grow the window only if it limited the data in flight (see RFC 7661) */
+    if (gnrc_tcp_cc_flight_size(tcb) + acked + smss >= tcb->cwnd) {
+        tcb->cc->acked(tcb, acked);
+    }
+}
+
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+
+    /* Connection is not established yet */
+    if (tcb->cwnd == 0) {
+        return;
+    }
+
+    /* Inflate window by the segment that left the network */
+    if (tcb->status & STATUS_FAST_RECOVERY) {
+        tcb->cwnd += smss;
+        return;
+    }
+
+    if (++tcb->dup_acks < CC_DUP_ACK_THRESHOLD) {
+        return;
+    }
+    tcb->dup_acks = 0;
+
+    /* Segments sent before the last recovery may cause duplicate ACKs as well */
+    if (LEQ_32_BIT(tcb->snd_una, tcb->recover)) {
+        return;
+    }
+
+    DEBUG("gnrc_tcp_cc.c : _cc_dup_ack() : Fast retransmit\n");
+    tcb->cc->congestion(tcb, GNRC_TCP_CC_FAST_RETRANSMIT);
+    tcb->cwnd = tcb->ssthresh + CC_DUP_ACK_THRESHOLD * smss;
+    tcb->bytes_acked = 0;
+    tcb->recover = tcb->snd_nxt;
+    tcb->status |= STATUS_FAST_RECOVERY;
+    _pkt_fast_retransmit(tcb);
+}
+
+void _cc_timeout(gnrc_tcp_tcb_t *tcb)
+{
+    /* Connection is not established yet */
+    if (tcb->cwnd == 0) {
+        return;
+    }
+
+    /* Repeated timeouts of the same segment reduce ssthresh only once (see RFC 5681) */
+    if (tcb->retries == 0) {
+        tcb->cc->congestion(tcb, GNRC_TCP_CC_TIMEOUT);
+    }
+    tcb->cwnd = gnrc_tcp_cc_smss(tcb);
+    tcb->bytes_acked = 0;
+    tcb->dup_acks = 0;
+    tcb->status &= ~STATUS_FAST_RECOVERY;
+}
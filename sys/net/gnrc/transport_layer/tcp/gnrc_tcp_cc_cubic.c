@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       CUBIC congestion control (see RFC 8312)
+ *
+ * Windows are kept in bytes and times in milliseconds, so the cubic function
+ * is evaluated with integer arithmetic only.
+ *
+ * @}
+ */
+#include <string.h>
+#include "net/gnrc/tcp/cc.h"
+#include "timex.h"
+#include "xtimer.h"
+
+/**
+ * @brief Multiplicative decrease factor beta = 0.7.
+ * @{
+ */
+#define CUBIC_BETA_NUM (7U)
+#define CUBIC_BETA_DEN (10U)
+/** @} */
+
+/**
+ * @brief Additive increase factor of standard TCP with beta:
+ *        alpha = 3 * (1 - beta) / (1 + beta) = 9 / 17.
+ * @{
+ */
+#define CUBIC_ALPHA_NUM (9U)
+#define CUBIC_ALPHA_DEN (17U)
+/** @} */
+
+/**
+ * @brief Scaling constant C = 0.4 for windows in bytes and times in ms:
+ *        W(t) = C * SMSS * t^3 / 10^9 = 4 * SMSS * t^3 / 10^10.
+ * @{
+ */
+#define CUBIC_C_NUM (4LL)
+#define CUBIC_C_DEN (10000000000LL)
+/** @} */
+
+/**
+ * @brief Largest distance from the origin the cubic function is evaluated at in ms.
+ */
+#define CUBIC_T_MAX (60000LL)
+
+/**
+ * @brief Calculates the integer cube root.
+ *
+ * @param[in] x   Radicand.
+ *
+ * @returns   Largest integer r with r^3 <= @p x.
+ */
+static uint32_t _cbrt(uint64_t x)
+{
+    uint64_t r = 0;
+
+    for (int s = 63; s >= 0; s -= 3) {
+        r <<= 1;
+        uint64_t b = 3 * r * (r + 1) + 1;
+        if ((x >> s) >= b) {
+            x -= b << s;
+            r++;
+        }
+    }
+    return r;
+}
+
+/**
+ * @brief Evaluates the cubic window function.
+ *
+ * @param[in] cubic   CUBIC state of the connection.
+ * @param[in] smss    Sender maximum segment size.
+ * @param[in] t       Time since the start of the epoch in ms.
+ *
+ * @returns   Window at @p t in bytes.
+ */
+static uint32_t _w_cubic(const gnrc_tcp_cubic_t *cubic, uint32_t smss, uint32_t t)
+{
+    int64_t dt = (int64_t) t - cubic->k;
+
+    dt = (dt > CUBIC_T_MAX) ? CUBIC_T_MAX : dt;
+    dt = (dt < -CUBIC_T_MAX) ? -CUBIC_T_MAX : dt;
+
+    int64_t w = cubic->origin + (CUBIC_C_NUM * smss * dt * dt * dt) / CUBIC_C_DEN;
+    if (w < (int64_t) smss) {
+        return smss;
+    }
+    return (w > UINT32_MAX) ? UINT32_MAX : w;
+}
+
+static void _init(gnrc_tcp_tcb_t *tcb)
+{
+    memset(&tcb->cubic, 0, sizeof(tcb->cubic));
+}
+
+static void _acked(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    gnrc_tcp_cubic_t *cubic = &tcb->cubic;
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+    uint32_t cwnd = tcb->cwnd;
+
+    /* Slow start as standard TCP */
+    if (cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+        return;
+    }
+
+    uint32_t now = xtimer_now_usec() / US_PER_MS;
+
+    /* First ACK in congestion avoidance after a loss: Start a new epoch */
+    if (!cubic->epoch_started) {
+        cubic->epoch_started = 1;
+        cubic->epoch = now;
+        cubic->w_est = cwnd;
+        if (cwnd < cubic->w_max) {
+            /* K = cbrt((W_max - cwnd) / C) with the difference in segments */
+            cubic->k = _cbrt(((uint64_t) (cubic->w_max - cwnd) * (CUBIC_C_DEN / CUBIC_C_NUM)) /
+                             smss);
+            cubic->origin = cubic->w_max;
+        }
+        else {
+            cubic->k = 0;
+            cubic->origin = cwnd;
+        }
+    }
+
+    /* Target is the window the cubic function reaches one RTT later */
+    uint32_t rtt = (tcb->srtt > 0) ? tcb->srtt / US_PER_MS : 0;
+    uint32_t target = _w_cubic(cubic, smss, now - cubic->epoch + rtt);
+
+    /* Grow at least as fast as standard TCP would (TCP-friendly region) */
+    cubic->w_est += ((uint64_t) acked * smss * CUBIC_ALPHA_NUM) / (CUBIC_ALPHA_DEN * cwnd);
+    target = (target > cubic->w_est) ? target : cubic->w_est;
+
+    /* Grow by at most half the window per RTT */
+    target = (target < cwnd + cwnd / 2) ? target : cwnd + cwnd / 2;
+
+    /* Grow by (target - cwnd) / cwnd per acknowledged byte */
+    if (target > cwnd) {
+        uint64_t inc = (uint64_t) (target - cwnd) * acked + tcb->bytes_acked;
+        tcb->cwnd += inc / cwnd;
+        tcb->bytes_acked = inc % cwnd;
+    }
+}
+
+static void _congestion(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cc_event_t event)
+{
+    gnrc_tcp_cubic_t *cubic = &tcb->cubic;
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+    uint32_t cwnd = tcb->cwnd;
+
+    (void)event;
+    cubic->epoch_started = 0;
+
+    /* Fast convergence: Release bandwidth if the window keeps shrinking */
+    if (cwnd < cubic->w_last_max) {
+        cubic->w_last_max = cwnd;
+        cubic->w_max = ((uint64_t) cwnd * (CUBIC_BETA_DEN + CUBIC_BETA_NUM)) /
+                       (2 * CUBIC_BETA_DEN);
+    }
+    else {
+        cubic->w_last_max = cwnd;
+        cubic->w_max = cwnd;
+    }
+
+    /* ssthresh = max(cwnd * beta, 2 * SMSS) */
+    uint32_t reduced = ((uint64_t) cwnd * CUBIC_BETA_NUM) / CUBIC_BETA_DEN;
+    tcb->ssthresh = (reduced > 2 * smss) ? reduced : 2 * smss;
+}
+
+const gnrc_tcp_cc_t gnrc_tcp_cc_cubic = {
+    .init = _init,
+    .acked = _acked,
+    .congestion = _congestion,
+};
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc
+ * @{
+ *
+ * @file
+ * @brief       NewReno congestion control (see RFC 5681)
+ *
+ * @}
+ */
+#include "net/gnrc/tcp/cc.h"
+
+static void _init(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+
+static void _acked(gnrc_tcp_tcb_t *tcb, uint32_t acked)
+{
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+
+    /* Slow start: Grow by up to one segment per ACK */
+    if (tcb->cwnd < tcb->ssthresh) {
+        tcb->cwnd += (acked < smss) ? acked : smss;
+        return;
+    }
+
+    /* Congestion avoidance: Grow by one segment per window of acknowledged data */
+    tcb->bytes_acked += acked;
+    if (tcb->bytes_acked >= tcb->cwnd) {
+        tcb->bytes_acked -= tcb->cwnd;
+        tcb->cwnd += smss;
+    }
+}
+
+static void _congestion(gnrc_tcp_tcb_t *tcb, gnrc_tcp_cc_event_t event)
+{
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+    uint32_t half = gnrc_tcp_cc_flight_size(tcb) / 2;
+
+    (void)event;
+    /* ssthresh = max(FlightSize / 2, 2 * SMSS) */
+    tcb->ssthresh = (half > 2 * smss) ? half : 2 * smss;
+}
+
+const gnrc_tcp_cc_t gnrc_tcp_cc_newreno = {
+    .init = _init,
+    .acked = _acked,
+    .congestion = _congestion,
+};
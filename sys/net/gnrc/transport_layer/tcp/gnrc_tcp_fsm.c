@@ -22,6 +22,7 @@
 #include "random.h"
 #include "net/af.h"
 #include "net/gnrc.h"
+#include "internal/cc.h"
 #include "internal/common.h"
 #include "internal/pkt.h"
 #include "internal/option.h"
@@ -83,10 +84,12 @@ static uint16_t _get_random_local_port(void)
  */
 static int _clear_retransmit(gnrc_tcp_tcb_t *tcb)
 {
-    if (tcb->pkt_retransmit != NULL) {
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
+    if (tcb->rtx_num > 0) {
+        for (unsigned i = 0; i < tcb->rtx_num; i++) {
+            gnrc_pktbuf_release(tcb->rtx[i].pkt);
+        }
         xtimer_remove(&(tcb->tim_tout));
-        tcb->pkt_retransmit = NULL;
+        tcb->rtx_num = 0;
     }
     return 0;
 }
@@ -148,6 +151,12 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
 #endif
             tcb->peer_port = PORT_UNSPEC;
 
+            /* Clear options negotiated with the previous peer */
+            tcb->status &= ~(STATUS_WND_SCALE | STATUS_SACK_PERM);
+            tcb->snd_wnd_shift = 0;
+            tcb->rcv_wnd_shift = 0;
+            _cc_reset(tcb);
+
             /* Allocate receive buffer */
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
@@ -163,6 +172,12 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             break;
 
         case FSM_STATE_SYN_SENT:
+            /* Clear options negotiated with the previous peer */
+            tcb->status &= ~(STATUS_WND_SCALE | STATUS_SACK_PERM);
+            tcb->snd_wnd_shift = 0;
+            tcb->rcv_wnd_shift = 0;
+            _cc_reset(tcb);
+
             /* Allocate rceveive buffer */
             if (_rcvbuf_get_buffer(tcb) == -ENOMEM) {
                 return -ENOMEM;
@@ -191,8 +206,13 @@ static int _transition_to(gnrc_tcp_tcb_t *tcb, fsm_state_t state)
             mutex_unlock(&_list_tcb_lock);
             break;
 
-        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_ESTABLISHED:
+            /* Start congestion control with the MSS of the peer */
+            _cc_init(tcb);
+            tcb->status |= STATUS_NOTIFY_USER;
+            break;
+
+        case FSM_STATE_SYN_RCVD:
         case FSM_STATE_CLOSE_WAIT:
             tcb->status |= STATUS_NOTIFY_USER;
             break;
@@ -222,7 +242,6 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
     int ret = 0;
 
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_open()\n");
-    tcb->rcv_wnd = GNRC_TCP_DEFAULT_WINDOW;
 
     if (tcb->status & STATUS_PASSIVE) {
         /* Passive open, T: CLOSED -> LISTEN */
@@ -230,12 +249,15 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
             _transition_to(tcb, FSM_STATE_CLOSED);
             return -ENOMEM;
         }
+        /* Announce the receive buffer as window */
+        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
     }
     else {
         /* Active Open, set TCB values, send SYN, T: CLOSED -> SYN_SENT */
         tcb->iss = random_uint32();
         tcb->snd_nxt = tcb->iss;
         tcb->snd_una = tcb->iss;
+        tcb->recover = tcb->iss;
 
         /* Transition FSM to SYN_SENT */
         ret = _transition_to(tcb, FSM_STATE_SYN_SENT);
@@ -243,6 +265,8 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
             _transition_to(tcb, FSM_STATE_CLOSED);
             return ret;
         }
+        /* Announce the receive buffer as window */
+        tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
 
         /* Send SYN */
         gnrc_pktsnip_t *out_pkt = NULL;
@@ -261,30 +285,47 @@ static int _fsm_call_open(gnrc_tcp_tcb_t *tcb)
  * @param[in,out] buf   Buffer containing data to send.
  * @param[in]     len   Maximum Number of Bytes to send from @p buf.
  *
+ * @note Sends up to GNRC_TCP_SND_SEGMENTS segments without waiting
+ *       for their acknowledgment, as far as send and congestion window allow.
+ *
  * @returns   Number of successfully transmitted bytes.
  */
 static int _fsm_call_send(gnrc_tcp_tcb_t *tcb, void *buf, size_t len)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_call_send()\n");
 
-    size_t payload = (tcb->snd_una + tcb->snd_wnd) - tcb->snd_nxt;
+    size_t sent = 0;
+    uint32_t smss = gnrc_tcp_cc_smss(tcb);
+
+    while (sent < len && tcb->rtx_num < GNRC_TCP_SND_SEGMENTS) {
+        int32_t wnd_left = (int32_t) ((tcb->snd_una + _cc_wnd(tcb)) - tcb->snd_nxt);
+
+        /* Check if window is open */
+        if (wnd_left <= 0 || tcb->snd_wnd == 0) {
+            break;
+        }
 
-    /* Check if window is open and all packets were transmitted */
-    if (payload > 0 && tcb->snd_wnd > 0 && tcb->pkt_retransmit == NULL) {
         /* Calculate segment size */
-        payload = (payload < GNRC_TCP_MSS) ? payload : GNRC_TCP_MSS;
-        payload = (payload < tcb->mss) ? payload : tcb->mss;
-        payload = (payload < len) ? payload : len;
+        size_t payload = wnd_left;
+        payload = (payload < smss) ? payload : smss;
+        payload = (payload < (len - sent)) ? payload : (len - sent);
+
+        /* Avoid small segments while others are in flight (see RFC 1122, 4.2.3.4) */
+        if (tcb->rtx_num > 0 && payload < smss && payload < (len - sent)) {
+            break;
+        }
 
-        /* Calculate payload size for this segment */
         gnrc_pktsnip_t *out_pkt = NULL;
         uint16_t seq_con = 0;
-        _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt, buf, payload);
+        if (_pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK | MSK_PSH, tcb->snd_nxt, tcb->rcv_nxt,
+                       (uint8_t *) buf + sent, payload) < 0) {
+            break;
+        }
         _pkt_setup_retransmit(tcb, out_pkt, false);
         _pkt_send(tcb, out_pkt, seq_con, false);
-        return payload;
+        sent += payload;
     }
-    return 0;
+    return sent;
 }
 
 /**
@@ -421,6 +462,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
     seg_ack = byteorder_ntohl(tcp_hdr->ack_num);
     seg_wnd = byteorder_ntohs(tcp_hdr->window);
 
+    /* Window in SYN segments is never scaled */
+    if (!(ctl & MSK_SYN)) {
+        seg_wnd <<= tcb->snd_wnd_shift;
+    }
+
     /* Extract network layer header */
 #ifdef MODULE_GNRC_IPV6
     LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_IPV6);
@@ -505,6 +551,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             tcb->iss = random_uint32();
             tcb->snd_una = tcb->iss;
             tcb->snd_nxt = tcb->iss;
+            tcb->recover = tcb->iss;
             tcb->snd_wnd = seg_wnd;
 
             /* Send SYN+ACK: seq_no = iss, ack_no = rcv_nxt, T: LISTEN -> SYN_RCVD */
@@ -541,6 +588,11 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
         if (ctl & MSK_SYN) {
             tcb->rcv_nxt = seg_seq + 1;
             tcb->irs = seg_seq;
+
+            /* Receive window is scaled only if the peer supports it as well */
+            if (!(tcb->status & STATUS_WND_SCALE)) {
+                tcb->rcv_wnd_shift = 0;
+            }
             if (ctl & MSK_ACK) {
                 tcb->snd_una = seg_ack;
                 _pkt_acknowledge(tcb, seg_ack);
@@ -632,8 +684,22 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_CLOSING || tcb->state == FSM_STATE_LAST_ACK) {
                 /* Acknowledge previously sent data */
                 if (LSS_32_BIT(tcb->snd_una, seg_ack) && LEQ_32_BIT(seg_ack, tcb->snd_nxt)) {
+                    uint32_t acked = seg_ack - tcb->snd_una;
+
                     tcb->snd_una = seg_ack;
                     _pkt_acknowledge(tcb, seg_ack);
+                    _cc_ack(tcb, acked);
+
+                    /* Signal user that more data can be sent */
+                    tcb->status |= STATUS_NOTIFY_USER;
+                }
+                /* Duplicate ACK: data in flight, nothing new acknowledged or updated */
+                else if (seg_ack == tcb->snd_una && tcb->rtx_num > 0 && pay_len == 0 &&
+                         !(ctl & MSK_FIN) && seg_wnd == tcb->snd_wnd) {
+                    _cc_dup_ack(tcb);
+
+                    /* Signal user that the window was inflated */
+                    tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* ACK received for something not yet sent: Reply with pure ACK */
                 else if (LSS_32_BIT(tcb->snd_nxt, seg_ack)) {
@@ -654,28 +720,39 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                         tcb->status |= STATUS_NOTIFY_USER;
                     }
                 }
+                /* Process SACK option and retransmit lost segments during recovery */
+                if (tcb->status & STATUS_SACK_PERM) {
+                    uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2];
+                    unsigned num = _option_parse_sack(tcp_hdr, blocks);
+
+                    for (unsigned i = 0; i < num; i++) {
+                        _pkt_sack(tcb, blocks[i][0], blocks[i][1]);
+                    }
+                }
+                _pkt_recover(tcb);
+
                 /* Additional processing */
                 /* Check additionally if previously sent FIN was acknowledged */
                 if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_FIN_WAIT_2);
                     }
                 }
                 /* If retransmission queue is empty, acknowledge close operation */
                 if (tcb->state == FSM_STATE_FIN_WAIT_2) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         /* Optional: Unblock user close operation */
                     }
                 }
                 /* If our FIN has been acknowledged: Transition to TIME_WAIT */
                 if (tcb->state == FSM_STATE_CLOSING) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_TIME_WAIT);
                     }
                 }
                 /* If our FIN was acknowledged and status is LAST_ACK: close connection */
                 if (tcb->state == FSM_STATE_LAST_ACK) {
-                    if (tcb->pkt_retransmit == NULL) {
+                    if (tcb->rtx_num == 0) {
                         _transition_to(tcb, FSM_STATE_CLOSED);
                         return 0;
                     }
@@ -690,24 +767,14 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
             /* Check if state is valid for payload receiving */
             if (tcb->state == FSM_STATE_ESTABLISHED || tcb->state == FSM_STATE_FIN_WAIT_1 ||
                 tcb->state == FSM_STATE_FIN_WAIT_2) {
-                /* Search for begin of payload */
-                LL_SEARCH_SCALAR(in_pkt, snp, type, GNRC_NETTYPE_UNDEF);
-
-                /* Accept only data that is expected, to be received */
-                if (tcb->rcv_nxt == seg_seq) {
-                    /* Copy contents into receive buffer */
-                    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
-                        tcb->rcv_nxt += ringbuffer_add(&(tcb->rcv_buf), snp->data, snp->size);
-                        snp = snp->next;
-                    }
-                    /* Shrink receive window */
-                    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+                /* Copy new data into receive buffer, keep data received out of order */
+                if (_rcvbuf_add(tcb, in_pkt, seg_seq, pay_len) > 0) {
                     /* Notify owner because new data is available */
                     tcb->status |= STATUS_NOTIFY_USER;
                 }
                 /* Send ACK, if FIN processing sends ACK already */
                 /* NOTE: this is the place to add payload piggybagging in the future */
-                if (!(ctl & MSK_FIN)) {
+                if (!(ctl & MSK_FIN) || LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
                     _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt,
                                NULL, 0);
                     _pkt_send(tcb, out_pkt, seq_con, false);
@@ -720,6 +787,10 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 tcb->state == FSM_STATE_SYN_SENT) {
                 return 0;
             }
+            /* Process FIN only if all data before it was received */
+            if (LSS_32_BIT(tcb->rcv_nxt, seg_seq + pay_len)) {
+                return 0;
+            }
             /* Advance rcv_nxt over FIN bit */
             tcb->rcv_nxt = seg_seq + seg_len;
             _pkt_build(tcb, &out_pkt, &seq_con, MSK_ACK, tcb->snd_nxt, tcb->rcv_nxt, NULL, 0);
@@ -729,7 +800,7 @@ static int _fsm_rcvd_pkt(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *in_pkt)
                 _transition_to(tcb, FSM_STATE_CLOSE_WAIT);
             }
             else if (tcb->state == FSM_STATE_FIN_WAIT_1) {
-                if (tcb->pkt_retransmit == NULL) {
+                if (tcb->rtx_num == 0) {
                     _transition_to(tcb, FSM_STATE_TIME_WAIT);
                 }
                 else {
@@ -771,9 +842,13 @@ static int _fsm_timeout_timewait(gnrc_tcp_tcb_t *tcb)
 static int _fsm_timeout_retransmit(gnrc_tcp_tcb_t *tcb)
 {
     DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit()\n");
-    if (tcb->pkt_retransmit != NULL) {
-        _pkt_setup_retransmit(tcb, tcb->pkt_retransmit, true);
-        _pkt_send(tcb, tcb->pkt_retransmit, 0, true);
+    if (tcb->rtx_num > 0) {
+        /* Segments in flight are lost unless acknowledged selectively */
+        _cc_timeout(tcb);
+        tcb->recover = tcb->snd_nxt;
+        _pkt_setup_retransmit(tcb, tcb->rtx[0].pkt, true);
+        _pkt_send(tcb, tcb->rtx[0].pkt, 0, true);
+        _pkt_recover(tcb);
     }
     else {
         DEBUG("gnrc_tcp_fsm.c : _fsm_timeout_retransmit() : Retransmit queue is empty\n");
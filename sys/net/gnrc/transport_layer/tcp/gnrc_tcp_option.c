@@ -16,6 +16,7 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  * @}
  */
+#include <string.h>
 #include "internal/common.h"
 #include "internal/option.h"
 
@@ -25,7 +26,8 @@
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
 {
     /* Extract offset value. Return if no options are set */
-    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint16_t ctl = byteorder_ntohs(hdr->off_ctl);
+    uint8_t offset = GET_OFFSET(ctl);
     if (offset <= TCP_HDR_OFFSET_MIN) {
         return 0;
     }
@@ -62,6 +64,48 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
                       tcb->mss);
                 break;
 
+            case TCP_OPTION_KIND_WS:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_WS) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid WS Option length.\n");
+                    return -1;
+                }
+                /* Window scaling is negotiated in SYN segments only */
+                if (GNRC_TCP_WINDOW_SCALING && (ctl & MSK_SYN)) {
+                    tcb->snd_wnd_shift = (option->value[0] < TCP_OPTION_WS_SHIFT_MAX) ?
+                                         option->value[0] : TCP_OPTION_WS_SHIFT_MAX;
+                    tcb->status |= STATUS_WND_SCALE;
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : WS option found. "
+                          "shift=%"PRIu8"\n", tcb->snd_wnd_shift);
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK_PERM:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length != TCP_OPTION_LENGTH_SACK_PERM) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK permitted Option "
+                          "length.\n");
+                    return -1;
+                }
+                if (GNRC_TCP_SACK && (ctl & MSK_SYN)) {
+                    tcb->status |= STATUS_SACK_PERM;
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : SACK permitted option found\n");
+                }
+                break;
+
+            case TCP_OPTION_KIND_SACK:
+                if (opt_left < TCP_OPTION_LENGTH_MIN || option->length > opt_left ||
+                    option->length < TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK ||
+                    (option->length - TCP_OPTION_LENGTH_MIN) % TCP_OPTION_LENGTH_SACK_BLOCK) {
+
+                    DEBUG("gnrc_tcp_option.c : _option_parse() : invalid SACK Option length.\n");
+                    return -1;
+                }
+                DEBUG("gnrc_tcp_option.c : _option_parse() : SACK option found\n");
+                break;
+
             default:
                 if (opt_left >= TCP_OPTION_LENGTH_MIN) {
                     DEBUG("gnrc_tcp_option.c : _option_parse() : Unsupported option found.\
@@ -80,3 +124,40 @@ int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr)
     }
     return 0;
 }
+
+unsigned _option_parse_sack(tcp_hdr_t *hdr, uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2])
+{
+    uint8_t offset = GET_OFFSET(byteorder_ntohs(hdr->off_ctl));
+    uint8_t *opt_ptr = (uint8_t *) hdr + sizeof(tcp_hdr_t);
+    uint8_t *opt_end = opt_ptr + (offset - TCP_HDR_OFFSET_MIN) * 4;
+
+    /* Options were validated by _option_parse() already */
+    while (opt_ptr < opt_end) {
+        tcp_hdr_opt_t *option = (tcp_hdr_opt_t *) opt_ptr;
+
+        if (option->kind == TCP_OPTION_KIND_EOL) {
+            break;
+        }
+        if (option->kind == TCP_OPTION_KIND_NOP) {
+            opt_ptr += 1;
+            continue;
+        }
+        if (option->kind == TCP_OPTION_KIND_SACK) {
+            unsigned num = (option->length - TCP_OPTION_LENGTH_MIN) /
+                           TCP_OPTION_LENGTH_SACK_BLOCK;
+
+            num = (num < TCP_OPTION_SACK_BLOCKS_MAX) ? num : TCP_OPTION_SACK_BLOCKS_MAX;
+            for (unsigned i = 0; i < num; i++) {
+                network_uint32_t edges[2];
+
+                /* Option values are unaligned */
+                memcpy(edges, option->value + i * TCP_OPTION_LENGTH_SACK_BLOCK, sizeof(edges));
+                blocks[i][0] = byteorder_ntohl(edges[0]);
+                blocks[i][1] = byteorder_ntohl(edges[1]);
+            }
+            return num;
+        }
+        opt_ptr += option->length;
+    }
+    return 0;
+}
@@ -25,6 +25,7 @@
 #include "internal/common.h"
 #include "internal/option.h"
 #include "internal/pkt.h"
+#include "internal/rcvbuf.h"
 
 #ifdef MODULE_GNRC_IPV6
 #include "net/gnrc/ipv6.h"
@@ -46,6 +47,72 @@ static inline uint32_t _max(const uint32_t x, const uint32_t y)
   return (x > y) ? x : y;
 }
 
+/**
+ * @brief Calculates the window scale shift count for a receive buffer.
+ *
+ * @param[in] size   Size of the receive buffer.
+ *
+ * @returns   Smallest shift count to announce the whole buffer as window.
+ */
+static uint8_t _wnd_shift(const uint32_t size)
+{
+    uint8_t shift = 0;
+    while ((shift < TCP_OPTION_WS_SHIFT_MAX) && ((size >> shift) > UINT16_MAX)) {
+        shift++;
+    }
+    return shift;
+}
+
+/**
+ * @brief Passes a packet down the network stack.
+ *
+ * @param[in] pkt   Packet to send.
+ */
+static void _send_down(gnrc_pktsnip_t *pkt)
+{
+    if (gnrc_netapi_send(gnrc_tcp_pid, pkt) < 1) {
+        DEBUG("gnrc_tcp_pkt.c : _send_down() : unable to send packet\n");
+        gnrc_pktbuf_release(pkt);
+    }
+}
+
+/**
+ * @brief Calculates the retransmission timeout from the round trip time estimation.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _calc_rto(gnrc_tcp_tcb_t *tcb)
+{
+    /* If there was no measurement yet: rto is 1 sec (Lower Bound) */
+    if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else {
+        tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+    }
+}
+
+/**
+ * @brief Starts the retransmission timer for the oldest segment in flight.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+static void _start_rtx_timer(gnrc_tcp_tcb_t *tcb)
+{
+    /* Perform boundary checks on current RTO before usage */
+    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+    }
+    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
+        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
+    }
+
+    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
+    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
+    tcb->msg_tout.content.ptr = (void *) tcb;
+    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+}
+
 int _pkt_build_reset_from_pkt(gnrc_pktsnip_t **out_pkt, gnrc_pktsnip_t *in_pkt)
 {
     tcp_hdr_t tcp_hdr_out;
@@ -147,6 +214,11 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     gnrc_pktsnip_t *tcp_snp = NULL;
     tcp_hdr_t tcp_hdr;
     uint8_t offset = TCP_HDR_OFFSET_MIN;
+    uint32_t wnd = 0;
+    uint32_t sack[TCP_OPTION_SACK_BLOCKS_MAX][2];
+    unsigned sack_num = 0;
+    bool ws = false;
+    bool sack_perm = false;
 
     /* Add payload, if supplied */
     if (payload != NULL && payload_len > 0) {
@@ -164,14 +236,32 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
     tcp_hdr.checksum = byteorder_htons(0);
     tcp_hdr.seq_num = byteorder_htonl(seq_num);
     tcp_hdr.ack_num = byteorder_htonl(ack_num);
-    tcp_hdr.window = byteorder_htons(tcb->rcv_wnd);
     tcp_hdr.urgent_ptr = byteorder_htons(0);
 
     /* Calculate option field size. */
     /* Add MSS option if SYN is sent */
     if (ctl & MSK_SYN) {
         offset += 1;
+
+        /* Offer window scaling and SACK with SYN, accept them with SYN+ACK */
+        ws = GNRC_TCP_WINDOW_SCALING &&
+             (!(ctl & MSK_ACK) || (tcb->status & STATUS_WND_SCALE));
+        sack_perm = GNRC_TCP_SACK &&
+                    (!(ctl & MSK_ACK) || (tcb->status & STATUS_SACK_PERM));
+        tcb->rcv_wnd_shift = (ws) ? _wnd_shift(tcb->rcv_buf.size) : 0;
+        offset += ws + sack_perm;
+    }
+    /* Add SACK option if data was received out of order */
+    else if ((ctl & MSK_ACK) && (tcb->status & STATUS_SACK_PERM)) {
+        sack_num = _rcvbuf_sack_blocks(tcb, sack);
+        if (sack_num > 0) {
+            offset += 1 + 2 * sack_num;
+        }
     }
+
+    /* Window in SYN segments is never scaled */
+    wnd = (ctl & MSK_SYN) ? tcb->rcv_wnd : (tcb->rcv_wnd >> tcb->rcv_wnd_shift);
+    tcp_hdr.window = byteorder_htons((wnd < UINT16_MAX) ? wnd : UINT16_MAX);
     /* Set offset and control bit accordingly */
     tcp_hdr.off_ctl = byteorder_htons(_option_build_offset_control(offset, ctl));
 
@@ -203,8 +293,29 @@ int _pkt_build(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t **out_pkt, uint16_t *seq_con,
             if (ctl & MSK_SYN) {
                 network_uint32_t mss_option = byteorder_htonl(_option_build_mss(GNRC_TCP_MSS));
                 memcpy(opt_ptr, &mss_option, sizeof(mss_option));
+                opt_ptr += sizeof(mss_option);
+            }
+            if (ws) {
+                network_uint32_t ws_option = byteorder_htonl(_option_build_ws(tcb->rcv_wnd_shift));
+                memcpy(opt_ptr, &ws_option, sizeof(ws_option));
+                opt_ptr += sizeof(ws_option);
+            }
+            if (sack_perm) {
+                network_uint32_t sack_perm_option = byteorder_htonl(_option_build_sack_perm());
+                memcpy(opt_ptr, &sack_perm_option, sizeof(sack_perm_option));
+                opt_ptr += sizeof(sack_perm_option);
+            }
+            if (sack_num > 0) {
+                network_uint32_t sack_option = byteorder_htonl(_option_build_sack(sack_num));
+                memcpy(opt_ptr, &sack_option, sizeof(sack_option));
+                opt_ptr += sizeof(sack_option);
+                for (unsigned i = 0; i < sack_num; i++) {
+                    network_uint32_t edges[2] = { byteorder_htonl(sack[i][0]),
+                                                  byteorder_htonl(sack[i][1]) };
+                    memcpy(opt_ptr, edges, sizeof(edges));
+                    opt_ptr += sizeof(edges);
+                }
             }
-            /* Increase opt_ptr and decrease opt_left, if other options are added */
             /* NOTE: Add additional options here */
         }
         *(out_pkt) = tcp_snp;
@@ -267,21 +378,16 @@ int _pkt_send(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *out_pkt, const uint16_t seq_c
         return -EINVAL;
     }
 
-    /* If this is no retransmission, advance sequence number and measure time */
+    /* If this is no retransmission, advance sequence number */
     if (!retransmit) {
-        tcb->retries = 0;
         tcb->snd_nxt += seq_con;
-        tcb->rtt_start = xtimer_now().ticks32;
     }
     else {
         tcb->retries += 1;
     }
 
     /* Pass packet down the network stack */
-    if (gnrc_netapi_send(gnrc_tcp_pid, out_pkt) < 1) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_send() : unable to send packet\n");
-        gnrc_pktbuf_release(out_pkt);
-    }
+    _send_down(out_pkt);
     return 0;
 }
 
@@ -352,6 +458,7 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt)
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit)
 {
     gnrc_pktsnip_t *snp = NULL;
+    gnrc_tcp_rtx_t *rtx = NULL;
     uint32_t ctl = 0;
     uint32_t len = 0;
 
@@ -361,12 +468,6 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return -EINVAL;
     }
 
-    /* Check if retransmit queue is full and pkt is not already in retransmit queue */
-    if (tcb->pkt_retransmit != NULL && tcb->pkt_retransmit != pkt) {
-        DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Nothing to do\n");
-        return -ENOMEM;
-    }
-
     /* Extract control bits and segment length */
     LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_TCP);
     ctl = byteorder_ntohs(((tcp_hdr_t *) snp->data)->off_ctl);
@@ -377,21 +478,36 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         return 0;
     }
 
-    /* Assign pkt and increase users: every send attempt consumes a user */
-    tcb->pkt_retransmit = pkt;
-    gnrc_pktbuf_hold(pkt, 1);
-
-    /* RTO adjustment */
     if (!retransmit) {
-        /* If this is the first transmission: rto is 1 sec (Lower Bound) */
-        if (tcb->srtt == RTO_UNINITIALIZED || tcb->rtt_var == RTO_UNINITIALIZED) {
-            tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
+        /* Check if retransmit queue is full */
+        if (tcb->rtx_num >= GNRC_TCP_RTX_QUEUE_SIZE) {
+            DEBUG("gnrc_tcp_pkt.c : _pkt_setup_retransmit() : Retransmit queue is full\n");
+            return -ENOMEM;
         }
-        else {
-            tcb->rto = tcb->srtt + _max(GNRC_TCP_RTO_GRANULARITY,  GNRC_TCP_RTO_K * tcb->rtt_var);
+
+        /* Append pkt to the retransmit queue */
+        rtx = &tcb->rtx[tcb->rtx_num++];
+        rtx->pkt = pkt;
+        rtx->seq = byteorder_ntohl(((tcp_hdr_t *) snp->data)->seq_num);
+        rtx->len = _pkt_get_seg_len(pkt);
+        rtx->sent = xtimer_now().ticks32;
+        rtx->retransmitted = 0;
+        rtx->sacked = 0;
+
+        /* The timer runs already if other segments are in flight */
+        if (tcb->rtx_num > 1) {
+            gnrc_pktbuf_hold(pkt, 1);
+            return 0;
         }
+        _calc_rto(tcb);
     }
     else {
+        for (unsigned i = 0; i < tcb->rtx_num; i++) {
+            if (tcb->rtx[i].pkt == pkt) {
+                tcb->rtx[i].retransmitted = 1;
+            }
+        }
+
         /* If this is a retransmission: Double the rto (Timer Backoff) */
         tcb->rto *= 2;
 
@@ -403,65 +519,117 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
         }
     }
 
-    /* Perform boundary checks on current RTO before usage */
-    if (tcb->rto < (int32_t) GNRC_TCP_RTO_LOWER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_LOWER_BOUND;
-    }
-    else if (tcb->rto > (int32_t) GNRC_TCP_RTO_UPPER_BOUND) {
-        tcb->rto = GNRC_TCP_RTO_UPPER_BOUND;
-    }
-
-    /* Setup retransmission timer, msg to TCP thread with ptr to TCB */
-    tcb->msg_tout.type = MSG_TYPE_RETRANSMISSION;
-    tcb->msg_tout.content.ptr = (void *) tcb;
-    xtimer_set_msg(&tcb->tim_tout, tcb->rto, &tcb->msg_tout, gnrc_tcp_pid);
+    /* Increase users: every send attempt consumes a user */
+    gnrc_pktbuf_hold(pkt, 1);
+    _start_rtx_timer(tcb);
     return 0;
 }
 
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack)
 {
-    uint32_t seg = 0;
-    gnrc_pktsnip_t *snp = NULL;
-    tcp_hdr_t *hdr;
+    unsigned acked = 0;
+    int32_t rtt = 0;
 
     /* Retransmission queue is empty. Nothing to ACK there */
-    if (tcb->pkt_retransmit == NULL) {
+    if (tcb->rtx_num == 0) {
         DEBUG("gnrc_tcp_pkt.c : _pkt_acknowledge() : There is no packet to ack\n");
         return -ENODATA;
     }
 
-    LL_SEARCH_SCALAR(tcb->pkt_retransmit, snp, type, GNRC_NETTYPE_TCP);
-    hdr = (tcp_hdr_t *) snp->data;
+    /* Release all segments that are acknowledged completely */
+    while (acked < tcb->rtx_num &&
+           LEQ_32_BIT(tcb->rtx[acked].seq + tcb->rtx[acked].len, ack)) {
+        /* Use time only if there was no retransmission (Karns Algorithm) */
+        if (!tcb->rtx[acked].retransmitted) {
+            rtt = xtimer_now().ticks32 - tcb->rtx[acked].sent;
+        }
+        gnrc_pktbuf_release(tcb->rtx[acked].pkt);
+        acked++;
+    }
+    if (acked == 0) {
+        return 0;
+    }
+    memmove(&tcb->rtx[0], &tcb->rtx[acked], (tcb->rtx_num - acked) * sizeof(tcb->rtx[0]));
+    tcb->rtx_num -= acked;
+    tcb->retries = 0;
+    xtimer_remove(&(tcb->tim_tout));
+
+    /* Measure round trip time, if there was no timer overflow */
+    if (rtt > 0) {
+        /* If this is the first sample taken */
+        if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
+            tcb->srtt = rtt;
+            tcb->rtt_var = (rtt >> 1);
+        }
+        /* If this is a subsequent sample */
+        else {
+            tcb->rtt_var = (tcb->rtt_var / GNRC_TCP_RTO_B_DIV) * (GNRC_TCP_RTO_B_DIV-1);
+            tcb->rtt_var += abs(tcb->srtt - rtt) / GNRC_TCP_RTO_B_DIV;
+            tcb->srtt = (tcb->srtt / GNRC_TCP_RTO_A_DIV) * (GNRC_TCP_RTO_A_DIV-1);
+            tcb->srtt += rtt / GNRC_TCP_RTO_A_DIV;
+        }
+        _calc_rto(tcb);
+    }
 
-    /* There must be a packet, waiting to be acknowledged. */
-    seg = byteorder_ntohl(hdr->seq_num) + _pkt_get_seg_len(tcb->pkt_retransmit) - 1;
+    /* Restart timer for the segments still in flight */
+    if (tcb->rtx_num > 0) {
+        _start_rtx_timer(tcb);
+    }
+    return 0;
+}
 
-    /* If segment can be acknowledged -> stop timer, release packet from pktbuf and update rto. */
-    if (LSS_32_BIT(seg, ack)) {
-        xtimer_remove(&(tcb->tim_tout));
-        gnrc_pktbuf_release(tcb->pkt_retransmit);
-        tcb->pkt_retransmit = NULL;
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right)
+{
+    for (unsigned i = 0; i < tcb->rtx_num; i++) {
+        gnrc_tcp_rtx_t *rtx = &tcb->rtx[i];
 
-        /* Measure round trip time */
-        int32_t rtt = xtimer_now().ticks32 - tcb->rtt_start;
+        if (LEQ_32_BIT(left, rtx->seq) && LEQ_32_BIT(rtx->seq + rtx->len, right)) {
+            rtx->sacked = 1;
+        }
+    }
+}
 
-        /* Use time only if there was no timer overflow and no retransmission (Karns Algorithm) */
-        if (tcb->retries == 0 && rtt > 0) {
-            /* If this is the first sample taken */
-            if (tcb->srtt == RTO_UNINITIALIZED && tcb->rtt_var == RTO_UNINITIALIZED) {
-                tcb->srtt = rtt;
-                tcb->rtt_var = (rtt >> 1);
-            }
-            /* If this is a subsequent sample */
-            else {
-                tcb->rtt_var = (tcb->rtt_var / GNRC_TCP_RTO_B_DIV) * (GNRC_TCP_RTO_B_DIV-1);
-                tcb->rtt_var += abs(tcb->srtt - rtt) / GNRC_TCP_RTO_B_DIV;
-                tcb->srtt = (tcb->srtt / GNRC_TCP_RTO_A_DIV) * (GNRC_TCP_RTO_A_DIV-1);
-                tcb->srtt += rtt / GNRC_TCP_RTO_A_DIV;
-            }
+/**
+ * @brief Retransmits a segment of the retransmission queue without timer backoff.
+ *
+ * @param[in,out] rtx   Segment to retransmit.
+ */
+static void _retransmit(gnrc_tcp_rtx_t *rtx)
+{
+    DEBUG("gnrc_tcp_pkt.c : _retransmit() : seq=%"PRIu32"\n", rtx->seq);
+    rtx->retransmitted = 1;
+    gnrc_pktbuf_hold(rtx->pkt, 1);
+    _send_down(rtx->pkt);
+}
+
+void _pkt_fast_retransmit(gnrc_tcp_tcb_t *tcb)
+{
+    if (tcb->rtx_num > 0) {
+        _retransmit(&tcb->rtx[0]);
+    }
+}
+
+void _pkt_recover(gnrc_tcp_tcb_t *tcb)
+{
+    int last_sacked = -1;
+
+    /* Recovery ends as soon as all segments in flight at its start are acknowledged */
+    if ((tcb->rtx_num == 0) || !LSS_32_BIT(tcb->snd_una, tcb->recover)) {
+        return;
+    }
+    for (unsigned i = 0; i < tcb->rtx_num; i++) {
+        if (tcb->rtx[i].sacked) {
+            last_sacked = i;
+        }
+    }
+    /* The oldest segment and all segments below a selectively acknowledged one are lost */
+    for (int i = 0; (i == 0) || (i < last_sacked); i++) {
+        gnrc_tcp_rtx_t *rtx = &tcb->rtx[i];
+
+        if (!rtx->retransmitted && !rtx->sacked && LSS_32_BIT(rtx->seq, tcb->recover)) {
+            _retransmit(rtx);
         }
     }
-    return 0;
 }
 
 uint16_t _pkt_calc_csum(const gnrc_pktsnip_t *hdr, const gnrc_pktsnip_t *pseudo_hdr,
@@ -16,11 +16,21 @@
  * @author      Simon Brummer <simon.brummer@posteo.de>
  */
 #include <errno.h>
+#include <string.h>
+#include <utlist.h>
+#include "net/gnrc.h"
+#include "internal/common.h"
 #include "internal/rcvbuf.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+/**
+ * @brief Minimum size of a receive buffer.
+ */
+#define RCV_BUF_SIZE_MIN ((GNRC_TCP_MSS < GNRC_TCP_RCV_BUF_SIZE) ? GNRC_TCP_MSS : \
+                                                                   GNRC_TCP_RCV_BUF_SIZE)
+
 /**
  * @brief Internal struct holding receive buffers.
  */
@@ -34,28 +44,83 @@ void _rcvbuf_init(void)
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_init() : entry\n");
     mutex_init(&(_static_buf.lock));
     for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        _static_buf.entries[i].used = 0;
+        _static_buf.entries[i].buffer = NULL;
     }
 }
 
+/**
+ * @brief Get the size of the unused space in the pool at @p start.
+ *
+ * @note Must be called from a context where the buffers are locked.
+ *
+ * @param[in] start   Start of the space.
+ *
+ * @returns   Number of bytes until the next buffer or the end of the pool.
+ */
+static size_t _rcvbuf_space(const uint8_t *start)
+{
+    const uint8_t *end = _static_buf.pool + sizeof(_static_buf.pool);
+
+    for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
+        const uint8_t *buffer = _static_buf.entries[i].buffer;
+        if ((buffer != NULL) && (buffer >= start) && (buffer < end)) {
+            end = buffer;
+        }
+    }
+    return end - start;
+}
+
 /**
  * @brief Allocate receive buffer.
  *
+ * @param[in,out] size   Requested size, actual size of the buffer on return.
+ *
  * @returns   Not NULL if a receive buffer was allocated.
  *            NULL if allocation failed.
  */
-static void* _rcvbuf_alloc(void)
+static void* _rcvbuf_alloc(size_t *size)
 {
-    void *result = NULL;
+    rcvbuf_entry_t *entry = NULL;
+    uint8_t *result = NULL;
+    size_t result_size = 0;
+
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_alloc() : Entry\n");
     mutex_lock(&(_static_buf.lock));
     for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if (_static_buf.entries[i].used == 0) {
-            _static_buf.entries[i].used = 1;
-            result = (void *)(_static_buf.entries[i].buffer);
+        if (_static_buf.entries[i].buffer == NULL) {
+            entry = &_static_buf.entries[i];
             break;
         }
     }
+    /* Unused space starts at the begin of the pool or right after a buffer:
+     * take the first that is large enough, or else the largest one */
+    for (size_t i = 0; (entry != NULL) && (i <= GNRC_TCP_RCV_BUFFERS); ++i) {
+        uint8_t *start = _static_buf.pool;
+        if (i > 0) {
+            if (_static_buf.entries[i - 1].buffer == NULL) {
+                continue;
+            }
+            start = _static_buf.entries[i - 1].buffer + _static_buf.entries[i - 1].size;
+        }
+        size_t space = _rcvbuf_space(start);
+        if (space >= *size) {
+            result = start;
+            result_size = *size;
+            break;
+        }
+        if (space > result_size) {
+            result = start;
+            result_size = space;
+        }
+    }
+    if ((result != NULL) && (result_size >= RCV_BUF_SIZE_MIN)) {
+        entry->buffer = result;
+        entry->size = result_size;
+        *size = result_size;
+    }
+    else {
+        result = NULL;
+    }
     mutex_unlock(&(_static_buf.lock));
     return result;
 }
@@ -70,23 +135,186 @@ static void _rcvbuf_free(void * const buf)
     DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_free() : Entry\n");
     mutex_lock(&(_static_buf.lock));
     for (size_t i = 0; i < GNRC_TCP_RCV_BUFFERS; ++i) {
-        if ((_static_buf.entries[i].used == 1) && (buf == _static_buf.entries[i].buffer)) {
-            _static_buf.entries[i].used = 0;
+        if (buf == _static_buf.entries[i].buffer) {
+            _static_buf.entries[i].buffer = NULL;
         }
     }
     mutex_unlock(&(_static_buf.lock));
 }
 
+/**
+ * @brief Copy the payload of a segment beyond rcv_nxt into the receive buffer.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[in]     pkt   Packet holding the segment.
+ * @param[in]     seq   Sequence number of the payload, not after rcv_nxt.
+ *
+ * @returns   Number of bytes added to the receive buffer.
+ */
+static uint32_t _rcvbuf_copy(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seq)
+{
+    gnrc_pktsnip_t *snp = NULL;
+    uint32_t skip = tcb->rcv_nxt - seq;
+    uint32_t added = 0;
+
+    LL_SEARCH_SCALAR(pkt, snp, type, GNRC_NETTYPE_UNDEF);
+    while (snp && snp->type == GNRC_NETTYPE_UNDEF) {
+        if (skip < snp->size) {
+            added += ringbuffer_add(&(tcb->rcv_buf), (char *)snp->data + skip,
+                                    snp->size - skip);
+            skip = 0;
+        }
+        else {
+            skip -= snp->size;
+        }
+        snp = snp->next;
+    }
+    tcb->rcv_nxt += added;
+    return added;
+}
+
+#if GNRC_TCP_RCV_OOO_SEGMENTS > 0
+/**
+ * @brief Mark a segment received out of order as the most recently received one.
+ *
+ * @param[in,out] tcb   TCB holding the segments received out of order.
+ * @param[in]     i     Index of the segment.
+ */
+static void _rcvbuf_ooo_touch(gnrc_tcp_tcb_t *tcb, unsigned i)
+{
+    for (unsigned j = 0; j < tcb->ooo_num; j++) {
+        if (tcb->ooo[j].rank < tcb->ooo[i].rank) {
+            tcb->ooo[j].rank++;
+        }
+    }
+    tcb->ooo[i].rank = 0;
+}
+
+/**
+ * @brief Release the segment received out of order with the lowest sequence number.
+ *
+ * @param[in,out] tcb   TCB holding the segments received out of order.
+ */
+static void _rcvbuf_ooo_pop(gnrc_tcp_tcb_t *tcb)
+{
+    gnrc_pktbuf_release(tcb->ooo[0].pkt);
+    for (unsigned j = 1; j < tcb->ooo_num; j++) {
+        if (tcb->ooo[j].rank > tcb->ooo[0].rank) {
+            tcb->ooo[j].rank--;
+        }
+    }
+    tcb->ooo_num--;
+    memmove(&tcb->ooo[0], &tcb->ooo[1], tcb->ooo_num * sizeof(tcb->ooo[0]));
+}
+
+/**
+ * @brief Keep a segment received out of order.
+ *
+ * @param[in,out] tcb   TCB holding the segments received out of order.
+ * @param[in]     pkt   Packet holding the segment.
+ * @param[in]     seq   Sequence number of the payload.
+ * @param[in]     len   Payload length.
+ */
+static void _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seq,
+                            uint32_t len)
+{
+    unsigned i = 0;
+
+    /* Keep only segments that fit into the receive window */
+    if (LSS_32_BIT(tcb->rcv_nxt + tcb->rcv_wnd, seq + len) ||
+        (tcb->ooo_num >= GNRC_TCP_RCV_OOO_SEGMENTS)) {
+        DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_ooo_add() : Drop segment\n");
+        return;
+    }
+    while ((i < tcb->ooo_num) && LSS_32_BIT(tcb->ooo[i].seq, seq)) {
+        i++;
+    }
+    /* Drop segments received already, but remember that they were received again */
+    if ((i > 0) && LEQ_32_BIT(seq + len, tcb->ooo[i - 1].seq + tcb->ooo[i - 1].len)) {
+        _rcvbuf_ooo_touch(tcb, i - 1);
+        return;
+    }
+    if ((i < tcb->ooo_num) && (tcb->ooo[i].seq == seq) && (tcb->ooo[i].len >= len)) {
+        _rcvbuf_ooo_touch(tcb, i);
+        return;
+    }
+    memmove(&tcb->ooo[i + 1], &tcb->ooo[i], (tcb->ooo_num - i) * sizeof(tcb->ooo[0]));
+    gnrc_pktbuf_hold(pkt, 1);
+    tcb->ooo[i].pkt = pkt;
+    tcb->ooo[i].seq = seq;
+    tcb->ooo[i].len = len;
+    tcb->ooo[i].rank = tcb->ooo_num;
+    tcb->ooo_num++;
+    _rcvbuf_ooo_touch(tcb, i);
+}
+
+/**
+ * @brief Move segments received out of order that are in order now into the
+ *        receive buffer.
+ *
+ * @param[in,out] tcb   TCB holding the segments received out of order.
+ *
+ * @returns   Number of bytes added to the receive buffer.
+ */
+static uint32_t _rcvbuf_ooo_drain(gnrc_tcp_tcb_t *tcb)
+{
+    uint32_t added = 0;
+
+    /* Segments are sorted, so all that got in order are at the front */
+    while ((tcb->ooo_num > 0) && LEQ_32_BIT(tcb->ooo[0].seq, tcb->rcv_nxt)) {
+        if (LSS_32_BIT(tcb->rcv_nxt, tcb->ooo[0].seq + tcb->ooo[0].len)) {
+            added += _rcvbuf_copy(tcb, tcb->ooo[0].pkt, tcb->ooo[0].seq);
+        }
+        _rcvbuf_ooo_pop(tcb);
+    }
+    return added;
+}
+
+/**
+ * @brief Release all segments received out of order.
+ *
+ * @param[in,out] tcb   TCB holding the segments received out of order.
+ */
+static void _rcvbuf_ooo_clear(gnrc_tcp_tcb_t *tcb)
+{
+    for (unsigned i = 0; i < tcb->ooo_num; i++) {
+        gnrc_pktbuf_release(tcb->ooo[i].pkt);
+    }
+    tcb->ooo_num = 0;
+}
+#else
+static inline void _rcvbuf_ooo_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seq,
+                                   uint32_t len)
+{
+    (void)tcb;
+    (void)pkt;
+    (void)seq;
+    (void)len;
+}
+
+static inline uint32_t _rcvbuf_ooo_drain(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+    return 0;
+}
+
+static inline void _rcvbuf_ooo_clear(gnrc_tcp_tcb_t *tcb)
+{
+    (void)tcb;
+}
+#endif
+
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 {
     if (tcb->rcv_buf_raw == NULL) {
-        tcb->rcv_buf_raw = _rcvbuf_alloc();
+        size_t size = GNRC_TCP_RCV_BUF_SIZE;
+        tcb->rcv_buf_raw = _rcvbuf_alloc(&size);
         if (tcb->rcv_buf_raw == NULL) {
             DEBUG("gnrc_tcp_rcvbuf.c : _rcvbuf_get_buffer() : Can't allocate rcv_buf_raw\n");
             return -ENOMEM;
         }
         else {
-            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, GNRC_TCP_RCV_BUF_SIZE);
+            ringbuffer_init(&tcb->rcv_buf, (char *) tcb->rcv_buf_raw, size);
         }
     }
     return 0;
@@ -94,8 +322,77 @@ int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb)
 
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb)
 {
+    _rcvbuf_ooo_clear(tcb);
     if (tcb->rcv_buf_raw != NULL) {
         _rcvbuf_free(tcb->rcv_buf_raw);
         tcb->rcv_buf_raw = NULL;
     }
 }
+
+uint32_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seq, uint32_t len)
+{
+    uint32_t added = 0;
+
+    if (LSS_32_BIT(tcb->rcv_nxt, seq)) {
+        _rcvbuf_ooo_add(tcb, pkt, seq, len);
+    }
+    else if (LSS_32_BIT(tcb->rcv_nxt, seq + len)) {
+        added = _rcvbuf_copy(tcb, pkt, seq);
+        added += _rcvbuf_ooo_drain(tcb);
+    }
+    tcb->rcv_wnd = ringbuffer_get_free(&(tcb->rcv_buf));
+    return added;
+}
+
+unsigned _rcvbuf_sack_blocks(const gnrc_tcp_tcb_t *tcb,
+                             uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2])
+{
+    unsigned num = 0;
+
+#if GNRC_TCP_RCV_OOO_SEGMENTS > 0
+    uint32_t merged[GNRC_TCP_RCV_OOO_SEGMENTS][2];
+    uint8_t rank[GNRC_TCP_RCV_OOO_SEGMENTS];
+    unsigned merged_num = 0;
+
+    /* Merge adjacent and overlapping segments into blocks */
+    for (unsigned i = 0; i < tcb->ooo_num; i++) {
+        uint32_t left = tcb->ooo[i].seq;
+        uint32_t right = left + tcb->ooo[i].len;
+
+        if ((merged_num > 0) && LEQ_32_BIT(left, merged[merged_num - 1][1])) {
+            if (LSS_32_BIT(merged[merged_num - 1][1], right)) {
+                merged[merged_num - 1][1] = right;
+            }
+            if (tcb->ooo[i].rank < rank[merged_num - 1]) {
+                rank[merged_num - 1] = tcb->ooo[i].rank;
+            }
+        }
+        else {
+            merged[merged_num][0] = left;
+            merged[merged_num][1] = right;
+            rank[merged_num] = tcb->ooo[i].rank;
+            merged_num++;
+        }
+    }
+    /* The block holding the most recently received segment comes first, then the
+     * other blocks from the most recently to the least recently reported one
+     * (see RFC 2018, section 4) */
+    while ((num < TCP_OPTION_SACK_BLOCKS_MAX) && (num < merged_num)) {
+        unsigned next = 0;
+
+        for (unsigned i = 1; i < merged_num; i++) {
+            if (rank[i] < rank[next]) {
+                next = i;
+            }
+        }
+        blocks[num][0] = merged[next][0];
+        blocks[num][1] = merged[next][1];
+        rank[next] = UINT8_MAX;
+        num++;
+    }
+#else
+    (void)tcb;
+    (void)blocks;
+#endif
+    return num;
+}
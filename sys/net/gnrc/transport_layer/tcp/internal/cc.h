@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     net_gnrc_tcp
+ *
+ * @{
+ *
+ * @file
+ * @brief       Congestion control common to all algorithms.
+ */
+
+#ifndef CC_H
+#define CC_H
+
+#include <stdint.h>
+#include "net/gnrc/tcp/cc.h"
+#include "net/gnrc/tcp/tcb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Number of duplicate ACKs that trigger a fast retransmit.
+ */
+#define CC_DUP_ACK_THRESHOLD (3U)
+
+/**
+ * @brief Initializes congestion control of an established connection.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_init(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Resets congestion control of a connection that is not established.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_reset(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Gets the usable window: the smaller one of send and congestion window.
+ *
+ * @param[in] tcb   TCB holding the connection information.
+ *
+ * @returns   Maximum number of bytes in flight.
+ */
+uint32_t _cc_wnd(const gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Updates the congestion window after new data was acknowledged.
+ *
+ * @note Must be called after snd_una was advanced.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     acked   Number of newly acknowledged bytes.
+ */
+void _cc_ack(gnrc_tcp_tcb_t *tcb, const uint32_t acked);
+
+/**
+ * @brief Handles a duplicate ACK, retransmits fast after CC_DUP_ACK_THRESHOLD of them.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_dup_ack(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Handles a retransmission timeout.
+ *
+ * @note Must be called before the retransmission counter is increased.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _cc_timeout(gnrc_tcp_tcb_t *tcb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CC_H */
+/** @} */
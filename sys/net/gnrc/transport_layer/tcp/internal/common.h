@@ -47,6 +47,9 @@ extern "C" {
 #define STATUS_ALLOW_ANY_ADDR (1 << 1)
 #define STATUS_NOTIFY_USER    (1 << 2)
 #define STATUS_WAIT_FOR_MSG   (1 << 3)
+#define STATUS_WND_SCALE      (1 << 4)
+#define STATUS_SACK_PERM      (1 << 5)
+#define STATUS_FAST_RECOVERY  (1 << 6)
 /** @} */
 
 /**
@@ -42,6 +42,47 @@ static inline uint32_t _option_build_mss(uint16_t mss)
             ((uint32_t) TCP_OPTION_LENGTH_MSS << 16) | mss);
 }
 
+/**
+ * @brief Helper function to build the window scale option, preceded by a NOP.
+ *
+ * @param[in] shift   Shift count that should be set.
+ *
+ * @returns   Window scale option value.
+ */
+static inline uint32_t _option_build_ws(uint8_t shift)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_WS << 16) |
+            ((uint32_t) TCP_OPTION_LENGTH_WS << 8) | shift);
+}
+
+/**
+ * @brief Helper function to build the SACK permitted option, preceded by two NOPs.
+ *
+ * @returns   SACK permitted option value.
+ */
+static inline uint32_t _option_build_sack_perm(void)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK_PERM << 8) | TCP_OPTION_LENGTH_SACK_PERM);
+}
+
+/**
+ * @brief Helper function to build the header of a SACK option, preceded by two NOPs.
+ *
+ * @param[in] blocks   Number of blocks in the option.
+ *
+ * @returns   SACK option header value.
+ */
+static inline uint32_t _option_build_sack(uint8_t blocks)
+{
+    return (((uint32_t) TCP_OPTION_KIND_NOP << 24) |
+            ((uint32_t) TCP_OPTION_KIND_NOP << 16) |
+            ((uint32_t) TCP_OPTION_KIND_SACK << 8) |
+            (TCP_OPTION_LENGTH_MIN + blocks * TCP_OPTION_LENGTH_SACK_BLOCK));
+}
+
 /**
  * @brief Helper function to build the combined option and control flag field.
  *
@@ -67,6 +108,19 @@ static inline uint16_t _option_build_offset_control(uint16_t nopts, uint16_t ctl
  */
 int _option_parse(gnrc_tcp_tcb_t *tcb, tcp_hdr_t *hdr);
 
+/**
+ * @brief Extracts the blocks of the SACK option of a given TCP header.
+ *
+ * @pre @p hdr was successfully parsed with _option_parse().
+ *
+ * @param[in]  hdr      TCP header to be parsed.
+ * @param[out] blocks   Left and right edges of the blocks in host byte order.
+ *
+ * @returns   Number of blocks in @p blocks.
+ */
+unsigned _option_parse_sack(tcp_hdr_t *hdr,
+                            uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2]);
+
 #ifdef __cplusplus
 }
 #endif
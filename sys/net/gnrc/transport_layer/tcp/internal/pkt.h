@@ -119,7 +119,7 @@ uint32_t _pkt_get_pay_len(gnrc_pktsnip_t *pkt);
 int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool retransmit);
 
 /**
- * @brief Acknowledges and removes packet from the retransmission mechanism.
+ * @brief Acknowledges and removes packets from the retransmission mechanism.
  *
  * @param[in,out] tcb   TCB holding the connection information.
  * @param[in]     ack   Acknowldegment number used to acknowledge packets.
@@ -129,6 +129,34 @@ int _pkt_setup_retransmit(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, const bool r
  */
 int _pkt_acknowledge(gnrc_tcp_tcb_t *tcb, const uint32_t ack);
 
+/**
+ * @brief Marks packets in the retransmission mechanism as selectively acknowledged.
+ *
+ * @param[in,out] tcb     TCB holding the connection information.
+ * @param[in]     left    Left edge of a SACK block.
+ * @param[in]     right   Right edge of a SACK block.
+ */
+void _pkt_sack(gnrc_tcp_tcb_t *tcb, const uint32_t left, const uint32_t right);
+
+/**
+ * @brief Retransmits the oldest packet in the retransmission mechanism
+ *        without backing off the retransmission timer.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _pkt_fast_retransmit(gnrc_tcp_tcb_t *tcb);
+
+/**
+ * @brief Retransmits lost packets during recovery.
+ *
+ * @note Packets are considered lost, if they were in flight when recovery started,
+ *       were not retransmitted since and are either the oldest packet or
+ *       followed by a selectively acknowledged packet.
+ *
+ * @param[in,out] tcb   TCB holding the connection information.
+ */
+void _pkt_recover(gnrc_tcp_tcb_t *tcb);
+
 /**
  * @brief Calculates checksum over payload, TCP header and network layer header.
  *
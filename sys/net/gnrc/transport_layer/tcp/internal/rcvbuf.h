@@ -22,8 +22,10 @@
 
 #include <stdint.h>
 #include "mutex.h"
+#include "net/gnrc/pkt.h"
 #include "net/gnrc/tcp/config.h"
 #include "net/gnrc/tcp/tcb.h"
+#include "net/tcp.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -33,8 +35,8 @@ extern "C" {
  * @brief Receive buffer entry.
  */
 typedef struct rcvbuf_entry {
-    uint8_t used;                          /**< Flag: Is buffer in use? */
-    uint8_t buffer[GNRC_TCP_RCV_BUF_SIZE]; /**< Receive buffer storage */
+    uint8_t *buffer;   /**< Start of the buffer in the pool, NULL if unused */
+    size_t size;       /**< Size of the buffer */
 } rcvbuf_entry_t;
 
 /**
@@ -43,6 +45,7 @@ typedef struct rcvbuf_entry {
 typedef struct rcvbuf {
     mutex_t lock;                                 /**< Lock for allocation synchronization */
     rcvbuf_entry_t entries[GNRC_TCP_RCV_BUFFERS]; /**< Maintained receive buffers */
+    uint8_t pool[GNRC_TCP_RCV_BUF_POOL_SIZE];     /**< Storage of the receive buffers */
 } rcvbuf_t;
 
 /**
@@ -53,6 +56,9 @@ void _rcvbuf_init(void);
 /**
  * @brief Allocate receive buffer and assign it to TCB.
  *
+ * The buffer has a size of GNRC_TCP_RCV_BUF_SIZE or, if the pool has not
+ * enough space left, of the largest free space of at least one MSS.
+ *
  * @param[in,out] tcb   TCB that acquires receive buffer.
  *
  * @returns   Zero  on success.
@@ -61,12 +67,43 @@ void _rcvbuf_init(void);
 int _rcvbuf_get_buffer(gnrc_tcp_tcb_t *tcb);
 
 /**
- * @brief Release allocated receive buffer.
+ * @brief Release allocated receive buffer and segments received out of order.
  *
  * @param[in,out] tcb   TCB holding the receive buffer that should be released.
  */
 void _rcvbuf_release_buffer(gnrc_tcp_tcb_t *tcb);
 
+/**
+ * @brief Adds the payload of a segment to the receive buffer.
+ *
+ * Data received already is skipped. A segment beyond the next expected
+ * sequence number is kept until the missing data arrives, if it fits into
+ * the receive window and GNRC_TCP_RCV_OOO_SEGMENTS allows.
+ * Advances rcv_nxt and updates rcv_wnd accordingly.
+ *
+ * @param[in,out] tcb   TCB holding the receive buffer.
+ * @param[in]     pkt   Received packet.
+ * @param[in]     seq   Sequence number of the payload.
+ * @param[in]     len   Payload length.
+ *
+ * @returns   Number of bytes that became available to the user.
+ */
+uint32_t _rcvbuf_add(gnrc_tcp_tcb_t *tcb, gnrc_pktsnip_t *pkt, uint32_t seq, uint32_t len);
+
+/**
+ * @brief Gets the blocks of data received out of order for a SACK option.
+ *
+ * The block holding the most recently received segment comes first, the
+ * others follow in the order their segments were received, newest first.
+ *
+ * @param[in]  tcb      TCB holding the segments received out of order.
+ * @param[out] blocks   Left and right edges of the blocks.
+ *
+ * @returns   Number of blocks in @p blocks.
+ */
+unsigned _rcvbuf_sack_blocks(const gnrc_tcp_tcb_t *tcb,
+                             uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2]);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "bitarithm.h"
 #include "net/ipv6/addr.h"
 
 #ifdef MODULE_FMT
@@ -54,26 +55,21 @@ uint8_t ipv6_addr_match_prefix(const ipv6_addr_t *a, const ipv6_addr_t *b)
         return 128;
     }
 
-    for (int i = 0; i < 16; i++) {
-        /* if bytes are equal add 8 */
-        if (a->u8[i] == b->u8[i]) {
-            prefix_len += 8;
+    for (unsigned i = 0; i < 4; i++) {
+        /* skip equal 32-bit words as a whole */
+        if (a->u32[i].u32 == b->u32[i].u32) {
+            prefix_len += 32;
+            continue;
         }
-        else {
-            uint8_t xor = (a->u8[i] ^ b->u8[i]);
-
-            /* while bits from byte equal add 1 */
-            for (int j = 0; j < 8; j++) {
-                if ((xor & 0x80) == 0) {
-                    prefix_len++;
-                    xor = xor << 1;
-                }
-                else {
-                    break;
-                }
-            }
+        /* find the first differing byte of the word */
+        for (unsigned j = i * 4; ; j++) {
+            uint8_t xor = (a->u8[j] ^ b->u8[j]);
 
-            break;
+            if (xor != 0) {
+                /* add the equal bits before the highest differing bit */
+                return prefix_len + 7 - bitarithm_msb(xor);
+            }
+            prefix_len += 8;
         }
     }
 
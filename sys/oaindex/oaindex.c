@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ */
+
+#include <assert.h>
+
+#include "oaindex.h"
+
+static inline unsigned _home(const oaindex_t *idx, unsigned slot)
+{
+    return oaindex_first(idx, idx->hash(oaindex_entry(idx, slot)));
+}
+
+/* Gets the slot of entry or the free slot ending its probe sequence */
+static unsigned _find(const oaindex_t *idx, unsigned entry)
+{
+    unsigned slot = oaindex_first(idx, idx->hash(entry));
+
+    while (!oaindex_free(idx, slot) && (oaindex_entry(idx, slot) != entry)) {
+        slot = oaindex_next(idx, slot);
+    }
+    return slot;
+}
+
+void oaindex_add(const oaindex_t *idx, unsigned entry)
+{
+    assert(entry < UINT16_MAX);
+    unsigned slot = _find(idx, entry);
+
+    idx->slots[slot] = entry + 1;
+}
+
+void oaindex_del(const oaindex_t *idx, unsigned entry)
+{
+    unsigned slot = _find(idx, entry);
+
+    if (oaindex_free(idx, slot)) {
+        return;
+    }
+    /* move back entries that would not be found anymore with the free slot
+     * in their probe sequence (no tombstones needed that way) */
+    for (unsigned next = oaindex_next(idx, slot);
+         !oaindex_free(idx, next);
+         next = oaindex_next(idx, next)) {
+        unsigned home = _home(idx, next);
+
+        if ((slot < next) ? ((home <= slot) || (home > next))
+                          : ((home <= slot) && (home > next))) {
+            idx->slots[slot] = idx->slots[next];
+            slot = next;
+        }
+    }
+    idx->slots[slot] = OAINDEX_FREE;
+}
+
+/** @} */
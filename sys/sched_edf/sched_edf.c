@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_sched_edf
+ * @{
+ *
+ * @file
+ * @brief       Earliest deadline first scheduling implementation
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <errno.h>
+#include <string.h>
+
+#include "irq.h"
+#include "sched.h"
+#include "sched_edf.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define ENABLE_DEBUG    (0)
+#include "debug.h"
+
+/* fixed point representation of a utilization of 100% */
+#define DENSITY_ONE     (1UL << 16)
+
+static sched_edf_t *_edf[KERNEL_PID_LAST + 1];
+/* sum of budget / deadline of all EDF threads */
+static uint32_t _density;
+
+static uint32_t _density_of(const sched_edf_params_t *params)
+{
+    return ((uint64_t)params->budget * DENSITY_ONE) / params->deadline;
+}
+
+/* starts budget accounting if the thread is the active one */
+static void _account_start(sched_edf_t *edf, uint32_t now)
+{
+    if (edf->remaining && (edf->pid == sched_active_pid)) {
+        edf->started = now;
+        ztimer_set(ZTIMER_USEC, &edf->budget_timer, edf->remaining);
+    }
+}
+
+static void _account_stop(sched_edf_t *edf, uint32_t now)
+{
+    if (edf->remaining) {
+        uint32_t elapsed = now - edf->started;
+        edf->remaining = (elapsed < edf->remaining) ? edf->remaining - elapsed
+                                                    : 0;
+        ztimer_remove(ZTIMER_USEC, &edf->budget_timer);
+    }
+}
+
+/* must be called with interrupts disabled */
+static void _start_job(sched_edf_t *edf, thread_t *thread, uint32_t now)
+{
+    if (edf->active) {
+        /* the previous job is still running, it continues as the new one */
+        if (!edf->missed) {
+            edf->misses++;
+        }
+        edf->backlog = 1;
+        ztimer_remove(ZTIMER_USEC, &edf->budget_timer);
+    }
+    edf->jobs++;
+    edf->active = 1;
+    edf->missed = 0;
+    edf->remaining = edf->params.budget;
+    thread->deadline = edf->release + edf->params.deadline;
+    /* sched_run() only compares thread->deadline, the timer is armed here */
+    int32_t left = thread->deadline - now;
+    ztimer_set(ZTIMER_USEC, &edf->deadline_timer, (left > 0) ? left : 0);
+    _account_start(edf, now);
+    if (thread->status == STATUS_SLEEPING) {
+        sched_set_status(thread, STATUS_PENDING);
+    }
+}
+
+static void _release(void *arg)
+{
+    sched_edf_t *edf = arg;
+    thread_t *thread = (thread_t *)sched_threads[edf->pid];
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+
+    if (thread == NULL) {
+        DEBUG("sched_edf: thread %" PRIkernel_pid " exited\n", edf->pid);
+        ztimer_remove(ZTIMER_USEC, &edf->deadline_timer);
+        ztimer_remove(ZTIMER_USEC, &edf->budget_timer);
+        _density -= _density_of(&edf->params);
+        _edf[edf->pid] = NULL;
+        return;
+    }
+
+    /* skip releases lost while interrupts were disabled for too long */
+    do {
+        edf->release += edf->params.period;
+    } while ((int32_t)(now - edf->release) >= (int32_t)edf->params.period);
+    ztimer_set(ZTIMER_USEC, &edf->release_timer,
+               edf->release + edf->params.period - now);
+
+    _start_job(edf, thread, now);
+    sched_change_priority(thread, SCHED_EDF_PRIORITY);
+    /* the new deadline might be earlier than the one of the active thread */
+    sched_context_switch_request = 1;
+}
+
+static void _deadline(void *arg)
+{
+    sched_edf_t *edf = arg;
+
+    if (edf->active && !edf->missed) {
+        DEBUG("sched_edf: thread %" PRIkernel_pid " missed its deadline\n",
+              edf->pid);
+        edf->missed = 1;
+        edf->misses++;
+    }
+}
+
+static void _throttle(void *arg)
+{
+    sched_edf_t *edf = arg;
+    thread_t *thread = (thread_t *)sched_threads[edf->pid];
+
+    DEBUG("sched_edf: thread %" PRIkernel_pid " exceeded its budget\n",
+          edf->pid);
+    edf->remaining = 0;
+    edf->throttled++;
+    if (thread) {
+        sched_change_priority(thread, edf->priority);
+    }
+}
+
+int sched_edf_add(sched_edf_t *edf, kernel_pid_t pid,
+                  const sched_edf_params_t *params)
+{
+    if (!pid_is_valid(pid) || (params->budget == 0) ||
+        (params->budget > params->deadline) ||
+        (params->deadline > params->period)) {
+        return -EINVAL;
+    }
+
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[pid];
+    uint32_t density = _density_of(params);
+
+    if (thread == NULL) {
+        irq_restore(state);
+        return -EINVAL;
+    }
+    if (_edf[pid] != NULL) {
+        irq_restore(state);
+        return -EBUSY;
+    }
+    if (_density + density > DENSITY_ONE) {
+        irq_restore(state);
+        return -ENOSPC;
+    }
+
+    memset(edf, 0, sizeof(*edf));
+    edf->params = *params;
+    edf->pid = pid;
+    edf->priority = thread->priority;
+    edf->release_timer.callback = _release;
+    edf->release_timer.arg = edf;
+    edf->deadline_timer.callback = _deadline;
+    edf->deadline_timer.arg = edf;
+    edf->budget_timer.callback = _throttle;
+    edf->budget_timer.arg = edf;
+    _edf[pid] = edf;
+    _density += density;
+
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+    edf->release = now;
+    ztimer_set(ZTIMER_USEC, &edf->release_timer, params->period);
+    _start_job(edf, thread, now);
+    irq_restore(state);
+
+    sched_change_priority(thread, SCHED_EDF_PRIORITY);
+    thread_yield_higher();
+    return 0;
+}
+
+void sched_edf_remove(sched_edf_t *edf)
+{
+    unsigned state = irq_disable();
+    thread_t *thread = (thread_t *)sched_threads[edf->pid];
+
+    assert(_edf[edf->pid] == edf);
+    ztimer_remove(ZTIMER_USEC, &edf->release_timer);
+    ztimer_remove(ZTIMER_USEC, &edf->deadline_timer);
+    ztimer_remove(ZTIMER_USEC, &edf->budget_timer);
+    _edf[edf->pid] = NULL;
+    _density -= _density_of(&edf->params);
+    if (thread && !edf->active && (thread->status == STATUS_SLEEPING)) {
+        sched_set_status(thread, STATUS_PENDING);
+    }
+    irq_restore(state);
+
+    if (thread) {
+        sched_change_priority(thread, edf->priority);
+        sched_switch(thread->priority);
+    }
+}
+
+void sched_edf_wait_next_period(void)
+{
+    unsigned state = irq_disable();
+    sched_edf_t *edf = _edf[sched_active_pid];
+    uint32_t now = ztimer_now(ZTIMER_USEC);
+
+    assert(edf);
+    if (edf->backlog) {
+        /* the next job is due already */
+        edf->backlog = 0;
+        irq_restore(state);
+        return;
+    }
+    if (!edf->missed && ((now - edf->release) > edf->params.deadline)) {
+        edf->missed = 1;
+        edf->misses++;
+    }
+    ztimer_remove(ZTIMER_USEC, &edf->deadline_timer);
+    _account_stop(edf, now);
+    edf->remaining = 0;
+    edf->active = 0;
+
+    sched_set_status((thread_t *)sched_active_thread, STATUS_SLEEPING);
+    irq_restore(state);
+    thread_yield_higher();
+}
+
+int sched_edf_stats(kernel_pid_t pid, sched_edf_stats_t *stats)
+{
+    unsigned state = irq_disable();
+    sched_edf_t *edf = pid_is_valid(pid) ? _edf[pid] : NULL;
+
+    if (edf) {
+        stats->jobs = edf->jobs;
+        stats->misses = edf->misses;
+        stats->throttled = edf->throttled;
+    }
+    irq_restore(state);
+    return edf ? 0 : -1;
+}
+
+void sched_edf_switch(kernel_pid_t active, kernel_pid_t next)
+{
+    sched_edf_t *prev_edf = _edf[active];
+    sched_edf_t *next_edf = _edf[next];
+    uint32_t now;
+
+    if (((prev_edf == NULL) || !prev_edf->remaining) &&
+        ((next_edf == NULL) || !next_edf->remaining)) {
+        return;
+    }
+    now = ztimer_now(ZTIMER_USEC);
+    if (prev_edf) {
+        _account_stop(prev_edf, now);
+    }
+    if (next_edf && next_edf->remaining) {
+        next_edf->started = now;
+        ztimer_set(ZTIMER_USEC, &next_edf->budget_timer, next_edf->remaining);
+    }
+}
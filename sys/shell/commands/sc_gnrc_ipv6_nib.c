@@ -13,6 +13,7 @@
  * @author  Martine Lenders <m.lenders@fu-berlin.de>
  */
 
+#include <inttypes.h>
 #include <stdio.h>
 
 #include "net/gnrc/ipv6/nib.h"
@@ -26,6 +27,9 @@ static int _nib_route(int argc, char **argv);
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
 static int _nib_abr(int argc, char **argv);
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+static int _nib_flow(int argc, char **argv);
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
 
 int _gnrc_ipv6_nib(int argc, char **argv)
 {
@@ -49,6 +53,11 @@ int _gnrc_ipv6_nib(int argc, char **argv)
         res = _nib_abr(argc, argv);
     }
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+    else if (strcmp(argv[1], "flow") == 0) {
+        res = _nib_flow(argc, argv);
+    }
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
     else {
         _usage(argv);
     }
@@ -57,11 +66,14 @@ int _gnrc_ipv6_nib(int argc, char **argv)
 
 static void _usage(char **argv)
 {
+    printf("usage: %s {neigh|prefix|route|"
 #if GNRC_IPV6_NIB_CONF_MULTIHOP_P6C
-    printf("usage: %s {neigh|prefix|route|abr|help} ...\n", argv[0]);
-#else   /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
-    printf("usage: %s {neigh|prefix|route|help} ...\n", argv[0]);
+           "abr|"
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+           "flow|"
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+           "help} ...\n", argv[0]);
 }
 
 static void _usage_nib_neigh(char **argv)
@@ -364,4 +376,21 @@ static int _nib_abr(int argc, char **argv)
 }
 #endif  /* GNRC_IPV6_NIB_CONF_MULTIHOP_P6C */
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+static int _nib_flow(int argc, char **argv)
+{
+    if ((argc == 2) || (strcmp(argv[2], "show") == 0)) {
+        gnrc_ipv6_nib_flow_stats_t stats;
+
+        gnrc_ipv6_nib_flow_stats(&stats);
+        printf("flow cache hits: %" PRIu32 " misses: %" PRIu32 "\n",
+               stats.hits, stats.misses);
+    }
+    else {
+        printf("usage: %s %s [show|help]\n", argv[0], argv[1]);
+    }
+    return 0;
+}
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+
 /** @} */
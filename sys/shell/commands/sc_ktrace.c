@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     sys_shell_commands
+ * @{
+ *
+ * @file
+ * @brief       Shell command controlling kernel event tracing
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "ktrace.h"
+
+static void _write_stdout(void *arg, const void *data, size_t len)
+{
+    (void)arg;
+    printf("%.*s", (int)len, (const char *)data);
+}
+
+static int _usage(const char *cmd)
+{
+#ifdef CPU_NATIVE
+    printf("usage: %s <on|off|clear|json [<file>]|ctf <dir>>\n", cmd);
+#else
+    printf("usage: %s <on|off|clear|json>\n", cmd);
+#endif
+    return 1;
+}
+
+int _ktrace_handler(int argc, char **argv)
+{
+    if (argc < 2) {
+        return _usage(argv[0]);
+    }
+    if (strcmp(argv[1], "on") == 0) {
+        ktrace_enable(true);
+    }
+    else if (strcmp(argv[1], "off") == 0) {
+        ktrace_enable(false);
+    }
+    else if (strcmp(argv[1], "clear") == 0) {
+        ktrace_clear();
+    }
+    else if ((strcmp(argv[1], "json") == 0) && (argc == 2)) {
+        ktrace_export_chrome(_write_stdout, NULL);
+    }
+#ifdef CPU_NATIVE
+    else if ((strcmp(argv[1], "json") == 0) || (strcmp(argv[1], "ctf") == 0)) {
+        if (argc != 3) {
+            return _usage(argv[0]);
+        }
+        int res = ktrace_export_file(argv[2], strcmp(argv[1], "ctf") == 0);
+        if (res < 0) {
+            printf("error: unable to write %s (%d)\n", argv[2], res);
+            return 1;
+        }
+    }
+#endif
+    else {
+        return _usage(argv[0]);
+    }
+    return 0;
+}
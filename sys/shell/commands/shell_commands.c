@@ -34,6 +34,10 @@ extern int _id_handler(int argc, char **argv);
 extern int _heap_handler(int argc, char **argv);
 #endif
 
+#ifdef MODULE_KTRACE
+extern int _ktrace_handler(int argc, char **argv);
+#endif
+
 #ifdef MODULE_PS
 extern int _ps_handler(int argc, char **argv);
 #endif
@@ -176,6 +180,9 @@ const shell_command_t _shell_command_list[] = {
 #ifdef MODULE_HEAP_CMD
     {"heap", "Prints heap statistics.", _heap_handler},
 #endif
+#ifdef MODULE_KTRACE
+    {"ktrace", "Controls and exports kernel event tracing.", _ktrace_handler},
+#endif
 #ifdef MODULE_PS
     {"ps", "Prints information about running threads.", _ps_handler},
 #endif
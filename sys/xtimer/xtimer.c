@@ -224,9 +224,16 @@ static void _mutex_remove_thread_from_waiting_queue(mutex_t *mutex, thread_t *th
                 mutex->queue.next = MUTEX_LOCKED;
             }
             *unlocked = 1;
+#ifdef MODULE_CORE_MUTEX_PI
+            thread->mutex_waiting = NULL;
+#endif
 
             sched_set_status(thread, STATUS_PENDING);
             irq_restore(irqstate);
+#ifdef MODULE_CORE_MUTEX_PI
+            /* the owner might have inherited the priority of thread */
+            mutex_pi_restore(mutex);
+#endif
             sched_switch(thread->priority);
             return;
         }
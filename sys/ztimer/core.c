@@ -32,6 +32,9 @@
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
+#if !MODULE_ZTIMER_WHEEL
+/* with ztimer_wheel, timers are stored in a timer wheel (see wheel.c) */
+
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry);
 static void _del_entry_from_list(ztimer_clock_t *clock, ztimer_base_t *entry);
 static void _ztimer_update(ztimer_clock_t *clock);
@@ -52,6 +55,37 @@ static unsigned _is_set(const ztimer_clock_t *clock, const ztimer_t *t)
     }
 }
 
+#if MODULE_ZTIMER_SLACK
+/* Remembers when the lower clock fires if set to val ticks after base */
+static inline uint32_t _arm(ztimer_clock_t *clock, uint32_t base, uint32_t val)
+{
+    clock->armed = base + val;
+    return val;
+}
+
+/* Checks if the armed wakeup still fires all timers within their windows
+ * after adding timer, due val ticks after clock->list.offset */
+static unsigned _armed_fits(const ztimer_clock_t *clock, const ztimer_t *timer,
+                            uint32_t val)
+{
+    int32_t armed = (int32_t)(clock->armed - clock->list.offset);
+    uint32_t end = val + timer->slack;
+
+    if ((armed <= 0) || (val > (uint32_t)armed)) {
+        /* the armed wakeup must not fire the timer before it is due */
+        return clock->list.next != &timer->base;
+    }
+    return (end >= (uint32_t)armed) || (end < val);
+}
+#else
+static inline uint32_t _arm(ztimer_clock_t *clock, uint32_t base, uint32_t val)
+{
+    (void)clock;
+    (void)base;
+    return val;
+}
+#endif
+
 void ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
 {
     unsigned state = irq_disable();
@@ -66,7 +100,8 @@ void ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
     irq_restore(state);
 }
 
-void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+static void _ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                        uint32_t slack)
 {
     DEBUG("ztimer_set(): %p: set %p at %"PRIu32" offset %"PRIu32"\n",
             (void *)clock, (void *)timer, clock->ops->now(clock), val);
@@ -74,6 +109,11 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     unsigned state = irq_disable();
 
     ztimer_update_head_offset(clock);
+#if MODULE_ZTIMER_SLACK
+    /* nothing is armed without timers, and the armed wakeup may be too early
+     * for the next timer if this one was the first */
+    unsigned rearm = !clock->list.next || (clock->list.next == &timer->base);
+#endif
     if (_is_set(clock, timer)) {
         _del_entry_from_list(clock, &timer->base);
     }
@@ -86,6 +126,16 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
     }
 
     timer->base.offset = val;
+#if MODULE_ZTIMER_SLACK
+    timer->slack = slack;
+    _add_entry_to_list(clock, &timer->base);
+    /* reprogram only if the armed wakeup misses the window of the new timer,
+     * which may be the case even if it isn't the first one due */
+    if (rearm || !_armed_fits(clock, timer, val)) {
+        _ztimer_update(clock);
+    }
+#else
+    (void)slack;
     _add_entry_to_list(clock, &timer->base);
     if (clock->list.next == &timer->base) {
 #ifdef MODULE_ZTIMER_EXTEND
@@ -96,10 +146,24 @@ void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
 #endif
         clock->ops->set(clock, val);
     }
+#endif
 
     irq_restore(state);
 }
 
+void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+{
+    _ztimer_set(clock, timer, val, 0);
+}
+
+#if MODULE_ZTIMER_SLACK
+void ztimer_set_slack(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                      uint32_t slack)
+{
+    _ztimer_set(clock, timer, val, slack);
+}
+#endif
+
 static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
 {
     uint32_t delta_sum = 0;
@@ -129,6 +193,7 @@ static void _add_entry_to_list(ztimer_clock_t *clock, ztimer_base_t *entry)
     DEBUG("_add_entry_to_list() %p offset %"PRIu32"\n", (void *)entry, entry->offset);
 
 }
+#endif /* !MODULE_ZTIMER_WHEEL */
 
 static uint32_t _add_modulo(uint32_t a, uint32_t b, uint32_t mod)
 {
@@ -156,6 +221,7 @@ ztimer_now_t _ztimer_now_extend(ztimer_clock_t *clock)
 }
 #endif /* MODULE_ZTIMER_EXTEND */
 
+#if !MODULE_ZTIMER_WHEEL
 void ztimer_update_head_offset(ztimer_clock_t *clock)
 {
     uint32_t old_base = clock->list.offset;
@@ -241,12 +307,48 @@ static ztimer_t *_now_next(ztimer_clock_t *clock)
     }
 }
 
+#if MODULE_ZTIMER_SLACK
+/* Returns the latest wakeup (relative to clock->list.offset) that fires the
+ * next timer within its window. Timers due before that wakeup may shorten it
+ * further, all of them are fired on the same interrupt. */
+static uint32_t _next_wakeup(const ztimer_clock_t *clock)
+{
+    const ztimer_base_t *entry = clock->list.next;
+    uint32_t target = 0;
+    uint32_t wakeup = UINT32_MAX;
+
+    while (entry) {
+        target += entry->offset;
+        if (target >= wakeup) {
+            break;
+        }
+        uint32_t end = target + ((const ztimer_t *)entry)->slack;
+        if (end < target) {
+            end = UINT32_MAX;
+        }
+        if (end < wakeup) {
+            wakeup = end;
+        }
+        entry = entry->next;
+    }
+
+    return wakeup;
+}
+#else
+static inline uint32_t _next_wakeup(const ztimer_clock_t *clock)
+{
+    return clock->list.next->offset;
+}
+#endif
+
 static void _ztimer_update(ztimer_clock_t *clock)
 {
 #ifdef MODULE_ZTIMER_EXTEND
     if (clock->max_value < UINT32_MAX) {
         if (clock->list.next) {
-            clock->ops->set(clock, _min_u32(clock->list.next->offset, clock->max_value >> 1));
+            uint32_t val = _min_u32(_next_wakeup(clock), clock->max_value >> 1);
+
+            clock->ops->set(clock, _arm(clock, clock->list.offset, val));
         }
         else {
             clock->ops->set(clock, clock->max_value >> 1);
@@ -257,7 +359,7 @@ static void _ztimer_update(ztimer_clock_t *clock)
     }
     else {
         if (clock->list.next) {
-            clock->ops->set(clock, clock->list.next->offset);
+            clock->ops->set(clock, _arm(clock, clock->list.offset, _next_wakeup(clock)));
         }
         else {
             clock->ops->cancel(clock);
@@ -267,6 +369,7 @@ static void _ztimer_update(ztimer_clock_t *clock)
 
 void ztimer_handler(ztimer_clock_t *clock)
 {
+    clock->wakeups++;
     DEBUG("ztimer_handler(): %p now=%"PRIu32"\n", (void *)clock, clock->ops->now(clock));
     if (ENABLE_DEBUG) {
         _ztimer_print(clock);
@@ -282,7 +385,7 @@ void ztimer_handler(ztimer_clock_t *clock)
             int32_t diff = (int32_t)(target - now);
             if (diff > 0) {
                 DEBUG("ztimer_handler(): %p postponing by %"PRIi32"\n", (void *)clock, diff);
-                clock->ops->set(clock, _min_u32(diff, clock->max_value >> 1));
+                clock->ops->set(clock, _arm(clock, now, _min_u32(diff, clock->max_value >> 1)));
                 return;
             }
             else {
@@ -340,3 +443,4 @@ static void _ztimer_print(const ztimer_clock_t *clock)
     } while ((entry = entry->next));
     puts("");
 }
+#endif /* !MODULE_ZTIMER_WHEEL */
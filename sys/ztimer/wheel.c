@@ -0,0 +1,360 @@
+/*
+ * Copyright (C) 2020 Kaspar Schleiser <kaspar@schleiser.de>
+ *               2020 Freie Universität Berlin
+ *               2020 Inria
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser General
+ * Public License v2.1. See the file LICENSE in the top level directory for more
+ * details.
+ */
+
+/**
+ * @ingroup     sys_ztimer
+ * @{
+ *
+ * @file
+ * @brief       ztimer core timer wheel implementation
+ *
+ * This file replaces the sorted list based timer storage of core.c with a
+ * hierarchical timer wheel, giving O(1) ztimer_set() and ztimer_remove().
+ *
+ * Every clock keeps its current time in `clock->list.offset` ("cur"), which
+ * never runs ahead of ztimer_now() nor past any set timer. A timer with the
+ * absolute target T is stored on level L = (highest digit in which T differs
+ * from cur), in the slot given by digit L of T (a digit being
+ * ZTIMER_WHEEL_BITS wide). When cur reaches the start of an occupied slot on
+ * a level > 0, its timers are re-inserted ("cascaded") and thereby move to a
+ * lower level. Timers in the level 0 slot of cur are due.
+ *
+ * @}
+ */
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bitarithm.h"
+#include "kernel_defines.h"
+#include "irq.h"
+#include "ztimer.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define WHEEL_MASK      (ZTIMER_WHEEL_SLOTS - 1)
+
+#if MODULE_ZTIMER_EXTEND || MODULE_ZTIMER_SLACK
+static inline uint32_t _min_u32(uint32_t a, uint32_t b) {
+    return a < b ? a : b;
+}
+#endif
+
+static unsigned _msb32(uint32_t v)
+{
+    /* bitarithm_msb() takes an unsigned, which might only be 16bit wide */
+    return (v >> 16) ? (bitarithm_msb(v >> 16) + 16) : bitarithm_msb(v);
+}
+
+static unsigned _is_set(const ztimer_t *t)
+{
+    return (t->base.pprev != NULL);
+}
+
+static ztimer_base_t **_slot(ztimer_clock_t *clock, uint32_t target,
+                             unsigned *level, unsigned *idx)
+{
+    uint32_t diff = target ^ clock->list.offset;
+
+    *level = diff ? (_msb32(diff) / ZTIMER_WHEEL_BITS) : 0;
+    *idx = (target >> (*level * ZTIMER_WHEEL_BITS)) & WHEEL_MASK;
+
+    return &clock->wheel[*level][*idx];
+}
+
+static void _wheel_insert(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    unsigned level, idx;
+    ztimer_base_t **head = _slot(clock, entry->offset, &level, &idx);
+
+    entry->next = *head;
+    if (entry->next) {
+        entry->next->pprev = &entry->next;
+    }
+    entry->pprev = head;
+    *head = entry;
+    clock->wheel_map[level] |= (1U << idx);
+
+    DEBUG("_wheel_insert() %p target %"PRIu32" level %u slot %u\n",
+          (void *)entry, entry->offset, level, idx);
+}
+
+static void _wheel_unlink(ztimer_clock_t *clock, ztimer_base_t *entry)
+{
+    assert(entry->pprev);
+
+    *entry->pprev = entry->next;
+    if (entry->next) {
+        entry->next->pprev = entry->pprev;
+    }
+    else {
+        /* entry might have been the last one in its slot */
+        unsigned level, idx;
+        if (*_slot(clock, entry->offset, &level, &idx) == NULL) {
+            clock->wheel_map[level] &= ~(1U << idx);
+        }
+    }
+
+    /* reset the entry's link pointers so _is_set() considers it unset */
+    entry->next = NULL;
+    entry->pprev = NULL;
+}
+
+/**
+ * @brief   Find the next event (due timer or cascade) of the wheel
+ *
+ * @param[in]   clock   clock to operate on
+ * @param[out]  delta   ticks from the clock's current time to the event
+ * @param[out]  level   wheel level of the event
+ *
+ * @return  true if there is an event, false if no timer is set
+ */
+static bool _wheel_next(const ztimer_clock_t *clock, uint32_t *delta,
+                        unsigned *level)
+{
+    uint32_t cur = clock->list.offset;
+
+    /* all timers on level l expire before any timer on level l+1 */
+    for (unsigned l = 0; l < ZTIMER_WHEEL_LEVELS; l++) {
+        uint32_t map = clock->wheel_map[l];
+        if (!map) {
+            continue;
+        }
+
+        unsigned shift = l * ZTIMER_WHEEL_BITS;
+        unsigned digit = (cur >> shift) & WHEEL_MASK;
+
+        /* rotate the map so that the current slot becomes bit 0 */
+        map = ((map >> digit) | (map << (ZTIMER_WHEEL_SLOTS - digit)))
+              & ((1UL << ZTIMER_WHEEL_SLOTS) - 1);
+
+        *delta = ((uint32_t)bitarithm_lsb(map) << shift)
+                 - (cur & ((UINT32_C(1) << shift) - 1));
+        *level = l;
+        return true;
+    }
+
+    return false;
+}
+
+static void _wheel_cascade(ztimer_clock_t *clock, unsigned level)
+{
+    unsigned idx = (clock->list.offset >> (level * ZTIMER_WHEEL_BITS))
+                   & WHEEL_MASK;
+    ztimer_base_t *entry = clock->wheel[level][idx];
+
+    DEBUG("_wheel_cascade() level %u slot %u\n", level, idx);
+
+    clock->wheel[level][idx] = NULL;
+    clock->wheel_map[level] &= ~(1U << idx);
+
+    while (entry) {
+        ztimer_base_t *next = entry->next;
+        _wheel_insert(clock, entry);
+        entry = next;
+    }
+}
+
+/**
+ * @brief   Advance the clock's current time towards @p now
+ *
+ * Cascades all slots passed on the way. Stops early at the first due timer,
+ * which is left for ztimer_handler() to trigger.
+ */
+static void _wheel_advance(ztimer_clock_t *clock, uint32_t now)
+{
+    uint32_t elapsed = now - clock->list.offset;
+    uint32_t delta;
+    unsigned level;
+
+    while (_wheel_next(clock, &delta, &level) && (delta <= elapsed)) {
+        clock->list.offset += delta;
+        elapsed -= delta;
+        if (level == 0) {
+            return;
+        }
+        _wheel_cascade(clock, level);
+    }
+
+    clock->list.offset += elapsed;
+}
+
+static ztimer_t *_now_next(ztimer_clock_t *clock)
+{
+    unsigned idx = clock->list.offset & WHEEL_MASK;
+    ztimer_base_t *entry = clock->wheel[0][idx];
+
+    if (entry) {
+        _wheel_unlink(clock, entry);
+    }
+
+    return (ztimer_t *)entry;
+}
+
+static void _ztimer_update(ztimer_clock_t *clock)
+{
+    uint32_t delta;
+    unsigned level;
+    bool pending = _wheel_next(clock, &delta, &level);
+
+#ifdef MODULE_ZTIMER_EXTEND
+    if (clock->max_value < UINT32_MAX) {
+        clock->ops->set(clock, pending ? _min_u32(delta, clock->max_value >> 1)
+                                       : clock->max_value >> 1);
+    }
+    else
+#endif
+    if (pending) {
+        clock->ops->set(clock, delta);
+    }
+    else {
+        clock->ops->cancel(clock);
+    }
+}
+
+void ztimer_update_head_offset(ztimer_clock_t *clock)
+{
+    _wheel_advance(clock, ztimer_now(clock));
+}
+
+void ztimer_remove(ztimer_clock_t *clock, ztimer_t *timer)
+{
+    unsigned state = irq_disable();
+
+    if (_is_set(timer)) {
+        _wheel_unlink(clock, &timer->base);
+
+        ztimer_update_head_offset(clock);
+        _ztimer_update(clock);
+    }
+
+    irq_restore(state);
+}
+
+#if MODULE_ZTIMER_SLACK
+/* Returns the value in [target, target + slack] that is a multiple of the
+ * highest power of two. Timers whose windows overlap are moved to the same
+ * target that way, without the wheel having to know about windows. */
+static uint32_t _align(uint32_t target, uint32_t slack)
+{
+    uint32_t end = target + slack;
+
+    if (slack == 0) {
+        return target;
+    }
+    if (end < target) {
+        /* the window contains the wrap around */
+        return 0;
+    }
+
+    /* below the highest bit differing between target and end, clearing the
+     * bits of end gives the most aligned value not before target */
+    unsigned bit = _msb32(target ^ end);
+    uint32_t low = (1UL << bit) - 1;
+    uint32_t aligned = end & ~low;
+
+    if ((target & ((low << 1) | 1)) == 0) {
+        /* target itself is aligned to the next power of two */
+        aligned = target;
+    }
+    return aligned;
+}
+#endif
+
+static void _ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                        uint32_t slack)
+{
+    DEBUG("ztimer_set(): %p: set %p at %"PRIu32" offset %"PRIu32"\n",
+            (void *)clock, (void *)timer, clock->ops->now(clock), val);
+
+    unsigned state = irq_disable();
+
+    uint32_t now = ztimer_now(clock);
+    _wheel_advance(clock, now);
+    if (_is_set(timer)) {
+        _wheel_unlink(clock, &timer->base);
+    }
+
+    /* optionally subtract a configurable adjustment value */
+    if (val > clock->adjust) {
+        val -= clock->adjust;
+    } else {
+        val = 0;
+    }
+
+    /* the wheel's current time might lag behind now if a timer is due but
+     * not yet handled, make sure the target stays within 32bit from it */
+    uint32_t lag = now - clock->list.offset;
+    if (val > UINT32_MAX - lag) {
+        val = UINT32_MAX - lag;
+    }
+#if MODULE_ZTIMER_SLACK
+    slack = _min_u32(slack, UINT32_MAX - lag - val);
+    val = _align(now + val, slack) - now;
+#else
+    (void)slack;
+#endif
+
+    uint32_t delta;
+    unsigned level;
+    bool earliest = !_wheel_next(clock, &delta, &level) || (lag + val < delta);
+
+    timer->base.offset = now + val;
+    _wheel_insert(clock, &timer->base);
+    if (earliest) {
+        _ztimer_update(clock);
+    }
+
+    irq_restore(state);
+}
+
+void ztimer_set(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val)
+{
+    _ztimer_set(clock, timer, val, 0);
+}
+
+#if MODULE_ZTIMER_SLACK
+void ztimer_set_slack(ztimer_clock_t *clock, ztimer_t *timer, uint32_t val,
+                      uint32_t slack)
+{
+    _ztimer_set(clock, timer, val, slack);
+}
+#endif
+
+void ztimer_handler(ztimer_clock_t *clock)
+{
+    clock->wakeups++;
+    DEBUG("ztimer_handler(): %p now=%"PRIu32"\n", (void *)clock, clock->ops->now(clock));
+
+    /* calling now triggers checkpointing, intermediate wakeups of extended
+     * clocks are handled implicitly as no timer will be due for them */
+    ztimer_update_head_offset(clock);
+
+    ztimer_t *entry = _now_next(clock);
+    while (entry) {
+        DEBUG("ztimer_handler(): trigger %p at %"PRIu32"\n",
+                (void *)entry, clock->ops->now(clock));
+        entry->callback(entry->arg);
+        entry = _now_next(clock);
+        if (!entry) {
+            /* See if any more alarms expired during callback processing */
+            ztimer_update_head_offset(clock);
+            entry = _now_next(clock);
+        }
+    }
+
+    _ztimer_update(clock);
+
+    DEBUG("ztimer_handler(): %p done.\n", (void *)clock);
+    if (!irq_is_in()) {
+        thread_yield_higher();
+    }
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the Observe notifications of gcoap by number of
+ *              observers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_OBSERVERS_MAX
+#define TEST_OBSERVERS_MAX  (1000U)
+#endif
+
+/* notifications to all observers per number of observers */
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (10U)
+#endif
+
+/* port of the application's observer, the others follow */
+#define OBSERVER_PORT       (7000U)
+/* registrations sent before gcoap gets time to handle them */
+#define REGISTER_BATCH      (4U)
+
+static const unsigned _counts[] = { 1, 10, 100, 1000 };
+static const char _value[] = "21.5";
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/sensor", COAP_GET, _sensor_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static gcoap_obs_entry_t _obs_pool[TEST_OBSERVERS_MAX];
+static uint8_t _buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+static sock_udp_t _sock;
+static sock_udp_ep_t _server = {
+    .family = AF_INET6,
+    .port = CONFIG_GCOAP_PORT,
+};
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx)
+{
+    (void)ctx;
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_format(pdu, COAP_FORMAT_TEXT);
+    size_t resp_len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    if (pdu->payload_len < sizeof(_value) - 1) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    memcpy(pdu->payload, _value, sizeof(_value) - 1);
+    return resp_len + sizeof(_value) - 1;
+}
+
+/* the token is the observer's number */
+static int _register(sock_udp_t *sock, uint32_t token)
+{
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    len = coap_build_hdr((coap_hdr_t *)_buf, COAP_TYPE_NON, (uint8_t *)&token,
+                         sizeof(token), COAP_METHOD_GET, (uint16_t)token);
+    coap_pkt_init(&pdu, _buf, sizeof(_buf), len);
+    coap_opt_add_uint(&pdu, COAP_OPT_OBSERVE, COAP_OBS_REGISTER);
+    coap_opt_add_string(&pdu, COAP_OPT_URI_PATH, _resources[0].path, '/');
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+
+    return sock_udp_send(sock, _buf, len, &_server);
+}
+
+/* every other observer uses a socket of its own port only to register */
+static unsigned _add_observers(unsigned from, unsigned to)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+    unsigned errors = 0;
+
+    for (unsigned i = from; i < to; i++) {
+        sock_udp_t sock;
+
+        local.port = OBSERVER_PORT + i;
+        if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+            errors++;
+            continue;
+        }
+        if (_register(&sock, i) < 0) {
+            errors++;
+        }
+        sock_udp_close(&sock);
+        if ((i % REGISTER_BATCH) == 0) {
+            ztimer_sleep(ZTIMER_USEC, 1000);
+        }
+    }
+    ztimer_sleep(ZTIMER_USEC, 10000);
+    return errors;
+}
+
+/* the notifications for the application's observer, with token 0 */
+static unsigned _check_notifications(unsigned numof)
+{
+    unsigned errors = 0;
+
+    for (unsigned i = 0; i < numof; i++) {
+        coap_pkt_t pdu;
+        uint32_t token = 0;
+        ssize_t len = sock_udp_recv(&_sock, _buf, sizeof(_buf), 100000, NULL);
+
+        if ((len <= 0) || (coap_parse(&pdu, _buf, len) < 0) ||
+            (coap_get_token_len(&pdu) != sizeof(token)) ||
+            (memcmp(pdu.token, &token, sizeof(token)) != 0) ||
+            !coap_has_observe(&pdu) ||
+            (pdu.payload_len != sizeof(_value) - 1) ||
+            (memcmp(pdu.payload, _value, sizeof(_value) - 1) != 0)) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+static void _run(unsigned numof, unsigned errors)
+{
+    unsigned notified = 0;
+    uint32_t start, time;
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        coap_pkt_t pdu;
+        int res;
+
+        if (gcoap_obs_init(&pdu, _buf, sizeof(_buf),
+                           &_resources[0]) != GCOAP_OBS_INIT_OK) {
+            errors++;
+            continue;
+        }
+        coap_opt_add_format(&pdu, COAP_FORMAT_TEXT);
+        size_t len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
+
+        memcpy(pdu.payload, _value, sizeof(_value) - 1);
+        res = gcoap_obs_notify_all(_buf, len + sizeof(_value) - 1,
+                                   &_resources[0]);
+        if (res < 0) {
+            errors++;
+        }
+        else {
+            notified += res;
+        }
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+    if (time == 0) {
+        time = 1;
+    }
+    /* every observer is notified once per round */
+    if (notified != (numof * TEST_ROUNDS)) {
+        errors++;
+    }
+    errors += _check_notifications(TEST_ROUNDS);
+
+    printf("{ \"observers\" : %u, \"notifications_per_sec\" : %" PRIu32
+           ", \"notified\" : %u, \"errors\" : %u }", numof,
+           (uint32_t)(((uint64_t)notified * US_PER_SEC) / time), notified,
+           errors);
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = OBSERVER_PORT };
+    unsigned numof = 1, errors;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_obs_pool_init(_obs_pool, ARRAY_SIZE(_obs_pool));
+    gcoap_register_listener(&_listener);
+    if ((sock_udp_create(&_sock, &local, NULL, 0) < 0) ||
+        (_register(&_sock, 0) < 0) ||
+        (sock_udp_recv(&_sock, _buf, sizeof(_buf), 100000, NULL) <= 0)) {
+        puts("Unable to register observer");
+        return 1;
+    }
+
+    printf("gcoap Observe notification benchmark (%u rounds, %u buckets, "
+           "rate %u/s)\n", TEST_ROUNDS, CONFIG_GCOAP_OBS_BUCKETS,
+           CONFIG_GCOAP_OBS_NOTIFY_RATE);
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_counts); i++) {
+        if (_counts[i] > TEST_OBSERVERS_MAX) {
+            break;
+        }
+        if (i) {
+            puts(",");
+        }
+        errors = _add_observers(numof, _counts[i]);
+        numof = _counts[i];
+        _run(numof, errors);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the request latency of a gcoap server with a slow
+ *              resource under a flood of requests
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "kernel_defines.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_REQUESTS
+#define TEST_REQUESTS       (400U)
+#endif
+
+/* every SLOW_RATEth request is for the slow resource */
+#ifndef TEST_SLOW_RATE
+#define TEST_SLOW_RATE      (4U)
+#endif
+
+/* time the slow resource takes, e.g. to read a sensor */
+#ifndef TEST_SLOW_US
+#define TEST_SLOW_US        (10000U)
+#endif
+
+/* requests for the slow resource the worker pool takes at once */
+#ifndef TEST_SLOW_LIMIT
+#define TEST_SLOW_LIMIT     (2U)
+#endif
+
+enum {
+    CLASS_FAST = 0,
+    CLASS_SLOW,
+    CLASS_NUMOF,
+};
+
+static const char *_class_names[] = { "fast", "slow" };
+
+static ssize_t _fast_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx);
+static ssize_t _slow_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx);
+
+/* must be sorted by path */
+static const coap_resource_t _resources[] = {
+    { "/fast", COAP_GET, _fast_handler, NULL },
+    { "/slow", COAP_GET, _slow_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static uint32_t _sent[TEST_REQUESTS];
+static uint32_t _latency[CLASS_NUMOF][TEST_REQUESTS];
+static unsigned _received[CLASS_NUMOF];
+static unsigned _unavailable[CLASS_NUMOF];
+static unsigned _errors[CLASS_NUMOF];
+
+static ssize_t _fast_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    (void)ctx;
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static ssize_t _slow_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    (void)ctx;
+    ztimer_sleep(ZTIMER_USEC, TEST_SLOW_US);
+    return gcoap_response(pdu, buf, len, COAP_CODE_CONTENT);
+}
+
+static inline unsigned _class(unsigned req)
+{
+    return ((req % TEST_SLOW_RATE) == 0) ? CLASS_SLOW : CLASS_FAST;
+}
+
+/* runs on the gcoap thread */
+static void _resp_handler(const gcoap_request_memo_t *memo, coap_pkt_t *pdu,
+                          const sock_udp_ep_t *remote)
+{
+    unsigned req = (uintptr_t)memo->context;
+    unsigned class = _class(req);
+
+    (void)remote;
+    if (memo->state != GCOAP_MEMO_RESP) {
+        _errors[class]++;
+    }
+    else if (coap_get_code_raw(pdu) == COAP_CODE_SERVICE_UNAVAILABLE) {
+        _unavailable[class]++;
+    }
+    else if (coap_get_code_raw(pdu) != COAP_CODE_CONTENT) {
+        _errors[class]++;
+    }
+    else {
+        _latency[class][_received[class]++] = ztimer_now(ZTIMER_USEC) -
+                                              _sent[req];
+    }
+}
+
+static int _cmp(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static uint32_t _percentile(const uint32_t *sorted, unsigned numof,
+                            unsigned pct)
+{
+    if (numof == 0) {
+        return 0;
+    }
+    return sorted[((numof - 1) * pct) / 100];
+}
+
+int main(void)
+{
+    uint8_t buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = CONFIG_GCOAP_PORT };
+    coap_pkt_t pdu;
+    uint32_t start, time;
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&remote.addr.ipv6);
+    gcoap_register_listener(&_listener);
+#if IS_USED(MODULE_GCOAP_WORKERS)
+    gcoap_worker_limit(&_resources[CLASS_SLOW], TEST_SLOW_LIMIT);
+    printf("gcoap worker pool benchmark (%u workers, %u requests)\n",
+           CONFIG_GCOAP_WORKERS_NUMOF, TEST_REQUESTS);
+#else
+    printf("gcoap worker pool benchmark (no workers, %u requests)\n",
+           TEST_REQUESTS);
+#endif
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned req = 0; req < TEST_REQUESTS; req++) {
+        size_t len;
+
+        gcoap_req_init(&pdu, buf, sizeof(buf), COAP_METHOD_GET,
+                       _resources[_class(req)].path);
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+        _sent[req] = ztimer_now(ZTIMER_USEC);
+        /* keep up to CONFIG_GCOAP_REQ_WAITING_MAX requests in flight */
+        while (gcoap_req_send(buf, len, &remote, _resp_handler,
+                              (void *)(uintptr_t)req) == 0) {
+            ztimer_sleep(ZTIMER_USEC, 100);
+        }
+    }
+    while (gcoap_op_state() > 0) {
+        ztimer_sleep(ZTIMER_USEC, 1000);
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+
+    puts("{ \"result\" : [");
+    for (unsigned class = 0; class < CLASS_NUMOF; class++) {
+        unsigned numof = _received[class];
+
+        qsort(_latency[class], numof, sizeof(uint32_t), _cmp);
+        if (class) {
+            puts(",");
+        }
+        printf("{ \"resource\" : \"%s\", \"received\" : %u, "
+               "\"unavailable\" : %u, \"p50_us\" : %" PRIu32
+               ", \"p90_us\" : %" PRIu32 ", \"p99_us\" : %" PRIu32
+               ", \"max_us\" : %" PRIu32 ", \"errors\" : %u }",
+               _class_names[class], numof, _unavailable[class],
+               _percentile(_latency[class], numof, 50),
+               _percentile(_latency[class], numof, 90),
+               _percentile(_latency[class], numof, 99),
+               _percentile(_latency[class], numof, 100), _errors[class]);
+    }
+    printf("\n], \"requests_per_sec\" : %" PRIu32 " }\n",
+           (uint32_t)(((uint64_t)TEST_REQUESTS * US_PER_SEC) / time));
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure next-hop resolution of forwarded packets
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/ethernet.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/ipv6/addr.h"
+#include "net/netdev_test.h"
+#include "random.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_PKTS
+#define TEST_PKTS           (50000U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+#define NEXT_HOPS_NUMOF     (4U)
+#define ROUTES_NUMOF        (64U)
+#define FLOWS_NUMOF         (8U)
+/* refresh a neighbor cache entry every CHURN_PKTS packets */
+#define CHURN_PKTS          (500U)
+
+static gnrc_netif_t _netif;
+static netdev_test_t _netdev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+
+static ipv6_addr_t _next_hops[NEXT_HOPS_NUMOF];
+static uint8_t _l2addrs[NEXT_HOPS_NUMOF][ETHERNET_ADDR_LEN];
+static ipv6_addr_t _flows[FLOWS_NUMOF];
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    static const uint8_t addr[] = { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x26 };
+
+    (void)dev;
+    expect(max_len >= sizeof(addr));
+    memcpy(value, addr, sizeof(addr));
+    return sizeof(addr);
+}
+
+static void _init_netif(void)
+{
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_MAX_PDU_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS, _get_address);
+    expect(gnrc_netif_ethernet_create(&_netif, _netif_stack,
+                                      sizeof(_netif_stack), GNRC_NETIF_PRIO,
+                                      "mock_eth", &_netdev.netdev) == 0);
+}
+
+static unsigned _init_nib(void)
+{
+    unsigned errors = 0;
+
+    for (unsigned i = 0; i < NEXT_HOPS_NUMOF; i++) {
+        ipv6_addr_from_str(&_next_hops[i], "fe80::1");
+        _next_hops[i].u8[15] += i;
+        random_bytes(_l2addrs[i], sizeof(_l2addrs[i]));
+        if (gnrc_ipv6_nib_nc_set(&_next_hops[i], _netif.pid, _l2addrs[i],
+                                 sizeof(_l2addrs[i])) < 0) {
+            errors++;
+        }
+    }
+    for (unsigned i = 0; i < ROUTES_NUMOF; i++) {
+        ipv6_addr_t pfx;
+
+        ipv6_addr_from_str(&pfx, "2001:db8::");
+        pfx.u16[3] = byteorder_htons(i);
+        if (gnrc_ipv6_nib_ft_add(&pfx, 64, &_next_hops[i % NEXT_HOPS_NUMOF],
+                                 _netif.pid, 0) < 0) {
+            errors++;
+        }
+    }
+    for (unsigned i = 0; i < FLOWS_NUMOF; i++) {
+        ipv6_addr_from_str(&_flows[i], "2001:db8::");
+        _flows[i].u16[3] = byteorder_htons(random_uint32() % ROUTES_NUMOF);
+        random_bytes(&_flows[i].u8[8], 8);
+    }
+    return errors;
+}
+
+int main(void)
+{
+    gnrc_ipv6_nib_nc_t nce;
+    unsigned errors;
+    uint32_t start, time;
+
+    printf("NIB next-hop resolution benchmark (%s)\n",
+           IS_ACTIVE(GNRC_IPV6_NIB_CONF_FLOW_CACHE) ? "flow cache"
+                                                    : "no flow cache");
+
+    random_init(TEST_SEED);
+    _init_netif();
+    errors = _init_nib();
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_PKTS; i++) {
+        const ipv6_addr_t *dst = &_flows[i % FLOWS_NUMOF];
+
+        if ((i % CHURN_PKTS) == 0) {
+            unsigned nh = (i / CHURN_PKTS) % NEXT_HOPS_NUMOF;
+
+            gnrc_ipv6_nib_nc_set(&_next_hops[nh], _netif.pid, _l2addrs[nh],
+                                 sizeof(_l2addrs[nh]));
+        }
+        if ((gnrc_ipv6_nib_get_next_hop_l2addr(dst, NULL, NULL, &nce) < 0) ||
+            (gnrc_ipv6_nib_nc_get_iface(&nce) != (unsigned)_netif.pid)) {
+            errors++;
+        }
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+
+    puts("{ \"result\" : [");
+    printf("{ \"pkts\" : %u, \"time_us\" : %" PRIu32 ", \"pkts_per_sec\" : %"
+           PRIu32, TEST_PKTS, time,
+           (uint32_t)(((uint64_t)TEST_PKTS * US_PER_SEC) / time));
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+    gnrc_ipv6_nib_flow_stats_t stats;
+
+    gnrc_ipv6_nib_flow_stats(&stats);
+    printf(", \"hits\" : %" PRIu32 ", \"misses\" : %" PRIu32,
+           stats.hits, stats.misses);
+#endif
+    printf(", \"errors\" : %u }", errors);
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure forwarding table look-ups with many routes
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/ipv6/nib/ft.h"
+#include "net/ipv6/addr.h"
+#include "random.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_ROUTES_MAX
+#define TEST_ROUTES_MAX     (16U)
+#endif
+
+#ifndef TEST_LOOKUPS
+#define TEST_LOOKUPS        (20000U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+#define NEXT_HOPS_NUMOF     (4U)
+#define DSTS_NUMOF          (256U)
+#define IFACE               (1U)
+
+typedef struct {
+    ipv6_addr_t pfx;
+    uint8_t len;
+} route_t;
+
+static const unsigned _counts[] = { 16, 256, 4096 };
+
+static route_t _routes[TEST_ROUTES_MAX];
+static ipv6_addr_t _dsts[DSTS_NUMOF];
+static uint8_t _dst_lens[DSTS_NUMOF];
+
+static void _random_route(route_t *route)
+{
+    /* 2001:db8:0:<subnet>::/64 prefixes and 2001:db8::<iid>/128 host routes
+     * as installed by RPL in storing mode */
+    ipv6_addr_from_str(&route->pfx, "2001:db8::");
+    if ((random_uint32() % 4) == 0) {
+        route->pfx.u16[3] = byteorder_htons(random_uint32() & 0xffff);
+        route->len = 64;
+    }
+    else {
+        random_bytes(&route->pfx.u8[8], 8);
+        route->len = 128;
+    }
+}
+
+static void _run(unsigned numof)
+{
+    ipv6_addr_t next_hops[NEXT_HOPS_NUMOF];
+    gnrc_ipv6_nib_ft_t fte;
+    unsigned errors = 0;
+    uint32_t start, time;
+
+    for (unsigned i = 0; i < NEXT_HOPS_NUMOF; i++) {
+        ipv6_addr_from_str(&next_hops[i], "fe80::1");
+        next_hops[i].u8[15] += i;
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        _random_route(&_routes[i]);
+        if (gnrc_ipv6_nib_ft_add(&_routes[i].pfx, _routes[i].len,
+                                 &next_hops[i % NEXT_HOPS_NUMOF], IFACE,
+                                 0) < 0) {
+            errors++;
+        }
+    }
+    for (unsigned i = 0; i < DSTS_NUMOF; i++) {
+        const route_t *route = &_routes[random_uint32() % numof];
+
+        /* random address within the route's prefix */
+        random_bytes(_dsts[i].u8, sizeof(_dsts[i]));
+        ipv6_addr_init_prefix(&_dsts[i], &route->pfx, route->len);
+        _dst_lens[i] = route->len;
+    }
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_LOOKUPS; i++) {
+        unsigned idx = i % DSTS_NUMOF;
+
+        if ((gnrc_ipv6_nib_ft_get(&_dsts[idx], NULL, &fte) < 0) ||
+            (fte.dst_len < _dst_lens[idx])) {
+            errors++;
+        }
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_ipv6_nib_ft_del(&_routes[i].pfx, _routes[i].len);
+    }
+
+    printf("{ \"routes\" : %u, \"lookups\" : %u, \"time_us\" : %" PRIu32
+           ", \"lookups_per_sec\" : %" PRIu32 ", \"errors\" : %u }",
+           numof, TEST_LOOKUPS, time,
+           (uint32_t)(((uint64_t)TEST_LOOKUPS * US_PER_SEC) / time), errors);
+}
+
+int main(void)
+{
+    printf("NIB forwarding table benchmark (%s)\n",
+           IS_ACTIVE(GNRC_IPV6_NIB_CONF_OFFL_TRIE) ? "prefix trie"
+                                                   : "linear search");
+
+    random_init(TEST_SEED);
+
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_counts); i++) {
+        if (_counts[i] > TEST_ROUTES_MAX) {
+            break;
+        }
+        if (i) {
+            puts(",");
+        }
+        _run(_counts[i]);
+    }
+    puts("\n] }");
+
+    return 0;
+}
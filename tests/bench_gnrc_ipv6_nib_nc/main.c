@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure neighbor cache look-ups with many neighbors
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/ipv6/nib/nc.h"
+#include "net/ipv6/addr.h"
+#include "random.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#include "_nib-internal.h"
+
+#ifndef TEST_NEIGHBORS_MAX
+#define TEST_NEIGHBORS_MAX  (16U)
+#endif
+
+#ifndef TEST_OPS
+#define TEST_OPS            (20000U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+#define IFACE               (1U)
+
+static const unsigned _counts[] = { 16, 64, 256, 1024 };
+
+static ipv6_addr_t _addrs[TEST_NEIGHBORS_MAX];
+static uint8_t _l2addrs[TEST_NEIGHBORS_MAX][8];
+
+static uint32_t _per_sec(uint32_t time)
+{
+    return ((uint64_t)TEST_OPS * US_PER_SEC) / time;
+}
+
+static void _run(unsigned numof)
+{
+    ipv6_addr_t unknown;
+    unsigned errors = 0;
+    uint32_t start, lookup_time, refresh_time;
+
+    for (unsigned i = 0; i < numof; i++) {
+        random_bytes(_l2addrs[i], sizeof(_l2addrs[i]));
+        ipv6_addr_set_link_local_prefix(&_addrs[i]);
+        memcpy(&_addrs[i].u8[8], _l2addrs[i], sizeof(_l2addrs[i]));
+        _addrs[i].u8[8] ^= 0x02;
+        if (gnrc_ipv6_nib_nc_set(&_addrs[i], IFACE, _l2addrs[i],
+                                 sizeof(_l2addrs[i])) < 0) {
+            errors++;
+        }
+    }
+    ipv6_addr_set_link_local_prefix(&unknown);
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_OPS; i++) {
+        unsigned idx = random_uint32() % numof;
+
+        _nib_acquire();
+        if ((i % 8) == 0) {
+            /* some packets come from neighbors not in the cache */
+            random_bytes(&unknown.u8[8], 8);
+            if (_nib_onl_get(&unknown, IFACE) != NULL) {
+                errors++;
+            }
+        }
+        else if (_nib_onl_get(&_addrs[idx], IFACE) == NULL) {
+            errors++;
+        }
+        _nib_release();
+    }
+    lookup_time = ztimer_now(ZTIMER_USEC) - start;
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_OPS; i++) {
+        unsigned idx = random_uint32() % numof;
+
+        if (gnrc_ipv6_nib_nc_set(&_addrs[idx], IFACE, _l2addrs[idx],
+                                 sizeof(_l2addrs[idx])) < 0) {
+            errors++;
+        }
+    }
+    refresh_time = ztimer_now(ZTIMER_USEC) - start;
+
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_ipv6_nib_nc_del(&_addrs[i], IFACE);
+    }
+
+    printf("{ \"neighbors\" : %u, \"lookups_per_sec\" : %" PRIu32
+           ", \"refreshes_per_sec\" : %" PRIu32 ", \"errors\" : %u }",
+           numof, _per_sec(lookup_time), _per_sec(refresh_time), errors);
+}
+
+int main(void)
+{
+    printf("NIB neighbor cache benchmark (%s)\n",
+           IS_ACTIVE(GNRC_IPV6_NIB_CONF_NC_INDEX) ? "hash index"
+                                                  : "linear search");
+
+    random_init(TEST_SEED);
+
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_counts); i++) {
+        if (_counts[i] > TEST_NEIGHBORS_MAX) {
+            break;
+        }
+        if (i) {
+            puts(",");
+        }
+        _run(_counts[i]);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Count context switches when forwarding packets through
+ *              GNRC netapi one by one and in bulk
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "sched.h"
+#include "thread.h"
+
+#ifndef TEST_PKTS
+#define TEST_PKTS           (10000U)
+#endif
+
+#ifndef TEST_BURST
+#define TEST_BURST          (8U)
+#endif
+
+#ifndef TEST_PKT_SIZE
+#define TEST_PKT_SIZE       (64U)
+#endif
+
+#define TEST_QUEUE_LEN      (16U)
+#define TEST_CTX_FWD        (1U)
+#define TEST_CTX_SINK       (2U)
+
+static char _fwd_stack[THREAD_STACKSIZE_DEFAULT];
+static char _sink_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _fwd_queue[TEST_QUEUE_LEN];
+static msg_t _sink_queue[TEST_QUEUE_LEN];
+
+static bool _bulk;
+static unsigned _forwarded;
+static unsigned _switches;
+
+static void _sched_cb(kernel_pid_t active, kernel_pid_t next)
+{
+    (void)active;
+    (void)next;
+    _switches++;
+}
+
+static unsigned _receive(msg_t *msgs, gnrc_pktsnip_t **pkts)
+{
+    unsigned n = 1;
+
+    if (_bulk) {
+        n = msg_receive_bulk(msgs, TEST_BURST);
+    }
+    else {
+        msg_receive(msgs);
+    }
+    for (unsigned i = 0; i < n; i++) {
+        pkts[i] = msgs[i].content.ptr;
+    }
+    return n;
+}
+
+static void _dispatch(uint32_t ctx, uint16_t cmd, gnrc_pktsnip_t **pkts,
+                      unsigned num)
+{
+    if (_bulk) {
+        gnrc_netapi_dispatch_bulk(GNRC_NETTYPE_UNDEF, ctx, cmd, pkts, num);
+    }
+    else {
+        for (unsigned i = 0; i < num; i++) {
+            gnrc_netapi_dispatch(GNRC_NETTYPE_UNDEF, ctx, cmd, pkts[i]);
+        }
+    }
+}
+
+static void *_fwd_thread(void *arg)
+{
+    msg_t msgs[TEST_BURST];
+    gnrc_pktsnip_t *pkts[TEST_BURST];
+    gnrc_netreg_entry_t entry;
+
+    (void)arg;
+    msg_init_queue(_fwd_queue, TEST_QUEUE_LEN);
+    gnrc_netreg_entry_init_pid(&entry, TEST_CTX_FWD, thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+
+    while (1) {
+        unsigned n = _receive(msgs, pkts);
+        _dispatch(TEST_CTX_SINK, GNRC_NETAPI_MSG_TYPE_SND, pkts, n);
+    }
+
+    return NULL;
+}
+
+static void *_sink_thread(void *arg)
+{
+    msg_t msgs[TEST_BURST];
+    gnrc_pktsnip_t *pkts[TEST_BURST];
+    gnrc_netreg_entry_t entry;
+
+    (void)arg;
+    msg_init_queue(_sink_queue, TEST_QUEUE_LEN);
+    gnrc_netreg_entry_init_pid(&entry, TEST_CTX_SINK, thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &entry);
+
+    while (1) {
+        unsigned n = _receive(msgs, pkts);
+        for (unsigned i = 0; i < n; i++) {
+            gnrc_pktbuf_release(pkts[i]);
+        }
+        _forwarded += n;
+    }
+
+    return NULL;
+}
+
+static void _run(bool bulk)
+{
+    gnrc_pktsnip_t *pkts[TEST_BURST];
+    unsigned switches;
+
+    _bulk = bulk;
+    _forwarded = 0;
+    _switches = 0;
+
+    for (unsigned i = 0; i < TEST_PKTS; i += TEST_BURST) {
+        unsigned n = 0;
+
+        while ((n < TEST_BURST) && ((i + n) < TEST_PKTS)) {
+            pkts[n] = gnrc_pktbuf_add(NULL, NULL, TEST_PKT_SIZE,
+                                      GNRC_NETTYPE_UNDEF);
+            if (pkts[n] == NULL) {
+                printf("packet %u: out of packet buffer\n", i + n);
+                return;
+            }
+            n++;
+        }
+        _dispatch(TEST_CTX_FWD, GNRC_NETAPI_MSG_TYPE_RCV, pkts, n);
+    }
+    /* both other threads have a higher priority, so they are done here */
+    switches = _switches;
+
+    printf("{ \"mode\" : \"%s\", \"pkts\" : %u, \"forwarded\" : %u, "
+           "\"context_switches\" : %u, \"context_switches_per_pkt\" : %u.%02u }",
+           bulk ? "bulk" : "single", TEST_PKTS, _forwarded, switches,
+           switches / TEST_PKTS, ((switches * 100U) / TEST_PKTS) % 100U);
+}
+
+int main(void)
+{
+    printf("netapi forwarding benchmark (bursts of %u packets)\n", TEST_BURST);
+
+    thread_create(_fwd_stack, sizeof(_fwd_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _fwd_thread, NULL, "forwarder");
+    thread_create(_sink_stack, sizeof(_sink_stack), THREAD_PRIORITY_MAIN - 2,
+                  THREAD_CREATE_STACKTEST, _sink_thread, NULL, "sink");
+    sched_register_cb(_sched_cb);
+
+    puts("{ \"result\" : [");
+    _run(false);
+    puts(",");
+    _run(true);
+    puts("\n] }");
+
+    return 0;
+}
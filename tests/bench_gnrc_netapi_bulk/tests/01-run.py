@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"result\" : \[")
+    child.expect(r"{ \"mode\" : \"single\", \"pkts\" : (\d+), "
+                 r"\"forwarded\" : (\d+), \"context_switches\" : (\d+)")
+    pkts = int(child.match.group(1))
+    assert int(child.match.group(2)) == pkts
+    single = int(child.match.group(3))
+    child.expect(r"{ \"mode\" : \"bulk\", \"pkts\" : (\d+), "
+                 r"\"forwarded\" : (\d+), \"context_switches\" : (\d+)")
+    assert int(child.match.group(2)) == pkts
+    assert int(child.match.group(3)) < single
+    child.expect(r"\] }")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
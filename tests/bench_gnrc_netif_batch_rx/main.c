@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure receive throughput of a network interface with bursts
+ *              of packets
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_PKTS
+#define TEST_PKTS           (20000U)
+#endif
+
+#define PAYLOAD_LEN         (64U)
+#define FRAME_LEN           (sizeof(ethernet_hdr_t) + sizeof(ipv6_hdr_t) + \
+                             PAYLOAD_LEN)
+#define MAIN_QUEUE_SIZE     (16U)
+
+static const unsigned _bursts[] = { 1, 4, 8 };
+
+static gnrc_netif_t _netif;
+static netdev_test_t _netdev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _inject_stack[THREAD_STACKSIZE_DEFAULT];
+static msg_t _main_queue[MAIN_QUEUE_SIZE];
+static kernel_pid_t _inject_pid;
+
+static uint8_t _frame[FRAME_LEN];
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    static const uint8_t addr[] = { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x26 };
+
+    (void)dev;
+    expect(max_len >= sizeof(addr));
+    memcpy(value, addr, sizeof(addr));
+    return sizeof(addr);
+}
+
+static int _recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    (void)dev;
+    (void)info;
+    if (buf == NULL) {
+        return sizeof(_frame);
+    }
+    if ((unsigned)len < sizeof(_frame)) {
+        return -ENOBUFS;
+    }
+    memcpy(buf, _frame, sizeof(_frame));
+    return sizeof(_frame);
+}
+
+static void _isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+static void _init_netif(void)
+{
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_MAX_PDU_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS, _get_address);
+    netdev_test_set_recv_cb(&_netdev, _recv);
+    netdev_test_set_isr_cb(&_netdev, _isr);
+    expect(gnrc_netif_ethernet_create(&_netif, _netif_stack,
+                                      sizeof(_netif_stack), GNRC_NETIF_PRIO,
+                                      "mock_eth", &_netdev.netdev) == 0);
+}
+
+static void _init_frame(void)
+{
+    static const uint8_t dst[] = { 0x33, 0x33, 0x00, 0x00, 0x00, 0x01 };
+    static const uint8_t src[] = { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x27 };
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)_frame;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    uint8_t *payload = (uint8_t *)(ipv6 + 1);
+
+    memcpy(eth->dst, dst, sizeof(dst));
+    memcpy(eth->src, src, sizeof(src));
+    eth->type = byteorder_htons(ETHERTYPE_IPV6);
+    ipv6_hdr_set_version(ipv6);
+    ipv6->len = byteorder_htons(PAYLOAD_LEN);
+    ipv6->nh = PROTNUM_IPV6_NONXT;
+    ipv6->hl = 255;
+    ipv6_addr_from_str(&ipv6->src, "fe80::ccab:feff:fead:f727");
+    ipv6->dst = ipv6_addr_all_nodes_link_local;
+    for (unsigned i = 0; i < PAYLOAD_LEN; i++) {
+        payload[i] = i;
+    }
+}
+
+/* runs with a higher priority than the interface, so all frames of a burst
+ * are signaled before the interface gets to handle them */
+static void *_inject(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    while (1) {
+        msg_receive(&msg);
+        for (unsigned i = 0; i < msg.content.value; i++) {
+            netdev_trigger_event_isr(&_netdev.netdev);
+        }
+    }
+    return NULL;
+}
+
+static void _run(unsigned burst)
+{
+    unsigned errors = 0;
+    uint32_t start, time;
+    msg_t msg = { .content = { .value = burst } };
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_PKTS; i += burst) {
+        msg_send(&msg, _inject_pid);
+        for (unsigned j = 0; j < burst; j++) {
+            msg_t rcv;
+
+            msg_receive(&rcv);
+            if ((rcv.type != GNRC_NETAPI_MSG_TYPE_RCV) ||
+                (((gnrc_pktsnip_t *)rcv.content.ptr)->size != PAYLOAD_LEN)) {
+                errors++;
+            }
+            if (rcv.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+                gnrc_pktbuf_release(rcv.content.ptr);
+            }
+        }
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+
+    printf("{ \"burst\" : %u, \"pkts\" : %u, \"time_us\" : %" PRIu32
+           ", \"pkts_per_sec\" : %" PRIu32 ", \"errors\" : %u }",
+           burst, TEST_PKTS, time,
+           (uint32_t)(((uint64_t)TEST_PKTS * US_PER_SEC) / time), errors);
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t sink = GNRC_NETREG_ENTRY_INIT_PID(PROTNUM_IPV6_NONXT,
+                                                          thread_getpid());
+
+    printf("GNRC receive throughput benchmark (%s)\n",
+           IS_USED(MODULE_GNRC_NETIF_BATCH_RX) ? "batch receive"
+                                               : "single receive");
+
+    msg_init_queue(_main_queue, MAIN_QUEUE_SIZE);
+    _init_frame();
+    _init_netif();
+    _inject_pid = thread_create(_inject_stack, sizeof(_inject_stack),
+                                GNRC_NETIF_PRIO - 1, THREAD_CREATE_STACKTEST,
+                                _inject, NULL, "inject");
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &sink);
+
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_bursts); i++) {
+        if (i) {
+            puts(",");
+        }
+        _run(_bursts[i]);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the dispatch cost of GNRC's network protocol registry
+ *              by number of registered ports
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (10000U)
+#endif
+
+#define PORTS_MAX           (128U)
+/* port the benchmark dispatches to, registered first so it is the last one
+ * in a plain list */
+#define TARGET_PORT         (5683U)
+/* number of subscribers for the target port */
+#define TARGET_SUBS         (2U)
+/* the registry treats all types alike, so spare the UDP implementation */
+#define TEST_NETTYPE        (GNRC_NETTYPE_UNDEF)
+
+static const unsigned _counts[] = { 0, 4, 16, 32, 64, PORTS_MAX };
+
+static gnrc_netreg_entry_t _ports[PORTS_MAX];
+static gnrc_netreg_entry_t _targets[TARGET_SUBS];
+static unsigned _received;
+static unsigned _misdelivered;
+
+static void _recv(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)cmd;
+    (void)ctx;
+    _received++;
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _misdeliver(uint16_t cmd, gnrc_pktsnip_t *pkt, void *ctx)
+{
+    (void)cmd;
+    (void)ctx;
+    _misdelivered++;
+    gnrc_pktbuf_release(pkt);
+}
+
+static gnrc_netreg_entry_cbd_t _target_cbd = { .cb = _recv };
+static gnrc_netreg_entry_cbd_t _port_cbd = { .cb = _misdeliver };
+
+static void _run(gnrc_pktsnip_t *pkt, unsigned numof)
+{
+    unsigned errors = 0;
+    uint32_t start, time;
+
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_entry_init_cb(&_ports[i], TARGET_PORT + 1 + i, &_port_cbd);
+        gnrc_netreg_register(TEST_NETTYPE, &_ports[i]);
+    }
+    _received = 0;
+    _misdelivered = 0;
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        /* keep the packet for the next round, the subscribers release it */
+        gnrc_pktbuf_hold(pkt, 1);
+        if (gnrc_netapi_dispatch_receive(TEST_NETTYPE, TARGET_PORT,
+                                         pkt) != TARGET_SUBS) {
+            errors++;
+        }
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+    for (unsigned i = 0; i < numof; i++) {
+        gnrc_netreg_unregister(TEST_NETTYPE, &_ports[i]);
+    }
+    if (time == 0) {
+        time = 1;
+    }
+    errors += _misdelivered;
+    if (_received != (TARGET_SUBS * TEST_ROUNDS)) {
+        errors++;
+    }
+    printf("{ \"ports\" : %u, \"dispatches_per_sec\" : %" PRIu32
+           ", \"errors\" : %u }",
+           numof + 1, (uint32_t)(((uint64_t)TEST_ROUNDS * US_PER_SEC) / time),
+           errors);
+}
+
+int main(void)
+{
+    gnrc_pktsnip_t *pkt;
+
+    /* auto-initialization of GNRC is disabled */
+    gnrc_pktbuf_init();
+    gnrc_netreg_init();
+    for (unsigned i = 0; i < TARGET_SUBS; i++) {
+        gnrc_netreg_entry_init_cb(&_targets[i], TARGET_PORT, &_target_cbd);
+        gnrc_netreg_register(TEST_NETTYPE, &_targets[i]);
+    }
+    pkt = gnrc_pktbuf_add(NULL, NULL, 8, TEST_NETTYPE);
+    if (pkt == NULL) {
+        puts("Unable to allocate packet");
+        return 1;
+    }
+
+    printf("GNRC netreg dispatch benchmark (%u rounds, %u buckets, "
+           "%u subscribers)\n", TEST_ROUNDS, CONFIG_GNRC_NETREG_BUCKETS,
+           TARGET_SUBS);
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_counts); i++) {
+        if (i) {
+            puts(",");
+        }
+        _run(pkt, _counts[i]);
+    }
+    puts("\n] }");
+    gnrc_pktbuf_release(pkt);
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare copying and zero-copy reception into the packet buffer
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "net/ethernet/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/ipv6/hdr.h"
+#include "net/udp.h"
+#include "ztimer.h"
+
+#ifndef TEST_PKTS
+#define TEST_PKTS           (10000U)
+#endif
+
+#ifndef TEST_FRAME_LEN
+#define TEST_FRAME_LEN      (1280U)
+#endif
+
+static uint8_t _frame[TEST_FRAME_LEN];
+static unsigned _released;
+
+static void _release(void *arg, void *data)
+{
+    (void)arg;
+    (void)data;
+    _released++;
+}
+
+static bool _recv(bool zero_copy)
+{
+    gnrc_pktsnip_t *pkt;
+
+    if (zero_copy) {
+        pkt = gnrc_pktbuf_add_ext(NULL, _frame, sizeof(_frame),
+                                  GNRC_NETTYPE_UNDEF, _release, NULL);
+    }
+    else {
+        pkt = gnrc_pktbuf_add(NULL, _frame, sizeof(_frame),
+                              GNRC_NETTYPE_UNDEF);
+    }
+    if ((pkt == NULL) ||
+        !gnrc_pktbuf_mark(pkt, sizeof(ethernet_hdr_t), GNRC_NETTYPE_UNDEF) ||
+        !gnrc_pktbuf_mark(pkt, sizeof(ipv6_hdr_t), GNRC_NETTYPE_UNDEF) ||
+        !gnrc_pktbuf_mark(pkt, sizeof(udp_hdr_t), GNRC_NETTYPE_UNDEF)) {
+        gnrc_pktbuf_release(pkt);
+        return false;
+    }
+    gnrc_pktbuf_release(pkt);
+    return true;
+}
+
+static void _run(bool zero_copy)
+{
+    uint32_t start, time, copied;
+
+    gnrc_pktbuf_init();
+    _released = 0;
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_PKTS; i++) {
+        if (!_recv(zero_copy)) {
+            printf("packet %u: out of packet buffer\n", i);
+            return;
+        }
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+    copied = gnrc_pktbuf_copied_bytes();
+
+    printf("{ \"mode\" : \"%s\", \"pkts\" : %u, \"time_us\" : %" PRIu32
+           ", \"bytes_copied_per_pkt\" : %" PRIu32 ", \"released\" : %u }",
+           zero_copy ? "zero-copy" : "copy", TEST_PKTS, time,
+           copied / TEST_PKTS, _released);
+}
+
+int main(void)
+{
+    printf("packet buffer reception benchmark (%u byte frames)\n",
+           TEST_FRAME_LEN);
+    memset(_frame, 0xa5, sizeof(_frame));
+
+    puts("{ \"result\" : [");
+    _run(false);
+    puts(",");
+    _run(true);
+    puts("\n] }");
+
+    return 0;
+}
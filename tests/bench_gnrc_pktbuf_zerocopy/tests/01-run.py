@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"result\" : \[")
+    child.expect(r"\"mode\" : \"copy\", \"pkts\" : (\d+)")
+    pkts = int(child.match.group(1))
+    child.expect(r"\"mode\" : \"zero-copy\", \"pkts\" : \d+, "
+                 r"\"time_us\" : \d+, \"bytes_copied_per_pkt\" : 0, "
+                 r"\"released\" : (\d+) }")
+    assert int(child.match.group(1)) == pkts
+    child.expect(r"\] }")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the 6LoWPAN reassembly buffer with many interleaved
+ *              datagrams
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/sixlowpan.h"
+#include "random.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_DATAGRAMS_MAX
+#define TEST_DATAGRAMS_MAX  (4U)
+#endif
+
+#ifndef TEST_DATAGRAM_SIZE
+#define TEST_DATAGRAM_SIZE  (256U)
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (20U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+/* payload of a fragment, must be a multiple of 8 */
+#define FRAG_PAYLOAD        (96U)
+#define FRAGS_PER_DATAGRAM  ((TEST_DATAGRAM_SIZE + FRAG_PAYLOAD - 1) / \
+                             FRAG_PAYLOAD)
+/* every DUPLICATE_RATEth fragment is received twice */
+#define DUPLICATE_RATE      (8U)
+#define ORDER_NUMOF         (TEST_DATAGRAMS_MAX * FRAGS_PER_DATAGRAM)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static const unsigned _counts[] = { 4, 16, 32, 64 };
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static uint16_t _order[ORDER_NUMOF];
+static uint8_t _frag[sizeof(sixlowpan_frag_n_t) + 1 + FRAG_PAYLOAD];
+
+static struct {
+    gnrc_netif_hdr_t hdr;
+    uint8_t src[8];
+    uint8_t dst[8];
+} _netif_hdr;
+
+static inline uint8_t _pattern(unsigned tag, unsigned pos)
+{
+    return (uint8_t)(tag ^ (pos * 7));
+}
+
+static void _shuffle(unsigned numof)
+{
+    for (unsigned i = 0; i < numof; i++) {
+        _order[i] = i;
+    }
+    for (unsigned i = numof - 1; i > 0; i--) {
+        unsigned j = random_uint32_range(0, i + 1);
+        uint16_t tmp = _order[i];
+
+        _order[i] = _order[j];
+        _order[j] = tmp;
+    }
+}
+
+static gnrc_pktsnip_t *_build_frag(uint16_t tag, unsigned frag)
+{
+    unsigned offset = frag * FRAG_PAYLOAD;
+    unsigned size = TEST_DATAGRAM_SIZE - offset;
+    uint8_t *data;
+    size_t hdr_size;
+
+    if (size > FRAG_PAYLOAD) {
+        size = FRAG_PAYLOAD;
+    }
+    if (frag == 0) {
+        sixlowpan_frag_t *hdr = (sixlowpan_frag_t *)_frag;
+
+        hdr->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_1_DISP;
+        hdr->tag = byteorder_htons(tag);
+        _frag[sizeof(*hdr)] = SIXLOWPAN_UNCOMP;
+        hdr_size = sizeof(*hdr) + 1;
+    }
+    else {
+        sixlowpan_frag_n_t *hdr = (sixlowpan_frag_n_t *)_frag;
+
+        hdr->disp_size = byteorder_htons(TEST_DATAGRAM_SIZE);
+        hdr->disp_size.u8[0] |= SIXLOWPAN_FRAG_N_DISP;
+        hdr->tag = byteorder_htons(tag);
+        hdr->offset = (uint8_t)(offset >> 3);
+        hdr_size = sizeof(*hdr);
+    }
+    data = &_frag[hdr_size];
+    for (unsigned i = 0; i < size; i++) {
+        data[i] = _pattern(tag, offset + i);
+    }
+    return gnrc_pktbuf_add(NULL, _frag, hdr_size + size,
+                           GNRC_NETTYPE_SIXLOWPAN);
+}
+
+static unsigned _check_datagrams(void)
+{
+    unsigned errors = 0;
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        uint16_t tag;
+
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_RCV) {
+            /* garbage collection of the reassembly buffer */
+            continue;
+        }
+        /* the first byte is the pattern at offset 0, i.e. the lower byte of
+         * the tag */
+        tag = ((uint8_t *)pkt->data)[0];
+        for (unsigned i = 0; i < pkt->size; i++) {
+            if (((uint8_t *)pkt->data)[i] != _pattern(tag, i)) {
+                errors++;
+                break;
+            }
+        }
+        if (pkt->size != TEST_DATAGRAM_SIZE) {
+            errors++;
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    return errors;
+}
+
+static void _run(unsigned numof)
+{
+    unsigned frags = numof * FRAGS_PER_DATAGRAM;
+    unsigned added = 0, complete = 0, errors = 0;
+    uint32_t start, time;
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        /* shuffling is part of the measurement, but negligible compared to
+         * the reassembly */
+        _shuffle(frags);
+        for (unsigned i = 0; i < frags; i++) {
+            unsigned dg = _order[i] % numof;
+            unsigned frag = _order[i] / numof;
+            /* tag's lower byte is used as pattern, so keep it unique per
+             * datagram */
+            uint16_t tag = (uint16_t)((round * TEST_DATAGRAMS_MAX) + dg);
+            unsigned reps = ((i % DUPLICATE_RATE) == 0) ? 2 : 1;
+
+            /* every datagram comes from another source */
+            _netif_hdr.src[7] = (uint8_t)dg;
+            _netif_hdr.src[6] = (uint8_t)(dg >> 8);
+            for (unsigned rep = 0; rep < reps; rep++) {
+                gnrc_pktsnip_t *pkt = _build_frag(tag, frag);
+                gnrc_sixlowpan_frag_rb_t *rbuf;
+                int res;
+
+                if (pkt == NULL) {
+                    errors++;
+                    continue;
+                }
+                added++;
+                rbuf = gnrc_sixlowpan_frag_rb_add(&_netif_hdr.hdr, pkt,
+                                                  frag * FRAG_PAYLOAD, 0);
+                if (rbuf == NULL) {
+                    errors++;
+                    continue;
+                }
+                res = gnrc_sixlowpan_frag_rb_dispatch_when_complete(
+                        rbuf, &_netif_hdr.hdr
+                    );
+                if (res > 0) {
+                    complete++;
+                }
+                else if (res < 0) {
+                    errors++;
+                }
+            }
+            errors += _check_datagrams();
+        }
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+
+    if (complete != (numof * TEST_ROUNDS)) {
+        errors += (numof * TEST_ROUNDS) - complete;
+    }
+    printf("{ \"datagrams\" : %u, \"fragments\" : %u, \"fragments_per_sec\" : %"
+           PRIu32 ", \"entry_size\" : %u, \"errors\" : %u }",
+           numof, added, (uint32_t)(((uint64_t)added * US_PER_SEC) / time),
+           (unsigned)sizeof(gnrc_sixlowpan_frag_rb_t), errors);
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL, thread_getpid()
+        );
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    /* auto-initialization of GNRC is disabled */
+    gnrc_pktbuf_init();
+    /* the reassembled datagrams are dispatched as IPv6 with gnrc_ipv6 and
+     * as undefined type otherwise */
+#ifdef MODULE_GNRC_IPV6
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &reg);
+#else
+    gnrc_netreg_register(GNRC_NETTYPE_UNDEF, &reg);
+#endif
+    gnrc_netif_hdr_init(&_netif_hdr.hdr, sizeof(_netif_hdr.src),
+                        sizeof(_netif_hdr.dst));
+    memset(_netif_hdr.src, 0x2a, sizeof(_netif_hdr.src));
+    memset(_netif_hdr.dst, 0x17, sizeof(_netif_hdr.dst));
+
+    printf("6LoWPAN reassembly buffer benchmark (%u byte datagrams in %u "
+           "fragments)\n", TEST_DATAGRAM_SIZE, FRAGS_PER_DATAGRAM);
+
+    random_init(TEST_SEED);
+
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_counts); i++) {
+        if (_counts[i] > TEST_DATAGRAMS_MAX) {
+            break;
+        }
+        if (i) {
+            puts(",");
+        }
+        _run(_counts[i]);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure delivery of fragmented datagrams over a multi-hop
+ *              6LoWPAN line
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "shell.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#define BENCH_PORT          (61616U)
+#define PAYLOAD_MAX         (1200U)
+#define MAIN_QUEUE_SIZE     (8U)
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _sink_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _sink_buf[PAYLOAD_MAX];
+static uint8_t _send_buf[PAYLOAD_MAX];
+
+static unsigned _received;
+static unsigned _corrupt;
+
+static inline uint8_t _pattern(unsigned seq, unsigned pos)
+{
+    return (uint8_t)(seq + pos);
+}
+
+static void *_sink(void *arg)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+
+    (void)arg;
+    local.port = BENCH_PORT;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("unable to create sink");
+        return NULL;
+    }
+    while (1) {
+        ssize_t res = sock_udp_recv(&sock, _sink_buf, sizeof(_sink_buf),
+                                    SOCK_NO_TIMEOUT, NULL);
+        unsigned seq;
+
+        if (res < 2) {
+            continue;
+        }
+        seq = _sink_buf[0];
+        for (ssize_t i = 1; i < res; i++) {
+            if (_sink_buf[i] != _pattern(seq, i)) {
+                _corrupt++;
+                res = -1;
+                break;
+            }
+        }
+        if (res > 0) {
+            _received++;
+        }
+    }
+    return NULL;
+}
+
+static int _send(int argc, char **argv)
+{
+    sock_udp_ep_t remote = { .family = AF_INET6, .port = BENCH_PORT };
+    unsigned count, size, gap_ms, errors = 0;
+
+    if (argc < 5) {
+        printf("usage: %s <addr> <count> <size> <gap in ms>\n", argv[0]);
+        return 1;
+    }
+    if (ipv6_addr_from_str((ipv6_addr_t *)&remote.addr.ipv6, argv[1]) == NULL) {
+        puts("error: unable to parse destination address");
+        return 1;
+    }
+    count = atoi(argv[2]);
+    size = atoi(argv[3]);
+    gap_ms = atoi(argv[4]);
+    if ((size < 2) || (size > PAYLOAD_MAX)) {
+        printf("error: size must be between 2 and %u\n", PAYLOAD_MAX);
+        return 1;
+    }
+    for (unsigned seq = 0; seq < count; seq++) {
+        _send_buf[0] = (uint8_t)seq;
+        for (unsigned i = 1; i < size; i++) {
+            _send_buf[i] = _pattern(seq, i);
+        }
+        if (sock_udp_send(NULL, _send_buf, size, &remote) < 0) {
+            errors++;
+        }
+        ztimer_sleep(ZTIMER_MSEC, gap_ms);
+    }
+    printf("{ \"sent\" : %u, \"size\" : %u, \"errors\" : %u }\n",
+           count - errors, size, errors);
+    return 0;
+}
+
+static int _stats(int argc, char **argv)
+{
+    printf("{ \"received\" : %u, \"corrupt\" : %u }\n", _received, _corrupt);
+    if ((argc > 1) && (strcmp(argv[1], "reset") == 0)) {
+        _received = 0;
+        _corrupt = 0;
+    }
+    return 0;
+}
+
+static const shell_command_t _commands[] = {
+    { "bench_send", "send datagrams to the sink of a node", _send },
+    { "bench_stats", "print [and reset] datagrams received by the sink", _stats },
+    { NULL, NULL, NULL }
+};
+
+int main(void)
+{
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    thread_create(_sink_stack, sizeof(_sink_stack), THREAD_PRIORITY_MAIN - 1,
+                  THREAD_CREATE_STACKTEST, _sink, NULL, "sink");
+    shell_run(_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
+    return 0;
+}
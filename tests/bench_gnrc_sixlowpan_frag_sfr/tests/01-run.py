@@ -0,0 +1,157 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+"""Runs the benchmark on a line of native instances.
+
+Every instance talks ZEP to a dispatcher in this script, which forwards each
+frame only to the direct neighbors of the sender in the line and drops it
+with a given probability. The airtime of all frames is accounted for at
+250 kbit/s. The first node sends UDP datagrams to the last node.
+"""
+
+import json
+import os
+import random
+import socket
+import struct
+import sys
+import threading
+import time
+
+import pexpect
+
+NODES = int(os.environ.get("NODES", 4))
+COUNT = int(os.environ.get("COUNT", 50))
+SIZE = int(os.environ.get("SIZE", 640))
+GAP_MS = int(os.environ.get("GAP_MS", 100))
+LOSS_RATES = [0.0, 0.05, 0.1]
+
+DISPATCHER_PORT = 17754
+NODE_PORT_BASE = 17760
+ZEP_V2_HDR_LEN = 32
+PHY_OVERHEAD = 6        # preamble, SFD, PHR
+BITRATE = 250000
+PREFIX = "2001:db8::"
+
+
+class LineDispatcher(threading.Thread):
+    def __init__(self, nodes):
+        super().__init__(daemon=True)
+        self.nodes = nodes
+        self.loss = 0.0
+        self.airtime_us = 0
+        self.frames = 0
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.bind(("127.0.0.1", DISPATCHER_PORT))
+
+    def reset(self, loss):
+        self.loss = loss
+        self.airtime_us = 0
+        self.frames = 0
+
+    def run(self):
+        while True:
+            data, (_, port) = self.sock.recvfrom(2048)
+            idx = port - NODE_PORT_BASE
+            if not (0 <= idx < self.nodes) or len(data) < ZEP_V2_HDR_LEN:
+                continue
+            frame_len = struct.unpack("B", data[ZEP_V2_HDR_LEN - 1:
+                                               ZEP_V2_HDR_LEN])[0]
+            self.frames += 1
+            self.airtime_us += ((frame_len + PHY_OVERHEAD) * 8 * 1000000 //
+                                BITRATE)
+            for neigh in (idx - 1, idx + 1):
+                if (0 <= neigh < self.nodes) and (random.random() >= self.loss):
+                    self.sock.sendto(data, ("127.0.0.1",
+                                            NODE_PORT_BASE + neigh))
+
+
+def cmd(node, line, expect=r"> "):
+    node.sendline(line)
+    node.expect_exact(line)
+    node.expect(expect)
+    return node
+
+
+def start_node(elf, idx):
+    node = pexpect.spawnu(elf, ["-z", "127.0.0.1:{},127.0.0.1:{}".format(
+        NODE_PORT_BASE + idx, DISPATCHER_PORT)], timeout=30)
+    node.sendline("")
+    node.expect(r"> ")
+    node.sendline("ifconfig")
+    node.expect(r"Iface\s+(\d+)")
+    iface = node.match.group(1)
+    node.expect(r"Long HWaddr: ([0-9A-Fa-f:]+)")
+    l2addr = node.match.group(1)
+    node.expect(r"inet6 addr: (fe80:[0-9a-f:]+)")
+    ll_addr = node.match.group(1)
+    node.expect(r"> ")
+    return {"term": node, "iface": iface, "l2addr": l2addr, "ll": ll_addr}
+
+
+def setup_line(nodes):
+    for idx, node in enumerate(nodes):
+        cmd(node["term"], "ifconfig {} add {}{:x}/128".format(
+            node["iface"], PREFIX, idx + 1))
+        if idx + 1 < len(nodes):
+            nxt = nodes[idx + 1]
+            cmd(node["term"], "nib neigh add {} {} {}".format(
+                node["iface"], nxt["ll"], nxt["l2addr"]))
+            cmd(node["term"], "nib route add {} {}/64 {}".format(
+                node["iface"], PREFIX, nxt["ll"]))
+
+
+def run_loss(nodes, dispatcher, loss):
+    src = nodes[0]["term"]
+    sink = nodes[-1]["term"]
+    cmd(sink, "bench_stats reset")
+    dispatcher.reset(loss)
+    src.sendline("bench_send {}{:x} {} {} {}".format(
+        PREFIX, len(nodes), COUNT, SIZE, GAP_MS))
+    src.expect(r"{ \"sent\" : (\d+), \"size\" : \d+, \"errors\" : (\d+) }",
+               timeout=COUNT * (GAP_MS + 1000) / 1000 + 30)
+    sent, errors = int(src.match.group(1)), int(src.match.group(2))
+    src.expect(r"> ")
+    # let recovery of the last datagram finish
+    time.sleep(3)
+    cmd(sink, "bench_stats", r"{ \"received\" : (\d+), \"corrupt\" : (\d+) }")
+    received, corrupt = int(sink.match.group(1)), int(sink.match.group(2))
+    return {
+        "loss": loss,
+        "hops": len(nodes) - 1,
+        "sent": sent,
+        "received": received,
+        "delivery_ratio": round(received / sent, 3) if sent else 0,
+        "frames": dispatcher.frames,
+        "airtime_per_datagram_us": (dispatcher.airtime_us // received
+                                    if received else None),
+        "errors": errors + corrupt,
+    }
+
+
+def main():
+    elf = os.environ["ELFFILE"]
+    dispatcher = LineDispatcher(NODES)
+    dispatcher.start()
+    nodes = [start_node(elf, i) for i in range(NODES)]
+    results = []
+    try:
+        setup_line(nodes)
+        for loss in LOSS_RATES:
+            results.append(run_loss(nodes, dispatcher, loss))
+    finally:
+        for node in nodes:
+            node["term"].terminate(force=True)
+    print(json.dumps({"result": results}, indent=1))
+    assert all(res["errors"] == 0 for res in results)
+    assert all(res["received"] > 0 for res in results)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure 6LoWPAN IPHC compression and decompression with
+ *              random IPv6 headers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "byteorder.h"
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "random.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (1000U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+#define TEST_L2ADDR         { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_MAX_PDU_SIZE   (127U)
+#define PAYLOAD_SIZE        (16U)
+#define MAIN_QUEUE_SIZE     (8U)
+
+enum {
+    PREFIX_LINK_LOCAL = 0,
+    PREFIX_CTX_0,
+    PREFIX_CTX_1,           /* requires context identifier extension */
+    PREFIX_GLOBAL,          /* not covered by a context */
+    PREFIX_NUMOF,
+};
+
+enum {
+    IID_L2 = 0,             /* derived from link-layer address */
+    IID_SHORT,              /* 0000:00ff:fe00:XXXX */
+    IID_RANDOM,
+    IID_NUMOF,
+};
+
+enum {
+    MCAST_8 = 0,            /* ff02::XX */
+    MCAST_32,               /* ffXX::00XX:XXXX */
+    MCAST_48,               /* ffXX::00XX:XXXX:XXXX */
+    MCAST_FULL,
+    MCAST_NUMOF,
+};
+
+static const uint8_t _l2addr[] = TEST_L2ADDR;
+static const ipv6_addr_t _prefixes[] = {
+    { .u8 = { 0xfe, 0x80 } },
+    { .u8 = { 0x20, 0x01, 0x0d, 0xb8 } },
+    { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 } },
+    { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0xff, 0xff } },
+};
+static const uint8_t _hop_limits[] = { 1, 64, 255 };
+
+static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
+static char _mock_netif_stack[THREAD_STACKSIZE_DEFAULT];
+static netdev_test_t _mock_dev;
+static gnrc_netif_t _netif;
+
+static ipv6_hdr_t _hdr;
+static uint8_t _payload[PAYLOAD_SIZE];
+static uint8_t _dst_l2addr[sizeof(_l2addr)];
+static uint8_t _frame[TEST_MAX_PDU_SIZE];
+static size_t _frame_len;
+
+static void _set_iid(ipv6_addr_t *addr, unsigned iid_type, const eui64_t *l2)
+{
+    switch (iid_type) {
+        case IID_L2:
+            memcpy(&addr->u64[1], l2, sizeof(addr->u64[1]));
+            break;
+        case IID_SHORT:
+            addr->u32[2] = byteorder_htonl(0x000000ff);
+            addr->u32[3] = byteorder_htonl(0xfe000000 |
+                                           (random_uint32() & 0xffff));
+            break;
+        default:
+            random_bytes(&addr->u8[8], 8);
+            break;
+    }
+}
+
+static void _set_unicast(ipv6_addr_t *addr, const eui64_t *l2)
+{
+    memcpy(addr, &_prefixes[random_uint32_range(0, PREFIX_NUMOF)], 8);
+    _set_iid(addr, random_uint32_range(0, IID_NUMOF), l2);
+}
+
+static void _set_multicast(ipv6_addr_t *addr)
+{
+    memset(addr, 0, sizeof(*addr));
+    addr->u8[0] = 0xff;
+    switch (random_uint32_range(0, MCAST_NUMOF)) {
+        case MCAST_8:
+            addr->u8[1] = 0x02;
+            addr->u8[15] = (uint8_t)random_uint32();
+            break;
+        case MCAST_32:
+            addr->u8[1] = (uint8_t)random_uint32();
+            random_bytes(&addr->u8[13], 3);
+            break;
+        case MCAST_48:
+            addr->u8[1] = (uint8_t)random_uint32();
+            random_bytes(&addr->u8[11], 5);
+            break;
+        default:
+            random_bytes(&addr->u8[1], 15);
+            /* no valid prefix length, so unicast-prefix-based compression
+             * (RFC 3306) does not apply */
+            addr->u8[3] = 0xff;
+            break;
+    }
+}
+
+static void _build_hdr(const eui64_t *src_iid, const eui64_t *dst_iid)
+{
+    uint32_t rnd = random_uint32();
+
+    memset(&_hdr, 0, sizeof(_hdr));
+    ipv6_hdr_set_version(&_hdr);
+    ipv6_hdr_set_tc(&_hdr, (rnd & 0x1) ? (uint8_t)(rnd >> 24) : 0);
+    /* the last byte of the flow label is not carried inline by the
+     * compressor, so keep it zero to be able to compare the headers */
+    ipv6_hdr_set_fl(&_hdr, (rnd & 0x2) ? (random_uint32() & 0xfff00) : 0);
+    _hdr.len = byteorder_htons(PAYLOAD_SIZE);
+    _hdr.nh = PROTNUM_ICMPV6;
+    _hdr.hl = ((rnd & 0xc) == 0xc) ? (uint8_t)(rnd >> 16)
+                                   : _hop_limits[(rnd >> 2) & 0x3];
+    if ((rnd & 0xf0) == 0) {
+        ipv6_addr_set_unspecified(&_hdr.src);
+    }
+    else {
+        _set_unicast(&_hdr.src, src_iid);
+    }
+    if (rnd & 0x100) {
+        _set_multicast(&_hdr.dst);
+    }
+    else {
+        _set_unicast(&_hdr.dst, dst_iid);
+    }
+    random_bytes(_payload, sizeof(_payload));
+}
+
+static gnrc_pktsnip_t *_netif_hdr_build(const uint8_t *src, uint8_t src_len)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(src, src_len, _dst_l2addr,
+                                                 sizeof(_dst_l2addr));
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    }
+    return netif;
+}
+
+static int _encode(void)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, _payload, sizeof(_payload),
+                          GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return -1;
+    }
+    pkt = gnrc_pktbuf_add(pkt, &_hdr, sizeof(_hdr), GNRC_NETTYPE_IPV6);
+    if (pkt == NULL) {
+        return -1;
+    }
+    if ((netif = _netif_hdr_build(NULL, 0)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    netif->next = pkt;
+    _frame_len = 0;
+    /* the frame is captured by _send() */
+    gnrc_sixlowpan_iphc_send(netif, NULL, 0);
+    return (_frame_len > 0) ? 0 : -1;
+}
+
+static int _decode(void)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr_build(_netif.l2addr,
+                                             _netif.l2addr_len);
+    gnrc_pktsnip_t *sixlo;
+
+    if (netif == NULL) {
+        return -1;
+    }
+    sixlo = gnrc_pktbuf_add(netif, _frame, _frame_len,
+                            GNRC_NETTYPE_SIXLOWPAN);
+    if (sixlo == NULL) {
+        gnrc_pktbuf_release(netif);
+        return -1;
+    }
+    /* the decoded packet is dispatched to this thread */
+    gnrc_sixlowpan_iphc_recv(sixlo, NULL, 0);
+    return 0;
+}
+
+static unsigned _check_decoded(void)
+{
+    unsigned errors = 0, received = 0;
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+
+        if (msg.type == GNRC_NETAPI_MSG_TYPE_RCV) {
+            received++;
+            if ((pkt->size != (sizeof(_hdr) + sizeof(_payload))) ||
+                (memcmp(pkt->data, &_hdr, sizeof(_hdr)) != 0) ||
+                (memcmp((uint8_t *)pkt->data + sizeof(_hdr), _payload,
+                        sizeof(_payload)) != 0)) {
+                errors++;
+            }
+        }
+        /* drop anything the NIB might try to send */
+        gnrc_pktbuf_release(pkt);
+    }
+    return errors + ((received == 1) ? 0 : 1);
+}
+
+static void _run(void)
+{
+    unsigned errors = 0, hdr_len = 0;
+    uint32_t encode_time = 0, decode_time = 0;
+    eui64_t src_iid, dst_iid;
+    gnrc_pktsnip_t *dst_netif;
+
+    random_bytes(_dst_l2addr, sizeof(_dst_l2addr));
+    gnrc_netif_ipv6_get_iid(&_netif, &src_iid);
+    dst_netif = _netif_hdr_build(NULL, 0);
+    expect(dst_netif != NULL);
+    gnrc_netif_hdr_ipv6_iid_from_dst(&_netif, dst_netif->data, &dst_iid);
+    gnrc_pktbuf_release(dst_netif);
+
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        uint32_t start;
+
+        _build_hdr(&src_iid, &dst_iid);
+        start = ztimer_now(ZTIMER_USEC);
+        if (_encode() < 0) {
+            errors++;
+            continue;
+        }
+        encode_time += ztimer_now(ZTIMER_USEC) - start;
+        /* everything but the payload is the compressed header */
+        hdr_len += _frame_len - sizeof(_payload);
+        start = ztimer_now(ZTIMER_USEC);
+        if (_decode() < 0) {
+            errors++;
+            continue;
+        }
+        decode_time += ztimer_now(ZTIMER_USEC) - start;
+        errors += _check_decoded();
+    }
+    if (encode_time == 0) {
+        encode_time = 1;
+    }
+    if (decode_time == 0) {
+        decode_time = 1;
+    }
+    printf("{ \"headers\" : %u, \"encoded_per_sec\" : %" PRIu32
+           ", \"decoded_per_sec\" : %" PRIu32 ", \"round_trips_per_sec\" : %"
+           PRIu32 ", \"avg_hdr_len\" : %u, \"errors\" : %u }",
+           TEST_ROUNDS,
+           (uint32_t)(((uint64_t)TEST_ROUNDS * US_PER_SEC) / encode_time),
+           (uint32_t)(((uint64_t)TEST_ROUNDS * US_PER_SEC) / decode_time),
+           (uint32_t)(((uint64_t)TEST_ROUNDS * US_PER_SEC) /
+                      (encode_time + decode_time)),
+           hdr_len / TEST_ROUNDS, errors);
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    (void)dev;
+    /* skip the MAC header */
+    for (iolist = iolist->iol_next; iolist != NULL; iolist = iolist->iol_next) {
+        if ((_frame_len + iolist->iol_len) > sizeof(_frame)) {
+            _frame_len = 0;
+            return -ENOBUFS;
+        }
+        memcpy(&_frame[_frame_len], iolist->iol_base, iolist->iol_len);
+        _frame_len += iolist->iol_len;
+    }
+    return _frame_len;
+}
+
+static int _get_netdev_device_type(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = NETDEV_TYPE_IEEE802154;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_proto(netdev_t *netdev, void *value, size_t max_len)
+{
+    expect(max_len == sizeof(gnrc_nettype_t));
+    (void)netdev;
+
+    *((gnrc_nettype_t *)value) = GNRC_NETTYPE_SIXLOWPAN;
+    return sizeof(gnrc_nettype_t);
+}
+
+static int _get_netdev_max_pdu_size(netdev_t *netdev, void *value,
+                                    size_t max_len)
+{
+    expect(max_len == sizeof(uint16_t));
+    (void)netdev;
+
+    *((uint16_t *)value) = TEST_MAX_PDU_SIZE;
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_src_len(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = sizeof(_l2addr);
+    return sizeof(uint16_t);
+}
+
+static int _get_netdev_addr_long(netdev_t *netdev, void *value, size_t max_len)
+{
+    (void)netdev;
+    expect(max_len >= sizeof(_l2addr));
+    memcpy(value, _l2addr, sizeof(_l2addr));
+    return sizeof(_l2addr);
+}
+
+static void _init_mock_netif(void)
+{
+    netdev_test_setup(&_mock_dev, NULL);
+    netdev_test_set_send_cb(&_mock_dev, _send);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_DEVICE_TYPE,
+                           _get_netdev_device_type);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_PROTO,
+                           _get_netdev_proto);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_MAX_PDU_SIZE,
+                           _get_netdev_max_pdu_size);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_SRC_LEN,
+                           _get_netdev_src_len);
+    netdev_test_set_get_cb(&_mock_dev, NETOPT_ADDRESS_LONG,
+                           _get_netdev_addr_long);
+    gnrc_netif_ieee802154_create(&_netif, _mock_netif_stack,
+                                 THREAD_STACKSIZE_DEFAULT, GNRC_NETIF_PRIO,
+                                 "mock_netif", (netdev_t *)&_mock_dev);
+    thread_yield_higher();
+}
+
+int main(void)
+{
+    gnrc_netreg_entry_t reg = GNRC_NETREG_ENTRY_INIT_PID(
+            GNRC_NETREG_DEMUX_CTX_ALL, thread_getpid()
+        );
+
+    msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &reg);
+    _init_mock_netif();
+    gnrc_sixlowpan_ctx_update(0, &_prefixes[PREFIX_CTX_0], 64, UINT16_MAX,
+                              true);
+    gnrc_sixlowpan_ctx_update(1, &_prefixes[PREFIX_CTX_1], 64, UINT16_MAX,
+                              true);
+
+    printf("6LoWPAN IPHC benchmark (%u byte payload)\n", PAYLOAD_SIZE);
+
+    random_init(TEST_SEED);
+
+    puts("{ \"result\" : [");
+    _run();
+    puts("\n] }");
+
+    return 0;
+}
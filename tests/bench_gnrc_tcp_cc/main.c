@@ -0,0 +1,456 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the goodput of TCP congestion control algorithms over
+ *              an emulated link with loss and delay
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/af.h"
+#include "net/ethernet.h"
+#include "net/ethertype.h"
+#include "net/gnrc.h"
+#include "net/gnrc/ipv6/nib.h"
+#include "net/gnrc/netif/ethernet.h"
+#include "net/gnrc/tcp.h"
+#include "net/inet_csum.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev_test.h"
+#include "net/protnum.h"
+#include "net/tcp.h"
+#include "random.h"
+#include "test_utils/expect.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_BYTES
+#define TEST_BYTES          (128U * 1024U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+/* link rate in bit/s */
+#ifndef LINK_RATE
+#define LINK_RATE           (2000000U)
+#endif
+
+/* one-way delay of the link in us */
+#ifndef LINK_DELAY
+#define LINK_DELAY          (20U * US_PER_MS)
+#endif
+
+/* length of the drop-tail queue in front of the link in frames */
+#ifndef LINK_QUEUE
+#define LINK_QUEUE          (12U)
+#endif
+
+#define PORT                (24911U)
+#define SERVER_EP           "[::]:24911"
+#define RECV_TIMEOUT        (10U * US_PER_SEC)
+#define CHUNK_MAX           (1220U)
+#define FRAME_MAX           (sizeof(ethernet_hdr_t) + ETHERNET_DATA_LEN)
+#define LINK_MSG_QUEUE_SIZE (4U)
+
+/**
+ * @brief   A frame on the emulated link
+ */
+typedef struct {
+    uint32_t due;               /**< time of delivery */
+    uint16_t len;               /**< length of the frame */
+    uint8_t data[FRAME_MAX];    /**< the frame */
+} frame_t;
+
+static const unsigned _losses[] = { 0, 10, 30 };
+
+static const struct {
+    const char *name;
+    const gnrc_tcp_cc_t *cc;
+} _ccs[] = {
+    { "newreno", &gnrc_tcp_cc_newreno },
+#ifdef MODULE_GNRC_TCP_CC_CUBIC
+    { "cubic", &gnrc_tcp_cc_cubic },
+#endif
+};
+
+/* the client connects to the peer _addrs[1], the reflector on the link
+ * forwards its segments to the server as if they came from _addrs[2] and
+ * the answers back to the client as if they came from _addrs[1] */
+static const ipv6_addr_t _addrs[] = {
+    { .u8 = { 0xfe, 0x80, [15] = 0x01 } },
+    { .u8 = { 0xfe, 0x80, [15] = 0x02 } },
+    { .u8 = { 0xfe, 0x80, [15] = 0x03 } },
+};
+static const uint8_t _l2addrs[][ETHERNET_ADDR_LEN] = {
+    { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x26 },
+    { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x27 },
+    { 0xce, 0xab, 0xfe, 0xad, 0xf7, 0x28 },
+};
+
+static gnrc_netif_t _netif;
+static netdev_test_t _netdev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char _link_stack[THREAD_STACKSIZE_DEFAULT];
+static char _server_stack[THREAD_STACKSIZE_DEFAULT + CHUNK_MAX];
+static msg_t _link_msg_queue[LINK_MSG_QUEUE_SIZE];
+static kernel_pid_t _link_pid;
+static kernel_pid_t _main_pid;
+
+static gnrc_tcp_tcb_t _server_tcb;
+static gnrc_tcp_tcb_t _client_tcb;
+static uint8_t _send_buf[CHUNK_MAX];
+
+/* frames in the link queue, the first _ready of them are delivered */
+static frame_t _frames[LINK_QUEUE];
+static unsigned _head;
+static unsigned _num;
+static unsigned _ready;
+static uint32_t _link_free;
+static unsigned _loss;
+static unsigned _drops;
+
+static inline uint8_t _pattern(uint32_t pos)
+{
+    return (uint8_t)(pos * 7);
+}
+
+static int _get_device_type(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = NETDEV_TYPE_ETHERNET;
+    return sizeof(uint16_t);
+}
+
+static int _get_max_packet_size(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len == sizeof(uint16_t));
+    *((uint16_t *)value) = ETHERNET_DATA_LEN;
+    return sizeof(uint16_t);
+}
+
+static int _get_address(netdev_t *dev, void *value, size_t max_len)
+{
+    (void)dev;
+    expect(max_len >= sizeof(_l2addrs[0]));
+    memcpy(value, _l2addrs[0], sizeof(_l2addrs[0]));
+    return sizeof(_l2addrs[0]);
+}
+
+/* turns a TCP segment sent to one of the peers into the segment the peer
+ * would forward back to us, returns false for all other frames */
+static bool _reflect(uint8_t *data, size_t len)
+{
+    ethernet_hdr_t *eth = (ethernet_hdr_t *)data;
+    ipv6_hdr_t *ipv6 = (ipv6_hdr_t *)(eth + 1);
+    tcp_hdr_t *tcp = (tcp_hdr_t *)(ipv6 + 1);
+    uint8_t tmp[ETHERNET_ADDR_LEN];
+    uint16_t tcp_len, sum;
+
+    if ((len < (sizeof(*eth) + sizeof(*ipv6) + sizeof(*tcp))) ||
+        (byteorder_ntohs(eth->type) != ETHERTYPE_IPV6) ||
+        (ipv6->nh != PROTNUM_TCP)) {
+        return false;
+    }
+    tcp_len = byteorder_ntohs(ipv6->len);
+    if (ipv6_addr_equal(&ipv6->dst, &_addrs[1])) {
+        ipv6->dst = ipv6->src;
+        ipv6->src = _addrs[2];
+    }
+    else if (ipv6_addr_equal(&ipv6->dst, &_addrs[2])) {
+        ipv6->dst = ipv6->src;
+        ipv6->src = _addrs[1];
+    }
+    else {
+        return false;
+    }
+    memcpy(tmp, eth->dst, sizeof(tmp));
+    memcpy(eth->dst, eth->src, sizeof(eth->dst));
+    memcpy(eth->src, tmp, sizeof(eth->src));
+
+    tcp->checksum = byteorder_htons(0);
+    sum = ipv6_hdr_inet_csum(0, ipv6, PROTNUM_TCP, tcp_len);
+    sum = inet_csum(sum, (uint8_t *)tcp, tcp_len);
+    tcp->checksum = byteorder_htons(~sum);
+    return true;
+}
+
+static int _send(netdev_t *dev, const iolist_t *iolist)
+{
+    frame_t *frame;
+    msg_t msg;
+    uint32_t now, start;
+    unsigned state, len = 0;
+
+    (void)dev;
+    state = irq_disable();
+    if (_num == LINK_QUEUE) {
+        /* tail drop */
+        _drops++;
+        irq_restore(state);
+        return iolist_size(iolist);
+    }
+    frame = &_frames[(_head + _num) % LINK_QUEUE];
+    irq_restore(state);
+
+    for (; iolist; iolist = iolist->iol_next) {
+        if ((len + iolist->iol_len) > sizeof(frame->data)) {
+            return -EMSGSIZE;
+        }
+        memcpy(&frame->data[len], iolist->iol_base, iolist->iol_len);
+        len += iolist->iol_len;
+    }
+    if (!_reflect(frame->data, len)) {
+        return len;
+    }
+    if (random_uint32_range(0, 1000) < _loss) {
+        _drops++;
+        return len;
+    }
+
+    /* serialize the frame after the ones already queued, then delay it */
+    now = ztimer_now(ZTIMER_USEC);
+    start = ((int32_t)(_link_free - now) > 0) ? _link_free : now;
+    _link_free = start + (uint32_t)(((uint64_t)len * 8 * US_PER_SEC) /
+                                    LINK_RATE);
+    frame->due = _link_free + LINK_DELAY;
+    frame->len = len;
+
+    state = irq_disable();
+    _num++;
+    irq_restore(state);
+    /* wakes the link up if it was idle */
+    msg_try_send(&msg, _link_pid);
+    return len;
+}
+
+static int _recv(netdev_t *dev, char *buf, int len, void *info)
+{
+    frame_t *frame = &_frames[_head];
+    unsigned state;
+    int res = frame->len;
+
+    (void)dev;
+    (void)info;
+    if (_ready == 0) {
+        return -ENOBUFS;
+    }
+    if ((buf == NULL) && (len == 0)) {
+        return res;
+    }
+    if (buf != NULL) {
+        if (len < res) {
+            res = -ENOBUFS;
+        }
+        else {
+            memcpy(buf, frame->data, res);
+        }
+    }
+    state = irq_disable();
+    _head = (_head + 1) % LINK_QUEUE;
+    _num--;
+    _ready--;
+    irq_restore(state);
+    return res;
+}
+
+static void _isr(netdev_t *dev)
+{
+    dev->event_callback(dev, NETDEV_EVENT_RX_COMPLETE);
+}
+
+/* runs with a higher priority than the interface and signals each frame to
+ * it when the frame is due */
+static void *_link(void *arg)
+{
+    (void)arg;
+    msg_init_queue(_link_msg_queue, LINK_MSG_QUEUE_SIZE);
+    while (1) {
+        unsigned state = irq_disable();
+        uint32_t due, now;
+
+        if (_ready == _num) {
+            msg_t msg;
+
+            irq_restore(state);
+            msg_receive(&msg);
+            continue;
+        }
+        due = _frames[(_head + _ready) % LINK_QUEUE].due;
+        irq_restore(state);
+        now = ztimer_now(ZTIMER_USEC);
+        if ((int32_t)(due - now) > 0) {
+            ztimer_sleep(ZTIMER_USEC, due - now);
+        }
+        state = irq_disable();
+        _ready++;
+        irq_restore(state);
+        netdev_trigger_event_isr(&_netdev.netdev);
+    }
+    return NULL;
+}
+
+static void _init_netif(void)
+{
+    netdev_test_setup(&_netdev, 0);
+    netdev_test_set_get_cb(&_netdev, NETOPT_DEVICE_TYPE, _get_device_type);
+    netdev_test_set_get_cb(&_netdev, NETOPT_MAX_PDU_SIZE,
+                           _get_max_packet_size);
+    netdev_test_set_get_cb(&_netdev, NETOPT_ADDRESS, _get_address);
+    netdev_test_set_send_cb(&_netdev, _send);
+    netdev_test_set_recv_cb(&_netdev, _recv);
+    netdev_test_set_isr_cb(&_netdev, _isr);
+    expect(gnrc_netif_ethernet_create(&_netif, _netif_stack,
+                                      sizeof(_netif_stack), GNRC_NETIF_PRIO,
+                                      "mock_eth", &_netdev.netdev) == 0);
+    expect(gnrc_netif_ipv6_addr_add(&_netif, (ipv6_addr_t *)&_addrs[0], 64,
+                                    GNRC_NETIF_IPV6_ADDRS_FLAGS_STATE_VALID) >= 0);
+    for (unsigned i = 1; i < ARRAY_SIZE(_addrs); i++) {
+        expect(gnrc_ipv6_nib_nc_set(&_addrs[i], _netif.pid, _l2addrs[i],
+                                    sizeof(_l2addrs[i])) == 0);
+    }
+}
+
+/* accepts one connection per run and reports the number of bytes received
+ * correctly to the main thread */
+static void *_server(void *arg)
+{
+    uint8_t buf[CHUNK_MAX];
+    gnrc_tcp_ep_t local;
+
+    (void)arg;
+    gnrc_tcp_ep_from_str(&local, SERVER_EP);
+    while (1) {
+        msg_t msg = { .content = { .value = 0 } };
+
+        gnrc_tcp_tcb_init(&_server_tcb);
+        if (gnrc_tcp_open_passive(&_server_tcb, &local) < 0) {
+            msg_send(&msg, _main_pid);
+            continue;
+        }
+        while (msg.content.value < TEST_BYTES) {
+            ssize_t res = gnrc_tcp_recv(&_server_tcb, buf, sizeof(buf),
+                                        RECV_TIMEOUT);
+
+            if (res <= 0) {
+                break;
+            }
+            for (ssize_t i = 0; i < res; i++) {
+                if (buf[i] != _pattern(msg.content.value + i)) {
+                    res = i;
+                    break;
+                }
+            }
+            msg.content.value += res;
+        }
+        msg_send(&msg, _main_pid);
+        while (gnrc_tcp_recv(&_server_tcb, buf, sizeof(buf), RECV_TIMEOUT) > 0) {}
+        gnrc_tcp_close(&_server_tcb);
+    }
+    return NULL;
+}
+
+static void _run(unsigned cc, unsigned loss)
+{
+    unsigned errors = 0;
+    uint32_t sent = 0;
+    uint32_t start, time;
+    gnrc_tcp_ep_t remote;
+    msg_t msg;
+
+    _loss = loss;
+    _drops = 0;
+    gnrc_tcp_ep_init(&remote, AF_INET6, _addrs[1].u8, sizeof(_addrs[1]),
+                     PORT, _netif.pid);
+    gnrc_tcp_tcb_init(&_client_tcb);
+    gnrc_tcp_set_cc(&_client_tcb, _ccs[cc].cc);
+    if (gnrc_tcp_open_active(&_client_tcb, &remote, 0) < 0) {
+        printf("{ \"cc\" : \"%s\", \"loss_permille\" : %u, \"errors\" : 1 }",
+               _ccs[cc].name, loss);
+        return;
+    }
+
+    start = ztimer_now(ZTIMER_USEC);
+    while (sent < TEST_BYTES) {
+        unsigned len = ((TEST_BYTES - sent) < CHUNK_MAX) ? (TEST_BYTES - sent)
+                                                         : CHUNK_MAX;
+        ssize_t res;
+
+        for (unsigned i = 0; i < len; i++) {
+            _send_buf[i] = _pattern(sent + i);
+        }
+        res = gnrc_tcp_send(&_client_tcb, _send_buf, len, 0);
+        if (res <= 0) {
+            errors++;
+            break;
+        }
+        sent += res;
+    }
+    msg_receive(&msg);
+    time = ztimer_now(ZTIMER_USEC) - start;
+    if (msg.content.value != TEST_BYTES) {
+        errors++;
+    }
+    gnrc_tcp_close(&_client_tcb);
+
+    printf("{ \"cc\" : \"%s\", \"loss_permille\" : %u, \"bytes\" : %u, "
+           "\"time_us\" : %" PRIu32 ", \"goodput_bps\" : %" PRIu32
+           ", \"drops\" : %u, \"errors\" : %u }",
+           _ccs[cc].name, loss, TEST_BYTES, time,
+           (uint32_t)(((uint64_t)msg.content.value * 8 * US_PER_SEC) / time),
+           _drops, errors);
+}
+
+int main(void)
+{
+    printf("GNRC TCP congestion control benchmark (%u bit/s, %u us delay, "
+           "%u segments in flight)\n", LINK_RATE, LINK_DELAY,
+           GNRC_TCP_SND_SEGMENTS);
+
+    random_init(TEST_SEED);
+    _main_pid = thread_getpid();
+    _link_pid = thread_create(_link_stack, sizeof(_link_stack),
+                              GNRC_NETIF_PRIO - 1, THREAD_CREATE_STACKTEST,
+                              _link, NULL, "link");
+    _init_netif();
+    /* higher priority than main, so the server listens before the client
+     * connects */
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _server, NULL, "server");
+
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_ccs); i++) {
+        for (unsigned j = 0; j < ARRAY_SIZE(_losses); j++) {
+            if (i || j) {
+                puts(",");
+            }
+            _run(i, _losses[j]);
+        }
+    }
+    puts("\n] }");
+
+    return 0;
+}
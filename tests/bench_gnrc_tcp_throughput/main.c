@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of a TCP connection over loopback
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "msg.h"
+#include "net/gnrc/tcp.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_BYTES
+#define TEST_BYTES          (64U * 1024U)
+#endif
+
+#define SERVER_EP           "[::]:24911"
+#define CLIENT_EP           "[::1]:24911"
+#define RECV_TIMEOUT        (2U * US_PER_SEC)
+#define CHUNK_MAX           (1220U)
+
+static const unsigned _chunks[] = { 64, 512, CHUNK_MAX };
+
+static gnrc_tcp_tcb_t _server_tcb;
+static gnrc_tcp_tcb_t _client_tcb;
+static char _server_stack[THREAD_STACKSIZE_DEFAULT + CHUNK_MAX];
+static uint8_t _send_buf[CHUNK_MAX];
+static kernel_pid_t _main_pid;
+
+static inline uint8_t _pattern(uint32_t pos)
+{
+    return (uint8_t)(pos * 7);
+}
+
+/* accepts one connection per run and reports the number of bytes received
+ * correctly to the main thread, the client closes the connection first so
+ * the server is listening again when the next run starts */
+static void *_server(void *arg)
+{
+    uint8_t buf[CHUNK_MAX];
+    gnrc_tcp_ep_t local;
+
+    (void)arg;
+    gnrc_tcp_ep_from_str(&local, SERVER_EP);
+    while (1) {
+        msg_t msg = { .content = { .value = 0 } };
+
+        gnrc_tcp_tcb_init(&_server_tcb);
+        if (gnrc_tcp_open_passive(&_server_tcb, &local) < 0) {
+            msg_send(&msg, _main_pid);
+            continue;
+        }
+        while (msg.content.value < TEST_BYTES) {
+            ssize_t res = gnrc_tcp_recv(&_server_tcb, buf, sizeof(buf),
+                                        RECV_TIMEOUT);
+
+            if (res <= 0) {
+                break;
+            }
+            for (ssize_t i = 0; i < res; i++) {
+                if (buf[i] != _pattern(msg.content.value + i)) {
+                    res = i;
+                    break;
+                }
+            }
+            msg.content.value += res;
+        }
+        msg_send(&msg, _main_pid);
+        while (gnrc_tcp_recv(&_server_tcb, buf, sizeof(buf), RECV_TIMEOUT) > 0) {}
+        gnrc_tcp_close(&_server_tcb);
+    }
+    return NULL;
+}
+
+static void _run(unsigned chunk)
+{
+    unsigned errors = 0;
+    uint32_t sent = 0;
+    uint32_t start, time;
+    gnrc_tcp_ep_t remote;
+    msg_t msg;
+
+    gnrc_tcp_ep_from_str(&remote, CLIENT_EP);
+    gnrc_tcp_tcb_init(&_client_tcb);
+    if (gnrc_tcp_open_active(&_client_tcb, &remote, 0) < 0) {
+        printf("{ \"chunk\" : %u, \"errors\" : 1 }", chunk);
+        return;
+    }
+
+    start = ztimer_now(ZTIMER_USEC);
+    while (sent < TEST_BYTES) {
+        unsigned len = ((TEST_BYTES - sent) < chunk) ? (TEST_BYTES - sent)
+                                                      : chunk;
+        ssize_t res;
+
+        for (unsigned i = 0; i < len; i++) {
+            _send_buf[i] = _pattern(sent + i);
+        }
+        res = gnrc_tcp_send(&_client_tcb, _send_buf, len, 0);
+        if (res <= 0) {
+            errors++;
+            break;
+        }
+        /* data not taken by gnrc_tcp_send() is refilled with the next call */
+        sent += res;
+    }
+    msg_receive(&msg);
+    time = ztimer_now(ZTIMER_USEC) - start;
+    if (msg.content.value != TEST_BYTES) {
+        errors++;
+    }
+    gnrc_tcp_close(&_client_tcb);
+
+    printf("{ \"chunk\" : %u, \"bytes\" : %u, \"time_us\" : %" PRIu32
+           ", \"bytes_per_sec\" : %" PRIu32 ", \"errors\" : %u }",
+           chunk, TEST_BYTES, time,
+           (uint32_t)(((uint64_t)msg.content.value * US_PER_SEC) / time),
+           errors);
+}
+
+int main(void)
+{
+    printf("GNRC TCP throughput benchmark (%u segments in flight)\n",
+           GNRC_TCP_SND_SEGMENTS);
+
+    _main_pid = thread_getpid();
+    /* higher priority than main, so the server listens before the client
+     * connects */
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _server, NULL, "server");
+
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_chunks); i++) {
+        if (i) {
+            puts(",");
+        }
+        _run(_chunks[i]);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the Internet checksum throughput by packet size
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/inet_csum.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (1000U)
+#endif
+
+#define BUF_SIZE            (1280U)
+
+static const uint16_t _sizes[] = { 8, 20, 40, 64, 128, 256, 512, 1024, 1280 };
+
+/* one more word for the unaligned buffer */
+static uint32_t _buf[(BUF_SIZE / sizeof(uint32_t)) + 1];
+
+/* byte-wise reference implementation */
+static uint16_t _csum_ref(uint16_t sum, const uint8_t *buf, uint16_t len)
+{
+    uint32_t csum = sum;
+
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if (len & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static uint32_t _bytes_per_sec(uint16_t size, uint32_t time)
+{
+    if (time == 0) {
+        time = 1;
+    }
+    return (uint32_t)(((uint64_t)size * TEST_ROUNDS * US_PER_SEC) / time);
+}
+
+static void _run(uint16_t size, bool aligned)
+{
+    const uint8_t *buf = (uint8_t *)_buf + (aligned ? 0 : 1);
+    uint32_t start, time, ref_time;
+    unsigned errors = 0;
+    /* keep the compiler from optimizing the checksums out */
+    volatile uint16_t res = 0, ref = 0;
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        res = inet_csum(i, buf, size);
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        ref = _csum_ref(i, buf, size);
+    }
+    ref_time = ztimer_now(ZTIMER_USEC) - start;
+    if (res != ref) {
+        errors++;
+    }
+    printf("{ \"size\" : %u, \"aligned\" : %u, \"bytes_per_sec\" : %" PRIu32
+           ", \"ref_bytes_per_sec\" : %" PRIu32 ", \"errors\" : %u }",
+           size, aligned, _bytes_per_sec(size, time),
+           _bytes_per_sec(size, ref_time), errors);
+}
+
+int main(void)
+{
+    uint8_t *buf = (uint8_t *)_buf;
+
+    for (unsigned i = 0; i < sizeof(_buf); i++) {
+        /* mostly high bytes to provoke many carries */
+        buf[i] = (uint8_t)(0xff - (i * 7));
+    }
+
+    printf("Internet checksum benchmark (%u rounds)\n", TEST_ROUNDS);
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_sizes); i++) {
+        if (i) {
+            puts(",");
+        }
+        _run(_sizes[i], true);
+        puts(",");
+        _run(_sizes[i], false);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import re
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"result\" : \[")
+    child.expect(r"\] }", timeout=120)
+    assert re.search(r"\"errors\" : [1-9]", child.before) is None
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include "thread.h"
 
+#include "kernel_defines.h"
 #include "msg.h"
 #include "xtimer.h"
 
@@ -28,9 +29,33 @@
 #define TEST_DURATION       (1000000U)
 #endif
 
+#ifndef TEST_PRODUCERS
+#define TEST_PRODUCERS      (3U)
+#endif
+
+#ifndef TEST_QUEUE_LEN
+#define TEST_QUEUE_LEN      (8U)
+#endif
+
+#ifndef TEST_LATENCY_PERIOD
+#define TEST_LATENCY_PERIOD (1000U)
+#endif
+
 volatile unsigned _flag = 0;
 static char _stack[THREAD_STACKSIZE_MAIN];
 
+static char _consumer_stack[THREAD_STACKSIZE_DEFAULT];
+static char _producer_stacks[TEST_PRODUCERS][THREAD_STACKSIZE_DEFAULT];
+static msg_t _queue[TEST_QUEUE_LEN];
+static kernel_pid_t _consumer;
+static volatile uint32_t _received;
+
+static xtimer_t _latency_timer;
+static uint32_t _latency_target;
+static uint32_t _latency_max;
+static uint32_t _latency_sum;
+static uint32_t _latency_numof;
+
 static void _timer_callback(void*arg)
 {
     (void)arg;
@@ -50,6 +75,95 @@ static void *_second_thread(void *arg)
     return NULL;
 }
 
+static void *_consumer_thread(void *arg)
+{
+    (void)arg;
+    msg_t test;
+
+#ifdef MODULE_CORE_MSG_MPSC
+    msg_init_queue_mpsc(_queue, TEST_QUEUE_LEN);
+#else
+    msg_init_queue(_queue, TEST_QUEUE_LEN);
+#endif
+
+    while(1) {
+        msg_receive(&test);
+        _received++;
+    }
+
+    return NULL;
+}
+
+static void *_producer_thread(void *arg)
+{
+    (void)arg;
+    msg_t test;
+
+    while(!_flag) {
+        msg_send(&test, _consumer);
+        /* interleave with the other producers */
+        thread_yield();
+    }
+
+    return NULL;
+}
+
+static void _latency_callback(void *arg)
+{
+    (void)arg;
+
+    /* any time spent with interrupts disabled delays this callback */
+    uint32_t now = xtimer_now_usec();
+    uint32_t latency = now - _latency_target;
+
+    if (latency > _latency_max) {
+        _latency_max = latency;
+    }
+    _latency_sum += latency;
+    _latency_numof++;
+
+    if (!_flag) {
+        _latency_target = now + TEST_LATENCY_PERIOD;
+        xtimer_set(&_latency_timer, TEST_LATENCY_PERIOD);
+    }
+}
+
+static void _bench_producers(void)
+{
+    _flag = 0;
+    _consumer = thread_create(_consumer_stack,
+                              sizeof(_consumer_stack),
+                              (THREAD_PRIORITY_MAIN + 2),
+                              THREAD_CREATE_STACKTEST,
+                              _consumer_thread,
+                              NULL,
+                              "consumer");
+
+    for (unsigned i = 0; i < TEST_PRODUCERS; i++) {
+        thread_create(_producer_stacks[i],
+                      sizeof(_producer_stacks[i]),
+                      (THREAD_PRIORITY_MAIN + 1),
+                      THREAD_CREATE_STACKTEST,
+                      _producer_thread,
+                      NULL,
+                      "producer");
+    }
+
+    _latency_timer.callback = _latency_callback;
+    _latency_target = xtimer_now_usec() + TEST_LATENCY_PERIOD;
+    xtimer_set(&_latency_timer, TEST_LATENCY_PERIOD);
+
+    xtimer_usleep(TEST_DURATION);
+    _flag = 1;
+    xtimer_remove(&_latency_timer);
+
+    printf("{ \"producers\" : %u, \"mpsc\" : %u, \"result\" : %"PRIu32
+           ", \"irq_latency_max\" : %"PRIu32
+           ", \"irq_latency_avg\" : %"PRIu32" }\n",
+           TEST_PRODUCERS, IS_USED(MODULE_CORE_MSG_MPSC), _received,
+           _latency_max, _latency_numof ? _latency_sum / _latency_numof : 0);
+}
+
 int main(void)
 {
     printf("main starting\n");
@@ -77,5 +191,7 @@ int main(void)
 
     printf("{ \"result\" : %"PRIu32" }\n", n);
 
+    _bench_producers();
+
     return 0;
 }
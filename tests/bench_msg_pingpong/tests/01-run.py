@@ -13,6 +13,8 @@ from testrunner import run
 
 def testfunc(child):
     child.expect(r"{ \"result\" : \d+ }")
+    child.expect(r"{ \"producers\" : \d+, \"mpsc\" : [01], \"result\" : \d+, "
+                 r"\"irq_latency_max\" : \d+, \"irq_latency_avg\" : \d+ }")
 
 
 if __name__ == "__main__":
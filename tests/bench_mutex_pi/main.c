@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Mutex priority inversion latency benchmark
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "mutex.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (20U)
+#endif
+
+#ifndef TEST_CS_US
+#define TEST_CS_US          (2000U)
+#endif
+
+#ifndef TEST_HOG_US
+#define TEST_HOG_US         (10000U)
+#endif
+
+static char _low_stack[THREAD_STACKSIZE_DEFAULT];
+static char _mid_stack[THREAD_STACKSIZE_DEFAULT];
+static char _high_stack[THREAD_STACKSIZE_DEFAULT];
+
+static mutex_t _mutex = MUTEX_INIT;
+static kernel_pid_t _mid_pid;
+static kernel_pid_t _high_pid;
+static xtimer_t _mid_timer;
+static xtimer_t _high_timer;
+
+static uint32_t _latency_max;
+static uint32_t _latency_sum;
+
+static void _busy(uint32_t us)
+{
+    uint32_t start = xtimer_now_usec();
+
+    while ((xtimer_now_usec() - start) < us) {}
+}
+
+static void _wakeup(void *arg)
+{
+    thread_wakeup((kernel_pid_t)(intptr_t)arg);
+}
+
+static void *_low_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        mutex_lock(&_mutex);
+        xtimer_set(&_high_timer, TEST_CS_US / 4);
+        xtimer_set(&_mid_timer, TEST_CS_US / 2);
+        _busy(TEST_CS_US);
+        mutex_unlock(&_mutex);
+    }
+
+    return NULL;
+}
+
+static void *_mid_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        _busy(TEST_HOG_US);
+    }
+
+    return NULL;
+}
+
+static void *_high_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        thread_sleep();
+        uint32_t start = xtimer_now_usec();
+        mutex_lock(&_mutex);
+        uint32_t latency = xtimer_now_usec() - start;
+        mutex_unlock(&_mutex);
+
+        _latency_sum += latency;
+        if (latency > _latency_max) {
+            _latency_max = latency;
+        }
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    kernel_pid_t low_pid;
+
+    puts("mutex priority inversion benchmark");
+
+    low_pid = thread_create(_low_stack, sizeof(_low_stack),
+                            THREAD_PRIORITY_MAIN - 1,
+                            THREAD_CREATE_STACKTEST | THREAD_CREATE_SLEEPING,
+                            _low_thread, NULL, "low");
+    _mid_pid = thread_create(_mid_stack, sizeof(_mid_stack),
+                             THREAD_PRIORITY_MAIN - 2,
+                             THREAD_CREATE_STACKTEST | THREAD_CREATE_SLEEPING,
+                             _mid_thread, NULL, "mid");
+    _high_pid = thread_create(_high_stack, sizeof(_high_stack),
+                              THREAD_PRIORITY_MAIN - 3,
+                              THREAD_CREATE_STACKTEST | THREAD_CREATE_SLEEPING,
+                              _high_thread, NULL, "high");
+    _mid_timer.callback = _wakeup;
+    _mid_timer.arg = (void *)(intptr_t)_mid_pid;
+    _high_timer.callback = _wakeup;
+    _high_timer.arg = (void *)(intptr_t)_high_pid;
+
+    /* the other threads have higher priorities, so main only gets here
+     * once all of them sleep again */
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        thread_wakeup(low_pid);
+        /* let the other threads finish in case they were preempted by the
+         * timers right before sleeping */
+        xtimer_usleep(TEST_HOG_US);
+    }
+
+    printf("{ \"mutex_pi\" : %s, \"rounds\" : %u, \"cs_us\" : %u, "
+           "\"hog_us\" : %u, \"latency_max_us\" : %" PRIu32 ", "
+           "\"latency_avg_us\" : %" PRIu32 " }\n",
+           IS_USED(MODULE_CORE_MUTEX_PI) ? "true" : "false", TEST_ROUNDS,
+           TEST_CS_US, TEST_HOG_US, _latency_max, _latency_sum / TEST_ROUNDS);
+
+    return 0;
+}
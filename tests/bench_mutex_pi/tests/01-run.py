@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"mutex_pi\" : (true|false), \"rounds\" : \d+, "
+                 r"\"cs_us\" : (\d+), \"hog_us\" : (\d+), "
+                 r"\"latency_max_us\" : (\d+), \"latency_avg_us\" : (\d+) }",
+                 timeout=60)
+    pi = child.match.group(1) == "true"
+    hog_us = int(child.match.group(3))
+    latency_max = int(child.match.group(4))
+    if pi:
+        # with priority inheritance, the busy thread never delays the holder
+        assert latency_max < hog_us
+    else:
+        assert latency_max >= hog_us
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the throughput of nanocoap block-wise transfers by
+ *              window and loss
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/ipv6/addr.h"
+#include "net/nanocoap_blockwise.h"
+#include "net/nanocoap_sock.h"
+#include "random.h"
+#include "thread.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_SIZE
+#define TEST_SIZE           (65536U)
+#endif
+
+#ifndef TEST_BLKSIZE
+#define TEST_BLKSIZE        (512U)
+#endif
+
+/* lost requests and responses per 1000 */
+#ifndef TEST_LOSS
+#define TEST_LOSS           (50U)
+#endif
+
+typedef struct {
+    size_t received;
+    unsigned errors;
+} _sink_t;
+
+static const unsigned _windows[] = { 1, 2, 4, 8 };
+
+static ssize_t _file_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx);
+static ssize_t _upload_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx);
+
+/* must be sorted by path */
+const coap_resource_t coap_resources[] = {
+    { "/file", COAP_GET, _file_handler, NULL },
+    { "/upload", COAP_PUT, _upload_handler, NULL },
+};
+
+const unsigned coap_resources_numof = ARRAY_SIZE(coap_resources);
+
+static char _server_stack[THREAD_STACKSIZE_DEFAULT];
+static uint8_t _server_buf[NANOCOAP_BLOCKWISE_BUF_SIZE(TEST_BLKSIZE, 0)];
+static uint8_t _buf[NANOCOAP_BLOCKWISE_BUF_SIZE(
+                        TEST_BLKSIZE, CONFIG_NANOCOAP_BLOCKWISE_WINDOW_MAX)];
+static sock_udp_ep_t _remote = { .family = AF_INET6, .port = COAP_PORT };
+static unsigned _loss;
+static size_t _upload_offset;
+static _sink_t _upload_sink;
+
+static inline uint8_t _pattern(size_t offset)
+{
+    return (offset * 7) ^ (offset >> 8);
+}
+
+static bool _lost(void)
+{
+    return _loss && (random_uint32_range(0, 1000) < _loss);
+}
+
+/* the payload is generated like it is read from a file or an MTD */
+static ssize_t _read(void *arg, size_t offset, uint8_t *buf, size_t len)
+{
+    (void)arg;
+    if (offset >= TEST_SIZE) {
+        return 0;
+    }
+    if (len > TEST_SIZE - offset) {
+        len = TEST_SIZE - offset;
+    }
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = _pattern(offset + i);
+    }
+    return len;
+}
+
+static int _check(void *arg, size_t offset, const uint8_t *buf, size_t len,
+                  bool more)
+{
+    _sink_t *sink = arg;
+
+    if ((offset != sink->received) ||
+        (!more && ((offset + len) != TEST_SIZE))) {
+        sink->errors++;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != _pattern(offset + i)) {
+            sink->errors++;
+            break;
+        }
+    }
+    sink->received += len;
+    return 0;
+}
+
+/* a request is lost if the handler does not respond, the response is lost
+ * if the handler drops it */
+static ssize_t _file_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                             void *ctx)
+{
+    (void)ctx;
+    if (_lost()) {
+        return 0;
+    }
+    ssize_t res = nanocoap_blockwise_reply(pdu, buf, len, COAP_FORMAT_OCTET,
+                                           _read, NULL);
+    return _lost() ? 0 : res;
+}
+
+static ssize_t _upload_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx)
+{
+    (void)ctx;
+    if (_lost()) {
+        return 0;
+    }
+    ssize_t res = nanocoap_blockwise_recv(pdu, buf, len, &_upload_offset,
+                                          _check, &_upload_sink);
+    return _lost() ? 0 : res;
+}
+
+static void *_server(void *arg)
+{
+    sock_udp_ep_t local = { .family = AF_INET6, .port = COAP_PORT };
+
+    (void)arg;
+    nanocoap_server(&local, _server_buf, sizeof(_server_buf));
+    return NULL;
+}
+
+static void _print(const char *transfer, unsigned window, uint32_t time,
+                   unsigned errors)
+{
+    if (time == 0) {
+        time = 1;
+    }
+    printf("{ \"transfer\" : \"%s\", \"window\" : %u, \"loss\" : %u, "
+           "\"bytes_per_sec\" : %" PRIu32 ", \"errors\" : %u }", transfer,
+           window, _loss,
+           (uint32_t)(((uint64_t)TEST_SIZE * US_PER_SEC) / time), errors);
+}
+
+static void _get(unsigned window)
+{
+    _sink_t sink = { .received = 0 };
+    uint32_t start, time;
+    ssize_t res;
+
+    start = ztimer_now(ZTIMER_USEC);
+    res = nanocoap_blockwise_get(&_remote, "/file", TEST_BLKSIZE, window,
+                                 _buf, sizeof(_buf), _check, &sink);
+    time = ztimer_now(ZTIMER_USEC) - start;
+    if ((res != (ssize_t)TEST_SIZE) || (sink.received != TEST_SIZE)) {
+        sink.errors++;
+    }
+    _print("get", window, time, sink.errors);
+}
+
+static void _upload(void)
+{
+    uint32_t start, time;
+    ssize_t res;
+
+    _upload_sink.received = 0;
+    _upload_sink.errors = 0;
+    start = ztimer_now(ZTIMER_USEC);
+    res = nanocoap_blockwise_upload(&_remote, "/upload", COAP_METHOD_PUT,
+                                    TEST_BLKSIZE, _buf, sizeof(_buf), _read,
+                                    NULL);
+    time = ztimer_now(ZTIMER_USEC) - start;
+    if ((res != (ssize_t)TEST_SIZE) ||
+        (_upload_sink.received != TEST_SIZE)) {
+        _upload_sink.errors++;
+    }
+    _print("upload", 1, time, _upload_sink.errors);
+}
+
+int main(void)
+{
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_remote.addr.ipv6);
+    thread_create(_server_stack, sizeof(_server_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST, _server,
+                  NULL, "nanocoap");
+
+    printf("nanocoap block-wise benchmark (%u bytes, blocks of %u bytes)\n",
+           TEST_SIZE, TEST_BLKSIZE);
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < 2; i++) {
+        _loss = i ? TEST_LOSS : 0;
+        if (i && (_loss == 0)) {
+            break;
+        }
+        for (unsigned j = 0; j < ARRAY_SIZE(_windows); j++) {
+            if (_windows[j] > CONFIG_NANOCOAP_BLOCKWISE_WINDOW_MAX) {
+                break;
+            }
+            if (i || j) {
+                puts(",");
+            }
+            _get(_windows[j]);
+        }
+        puts(",");
+        _upload();
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure the resource lookup of nanocoap based servers by
+ *              number of resources
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/nanocoap.h"
+#include "timex.h"
+#include "ztimer.h"
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (10000U)
+#endif
+
+#ifndef TEST_RESOURCES_MAX
+#define TEST_RESOURCES_MAX  (1000U)
+#endif
+
+/* length of "/ch/0000" with terminating zero */
+#define PATH_SIZE           (9U)
+#define URI_SIZE            (16U)
+/* besides one for every resource, a URI below /log and one not found */
+#define URIS_EXTRA          (2U)
+
+static const unsigned _counts[] = { 10, 100, 1000 };
+
+static coap_resource_t _resources[TEST_RESOURCES_MAX + 1];
+static char _paths[TEST_RESOURCES_MAX][PATH_SIZE];
+
+/* the handlers are not called, only the lookup is measured */
+static ssize_t _handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)pdu;
+    (void)buf;
+    (void)len;
+    (void)ctx;
+    return 0;
+}
+
+/* the lookup of gcoap and coap_tree_handler() before
+ * coap_find_resource() */
+static int _find_ref(const coap_resource_t *resources, size_t numof,
+                     uint8_t *uri, coap_method_flags_t method_flag,
+                     const coap_resource_t **resource)
+{
+    int ret = -ENOENT;
+
+    for (size_t i = 0; i < numof; i++) {
+        int res = coap_match_path(&resources[i], uri);
+
+        if (res > 0) {
+            continue;
+        }
+        else if (res < 0) {
+            break;
+        }
+        if (!(resources[i].methods & method_flag)) {
+            ret = -EPERM;
+            continue;
+        }
+        *resource = &resources[i];
+        return 0;
+    }
+    return ret;
+}
+
+static void _init_ch(unsigned i)
+{
+    _resources[i].path = _paths[i];
+    _resources[i].methods = COAP_GET;
+    _resources[i].handler = _handler;
+}
+
+static void _uri(uint8_t *uri, unsigned i, unsigned numof)
+{
+    if (i < numof) {
+        snprintf((char *)uri, URI_SIZE, "/ch/%04u", i);
+    }
+    else if (i == numof) {
+        snprintf((char *)uri, URI_SIZE, "/log/%u", numof);
+    }
+    else {
+        snprintf((char *)uri, URI_SIZE, "/ch/%04ux", numof);
+    }
+}
+
+static uint32_t _lookups_per_sec(uint32_t time)
+{
+    if (time == 0) {
+        time = 1;
+    }
+    return (uint32_t)(((uint64_t)TEST_ROUNDS * US_PER_SEC) / time);
+}
+
+static void _run(unsigned numof)
+{
+    uint8_t uri[URI_SIZE];
+    uint32_t start, time, ref_time;
+    unsigned errors = 0;
+    /* the /log subtree sorts behind the /ch resources */
+    size_t resources_numof = numof + 1;
+
+    _resources[numof].path = "/log";
+    _resources[numof].methods = COAP_POST | COAP_MATCH_SUBTREE;
+    _resources[numof].handler = _handler;
+
+    for (unsigned i = 0; i < (numof + URIS_EXTRA); i++) {
+        const coap_resource_t *res = NULL, *ref = NULL;
+        int ret, ref_ret;
+
+        _uri(uri, i, numof);
+        ret = coap_find_resource(_resources, resources_numof, uri, COAP_GET,
+                                 &res);
+        ref_ret = _find_ref(_resources, resources_numof, uri, COAP_GET, &ref);
+        if ((ret != ref_ret) || (res != ref)) {
+            errors++;
+        }
+        ret = coap_find_resource(_resources, resources_numof, uri, COAP_POST,
+                                 &res);
+        ref_ret = _find_ref(_resources, resources_numof, uri, COAP_POST, &ref);
+        if ((ret != ref_ret) || (res != ref)) {
+            errors++;
+        }
+    }
+
+    /* formatting the URI is part of the measurement, but the same for
+     * both lookups */
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        const coap_resource_t *res;
+
+        _uri(uri, round % (numof + URIS_EXTRA), numof);
+        coap_find_resource(_resources, resources_numof, uri, COAP_GET, &res);
+    }
+    time = ztimer_now(ZTIMER_USEC) - start;
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned round = 0; round < TEST_ROUNDS; round++) {
+        const coap_resource_t *res;
+
+        _uri(uri, round % (numof + URIS_EXTRA), numof);
+        _find_ref(_resources, resources_numof, uri, COAP_GET, &res);
+    }
+    ref_time = ztimer_now(ZTIMER_USEC) - start;
+    if (numof < TEST_RESOURCES_MAX) {
+        _init_ch(numof);
+    }
+
+    printf("{ \"resources\" : %u, \"lookups_per_sec\" : %" PRIu32
+           ", \"ref_lookups_per_sec\" : %" PRIu32 ", \"errors\" : %u }",
+           (unsigned)resources_numof, _lookups_per_sec(time),
+           _lookups_per_sec(ref_time), errors);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < TEST_RESOURCES_MAX; i++) {
+        snprintf(_paths[i], sizeof(_paths[i]), "/ch/%04u", i);
+        _init_ch(i);
+    }
+
+    printf("nanocoap resource lookup benchmark (%u rounds)\n", TEST_ROUNDS);
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_counts); i++) {
+        if (_counts[i] > TEST_RESOURCES_MAX) {
+            break;
+        }
+        if (i) {
+            puts(",");
+        }
+        _run(_counts[i]);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compare serial and native_smp offloaded CPU-bound work
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "hashes/sha256.h"
+#include "native_smp.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#ifndef TEST_JOBS
+#define TEST_JOBS           (64U)
+#endif
+
+#ifndef TEST_JOB_SIZE
+#define TEST_JOB_SIZE       (4096U)
+#endif
+
+#ifndef TEST_ROUNDS
+#define TEST_ROUNDS         (64U)
+#endif
+
+static uint8_t _data[TEST_JOBS][TEST_JOB_SIZE];
+static uint8_t _serial[TEST_JOBS][SHA256_DIGEST_LENGTH];
+static uint8_t _parallel[TEST_JOBS][SHA256_DIGEST_LENGTH];
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static volatile uint32_t _counter;
+
+static void _hash(void *arg, unsigned idx)
+{
+    uint8_t (*out)[SHA256_DIGEST_LENGTH] = arg;
+    sha256_context_t ctx;
+
+    sha256_init(&ctx);
+    for (unsigned i = 0; i < TEST_ROUNDS; i++) {
+        sha256_update(&ctx, _data[idx], TEST_JOB_SIZE);
+    }
+    sha256_final(&ctx, out[idx]);
+}
+
+static void *_counter_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        _counter++;
+        thread_yield();
+    }
+
+    return NULL;
+}
+
+int main(void)
+{
+    uint32_t start, serial, parallel;
+
+    for (unsigned i = 0; i < TEST_JOBS; i++) {
+        memset(_data[i], i, TEST_JOB_SIZE);
+    }
+    printf("workers: %u\n", native_smp_numof());
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < TEST_JOBS; i++) {
+        _hash(_serial, i);
+    }
+    serial = ztimer_now(ZTIMER_USEC) - start;
+
+    /* lower priority than main, only runs while main waits for the workers */
+    thread_create(_stack, sizeof(_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_STACKTEST, _counter_thread, NULL, "counter");
+
+    start = ztimer_now(ZTIMER_USEC);
+    native_smp_parallel_for(_hash, _parallel, TEST_JOBS);
+    parallel = ztimer_now(ZTIMER_USEC) - start;
+
+    printf("{ \"serial_us\" : %" PRIu32 ", \"parallel_us\" : %" PRIu32
+           ", \"counter\" : %" PRIu32 " }\n", serial, parallel, _counter);
+
+    puts(memcmp(_serial, _parallel, sizeof(_serial)) ? "FAILURE" : "SUCCESS");
+
+    return 0;
+}
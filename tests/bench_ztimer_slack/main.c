@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Count ztimer wakeups of a 6LoWPAN router with and without
+ *              timer coalescing
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "random.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+/* simulated time in ms ticks */
+#define TEST_DURATION       (10LU * 60LU * 1000LU)
+
+/**
+ * @brief   A kind of periodic timer of the router
+ */
+typedef struct {
+    unsigned numof;         /**< number of instances */
+    uint32_t interval;      /**< minimum interval in ms */
+    uint32_t jitter;        /**< random jitter added to the interval in ms */
+    uint32_t slack_div;     /**< slack is 1/slack_div of the interval */
+} job_t;
+
+static const job_t _jobs[] = {
+    /* NUD: reachable time of 16 neighbors, 0.5 to 1.5 times 30 s */
+    { .numof = 16, .interval = 15000, .jitter = 30000, .slack_div = 8 },
+    /* RPL trickle timer in steady state, t in [I/2, I) for I = 16 s */
+    { .numof = 1, .interval = 8000, .jitter = 8000, .slack_div = 16 },
+    /* RPL DAO refresh */
+    { .numof = 1, .interval = 60000, .jitter = 6000, .slack_div = 8 },
+    /* unsolicited router advertisements every 200 s to 600 s */
+    { .numof = 1, .interval = 200000, .jitter = 400000, .slack_div = 8 },
+    /* 6LoWPAN reassembly buffer garbage collection */
+    { .numof = 1, .interval = 1000, .jitter = 0, .slack_div = 2 },
+    /* CoAP observe notifications of 4 resources */
+    { .numof = 4, .interval = 10000, .jitter = 0, .slack_div = 10 },
+};
+
+#define TIMERS_NUMOF        (16 + 1 + 1 + 1 + 1 + 4)
+
+typedef struct {
+    ztimer_t timer;
+    const job_t *job;
+    uint32_t target;
+} router_timer_t;
+
+static ztimer_mock_t _mock;
+static router_timer_t _timers[TIMERS_NUMOF];
+static bool _slack;
+static unsigned _callbacks;
+static uint32_t _max_late;
+
+static void _set(router_timer_t *t)
+{
+    const job_t *job = t->job;
+    uint32_t val = job->interval;
+
+    if (job->jitter) {
+        val += random_uint32_range(0, job->jitter);
+    }
+    t->target = ztimer_now(&_mock.super) + val;
+    ztimer_set_slack(&_mock.super, &t->timer, val,
+                     _slack ? val / job->slack_div : 0);
+}
+
+static void _callback(void *arg)
+{
+    router_timer_t *t = arg;
+    uint32_t late = ztimer_now(&_mock.super) - t->target;
+
+    if (late > _max_late) {
+        _max_late = late;
+    }
+    _callbacks++;
+    _set(t);
+}
+
+static void _run(bool slack)
+{
+    router_timer_t *t = _timers;
+
+    random_init(TEST_SEED);
+    ztimer_mock_init(&_mock, 32);
+    _slack = slack;
+    _callbacks = 0;
+    _max_late = 0;
+
+    for (unsigned i = 0; i < ARRAY_SIZE(_jobs); i++) {
+        for (unsigned j = 0; j < _jobs[i].numof; j++, t++) {
+            t->timer = (ztimer_t){ .callback = _callback, .arg = t };
+            t->job = &_jobs[i];
+            _set(t);
+        }
+    }
+
+    ztimer_mock_advance(&_mock, TEST_DURATION);
+
+    for (unsigned i = 0; i < TIMERS_NUMOF; i++) {
+        ztimer_remove(&_mock.super, &_timers[i].timer);
+    }
+
+    printf("{ \"slack\" : %s, \"callbacks\" : %u, \"wakeups_per_minute\" : %"
+           PRIu32 ", \"max_late\" : %" PRIu32 " }", slack ? "true" : "false",
+           _callbacks,
+           (uint32_t)(ztimer_wakeups(&_mock.super) /
+                      (TEST_DURATION / (60LU * 1000LU))),
+           _max_late);
+}
+
+int main(void)
+{
+    printf("ztimer coalescing benchmark (%s)\n",
+           IS_USED(MODULE_ZTIMER_WHEEL) ? "ztimer_wheel" : "sorted list");
+
+    puts("{ \"result\" : [");
+    _run(false);
+    puts(",");
+    _run(true);
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"result\" : \[")
+    child.expect(r"\"slack\" : false, \"callbacks\" : (\d+), "
+                 r"\"wakeups_per_minute\" : (\d+), \"max_late\" : 0 }")
+    wakeups = int(child.match.group(2))
+    child.expect(r"\"slack\" : true, \"callbacks\" : (\d+), "
+                 r"\"wakeups_per_minute\" : (\d+), \"max_late\" : \d+ }")
+    assert int(child.match.group(2)) < wakeups
+    child.expect(r"\] }")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Measure ztimer_set() and ztimer_remove() with many timers
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "random.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#ifndef TEST_TIMERS_MAX
+#define TEST_TIMERS_MAX     (1000U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+static const unsigned _counts[] = { 1000, 10000, 100000 };
+
+static ztimer_mock_t _mock;
+static ztimer_t _timers[TEST_TIMERS_MAX];
+
+static void _callback(void *arg)
+{
+    (void)arg;
+}
+
+static void _run(unsigned numof)
+{
+    ztimer_clock_t *clock = &_mock.super;
+    uint32_t start, set_time, remove_time;
+
+    for (unsigned i = 0; i < numof; i++) {
+        _timers[i] = (ztimer_t){ .callback = _callback };
+    }
+
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < numof; i++) {
+        /* targets within about a day of mock clock ticks */
+        ztimer_set(clock, &_timers[i], random_uint32() >> 6);
+    }
+    set_time = ztimer_now(ZTIMER_USEC) - start;
+
+    /* remove with a stride so that removal order differs from set order */
+    start = ztimer_now(ZTIMER_USEC);
+    for (unsigned i = 0; i < numof; i++) {
+        ztimer_remove(clock, &_timers[(i * 7919U) % numof]);
+    }
+    remove_time = ztimer_now(ZTIMER_USEC) - start;
+
+    printf("{ \"timers\" : %u, \"set_us\" : %" PRIu32 ", \"remove_us\" : %"
+           PRIu32 ", \"set_ns_per_op\" : %" PRIu32 ", \"remove_ns_per_op\" : %"
+           PRIu32 " }", numof, set_time, remove_time,
+           (uint32_t)(((uint64_t)set_time * 1000) / numof),
+           (uint32_t)(((uint64_t)remove_time * 1000) / numof));
+}
+
+int main(void)
+{
+    printf("ztimer set/remove benchmark (%s)\n",
+           IS_USED(MODULE_ZTIMER_WHEEL) ? "ztimer_wheel" : "sorted list");
+
+    random_init(TEST_SEED);
+    ztimer_mock_init(&_mock, 32);
+
+    puts("{ \"result\" : [");
+    for (unsigned i = 0; i < ARRAY_SIZE(_counts); i++) {
+        if (_counts[i] > TEST_TIMERS_MAX) {
+            break;
+        }
+        if (i) {
+            puts(",");
+        }
+        _run(_counts[i]);
+    }
+    puts("\n] }");
+
+    return 0;
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Tests the Observe registrations and notifications of gcoap's
+ *              `gcoap_obs_fanout` module
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "embUnit.h"
+#include "kernel_defines.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#define OBSERVERS_NUMOF     (4U)
+/* port of the first observer, the others follow */
+#define OBSERVER_PORT       (7000U)
+/* tokens of notifications are the ones of the registrations, the ones of
+ * deregistrations start here */
+#define DEREGISTER_TOKEN    (1000U)
+#define INVALID_TOKEN       (UINT32_MAX)
+#define RECV_TIMEOUT        (100U * US_PER_MS)
+/* time to wait for a message that must not arrive */
+#define NONE_TIMEOUT        (10U * US_PER_MS)
+/* time a notification to one observer is paced to */
+#define PACING_INTERVAL     (US_PER_SEC / CONFIG_GCOAP_OBS_NOTIFY_RATE)
+
+static const char _value[] = "21.5";
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx);
+
+static const coap_resource_t _resources[] = {
+    { "/sensor", COAP_GET, _sensor_handler, NULL },
+};
+
+static gcoap_listener_t _listener = {
+    &_resources[0],
+    ARRAY_SIZE(_resources),
+    NULL,
+    NULL
+};
+
+static gcoap_obs_entry_t _obs_pool[OBSERVERS_NUMOF];
+static sock_udp_t _socks[OBSERVERS_NUMOF];
+static uint8_t _buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+static uint8_t _req_buf[CONFIG_GCOAP_PDU_BUF_SIZE];
+static char _deregister_stack[THREAD_STACKSIZE_DEFAULT];
+static sock_udp_ep_t _server = {
+    .family = AF_INET6,
+    .port = CONFIG_GCOAP_PORT,
+};
+
+static ssize_t _sensor_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                               void *ctx)
+{
+    (void)ctx;
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_format(pdu, COAP_FORMAT_TEXT);
+    size_t resp_len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    if (pdu->payload_len < sizeof(_value) - 1) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_INTERNAL_SERVER_ERROR);
+    }
+    memcpy(pdu->payload, _value, sizeof(_value) - 1);
+    return resp_len + sizeof(_value) - 1;
+}
+
+static int _send_request(unsigned observer, uint32_t observe, uint32_t token)
+{
+    coap_pkt_t pdu;
+    ssize_t len;
+
+    len = coap_build_hdr((coap_hdr_t *)_req_buf, COAP_TYPE_NON,
+                         (uint8_t *)&token, sizeof(token), COAP_METHOD_GET,
+                         (uint16_t)token);
+    coap_pkt_init(&pdu, _req_buf, sizeof(_req_buf), len);
+    coap_opt_add_uint(&pdu, COAP_OPT_OBSERVE, observe);
+    coap_opt_add_string(&pdu, COAP_OPT_URI_PATH, _resources[0].path, '/');
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+
+    return sock_udp_send(&_socks[observer], _req_buf, len, &_server);
+}
+
+/* receives a response or notification of the resource
+ * returns its token, 0 if there is none, or INVALID_TOKEN if it is not a
+ * valid one */
+static uint32_t _recv(unsigned observer, uint32_t timeout)
+{
+    coap_pkt_t pdu;
+    uint32_t token;
+    ssize_t len = sock_udp_recv(&_socks[observer], _buf, sizeof(_buf),
+                                timeout, NULL);
+
+    if (len <= 0) {
+        return 0;
+    }
+    if ((coap_parse(&pdu, _buf, len) < 0) ||
+        (coap_get_code_raw(&pdu) != COAP_CODE_CONTENT) ||
+        (coap_get_token_len(&pdu) != sizeof(token)) ||
+        (pdu.payload_len != sizeof(_value) - 1) ||
+        (memcmp(pdu.payload, _value, sizeof(_value) - 1) != 0)) {
+        return INVALID_TOKEN;
+    }
+    memcpy(&token, pdu.token, sizeof(token));
+    return token;
+}
+
+static void _register(unsigned observer, uint32_t token)
+{
+    TEST_ASSERT(_send_request(observer, COAP_OBS_REGISTER, token) > 0);
+    TEST_ASSERT_EQUAL_INT(token, _recv(observer, RECV_TIMEOUT));
+}
+
+static void _deregister(unsigned observer)
+{
+    uint32_t token = DEREGISTER_TOKEN + observer;
+
+    TEST_ASSERT(_send_request(observer, COAP_OBS_DEREGISTER, token) > 0);
+    TEST_ASSERT_EQUAL_INT(token, _recv(observer, RECV_TIMEOUT));
+}
+
+/* returns the number of observers notified, or <0 on error */
+static int _notify(void)
+{
+    coap_pkt_t pdu;
+
+    if (gcoap_obs_init(&pdu, _buf, sizeof(_buf),
+                       &_resources[0]) != GCOAP_OBS_INIT_OK) {
+        return -1;
+    }
+    coap_opt_add_format(&pdu, COAP_FORMAT_TEXT);
+    size_t len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    memcpy(pdu.payload, _value, sizeof(_value) - 1);
+    return gcoap_obs_notify_all(_buf, len + sizeof(_value) - 1,
+                                &_resources[0]);
+}
+
+static void _set_up(void)
+{
+    /* start every test with the burst of notifications available */
+    xtimer_usleep(CONFIG_GCOAP_OBS_NOTIFY_BURST * PACING_INTERVAL);
+}
+
+static void _tear_down(void)
+{
+    for (unsigned i = 0; i < OBSERVERS_NUMOF; i++) {
+        _deregister(i);
+    }
+}
+
+static void test_gcoap_obs__register(void)
+{
+    _register(0, 10);
+    _register(1, 11);
+    TEST_ASSERT_EQUAL_INT(2, _notify());
+    TEST_ASSERT_EQUAL_INT(10, _recv(0, RECV_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(11, _recv(1, RECV_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(0, _recv(2, NONE_TIMEOUT));
+}
+
+static void test_gcoap_obs__reregister(void)
+{
+    _register(0, 10);
+    /* a client may register again with a new token */
+    _register(0, 20);
+    TEST_ASSERT_EQUAL_INT(1, _notify());
+    TEST_ASSERT_EQUAL_INT(20, _recv(0, RECV_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(0, _recv(0, NONE_TIMEOUT));
+}
+
+static void test_gcoap_obs__deregister(void)
+{
+    _register(0, 10);
+    _register(1, 11);
+    _deregister(0);
+    TEST_ASSERT_EQUAL_INT(1, _notify());
+    TEST_ASSERT_EQUAL_INT(11, _recv(1, RECV_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(0, _recv(0, NONE_TIMEOUT));
+}
+
+static void test_gcoap_obs__fanout(void)
+{
+    for (unsigned i = 0; i < OBSERVERS_NUMOF; i++) {
+        _register(i, 10 + i);
+    }
+    TEST_ASSERT_EQUAL_INT(OBSERVERS_NUMOF, _notify());
+    for (unsigned i = 0; i < OBSERVERS_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(10 + i, _recv(i, RECV_TIMEOUT));
+        TEST_ASSERT_EQUAL_INT(0, _recv(i, NONE_TIMEOUT));
+    }
+}
+
+static void *_deregister_thread(void *arg)
+{
+    (void)arg;
+    /* the first observer is notified right away, the second one only after
+     * the pacing interval */
+    xtimer_usleep(PACING_INTERVAL / 4);
+    _send_request(1, COAP_OBS_DEREGISTER, DEREGISTER_TOKEN + 1);
+    return NULL;
+}
+
+static void test_gcoap_obs__deregister_while_pacing(void)
+{
+    for (unsigned i = 0; i < OBSERVERS_NUMOF; i++) {
+        _register(i, 10 + i);
+    }
+    /* deregisters the observer gcoap_obs_notify_all() waits to notify */
+    thread_create(_deregister_stack, sizeof(_deregister_stack),
+                  THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                  _deregister_thread, NULL, "deregister");
+    /* the observers after the deregistered one are still notified */
+    TEST_ASSERT_EQUAL_INT(OBSERVERS_NUMOF - 1, _notify());
+    TEST_ASSERT_EQUAL_INT(10, _recv(0, RECV_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(DEREGISTER_TOKEN + 1, _recv(1, RECV_TIMEOUT));
+    TEST_ASSERT_EQUAL_INT(0, _recv(1, NONE_TIMEOUT));
+    for (unsigned i = 2; i < OBSERVERS_NUMOF; i++) {
+        TEST_ASSERT_EQUAL_INT(10 + i, _recv(i, RECV_TIMEOUT));
+    }
+}
+
+static Test *tests_gcoap_obs(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_gcoap_obs__register),
+        new_TestFixture(test_gcoap_obs__reregister),
+        new_TestFixture(test_gcoap_obs__deregister),
+        new_TestFixture(test_gcoap_obs__fanout),
+        new_TestFixture(test_gcoap_obs__deregister_while_pacing),
+    };
+
+    EMB_UNIT_TESTCALLER(tests, _set_up, _tear_down, fixtures);
+
+    return (Test *)&tests;
+}
+
+int main(void)
+{
+    sock_udp_ep_t local = { .family = AF_INET6 };
+
+    ipv6_addr_set_loopback((ipv6_addr_t *)&_server.addr.ipv6);
+    gcoap_obs_pool_init(_obs_pool, ARRAY_SIZE(_obs_pool));
+    gcoap_register_listener(&_listener);
+    for (unsigned i = 0; i < OBSERVERS_NUMOF; i++) {
+        local.port = OBSERVER_PORT + i;
+        if (sock_udp_create(&_socks[i], &local, NULL, 0) < 0) {
+            puts("Unable to create sockets");
+            return 1;
+        }
+    }
+
+    TESTS_START();
+    TESTS_RUN(tests_gcoap_obs());
+    TESTS_END();
+
+    return 0;
+}
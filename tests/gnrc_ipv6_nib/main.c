@@ -224,6 +224,74 @@ static void test_get_next_hop_l2addr__link_local_static_conf(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+static void test_get_next_hop_l2addr__flow_cache(void)
+{
+    gnrc_ipv6_nib_flow_stats_t before, after;
+    gnrc_ipv6_nib_nc_t nce;
+    uint8_t l2addr[sizeof(_rem_l2)];
+
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(NULL, 0, &_rem_ll,
+                                                  _mock_netif->pid, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  _rem_l2, sizeof(_rem_l2)));
+    gnrc_ipv6_nib_flow_stats(&before);
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_gb, NULL,
+                                                               NULL, &nce));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_gb, NULL,
+                                                               NULL, &nce));
+    gnrc_ipv6_nib_flow_stats(&after);
+    TEST_ASSERT_EQUAL_INT(before.misses + 1, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits + 1, after.hits);
+    TEST_ASSERT(ipv6_addr_equal(&_rem_ll, &nce.ipv6));
+    TEST_ASSERT_EQUAL_INT(sizeof(_rem_l2), nce.l2addr_len);
+    TEST_ASSERT_MESSAGE((memcmp(&_rem_l2, &nce.l2addr, nce.l2addr_len) == 0),
+                        "_rem_l2 != nce.l2addr");
+    /* changes to the NIB invalidate the flow */
+    memcpy(l2addr, _rem_l2, sizeof(l2addr));
+    l2addr[sizeof(l2addr) - 1]++;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  l2addr, sizeof(l2addr)));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&_rem_gb, NULL,
+                                                               NULL, &nce));
+    gnrc_ipv6_nib_flow_stats(&before);
+    TEST_ASSERT_EQUAL_INT(after.misses + 1, before.misses);
+    TEST_ASSERT_MESSAGE((memcmp(l2addr, &nce.l2addr, nce.l2addr_len) == 0),
+                        "l2addr != nce.l2addr");
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_get_next_hop_l2addr__flow_cache_interleaved(void)
+{
+    gnrc_ipv6_nib_flow_stats_t before, after;
+    gnrc_ipv6_nib_nc_t nce;
+    ipv6_addr_t dst[2];
+
+    /* both destinations map to different flow cache entries */
+    dst[0] = _rem_gb;
+    dst[1] = _rem_gb;
+    dst[1].u8[15]++;
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(NULL, 0, &_rem_ll,
+                                                  _mock_netif->pid, 0));
+    TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_nc_set(&_rem_ll, _mock_netif->pid,
+                                                  _rem_l2, sizeof(_rem_l2)));
+    gnrc_ipv6_nib_flow_stats(&before);
+    for (unsigned i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_get_next_hop_l2addr(&dst[i & 1],
+                                                                   NULL, NULL,
+                                                                   &nce));
+        TEST_ASSERT(ipv6_addr_equal(&_rem_ll, &nce.ipv6));
+    }
+    gnrc_ipv6_nib_flow_stats(&after);
+    /* only the first look-up of each destination misses */
+    TEST_ASSERT_EQUAL_INT(before.misses + 2, after.misses);
+    TEST_ASSERT_EQUAL_INT(before.hits + 6, after.hits);
+    TEST_ASSERT_EQUAL_INT(0, msg_avail());
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
+
 void _simulate_ndp_handshake(const ipv6_addr_t *src, const ipv6_addr_t *dst,
                              uint8_t adv_flags)
 {
@@ -1292,6 +1360,10 @@ static Test *tests_gnrc_ipv6_nib(void)
         new_TestFixture(test_get_next_hop_l2addr__global_EHOSTUNREACH_iface_on_link),
         new_TestFixture(test_get_next_hop_l2addr__ENETUNREACH),
         new_TestFixture(test_get_next_hop_l2addr__link_local_static_conf),
+#if GNRC_IPV6_NIB_CONF_FLOW_CACHE
+        new_TestFixture(test_get_next_hop_l2addr__flow_cache),
+        new_TestFixture(test_get_next_hop_l2addr__flow_cache_interleaved),
+#endif  /* GNRC_IPV6_NIB_CONF_FLOW_CACHE */
         new_TestFixture(test_get_next_hop_l2addr__link_local_after_handshake_iface),
         new_TestFixture(test_get_next_hop_l2addr__link_local_after_handshake_iface_router),
         new_TestFixture(test_get_next_hop_l2addr__link_local_after_handshake_no_iface),
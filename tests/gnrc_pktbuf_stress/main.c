@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Stress the packet buffer with mixed-size traffic
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/pktbuf.h"
+#include "random.h"
+
+#ifndef TEST_STEPS
+#define TEST_STEPS          (100000U)
+#endif
+
+#ifndef TEST_QUEUE_LEN
+#define TEST_QUEUE_LEN      (16U)
+#endif
+
+#ifndef TEST_SEED
+#define TEST_SEED           (0x5eed)
+#endif
+
+/* percentage of full-MTU packets */
+#ifndef TEST_LARGE_PERCENT
+#define TEST_LARGE_PERCENT  (20U)
+#endif
+
+#define LARGE_SIZE          (1280U)
+#define SMALL_SIZE_MIN      (40U)
+#define SMALL_SIZE_MAX      (127U)
+#define HDR_SIZE            (40U)
+#define NETIF_HDR_SIZE      (sizeof(gnrc_netif_hdr_t) + 16)
+
+static gnrc_pktsnip_t *_queue[TEST_QUEUE_LEN];
+static unsigned _queued;
+static unsigned _bytes;
+
+static gnrc_pktsnip_t *_alloc(size_t size)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return NULL;
+    }
+    netif = gnrc_pktbuf_add(NULL, NULL, NETIF_HDR_SIZE, GNRC_NETTYPE_NETIF);
+    if (netif == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return NULL;
+    }
+    if (!gnrc_pktbuf_mark(pkt, HDR_SIZE, GNRC_NETTYPE_UNDEF)) {
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    LL_APPEND(pkt, netif);
+    return pkt;
+}
+
+int main(void)
+{
+    unsigned allocs = 0, drops = 0, large_drops = 0;
+    uint64_t bytes_at_drop = 0;
+
+    printf("packet buffer stress test (%s, %u bytes)\n",
+           IS_USED(MODULE_GNRC_PKTBUF_SLAB) ? "slab" : "first-fit",
+           GNRC_PKTBUF_SIZE);
+    random_init(TEST_SEED);
+
+    for (unsigned i = 0; i < TEST_STEPS; i++) {
+        /* allocate with a probability of 1/2 if there is room in the queue */
+        if ((_queued < TEST_QUEUE_LEN) && (random_uint32() & 1)) {
+            bool large = random_uint32_range(0, 100) < TEST_LARGE_PERCENT;
+            size_t size = large ? LARGE_SIZE
+                                : random_uint32_range(SMALL_SIZE_MIN,
+                                                      SMALL_SIZE_MAX + 1);
+            gnrc_pktsnip_t *pkt = _alloc(size);
+
+            allocs++;
+            if (pkt == NULL) {
+                drops++;
+                large_drops += large;
+                bytes_at_drop += _bytes;
+                continue;
+            }
+            _queue[_queued++] = pkt;
+            _bytes += size + NETIF_HDR_SIZE;
+        }
+        else if (_queued > 0) {
+            unsigned idx = random_uint32_range(0, _queued);
+
+            _bytes -= gnrc_pkt_len(_queue[idx]);
+            gnrc_pktbuf_release(_queue[idx]);
+            _queue[idx] = _queue[--_queued];
+        }
+    }
+    while (_queued > 0) {
+        gnrc_pktbuf_release(_queue[--_queued]);
+    }
+
+    printf("{ \"allocs\" : %u, \"drops\" : %u, \"large_drops\" : %u, "
+           "\"drop_rate_permille\" : %u, \"avg_bytes_used_at_drop\" : %u }\n",
+           allocs, drops, large_drops,
+           (unsigned)(((uint64_t)drops * 1000) / allocs),
+           drops ? (unsigned)(bytes_at_drop / drops) : 0);
+#ifdef DEVELHELP
+    gnrc_pktbuf_stats();
+#endif
+    puts("SUCCESS");
+
+    return 0;
+}
@@ -235,10 +235,9 @@ static void _test_entry(const gnrc_sixlowpan_frag_rb_t *entry,
                         "entry->super.dst != TEST_NETIF_HDR_DST");
     TEST_ASSERT_EQUAL_INT(TEST_TAG, entry->super.tag);
     TEST_ASSERT_EQUAL_INT(exp_current_size, entry->super.current_size);
-    TEST_ASSERT_NOT_NULL(entry->super.ints);
-    TEST_ASSERT_NULL(entry->super.ints->next);
-    TEST_ASSERT_EQUAL_INT(exp_int_start, entry->super.ints->start);
-    TEST_ASSERT_EQUAL_INT(exp_int_end, entry->super.ints->end);
+    TEST_ASSERT_EQUAL_INT(1, entry->ints_numof);
+    TEST_ASSERT_EQUAL_INT(exp_int_start, entry->ints[0].start);
+    TEST_ASSERT_EQUAL_INT(exp_int_end, entry->ints[0].end);
 }
 
 static void _check_pktbuf(const gnrc_sixlowpan_frag_rb_t *entry)
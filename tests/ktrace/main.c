@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Kernel event tracing test application
+ *
+ * @}
+ */
+
+#include <stdio.h>
+
+#include "ktrace.h"
+#include "msg.h"
+#include "mutex.h"
+#include "shell.h"
+#include "thread.h"
+
+#define TEST_MSG_TYPE       (0x1234)
+
+static char _stack[THREAD_STACKSIZE_DEFAULT];
+static mutex_t _mutex = MUTEX_INIT;
+
+static void *_worker(void *arg)
+{
+    msg_t msg;
+
+    (void)arg;
+    msg_receive(&msg);
+    msg.type = TEST_MSG_TYPE + 1;
+    msg_send(&msg, msg.sender_pid);
+    mutex_lock(&_mutex);
+    mutex_unlock(&_mutex);
+    return NULL;
+}
+
+static void _write_stdout(void *arg, const void *data, size_t len)
+{
+    (void)arg;
+    printf("%.*s", (int)len, (const char *)data);
+}
+
+static unsigned _count(ktrace_type_t type, uint32_t arg)
+{
+    ktrace_event_t event;
+    unsigned numof = 0;
+
+    for (unsigned i = 0; ktrace_get(i, &event) == 0; i++) {
+        if ((event.type == type) && (event.arg == arg)) {
+            numof++;
+        }
+    }
+    return numof;
+}
+
+int main(void)
+{
+    msg_t msg = { .type = TEST_MSG_TYPE };
+    kernel_pid_t main_pid = thread_getpid();
+
+    ktrace_clear();
+    mutex_lock(&_mutex);
+    kernel_pid_t pid = thread_create(_stack, sizeof(_stack),
+                                     THREAD_PRIORITY_MAIN - 1,
+                                     THREAD_CREATE_STACKTEST,
+                                     _worker, NULL, "worker");
+    msg_send(&msg, pid);
+    msg_receive(&msg);
+    mutex_unlock(&_mutex);
+    /* fails, as main has no message queue */
+    msg.type = TEST_MSG_TYPE + 2;
+    msg_try_send(&msg, main_pid);
+    ktrace_enable(false);
+
+    printf("sched to worker: %u\n", _count(KTRACE_SCHED, pid));
+    printf("sched to main: %u\n", _count(KTRACE_SCHED, main_pid));
+    printf("msg sent: %u\n", _count(KTRACE_MSG_SEND,
+                                    ((uint32_t)pid << 16) | TEST_MSG_TYPE));
+    printf("failed msg sent: %u\n",
+           _count(KTRACE_MSG_SEND,
+                  ((uint32_t)main_pid << 16) | (TEST_MSG_TYPE + 2)));
+    printf("msg received: %u\n", _count(KTRACE_MSG_RECV,
+                                        ((uint32_t)pid << 16) |
+                                        (TEST_MSG_TYPE + 1)));
+    printf("mutex blocked: %u\n", _count(KTRACE_MUTEX_BLOCK,
+                                         (uintptr_t)&_mutex));
+    printf("mutex acquired: %u\n", _count(KTRACE_MUTEX_ACQUIRE,
+                                          (uintptr_t)&_mutex));
+
+    ktrace_export_chrome(_write_stdout, NULL);
+    ktrace_enable(true);
+
+    char line_buf[SHELL_DEFAULT_BUFSIZE];
+    shell_run(NULL, line_buf, SHELL_DEFAULT_BUFSIZE);
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    # main wakes up the worker by sending and when unlocking the mutex, the
+    # worker sends its reply and blocks on the mutex
+    child.expect(r"sched to worker: (\d+)")
+    assert int(child.match.group(1)) >= 2
+    child.expect(r"sched to main: (\d+)")
+    assert int(child.match.group(1)) >= 2
+    child.expect_exact("msg sent: 1")
+    child.expect_exact("failed msg sent: 0")
+    child.expect_exact("msg received: 1")
+    child.expect_exact("mutex blocked: 1")
+    child.expect_exact("mutex acquired: 1")
+    child.expect_exact('{"displayTimeUnit":"ns","traceEvents":[')
+    child.expect_exact('"name":"worker"')
+    child.expect_exact('"name":"mutex_block"')
+    child.expect_exact("]}")
+    child.sendline("ktrace")
+    child.expect_exact("usage: ktrace")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     tests
+ * @{
+ *
+ * @file
+ * @brief       Compares deadline misses of periodic threads with fixed
+ *              priority and EDF scheduling
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "kernel_defines.h"
+#include "sched.h"
+#include "sched_edf.h"
+#include "thread.h"
+#include "ztimer.h"
+
+#ifndef TEST_PERIOD_1
+#define TEST_PERIOD_1       (50000LU)
+#endif
+
+#ifndef TEST_COST_1
+#define TEST_COST_1         (20000LU)
+#endif
+
+#ifndef TEST_PERIOD_2
+#define TEST_PERIOD_2       (70000LU)
+#endif
+
+#ifndef TEST_COST_2
+#define TEST_COST_2         (40000LU)
+#endif
+
+#ifndef TEST_PERIOD_3
+#define TEST_PERIOD_3       (100000LU)
+#endif
+
+#ifndef TEST_COST_3
+#define TEST_COST_3         (20000LU)
+#endif
+
+#ifndef TEST_BUDGET_3
+#define TEST_BUDGET_3       (500LU)
+#endif
+
+#ifndef TEST_DURATION
+#define TEST_DURATION       (1050000LU)
+#endif
+
+/* work is done in slices of busy waiting, so preemption skews it by at most
+ * one slice */
+#define TEST_SLICE          (100U)
+
+typedef enum {
+    MODE_FIXED,
+    MODE_EDF,
+    MODE_OVERRUN,
+} test_mode_t;
+
+typedef struct {
+    uint32_t period;
+    uint32_t cost;
+    uint32_t budget;
+    uint32_t release;
+    unsigned jobs;
+    unsigned misses;
+    sched_edf_t edf;
+    char stack[THREAD_STACKSIZE_DEFAULT];
+} task_t;
+
+/* the last task declares a budget far below its cost, it only runs in
+ * MODE_OVERRUN */
+static task_t _tasks[] = {
+    { .period = TEST_PERIOD_1, .cost = TEST_COST_1 },
+    { .period = TEST_PERIOD_2, .cost = TEST_COST_2 },
+    { .period = TEST_PERIOD_3, .cost = TEST_COST_3, .budget = TEST_BUDGET_3 },
+};
+
+static const char *_mode_names[] = { "fixed", "edf", "overrun" };
+
+static char _hog_stack[THREAD_STACKSIZE_DEFAULT];
+static volatile bool _edf_mode;
+static volatile bool _stop;
+
+static void _work(uint32_t us)
+{
+    for (uint32_t i = 0; i < us; i += TEST_SLICE) {
+        uint32_t start = ztimer_now(ZTIMER_USEC);
+        while ((ztimer_now(ZTIMER_USEC) - start) < TEST_SLICE) {}
+    }
+}
+
+static void *_task_thread(void *arg)
+{
+    task_t *task = arg;
+
+    while (!_stop) {
+        _work(task->cost);
+        if ((ztimer_now(ZTIMER_USEC) - task->release) > task->period) {
+            task->misses++;
+        }
+        task->jobs++;
+        if (_edf_mode) {
+            task->release += task->period;
+            sched_edf_wait_next_period();
+        }
+        else {
+            ztimer_periodic_wakeup(ZTIMER_USEC, &task->release, task->period);
+        }
+    }
+
+    return NULL;
+}
+
+static void *_hog_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {}
+
+    return NULL;
+}
+
+static void _run(test_mode_t mode)
+{
+    unsigned jobs = 0;
+    unsigned misses = 0;
+    unsigned throttled = 0;
+    unsigned numof = (mode == MODE_OVERRUN) ? ARRAY_SIZE(_tasks)
+                                            : ARRAY_SIZE(_tasks) - 1;
+    bool edf = (mode != MODE_FIXED);
+    kernel_pid_t pids[ARRAY_SIZE(_tasks)];
+
+    _edf_mode = edf;
+    _stop = false;
+
+    for (unsigned i = 0; i < numof; i++) {
+        task_t *task = &_tasks[i];
+        task->jobs = 0;
+        task->misses = 0;
+        /* rate monotonic priorities for the fixed priority mode */
+        pids[i] = thread_create(task->stack, sizeof(task->stack),
+                                THREAD_PRIORITY_MAIN - numof + i,
+                                THREAD_CREATE_SLEEPING, _task_thread, task,
+                                "task");
+    }
+    for (unsigned i = 0; i < numof; i++) {
+        task_t *task = &_tasks[i];
+        task->release = ztimer_now(ZTIMER_USEC);
+        if (edf) {
+            /* leave some margin for the overhead of the slices */
+            sched_edf_params_t params = {
+                .period = task->period,
+                .budget = task->budget ? task->budget
+                                       : task->cost + task->period / 100,
+                .deadline = task->period,
+            };
+            int res = sched_edf_add(&task->edf, pids[i], &params);
+            if (res < 0) {
+                printf("sched_edf_add() failed: %d\n", res);
+                return;
+            }
+        }
+        else {
+            thread_wakeup(pids[i]);
+        }
+    }
+
+    ztimer_sleep(ZTIMER_USEC, TEST_DURATION);
+    _stop = true;
+    for (unsigned i = 0; i < numof; i++) {
+        if (_tasks[i].budget == 0) {
+            /* only the tasks keeping their budget must meet deadlines */
+            jobs += _tasks[i].jobs;
+            misses += _tasks[i].misses;
+        }
+        if (edf) {
+            sched_edf_stats_t stats;
+            if (sched_edf_stats(pids[i], &stats) == 0) {
+                throttled += stats.throttled;
+            }
+        }
+    }
+    /* let the tasks finish their last job and exit, the overrunning one
+     * never catches up and is left running */
+    ztimer_sleep(ZTIMER_USEC, 2 * TEST_PERIOD_2);
+
+    printf("{ \"mode\" : \"%s\", \"jobs\" : %u, \"misses\" : %u, "
+           "\"throttled\" : %u }\n", _mode_names[mode], jobs, misses,
+           throttled);
+}
+
+int main(void)
+{
+    /* main controls the test, so it must preempt all other threads */
+    sched_change_priority((thread_t *)thread_get(thread_getpid()), 0);
+    thread_create(_hog_stack, sizeof(_hog_stack), THREAD_PRIORITY_MAIN + 1,
+                  THREAD_CREATE_WOUT_YIELD, _hog_thread, NULL, "hog");
+
+    puts("periodic threads with fixed priorities and EDF");
+    _run(MODE_FIXED);
+    _run(MODE_EDF);
+    _run(MODE_OVERRUN);
+    puts("TEST DONE");
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+
+# Copyright (C) 2020 Freie Universität Berlin
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+import sys
+from testrunner import run
+
+
+def testfunc(child):
+    child.expect(r"{ \"mode\" : \"fixed\", \"jobs\" : (\d+), "
+                 r"\"misses\" : (\d+)", timeout=10)
+    fixed_misses = int(child.match.group(2))
+    child.expect(r"{ \"mode\" : \"edf\", \"jobs\" : (\d+), "
+                 r"\"misses\" : (\d+)", timeout=10)
+    assert int(child.match.group(1)) > 0
+    assert int(child.match.group(2)) < fixed_misses
+    child.expect(r"{ \"mode\" : \"overrun\", \"jobs\" : (\d+), "
+                 r"\"misses\" : (\d+), \"throttled\" : (\d+)", timeout=10)
+    assert int(child.match.group(1)) > 0
+    assert int(child.match.group(2)) < fixed_misses
+    assert int(child.match.group(3)) > 0
+    child.expect_exact("TEST DONE")
+
+
+if __name__ == "__main__":
+    sys.exit(run(testfunc))
@@ -29,6 +29,10 @@
 
 mutex_t res_mtx;
 
+kernel_pid_t pid_low;
+kernel_pid_t pid_mid;
+kernel_pid_t pid_high;
+
 char stack_high[THREAD_STACKSIZE_DEFAULT];
 char stack_mid[THREAD_STACKSIZE_DEFAULT];
 char stack_low[THREAD_STACKSIZE_DEFAULT];
@@ -71,6 +75,20 @@ void *t_high_handler(void *arg)
 
     /* starting working loop after 500 ms */
     xtimer_usleep(500U * US_PER_MS);
+
+    /* t_low holds the resource for another 500 ms, so this times out. t_low
+     * must not keep the priority it inherited meanwhile. */
+    puts("t_high: allocating resource with timeout...");
+    if (xtimer_mutex_lock_timeout(&res_mtx, 100U * US_PER_MS) == 0) {
+        mutex_unlock(&res_mtx);
+    }
+    else {
+        uint8_t prio = thread_get(pid_low)->priority;
+        printf("t_high: timed out, t_low has priority %u [%s]\n",
+               (unsigned)prio,
+               (prio == THREAD_PRIORITY_MAIN - 1) ? "SUCCESS" : "FAILED");
+    }
+
     while (1) {
         puts("t_high: allocating resource...");
         mutex_lock(&res_mtx);
@@ -85,10 +103,6 @@ void *t_high_handler(void *arg)
     return NULL;
 }
 
-kernel_pid_t pid_low;
-kernel_pid_t pid_mid;
-kernel_pid_t pid_high;
-
 int main(void)
 {
     xtimer_init();
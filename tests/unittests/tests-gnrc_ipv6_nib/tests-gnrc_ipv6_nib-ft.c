@@ -178,6 +178,39 @@ static void test_nib_ft_get__success4(void)
     TEST_ASSERT_EQUAL_INT(IFACE, fte.iface);
 }
 
+/*
+ * Adds three nested routes to the forwarding table, the shortest one last,
+ * then removes them from the longest to the shortest, trying to get an address
+ * matching all of them after each step.
+ * Expected result: gnrc_ipv6_nib_ft_get() always returns the route with the
+ * longest prefix left
+ */
+static void test_nib_ft_get__success5(void)
+{
+    gnrc_ipv6_nib_ft_t fte;
+    static const ipv6_addr_t dst = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                              { .u64 = TEST_UINT64 } } };
+    static const ipv6_addr_t next_hops[] = {
+        { .u64 = { { .u8 = LINK_LOCAL_PREFIX }, { .u64 = TEST_UINT64 } } },
+        { .u64 = { { .u8 = LINK_LOCAL_PREFIX }, { .u64 = TEST_UINT64 + 1 } } },
+        { .u64 = { { .u8 = LINK_LOCAL_PREFIX }, { .u64 = TEST_UINT64 + 2 } } },
+    };
+    static const unsigned dst_lens[] = { 96, 64, 16 };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(dst_lens); i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_add(&dst, dst_lens[i],
+                                                      &next_hops[i], IFACE,
+                                                      0));
+    }
+    for (unsigned i = 0; i < ARRAY_SIZE(dst_lens); i++) {
+        TEST_ASSERT_EQUAL_INT(0, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+        TEST_ASSERT(ipv6_addr_equal(&next_hops[i], &fte.next_hop));
+        TEST_ASSERT_EQUAL_INT(dst_lens[i], fte.dst_len);
+        gnrc_ipv6_nib_ft_del(&dst, dst_lens[i]);
+    }
+    TEST_ASSERT_EQUAL_INT(-ENETUNREACH, gnrc_ipv6_nib_ft_get(&dst, NULL, &fte));
+}
+
 /*
  * Tries to create a forwarding table entry for the default route (::) with
  * NULL as next hop.
@@ -727,6 +760,7 @@ Test *tests_gnrc_ipv6_nib_ft_tests(void)
         new_TestFixture(test_nib_ft_get__success2),
         new_TestFixture(test_nib_ft_get__success3),
         new_TestFixture(test_nib_ft_get__success4),
+        new_TestFixture(test_nib_ft_get__success5),
         new_TestFixture(test_nib_ft_add__EINVAL_def_route_next_hop_NULL),
         new_TestFixture(test_nib_ft_add__EINVAL_iface0),
         new_TestFixture(test_nib_ft_add__ENOMEM_diff_def_router),
@@ -348,6 +348,40 @@ static void test_nib_get__success(void)
     TEST_ASSERT(nib_alloced == nib_got);
 }
 
+/*
+ * Creates GNRC_IPV6_NIB_NUMOF entries with different IP addresses, removes
+ * every second one and tries to get all of them.
+ * Expected result: _nib_onl_get() returns the remaining entries and NULL for
+ * the removed ones
+ */
+static void test_nib_get__success_removed(void)
+{
+    _nib_onl_entry_t *nodes[GNRC_IPV6_NIB_NUMOF];
+    ipv6_addr_t addr = { .u64 = { { .u8 = GLOBAL_PREFIX },
+                                  { .u64 = TEST_UINT64 } } };
+
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        TEST_ASSERT_NOT_NULL((nodes[i] = _nib_onl_alloc(&addr, IFACE)));
+        nodes[i]->mode = _NC;
+        addr.u64[1].u64++;
+    }
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i += 2) {
+        nodes[i]->mode = _EMPTY;
+        _nib_onl_clear(nodes[i]);
+    }
+    addr.u64[1].u64 = TEST_UINT64;
+    for (int i = 0; i < GNRC_IPV6_NIB_NUMOF; i++) {
+        if (i % 2) {
+            TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, IFACE));
+            TEST_ASSERT(nodes[i] == _nib_onl_get(&addr, 0));
+        }
+        else {
+            TEST_ASSERT_NULL(_nib_onl_get(&addr, IFACE));
+        }
+        addr.u64[1].u64++;
+    }
+}
+
 /*
  * Tries to get a NIB entry that is not in the NIB.
  * Expected result: _nib_onl_get() returns NULL
@@ -2020,6 +2054,7 @@ Test *tests_gnrc_ipv6_nib_internal_tests(void)
         new_TestFixture(test_nib_get__empty),
         new_TestFixture(test_nib_get__not_in_nib),
         new_TestFixture(test_nib_get__success),
+        new_TestFixture(test_nib_get__success_removed),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_iface),
         new_TestFixture(test_nib_nc_add__no_space_left_diff_addr_iface),
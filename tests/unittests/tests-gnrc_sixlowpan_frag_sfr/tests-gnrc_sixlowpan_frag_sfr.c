@@ -0,0 +1,495 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ */
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "bitfield.h"
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/frag/fb.h"
+#include "net/gnrc/sixlowpan/frag/rb.h"
+#include "net/gnrc/sixlowpan/frag/sfr.h"
+#include "net/gnrc/sixlowpan/frag/vrb.h"
+#include "net/gnrc/sixlowpan/internal.h"
+#include "net/sixlowpan.h"
+#include "net/sixlowpan/sfr.h"
+#include "thread.h"
+#include "utlist.h"
+#include "xtimer.h"
+
+#include "tests-gnrc_sixlowpan_frag_sfr.h"
+
+#define TEST_OWN            { 0x68, 0xDF, 0x2A, 0x5B, 0x21, 0x7D, 0xEE, 0xE5 }
+#define TEST_PEER           { 0xB1, 0x5B, 0x0F, 0x2F, 0x63, 0x76, 0x28, 0x39 }
+#define TEST_NEXT_HOP       { 0x13, 0xF8, 0xEB, 0x75, 0x46, 0x60, 0x7C, 0x60 }
+#define TEST_TAG            (26U)
+#define TEST_MAX_FRAG_SIZE  (32U)
+/* payload of a fragment sized to TEST_MAX_FRAG_SIZE */
+#define TEST_FRAG_SIZE      (TEST_MAX_FRAG_SIZE - sizeof(sixlowpan_sfr_rfrag_t))
+/* a datagram of three fragments */
+#define TEST_DATAGRAM_SIZE  (2 * TEST_FRAG_SIZE + 14U)
+/* the datagram with the dispatch for uncompressed IPv6 in front */
+#define TEST_COMPR_SIZE     (TEST_DATAGRAM_SIZE + 1U)
+#define TEST_MSG_QUEUE_SIZE (8U)
+
+/* Sending and forwarding goes to the message queue of the test thread, which
+ * is the thread of this interface. The 6LoWPAN thread does not run, so the
+ * timers of the inter-frame gap and ARQ expire unnoticed and the tests issue
+ * the next fragment themselves. */
+static gnrc_netif_t _netif;
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6_reg;
+
+static const uint8_t _own[] = TEST_OWN;
+static const uint8_t _peer[] = TEST_PEER;
+static const uint8_t _next_hop[] = TEST_NEXT_HOP;
+static uint8_t _datagram[TEST_DATAGRAM_SIZE];
+static uint8_t _compr[TEST_COMPR_SIZE];
+
+static inline size_t _min(size_t a, size_t b)
+{
+    return (a < b) ? a : b;
+}
+
+static void set_up(void)
+{
+    gnrc_sixlowpan_frag_rb_reset();
+    gnrc_sixlowpan_frag_vrb_reset();
+    gnrc_sixlowpan_frag_fb_reset();
+    gnrc_pktbuf_init();
+    for (unsigned i = 0; i < TEST_DATAGRAM_SIZE; i++) {
+        _datagram[i] = i;
+    }
+    _compr[0] = SIXLOWPAN_UNCOMP;
+    memcpy(&_compr[1], _datagram, sizeof(_datagram));
+}
+
+static void tear_down(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+}
+
+/* returns the packet of the next message of type @p type to the test thread,
+ * or NULL if there is none */
+static gnrc_pktsnip_t *_next_pkt(uint16_t type)
+{
+    msg_t msg;
+
+    if (msg_try_receive(&msg) < 1) {
+        return NULL;
+    }
+    if (msg.type != type) {
+        gnrc_pktbuf_release(msg.content.ptr);
+        return NULL;
+    }
+    return msg.content.ptr;
+}
+
+static gnrc_pktsnip_t *_netif_hdr(const uint8_t *src, size_t src_len)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(src, src_len, _own,
+                                                 sizeof(_own));
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    }
+    return netif;
+}
+
+/* sends the datagram to _peer and returns its tag */
+static uint8_t _send_datagram(void)
+{
+    gnrc_pktsnip_t *netif, *pkt;
+    /* the datagram gets the tag after this one */
+    uint8_t tag = gnrc_sixlowpan_frag_fb_next_tag() + 1;
+
+    pkt = gnrc_pktbuf_add(NULL, _datagram, sizeof(_datagram),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    netif = gnrc_netif_hdr_build(_own, sizeof(_own), _peer, sizeof(_peer));
+    if ((pkt == NULL) || (netif == NULL)) {
+        gnrc_pktbuf_release(pkt);
+        gnrc_pktbuf_release(netif);
+        return tag;
+    }
+    gnrc_netif_hdr_set_netif(netif->data, &_netif);
+    LL_PREPEND(pkt, netif);
+    gnrc_sixlowpan_multiplex_by_size(pkt, sizeof(_datagram), &_netif, 0);
+    return tag;
+}
+
+/* checks the next fragment of the datagram sent to _peer */
+static void _expect_frag(unsigned seq, bool ack_req, uint8_t tag)
+{
+    gnrc_pktsnip_t *pkt = _next_pkt(GNRC_NETAPI_MSG_TYPE_SND);
+    size_t offset = seq * TEST_FRAG_SIZE;
+    size_t size = _min(TEST_FRAG_SIZE, TEST_DATAGRAM_SIZE - offset);
+    gnrc_netif_hdr_t *netif_hdr;
+    sixlowpan_sfr_rfrag_t *rfrag;
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    netif_hdr = pkt->data;
+    TEST_ASSERT_EQUAL_INT(sizeof(_peer), netif_hdr->dst_l2addr_len);
+    TEST_ASSERT(memcmp(_peer, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                       sizeof(_peer)) == 0);
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_sfr_rfrag_t) + size,
+                          pkt->next->size);
+    rfrag = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is(&rfrag->base));
+    TEST_ASSERT_EQUAL_INT(tag, rfrag->base.tag);
+    TEST_ASSERT_EQUAL_INT(seq, sixlowpan_sfr_rfrag_get_seq(rfrag));
+    TEST_ASSERT_EQUAL_INT(ack_req, sixlowpan_sfr_rfrag_ack_req(rfrag));
+    TEST_ASSERT_EQUAL_INT(size, sixlowpan_sfr_rfrag_get_frag_size(rfrag));
+    /* the first fragment carries the datagram size in the offset field */
+    TEST_ASSERT_EQUAL_INT((seq == 0) ? TEST_DATAGRAM_SIZE : offset,
+                          sixlowpan_sfr_rfrag_get_offset(rfrag));
+    TEST_ASSERT(memcmp(&_datagram[offset], rfrag + 1, size) == 0);
+    gnrc_pktbuf_release(pkt);
+}
+
+/* checks the next acknowledgment, a NULL @p bitmap stands for a full one */
+static void _expect_ack(const uint8_t *dst, size_t dst_len, uint8_t tag,
+                        const uint8_t *bitmap)
+{
+    gnrc_pktsnip_t *pkt = _next_pkt(GNRC_NETAPI_MSG_TYPE_SND);
+    uint8_t full[SIXLOWPAN_SFR_ACK_BITMAP_SIZE / 8];
+    gnrc_netif_hdr_t *netif_hdr;
+    sixlowpan_sfr_ack_t *ack;
+
+    memset(full, UINT8_MAX, sizeof(full));
+    TEST_ASSERT_NOT_NULL(pkt);
+    netif_hdr = pkt->data;
+    TEST_ASSERT_EQUAL_INT(dst_len, netif_hdr->dst_l2addr_len);
+    TEST_ASSERT(memcmp(dst, gnrc_netif_hdr_get_dst_addr(netif_hdr),
+                       dst_len) == 0);
+    TEST_ASSERT_NOT_NULL(pkt->next);
+    TEST_ASSERT_EQUAL_INT(sizeof(sixlowpan_sfr_ack_t), pkt->next->size);
+    ack = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_ack_is(&ack->base));
+    TEST_ASSERT_EQUAL_INT(tag, ack->base.tag);
+    TEST_ASSERT(memcmp((bitmap == NULL) ? full : bitmap, ack->bitmap,
+                       sizeof(ack->bitmap)) == 0);
+    gnrc_pktbuf_release(pkt);
+}
+
+/* checks the datagram reassembled from the fragments of _peer */
+static void _expect_datagram(void)
+{
+    gnrc_pktsnip_t *pkt = _next_pkt(GNRC_NETAPI_MSG_TYPE_RCV);
+
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_IPV6, pkt->type);
+    TEST_ASSERT_EQUAL_INT(TEST_DATAGRAM_SIZE, pkt->size);
+    TEST_ASSERT(memcmp(_datagram, pkt->data, TEST_DATAGRAM_SIZE) == 0);
+    gnrc_pktbuf_release(pkt);
+}
+
+static void _recv_ack(const uint8_t *src, size_t src_len, uint8_t tag,
+                      const uint8_t *bitmap)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr(src, src_len), *pkt;
+    sixlowpan_sfr_ack_t *ack;
+
+    TEST_ASSERT_NOT_NULL(netif);
+    pkt = gnrc_pktbuf_add(netif, NULL, sizeof(sixlowpan_sfr_ack_t),
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    ack = pkt->data;
+    ack->base.disp_ecn = 0;
+    sixlowpan_sfr_ack_set_disp(&ack->base);
+    ack->base.tag = tag;
+    memcpy(ack->bitmap, bitmap, sizeof(ack->bitmap));
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+}
+
+/* receives a fragment of the (compressed) datagram of _peer */
+static void _recv_frag(uint8_t tag, unsigned seq, bool ack_req,
+                       uint16_t offset)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr(_peer, sizeof(_peer)), *pkt;
+    size_t size = _min(TEST_FRAG_SIZE, TEST_COMPR_SIZE - offset);
+    sixlowpan_sfr_rfrag_t *rfrag;
+
+    TEST_ASSERT_NOT_NULL(netif);
+    pkt = gnrc_pktbuf_add(netif, NULL, sizeof(sixlowpan_sfr_rfrag_t) + size,
+                          GNRC_NETTYPE_SIXLOWPAN);
+    TEST_ASSERT_NOT_NULL(pkt);
+    rfrag = pkt->data;
+    rfrag->base.disp_ecn = 0;
+    sixlowpan_sfr_rfrag_set_disp(&rfrag->base);
+    rfrag->base.tag = tag;
+    rfrag->ar_seq_fs.u16 = 0;
+    if (ack_req) {
+        sixlowpan_sfr_rfrag_set_ack_req(rfrag);
+    }
+    sixlowpan_sfr_rfrag_set_seq(rfrag, seq);
+    sixlowpan_sfr_rfrag_set_frag_size(rfrag, size);
+    sixlowpan_sfr_rfrag_set_offset(rfrag, (seq == 0) ? TEST_DATAGRAM_SIZE
+                                                     : offset);
+    memcpy(rfrag + 1, &_compr[offset], size);
+    gnrc_sixlowpan_frag_sfr_recv(pkt, NULL, 0);
+}
+
+static void _recv_compr_frag(unsigned seq, bool ack_req)
+{
+    _recv_frag(TEST_TAG, seq, ack_req, seq * TEST_FRAG_SIZE);
+}
+
+/* sends the datagram, which fits into the first window */
+static void _send_window(uint8_t *tag, gnrc_sixlowpan_frag_fb_t **fbuf)
+{
+    *tag = _send_datagram();
+    TEST_ASSERT_NOT_NULL((*fbuf = gnrc_sixlowpan_frag_fb_get_by_tag(*tag)));
+    _expect_frag(0, false, *tag);
+    /* only the first fragment is sent right away, the others follow what
+     * the inter-frame gap timer would issue */
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    gnrc_sixlowpan_frag_sfr_send(NULL, *fbuf, 0);
+    _expect_frag(1, false, *tag);
+    gnrc_sixlowpan_frag_sfr_send(NULL, *fbuf, 0);
+    /* the last fragment of the window requests an acknowledgment */
+    _expect_frag(2, true, *tag);
+    TEST_ASSERT((*fbuf)->sfr.arq_armed);
+}
+
+static void test_sfr_send__fragments(void)
+{
+    uint8_t full[SIXLOWPAN_SFR_ACK_BITMAP_SIZE / 8];
+    gnrc_sixlowpan_frag_fb_t *fbuf = NULL;
+    uint8_t tag;
+
+    memset(full, UINT8_MAX, sizeof(full));
+    _send_window(&tag, &fbuf);
+    TEST_ASSERT_NOT_NULL(fbuf);
+    /* nothing more to send until the acknowledgment arrives */
+    gnrc_sixlowpan_frag_sfr_send(NULL, fbuf, 0);
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    _recv_ack(_peer, sizeof(_peer), tag, full);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_fb_get_by_tag(tag));
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sfr_send__partial_ack(void)
+{
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+    gnrc_sixlowpan_frag_fb_t *fbuf = NULL;
+    uint8_t tag;
+
+    _send_window(&tag, &fbuf);
+    TEST_ASSERT_NOT_NULL(fbuf);
+    /* the second fragment got lost */
+    bf_set(bitmap, 0);
+    bf_set(bitmap, 2);
+    _recv_ack(_peer, sizeof(_peer), tag, bitmap);
+    TEST_ASSERT_NOT_NULL(gnrc_sixlowpan_frag_fb_get_by_tag(tag));
+    /* only the lost fragment is sent again, now requesting the
+     * acknowledgment */
+    _expect_frag(1, true, tag);
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    TEST_ASSERT(fbuf->sfr.arq_armed);
+    /* fragments already acknowledged stay acknowledged */
+    bf_set(bitmap, 1);
+    _recv_ack(_peer, sizeof(_peer), tag, bitmap);
+    /* all fragments are acknowledged */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_fb_get_by_tag(tag));
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sfr_send__null_ack(void)
+{
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+    gnrc_sixlowpan_frag_fb_t *fbuf = NULL;
+    uint8_t tag;
+
+    _send_window(&tag, &fbuf);
+    TEST_ASSERT_NOT_NULL(fbuf);
+    /* an acknowledgment from another node does not match the datagram */
+    _recv_ack(_next_hop, sizeof(_next_hop), tag, bitmap);
+    TEST_ASSERT(gnrc_sixlowpan_frag_fb_get_by_tag(tag) == fbuf);
+    /* the receiver aborts the datagram */
+    _recv_ack(_peer, sizeof(_peer), tag, bitmap);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_fb_get_by_tag(tag));
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sfr_send__tag_wrap(void)
+{
+    uint8_t full[SIXLOWPAN_SFR_ACK_BITMAP_SIZE / 8];
+    gnrc_sixlowpan_frag_fb_t *fbuf = NULL;
+    uint8_t tag;
+
+    memset(full, UINT8_MAX, sizeof(full));
+    /* the next tag has 9 bits, of which only the lower 8 bits are sent */
+    for (unsigned i = 0; i < (UINT8_MAX - 1); i++) {
+        gnrc_sixlowpan_frag_fb_next_tag();
+    }
+    _send_window(&tag, &fbuf);
+    TEST_ASSERT_NOT_NULL(fbuf);
+    TEST_ASSERT_EQUAL_INT(0, tag);
+    TEST_ASSERT_EQUAL_INT(0, fbuf->tag);
+    _recv_ack(_peer, sizeof(_peer), tag, full);
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_fb_get_by_tag(tag));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sfr_recv__ack_bitmap(void)
+{
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+
+    _recv_compr_frag(0, false);
+    /* no acknowledgment if not requested */
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    /* the last fragment overtakes the second one */
+    _recv_compr_frag(2, true);
+    bf_set(bitmap, 0);
+    bf_set(bitmap, 2);
+    _expect_ack(_peer, sizeof(_peer), TEST_TAG, bitmap);
+    /* a duplicate does not change the bitmap */
+    _recv_compr_frag(2, true);
+    _expect_ack(_peer, sizeof(_peer), TEST_TAG, bitmap);
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    /* the completed datagram is acknowledged even if not requested */
+    _recv_compr_frag(1, false);
+    _expect_datagram();
+    _expect_ack(_peer, sizeof(_peer), TEST_TAG, NULL);
+    if (CONFIG_GNRC_SIXLOWPAN_FRAG_RBUF_DEL_TIMER > 0) {
+        /* the acknowledgment got lost, so the sender asks again */
+        _recv_compr_frag(2, true);
+        _expect_ack(_peer, sizeof(_peer), TEST_TAG, NULL);
+    }
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sfr_recv__no_state(void)
+{
+    /* a later fragment without the first one is dropped */
+    _recv_compr_frag(1, true);
+    TEST_ASSERT_NULL(_next_pkt(GNRC_NETAPI_MSG_TYPE_SND));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_sfr_forward__tag_rewrite(void)
+{
+    const gnrc_sixlowpan_frag_rb_base_t base = {
+        .src = TEST_PEER,
+        .dst = TEST_OWN,
+        .src_len = sizeof(_peer),
+        .dst_len = sizeof(_own),
+        .tag = TEST_TAG,
+        .datagram_size = TEST_DATAGRAM_SIZE,
+    };
+    BITFIELD(bitmap, SIXLOWPAN_SFR_ACK_BITMAP_SIZE) = { 0 };
+    gnrc_sixlowpan_frag_vrb_t *vrbe;
+    sixlowpan_sfr_rfrag_t *rfrag;
+    sixlowpan_sfr_ack_t *ack;
+    gnrc_pktsnip_t *pkt;
+    uint8_t out_tag;
+
+    /* the outgoing tag has 9 bits, of which only the lower 8 bits are sent */
+    for (unsigned i = 0; i < UINT8_MAX; i++) {
+        gnrc_sixlowpan_frag_fb_next_tag();
+    }
+    TEST_ASSERT_NOT_NULL((vrbe = gnrc_sixlowpan_frag_vrb_add(
+            &base, &_netif, _next_hop, sizeof(_next_hop))));
+    TEST_ASSERT(vrbe->out_tag > UINT8_MAX);
+    out_tag = (uint8_t)vrbe->out_tag;
+    /* the first fragment was forwarded by IPHC with headers 3 bytes
+     * smaller */
+    vrbe->super.offset_diff = -3;
+    vrbe->in_netif = &_netif;
+
+    /* forward path: new tag and shifted offset */
+    _recv_compr_frag(1, false);
+    TEST_ASSERT_NOT_NULL((pkt = _next_pkt(GNRC_NETAPI_MSG_TYPE_SND)));
+    TEST_ASSERT_EQUAL_INT(sizeof(_next_hop),
+                          ((gnrc_netif_hdr_t *)pkt->data)->dst_l2addr_len);
+    TEST_ASSERT(memcmp(_next_hop, gnrc_netif_hdr_get_dst_addr(pkt->data),
+                       sizeof(_next_hop)) == 0);
+    rfrag = pkt->next->data;
+    TEST_ASSERT(sixlowpan_sfr_rfrag_is(&rfrag->base));
+    TEST_ASSERT_EQUAL_INT(out_tag, rfrag->base.tag);
+    TEST_ASSERT_EQUAL_INT(1, sixlowpan_sfr_rfrag_get_seq(rfrag));
+    TEST_ASSERT_EQUAL_INT(TEST_FRAG_SIZE - 3,
+                          sixlowpan_sfr_rfrag_get_offset(rfrag));
+    TEST_ASSERT(memcmp(&_compr[TEST_FRAG_SIZE], rfrag + 1,
+                       TEST_FRAG_SIZE) == 0);
+    gnrc_pktbuf_release(pkt);
+
+    /* reverse path: acknowledgments of the next hop get the original tag */
+    bf_set(bitmap, 0);
+    bf_set(bitmap, 1);
+    _recv_ack(_next_hop, sizeof(_next_hop), out_tag, bitmap);
+    _expect_ack(_peer, sizeof(_peer), TEST_TAG, bitmap);
+    /* the entry is kept for the fragments still to come */
+    TEST_ASSERT(gnrc_sixlowpan_frag_vrb_get(_peer, sizeof(_peer),
+                                            TEST_TAG) == vrbe);
+    memset(bitmap, UINT8_MAX, sizeof(bitmap));
+    _recv_ack(_next_hop, sizeof(_next_hop), out_tag, bitmap);
+    TEST_ASSERT_NOT_NULL((pkt = _next_pkt(GNRC_NETAPI_MSG_TYPE_SND)));
+    ack = pkt->next->data;
+    TEST_ASSERT_EQUAL_INT(TEST_TAG, ack->base.tag);
+    gnrc_pktbuf_release(pkt);
+    /* the datagram is done */
+    TEST_ASSERT_NULL(gnrc_sixlowpan_frag_vrb_get(_peer, sizeof(_peer),
+                                                 TEST_TAG));
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_sixlowpan_frag_sfr_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_sfr_send__fragments),
+        new_TestFixture(test_sfr_send__partial_ack),
+        new_TestFixture(test_sfr_send__null_ack),
+        new_TestFixture(test_sfr_send__tag_wrap),
+        new_TestFixture(test_sfr_recv__ack_bitmap),
+        new_TestFixture(test_sfr_recv__no_state),
+        new_TestFixture(test_sfr_forward__tag_rewrite),
+    };
+
+    EMB_UNIT_TESTCALLER(sfr_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&sfr_tests;
+}
+
+void tests_gnrc_sixlowpan_frag_sfr(void)
+{
+    xtimer_init();
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    _netif.pid = thread_getpid();
+    _netif.sixlo.max_frag_size = TEST_MAX_FRAG_SIZE;
+    netif_register(&_netif.netif);
+    gnrc_netreg_entry_init_pid(&_ipv6_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+    TESTS_RUN(tests_gnrc_sixlowpan_frag_sfr_tests());
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+}
+/** @} */
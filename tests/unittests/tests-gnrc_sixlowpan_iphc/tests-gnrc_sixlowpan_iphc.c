@@ -0,0 +1,521 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup tests
+ * @{
+ *
+ * @file
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+
+#include "byteorder.h"
+#include "checksum/crc16_ccitt.h"
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/gnrc/netif/hdr.h"
+#include "net/gnrc/netif/internal.h"
+#include "net/gnrc/netreg.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/sixlowpan/ctx.h"
+#include "net/gnrc/sixlowpan/iphc.h"
+#include "net/ipv6/hdr.h"
+#include "net/netdev.h"
+#include "net/protnum.h"
+#include "net/udp.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "tests-gnrc_sixlowpan_iphc.h"
+
+#define TEST_L2ADDR         { 0x2a, 0xab, 0xdc, 0x15, 0x54, 0x01, 0x64, 0x79 }
+#define TEST_DST_L2ADDR     { 0x3e, 0xe6, 0xb5, 0x22, 0xfd, 0x0a, 0x00, 0x01 }
+#define TEST_SEED           (0x6c0ac5e5U)
+#define TEST_PAYLOAD_SIZE   (8U)
+#define TEST_MSG_QUEUE_SIZE (4U)
+
+enum {
+    PREFIX_LINK_LOCAL = 0,
+    PREFIX_CTX_0,
+    PREFIX_CTX_1,           /* requires context identifier extension */
+    PREFIX_GLOBAL,          /* not covered by a context */
+    PREFIX_NUMOF,
+};
+
+enum {
+    IID_L2 = 0,             /* derived from link-layer address */
+    IID_SHORT,              /* 0000:00ff:fe00:XXXX */
+    IID_RANDOM,
+    IID_NUMOF,
+};
+
+enum {
+    MCAST_8 = 0,            /* ff02::XX */
+    MCAST_32,               /* ffXX::00XX:XXXX */
+    MCAST_48,               /* ffXX::00XX:XXXX:XXXX */
+    MCAST_CTX_0,            /* unicast-prefix-based (RFC 3306) */
+    MCAST_CTX_1,
+    MCAST_FULL,
+    MCAST_NUMOF,
+};
+
+/**
+ * @brief   Length and CRC-16-CCITT of the compressed frames of the headers
+ *          built by _build_datagram(), as produced by the encoder before it
+ *          was optimized
+ *
+ * The vectors are indexed by the vector number: its lowest two bits select
+ * the traffic class and flow label compression (TF), the next two the hop
+ * limit compression (HLIM) and the fifth whether the next header is
+ * compressed (NH). Source and destination address are chosen randomly from
+ * all address modes, with and without context (CID, SAC/SAM, M/DAC/DAM).
+ */
+static const struct {
+    uint8_t len;
+    uint16_t crc;
+} _golden[] = {
+    { 31, 0x88ea }, { 39, 0x7366 }, { 29, 0x5d04 }, { 44, 0x8827 },
+    { 47, 0xf57d }, { 17, 0xff3e }, { 20, 0x3f7c }, { 35, 0x20fa },
+    { 31, 0xfbda }, { 32, 0x4687 }, { 30, 0x116a }, { 28, 0xfc5f },
+    { 24, 0xfb15 }, { 20, 0x58ef }, { 28, 0x3162 }, { 20, 0x3dd7 },
+    { 25, 0x0ea7 }, { 30, 0x1fca }, { 35, 0xc56d }, { 20, 0x52c2 },
+    { 24, 0x2380 }, { 19, 0xb7c6 }, { 31, 0x57f2 }, { 35, 0x377f },
+    { 34, 0x6c54 }, { 25, 0xba7f }, { 41, 0x9985 }, { 33, 0x8207 },
+    { 38, 0x3920 }, { 45, 0x7428 }, { 24, 0xfa47 }, { 15, 0x4e50 },
+    { 19, 0xea4f }, { 37, 0x3ea3 }, { 13, 0x4879 }, { 27, 0x65fe },
+    { 30, 0xdd58 }, { 20, 0xc792 }, { 15, 0xa81e }, { 27, 0x7bd0 },
+    { 31, 0x98f7 }, { 38, 0x21f1 }, { 20, 0xa222 }, { 33, 0xa4f8 },
+    { 47, 0x9f43 }, { 17, 0xd449 }, { 28, 0x1e5b }, { 30, 0xfc2d },
+    { 39, 0xfc4f }, { 28, 0x62ca }, { 19, 0xd6ba }, { 34, 0x2ff3 },
+    { 26, 0x2dab }, { 20, 0xd560 }, { 34, 0x1eac }, { 35, 0x9967 },
+    { 29, 0x2107 }, { 27, 0x7a38 }, { 40, 0x5559 }, { 22, 0x1bd7 },
+    { 29, 0x6583 }, { 20, 0xd9b9 }, { 26, 0x6b58 }, { 20, 0x4db9 },
+    { 30, 0xb365 }, { 26, 0xe4a1 }, { 35, 0x2c0f }, { 18, 0x2afc },
+    { 37, 0xd077 }, { 17, 0x9c94 }, { 35, 0x0210 }, { 43, 0xa7ac },
+    { 32, 0x8050 }, { 24, 0xee5e }, { 36, 0xfe1c }, { 27, 0x5656 },
+    { 18, 0x503f }, { 32, 0x83ce }, { 14, 0x3f6d }, { 23, 0x636e },
+    { 30, 0x7aff }, { 29, 0xbc8f }, { 20, 0x3e7c }, { 35, 0x5d14 },
+    { 40, 0x4995 }, { 32, 0x5d5c }, { 50, 0xd2bf }, { 33, 0x4c13 },
+    { 24, 0x63f4 }, { 49, 0x826d }, { 16, 0x6200 }, { 34, 0xa1ad },
+    { 44, 0x5853 }, { 52, 0x6e8a }, { 35, 0x1fef }, { 49, 0x89e8 },
+    { 30, 0x0832 }, { 29, 0x37ee }, { 35, 0xe788 }, { 15, 0x070d },
+    { 40, 0x3e03 }, { 21, 0xac1d }, { 18, 0xa83b }, { 17, 0x79cc },
+    { 40, 0xc292 }, { 46, 0xd303 }, { 26, 0xb22b }, { 30, 0x083b },
+    { 18, 0xa0f3 }, { 18, 0x76a3 }, { 36, 0xaaa8 }, { 20, 0xac64 },
+    { 31, 0xc02f }, { 37, 0x32e2 }, { 21, 0x3bd4 }, { 35, 0xeb59 },
+    { 30, 0xf0c3 }, { 23, 0x50cc }, { 40, 0xbe0e }, { 14, 0x5bb8 },
+    { 19, 0x6560 }, { 29, 0x68fc }, { 23, 0x108a }, { 36, 0x0b80 },
+    { 35, 0x3970 }, { 27, 0xfad0 }, { 24, 0xcc98 }, { 38, 0x4b9b },
+    { 31, 0x0e7c }, { 33, 0x53b0 }, { 24, 0xa88c }, { 29, 0xab47 },
+    { 37, 0x7d70 }, { 38, 0xc9de }, { 36, 0xd4c4 }, { 17, 0x680d },
+    { 37, 0x685f }, { 21, 0x4530 }, { 28, 0x35d0 }, { 29, 0xcf2b },
+    { 21, 0xb5df }, { 24, 0xbfa3 }, { 37, 0xca00 }, { 21, 0x5f71 },
+    { 25, 0x1305 }, { 31, 0x66c8 }, { 21, 0x7d4e }, { 20, 0xcf85 },
+    { 39, 0x9472 }, { 37, 0x7b97 }, { 27, 0x46dc }, { 30, 0x3ba9 },
+    { 27, 0x5a44 }, { 28, 0xc5c7 }, { 21, 0xcb95 }, { 38, 0x385e },
+    { 29, 0x0fb1 }, { 24, 0xe20c }, { 34, 0x4b97 }, { 24, 0x07f0 },
+    { 32, 0x8052 }, { 19, 0x8c5f }, { 29, 0x0d44 }, { 44, 0xa49c },
+    { 35, 0x26a7 }, { 22, 0x831d }, { 14, 0x0713 }, { 20, 0xb7a3 },
+    { 18, 0xb257 }, { 30, 0x30ed }, { 19, 0x4e32 }, { 35, 0x5519 },
+    { 34, 0x79db }, { 25, 0xf8ad }, { 21, 0x642f }, { 15, 0xdb5f },
+    { 28, 0xac8f }, { 42, 0x692c }, { 35, 0x65bc }, { 24, 0x57cf },
+    { 39, 0x7fe1 }, { 20, 0xaed7 }, { 32, 0x0386 }, { 41, 0xe7d9 },
+    { 34, 0xfc2c }, { 22, 0x26b6 }, { 35, 0x6cab }, { 17, 0x0b1e },
+    { 42, 0x1c8a }, { 24, 0xedc8 }, { 34, 0x9995 }, { 25, 0x1fde },
+    { 24, 0x2c02 }, { 23, 0x41ba }, { 24, 0x792b }, { 20, 0x3940 },
+    { 47, 0xa110 }, { 15, 0x601c }, { 22, 0x5afd }, { 27, 0x085c },
+    { 35, 0x4b49 }, { 15, 0x2af4 }, { 28, 0x712f }, { 35, 0x6383 },
+    { 47, 0xe94d }, { 23, 0xea69 }, { 36, 0x0ac1 }, { 34, 0x0b65 },
+    { 27, 0x8265 }, { 30, 0x670b }, { 20, 0xd469 }, { 40, 0x7c72 },
+    { 20, 0x4858 }, { 38, 0xb7df }, { 22, 0xbe86 }, { 31, 0x372f },
+    { 25, 0xd158 }, { 25, 0xacda }, { 35, 0x8072 }, { 25, 0x1259 },
+    { 40, 0x98dc }, { 42, 0x017f }, { 31, 0xc162 }, { 14, 0xe0ab },
+    { 24, 0x42d2 }, { 24, 0x300d }, { 30, 0xccad }, { 12, 0xc63a },
+    { 24, 0x1ecb }, { 46, 0x2485 }, { 32, 0x915d }, { 27, 0xa0b2 },
+    { 33, 0xf8fc }, { 19, 0x963c }, { 36, 0xa0a2 }, { 34, 0x50c3 },
+    { 21, 0xbe6c }, { 31, 0xf748 }, { 14, 0x1208 }, { 14, 0x6970 },
+    { 42, 0xaa46 }, { 24, 0xdd51 }, { 24, 0x9ed3 }, { 25, 0xc2db },
+    { 38, 0x4243 }, { 30, 0xe346 }, { 37, 0x9d9f }, { 19, 0xc699 },
+    { 24, 0xba14 }, { 38, 0x286b }, { 35, 0x3437 }, { 36, 0x7424 },
+    { 38, 0x67d1 }, { 42, 0x196b }, { 42, 0x0e20 }, { 26, 0x8e02 },
+};
+
+static const uint8_t _l2addr[] = TEST_L2ADDR;
+static const uint8_t _dst_l2addr[] = TEST_DST_L2ADDR;
+static const ipv6_addr_t _prefixes[] = {
+    { .u8 = { 0xfe, 0x80 } },
+    { .u8 = { 0x20, 0x01, 0x0d, 0xb8 } },
+    { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01 } },
+    { .u8 = { 0x20, 0x01, 0x0d, 0xb8, 0xff, 0xff } },
+};
+/* hop limits indexed by the compressed HLIM field, 0 means carried inline */
+static const uint8_t _hop_limits[] = { 0, 1, 64, 255 };
+
+static gnrc_netif_t _own_netif;
+static gnrc_netif_t *_netif;
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+static gnrc_netreg_entry_t _ipv6_reg;
+static eui64_t _src_iid, _dst_iid;
+static uint32_t _rand_state;
+
+/* the uncompressed datagram */
+static uint8_t _datagram[sizeof(ipv6_hdr_t) + sizeof(udp_hdr_t) +
+                         TEST_PAYLOAD_SIZE];
+static size_t _datagram_len;
+/* the compressed frame without the interface header */
+static uint8_t _frame[sizeof(_datagram) + 2];
+static size_t _frame_len;
+
+/* xorshift32, so the vectors do not depend on the random module */
+static uint32_t _rand(void)
+{
+    _rand_state ^= _rand_state << 13;
+    _rand_state ^= _rand_state >> 17;
+    _rand_state ^= _rand_state << 5;
+    return _rand_state;
+}
+
+static void _rand_bytes(uint8_t *buf, size_t len)
+{
+    while (len--) {
+        *(buf++) = (uint8_t)_rand();
+    }
+}
+
+static void _set_unicast(ipv6_addr_t *addr, const eui64_t *l2)
+{
+    memcpy(addr, &_prefixes[_rand() % PREFIX_NUMOF], 8);
+    switch (_rand() % IID_NUMOF) {
+        case IID_L2:
+            memcpy(&addr->u64[1], l2, sizeof(addr->u64[1]));
+            break;
+        case IID_SHORT:
+            addr->u32[2] = byteorder_htonl(0x000000ff);
+            addr->u32[3] = byteorder_htonl(0xfe000000 | (_rand() & 0xffff));
+            break;
+        default:
+            _rand_bytes(&addr->u8[8], 8);
+            break;
+    }
+}
+
+static void _set_multicast(ipv6_addr_t *addr)
+{
+    unsigned mode = _rand() % MCAST_NUMOF;
+
+    memset(addr, 0, sizeof(*addr));
+    addr->u8[0] = 0xff;
+    switch (mode) {
+        case MCAST_8:
+            addr->u8[1] = 0x02;
+            addr->u8[15] = (uint8_t)_rand();
+            break;
+        case MCAST_32:
+            addr->u8[1] = (uint8_t)_rand();
+            _rand_bytes(&addr->u8[13], 3);
+            break;
+        case MCAST_48:
+            addr->u8[1] = (uint8_t)_rand();
+            _rand_bytes(&addr->u8[11], 5);
+            break;
+        case MCAST_CTX_0:
+        case MCAST_CTX_1:
+            /* ffXX:XX40:<64 bit prefix>:XXXX:XXXX */
+            addr->u8[1] = (uint8_t)_rand();
+            addr->u8[2] = (uint8_t)_rand();
+            addr->u8[3] = 64;
+            memcpy(&addr->u8[4],
+                   &_prefixes[PREFIX_CTX_0 + mode - MCAST_CTX_0], 8);
+            _rand_bytes(&addr->u8[12], 4);
+            break;
+        default:
+            _rand_bytes(&addr->u8[1], 15);
+            /* no valid prefix length, so unicast-prefix-based compression
+             * does not apply */
+            addr->u8[3] = 0xff;
+            break;
+    }
+}
+
+/* builds the uncompressed datagram of vector @p vector */
+static void _build_datagram(unsigned vector)
+{
+    ipv6_hdr_t *ipv6_hdr = (ipv6_hdr_t *)_datagram;
+    uint8_t tc = (uint8_t)_rand();
+    uint32_t fl = _rand() & 0xfff00;
+    uint8_t hl = _hop_limits[(vector >> 2) & 0x3];
+
+    memset(_datagram, 0, sizeof(_datagram));
+    ipv6_hdr_set_version(ipv6_hdr);
+    /* the last byte of the flow label is not carried inline by the encoder,
+     * so it stays zero to be able to compare the datagrams */
+    switch (vector & 0x3) {
+        case 0:     /* ECN + DSCP + flow label inline */
+            tc |= 0x01;
+            fl |= 0x00100;
+            break;
+        case 1:     /* ECN + flow label inline */
+            tc &= 0xc0;
+            fl |= 0x00100;
+            break;
+        case 2:     /* ECN + DSCP inline */
+            tc |= 0x01;
+            fl = 0;
+            break;
+        default:    /* elided */
+            tc = 0;
+            fl = 0;
+            break;
+    }
+    ipv6_hdr_set_tc(ipv6_hdr, tc);
+    ipv6_hdr_set_fl(ipv6_hdr, fl);
+    if (hl == 0) {
+        /* any other hop limit is carried inline */
+        do {
+            hl = (uint8_t)_rand();
+        } while ((hl == 1) || (hl == 64) || (hl == 255));
+    }
+    ipv6_hdr->hl = hl;
+    if ((_rand() % (PREFIX_NUMOF * IID_NUMOF + 1)) == 0) {
+        ipv6_addr_set_unspecified(&ipv6_hdr->src);
+    }
+    else {
+        _set_unicast(&ipv6_hdr->src, &_src_iid);
+    }
+    if (_rand() & 0x1) {
+        _set_multicast(&ipv6_hdr->dst);
+    }
+    else {
+        _set_unicast(&ipv6_hdr->dst, &_dst_iid);
+    }
+    _datagram_len = sizeof(ipv6_hdr_t);
+    if (vector & 0x10) {
+        udp_hdr_t *udp_hdr = (udp_hdr_t *)&_datagram[_datagram_len];
+        uint16_t src_port = (uint16_t)_rand(), dst_port = (uint16_t)_rand();
+
+        /* cover all port compressions */
+        switch (_rand() & 0x3) {
+            case 0:
+                src_port = 0xf0b0 | (src_port & 0xf);
+                dst_port = 0xf0b0 | (dst_port & 0xf);
+                break;
+            case 1:
+                src_port = 0xf000 | (src_port & 0xff);
+                break;
+            case 2:
+                dst_port = 0xf000 | (dst_port & 0xff);
+                break;
+            default:
+                break;
+        }
+        ipv6_hdr->nh = PROTNUM_UDP;
+        udp_hdr->src_port = byteorder_htons(src_port);
+        udp_hdr->dst_port = byteorder_htons(dst_port);
+        udp_hdr->length = byteorder_htons(sizeof(udp_hdr_t) +
+                                          TEST_PAYLOAD_SIZE);
+        udp_hdr->checksum = byteorder_htons((uint16_t)_rand());
+        _datagram_len += sizeof(udp_hdr_t);
+    }
+    else {
+        ipv6_hdr->nh = PROTNUM_ICMPV6;
+    }
+    _rand_bytes(&_datagram[_datagram_len], TEST_PAYLOAD_SIZE);
+    _datagram_len += TEST_PAYLOAD_SIZE;
+    ipv6_hdr->len = byteorder_htons(_datagram_len - sizeof(ipv6_hdr_t));
+}
+
+static gnrc_pktsnip_t *_netif_hdr(const uint8_t *src, size_t src_len)
+{
+    gnrc_pktsnip_t *netif = gnrc_netif_hdr_build(src, src_len, _dst_l2addr,
+                                                 sizeof(_dst_l2addr));
+
+    if (netif != NULL) {
+        gnrc_netif_hdr_set_netif(netif->data, _netif);
+    }
+    return netif;
+}
+
+/* returns the packet of the next message of type @p type to the test thread,
+ * or NULL if there is none */
+static gnrc_pktsnip_t *_next_pkt(uint16_t type)
+{
+    msg_t msg;
+
+    if (msg_try_receive(&msg) < 1) {
+        return NULL;
+    }
+    if (msg.type != type) {
+        gnrc_pktbuf_release(msg.content.ptr);
+        return NULL;
+    }
+    return msg.content.ptr;
+}
+
+/* compresses the datagram into _frame, returns 0 on success */
+static int _encode(void)
+{
+    gnrc_pktsnip_t *pkt, *netif;
+
+    pkt = gnrc_pktbuf_add(NULL, &_datagram[sizeof(ipv6_hdr_t)],
+                          _datagram_len - sizeof(ipv6_hdr_t),
+                          GNRC_NETTYPE_UNDEF);
+    if (pkt == NULL) {
+        return -1;
+    }
+    pkt = gnrc_pktbuf_add(pkt, _datagram, sizeof(ipv6_hdr_t),
+                          GNRC_NETTYPE_IPV6);
+    if (pkt == NULL) {
+        return -1;
+    }
+    if ((netif = _netif_hdr(NULL, 0)) == NULL) {
+        gnrc_pktbuf_release(pkt);
+        return -1;
+    }
+    netif->next = pkt;
+    gnrc_sixlowpan_iphc_send(netif, NULL, 0);
+    if ((pkt = _next_pkt(GNRC_NETAPI_MSG_TYPE_SND)) == NULL) {
+        return -1;
+    }
+    _frame_len = 0;
+    for (gnrc_pktsnip_t *snip = pkt->next; snip != NULL; snip = snip->next) {
+        if ((_frame_len + snip->size) > sizeof(_frame)) {
+            gnrc_pktbuf_release(pkt);
+            return -1;
+        }
+        memcpy(&_frame[_frame_len], snip->data, snip->size);
+        _frame_len += snip->size;
+    }
+    gnrc_pktbuf_release(pkt);
+    return 0;
+}
+
+/* decompresses _frame and returns the decoded datagram */
+static gnrc_pktsnip_t *_decode(void)
+{
+    gnrc_pktsnip_t *netif = _netif_hdr(_netif->l2addr, _netif->l2addr_len);
+    gnrc_pktsnip_t *sixlo;
+
+    if (netif == NULL) {
+        return NULL;
+    }
+    sixlo = gnrc_pktbuf_add(netif, _frame, _frame_len,
+                            GNRC_NETTYPE_SIXLOWPAN);
+    if (sixlo == NULL) {
+        gnrc_pktbuf_release(netif);
+        return NULL;
+    }
+    gnrc_sixlowpan_iphc_recv(sixlo, NULL, 0);
+    return _next_pkt(GNRC_NETAPI_MSG_TYPE_RCV);
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    gnrc_sixlowpan_ctx_reset();
+    gnrc_sixlowpan_ctx_update(0, &_prefixes[PREFIX_CTX_0], 64, UINT16_MAX,
+                              true);
+    gnrc_sixlowpan_ctx_update(1, &_prefixes[PREFIX_CTX_1], 64, UINT16_MAX,
+                              true);
+    _rand_state = TEST_SEED;
+}
+
+static void tear_down(void)
+{
+    msg_t msg;
+
+    while (msg_try_receive(&msg) > 0) {
+        gnrc_pktbuf_release(msg.content.ptr);
+    }
+    gnrc_sixlowpan_ctx_reset();
+}
+
+static void test_iphc_encode__golden(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_golden); i++) {
+        _build_datagram(i);
+        TEST_ASSERT_EQUAL_INT(0, _encode());
+        TEST_ASSERT_EQUAL_INT(_golden[i].len, _frame_len);
+        TEST_ASSERT_EQUAL_INT(_golden[i].crc,
+                              crc16_ccitt_calc(_frame, _frame_len));
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_iphc_decode__round_trip(void)
+{
+    for (unsigned i = 0; i < ARRAY_SIZE(_golden); i++) {
+        gnrc_pktsnip_t *pkt;
+
+        _build_datagram(i);
+        TEST_ASSERT_EQUAL_INT(0, _encode());
+        TEST_ASSERT_NOT_NULL((pkt = _decode()));
+        TEST_ASSERT_EQUAL_INT(_datagram_len, pkt->size);
+        TEST_ASSERT_EQUAL_INT(0, memcmp(_datagram, pkt->data, pkt->size));
+        gnrc_pktbuf_release(pkt);
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static Test *tests_gnrc_sixlowpan_iphc_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_iphc_encode__golden),
+        new_TestFixture(test_iphc_decode__round_trip),
+    };
+
+    EMB_UNIT_TESTCALLER(iphc_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&iphc_tests;
+}
+
+void tests_gnrc_sixlowpan_iphc(void)
+{
+    gnrc_pktsnip_t *netif;
+    uint32_t flags;
+    uint8_t max_frag_size;
+    uint8_t device_type;
+
+    xtimer_init();
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    /* the interface of other suites for this thread would shadow our own one
+     * in gnrc_netif_get_by_pid(), so use theirs instead */
+    if ((_netif = gnrc_netif_get_by_pid(thread_getpid())) == NULL) {
+        _netif = &_own_netif;
+        _netif->pid = thread_getpid();
+        netif_register(&_netif->netif);
+    }
+    flags = _netif->flags;
+    max_frag_size = _netif->sixlo.max_frag_size;
+    device_type = _netif->device_type;
+    _netif->flags |= GNRC_NETIF_FLAGS_HAS_L2ADDR;
+    _netif->device_type = NETDEV_TYPE_IEEE802154;
+    memcpy(_netif->l2addr, _l2addr, sizeof(_l2addr));
+    _netif->l2addr_len = sizeof(_l2addr);
+    /* don't fragment */
+    _netif->sixlo.max_frag_size = 0;
+    gnrc_pktbuf_init();
+    gnrc_netif_ipv6_get_iid(_netif, &_src_iid);
+    if ((netif = _netif_hdr(NULL, 0)) != NULL) {
+        gnrc_netif_hdr_ipv6_iid_from_dst(_netif, netif->data, &_dst_iid);
+        gnrc_pktbuf_release(netif);
+    }
+    gnrc_netreg_entry_init_pid(&_ipv6_reg, GNRC_NETREG_DEMUX_CTX_ALL,
+                               thread_getpid());
+    gnrc_netreg_register(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+    TESTS_RUN(tests_gnrc_sixlowpan_iphc_tests());
+    gnrc_netreg_unregister(GNRC_NETTYPE_IPV6, &_ipv6_reg);
+    _netif->flags = flags;
+    _netif->sixlo.max_frag_size = max_frag_size;
+    _netif->device_type = device_type;
+    _netif->l2addr_len = 0;
+}
+/** @} */
@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the selection of retransmitted segments by the
+ *              FSM of GNRC TCP
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+#include "msg.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/ipv6/addr.h"
+#include "net/ipv6/hdr.h"
+#include "net/tcp.h"
+#include "thread.h"
+#include "utlist.h"
+
+#include "internal/cc.h"
+#include "internal/common.h"
+#include "internal/fsm.h"
+#include "internal/option.h"
+#include "internal/rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define ISS             (0x1000U)
+#define IRS             (0x2000U)
+#define LOCAL_PORT      (2000U)
+#define PEER_PORT       (1000U)
+#define MSS             (100U)
+#define WND             (4000U)
+#define SEGS            (4U)
+#define SENT_MAX        (8U)
+
+static gnrc_tcp_tcb_t _tcb;
+static kernel_pid_t _tcp_pid;
+static uint8_t _data[SEGS * MSS];
+
+/* sequence number of segment i of _data */
+static uint32_t _seg(unsigned i)
+{
+    return ISS + 1 + i * MSS;
+}
+
+/* gets the sequence numbers of the segments passed down the stack */
+static unsigned _sent(uint32_t *seqs)
+{
+    msg_t msg;
+    unsigned num = 0;
+
+    while (msg_try_receive(&msg) == 1) {
+        gnrc_pktsnip_t *pkt = msg.content.ptr;
+        gnrc_pktsnip_t *tcp;
+
+        if (msg.type != GNRC_NETAPI_MSG_TYPE_SND) {
+            continue;
+        }
+        LL_SEARCH_SCALAR(pkt, tcp, type, GNRC_NETTYPE_TCP);
+        if ((tcp != NULL) && (num < SENT_MAX)) {
+            seqs[num++] = byteorder_ntohl(((tcp_hdr_t *)tcp->data)->seq_num);
+        }
+        gnrc_pktbuf_release(pkt);
+    }
+    return num;
+}
+
+/* checks that exactly the given segments were passed down the stack */
+static bool _sent_segs(const unsigned *segs, unsigned num)
+{
+    uint32_t seqs[SENT_MAX];
+
+    if (_sent(seqs) != num) {
+        return false;
+    }
+    for (unsigned i = 0; i < num; i++) {
+        if (seqs[i] != _seg(segs[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* passes an ACK from the peer to the FSM, SACK blocks are offsets into _data */
+static void _ack(uint32_t ack, const uint32_t (*blocks)[2], unsigned num)
+{
+    uint8_t opts[2 + TCP_OPTION_LENGTH_MIN +
+                 TCP_OPTION_SACK_BLOCKS_MAX * TCP_OPTION_LENGTH_SACK_BLOCK];
+    size_t opts_len = 0;
+    gnrc_pktsnip_t *ip = gnrc_pktbuf_add(NULL, NULL, sizeof(ipv6_hdr_t),
+                                         GNRC_NETTYPE_IPV6);
+    gnrc_pktsnip_t *tcp;
+    tcp_hdr_t hdr = {
+        .src_port = byteorder_htons(PEER_PORT),
+        .dst_port = byteorder_htons(LOCAL_PORT),
+        .seq_num = byteorder_htonl(IRS + 1),
+        .ack_num = byteorder_htonl(ack),
+        .window = byteorder_htons(WND),
+    };
+
+    if (num > 0) {
+        opts[0] = TCP_OPTION_KIND_NOP;
+        opts[1] = TCP_OPTION_KIND_NOP;
+        opts[2] = TCP_OPTION_KIND_SACK;
+        opts[3] = TCP_OPTION_LENGTH_MIN + num * TCP_OPTION_LENGTH_SACK_BLOCK;
+        opts_len = 4;
+        for (unsigned i = 0; i < num; i++) {
+            network_uint32_t edges[2] = { byteorder_htonl(_seg(0) + blocks[i][0]),
+                                          byteorder_htonl(_seg(0) + blocks[i][1]) };
+
+            memcpy(&opts[opts_len], edges, sizeof(edges));
+            opts_len += sizeof(edges);
+        }
+    }
+    hdr.off_ctl = byteorder_htons(
+        _option_build_offset_control(TCP_HDR_OFFSET_MIN + opts_len / 4, MSK_ACK));
+    memset(ip->data, 0, ip->size);
+    tcp = gnrc_pktbuf_add(ip, NULL, sizeof(hdr) + opts_len, GNRC_NETTYPE_TCP);
+    memcpy(tcp->data, &hdr, sizeof(hdr));
+    memcpy((uint8_t *)tcp->data + sizeof(hdr), opts, opts_len);
+    _fsm(&_tcb, FSM_EVENT_RCVD_PKT, tcp, NULL, 0);
+    gnrc_pktbuf_release(tcp);
+}
+
+/* passes three duplicate ACKs carrying the same SACK blocks to the FSM */
+static void _dup_acks(const uint32_t (*blocks)[2], unsigned num)
+{
+    for (unsigned i = 0; i < 3; i++) {
+        _ack(_seg(0), blocks, num);
+    }
+}
+
+static bool _send(void)
+{
+    static const unsigned segs[] = { 0, 1, 2, 3 };
+
+    return (_fsm(&_tcb, FSM_EVENT_CALL_SEND, NULL, _data, sizeof(_data)) == sizeof(_data)) &&
+           _sent_segs(segs, ARRAY_SIZE(segs));
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    _rcvbuf_init();
+    gnrc_tcp_tcb_init(&_tcb);
+    _rcvbuf_get_buffer(&_tcb);
+    /* the tests take the place of the TCP thread */
+    _tcp_pid = gnrc_tcp_pid;
+    gnrc_tcp_pid = thread_getpid();
+
+    ipv6_addr_from_str((ipv6_addr_t *)_tcb.local_addr, "2001:db8::1");
+    ipv6_addr_from_str((ipv6_addr_t *)_tcb.peer_addr, "2001:db8::2");
+    _tcb.local_port = LOCAL_PORT;
+    _tcb.peer_port = PEER_PORT;
+    _tcb.iss = ISS;
+    _tcb.snd_una = ISS + 1;
+    _tcb.snd_nxt = ISS + 1;
+    _tcb.recover = ISS;
+    _tcb.snd_wnd = WND;
+    _tcb.snd_wl1 = IRS + 1;
+    _tcb.snd_wl2 = ISS + 1;
+    _tcb.irs = IRS;
+    _tcb.rcv_nxt = IRS + 1;
+    _tcb.rcv_wnd = ringbuffer_get_free(&_tcb.rcv_buf);
+    _tcb.mss = MSS;
+    _tcb.status |= STATUS_SACK_PERM;
+    _tcb.state = FSM_STATE_ESTABLISHED;
+    _cc_init(&_tcb);
+}
+
+static void tear_down(void)
+{
+    uint32_t seqs[SENT_MAX];
+
+    _fsm(&_tcb, FSM_EVENT_CLEAR_RETRANSMIT, NULL, NULL, 0);
+    _rcvbuf_release_buffer(&_tcb);
+    _sent(seqs);
+    gnrc_tcp_pid = _tcp_pid;
+}
+
+static void test_fsm_call_send(void)
+{
+    TEST_ASSERT(_send());
+    TEST_ASSERT_EQUAL_INT(SEGS, _tcb.rtx_num);
+    TEST_ASSERT_EQUAL_INT(_seg(SEGS), _tcb.snd_nxt);
+    /* the congestion window is full */
+    TEST_ASSERT_EQUAL_INT(0, _fsm(&_tcb, FSM_EVENT_CALL_SEND, NULL, _data, sizeof(_data)));
+    TEST_ASSERT(_sent_segs(NULL, 0));
+}
+
+static void test_fsm_rcvd_pkt__sack_fast_retransmit(void)
+{
+    static const uint32_t blocks1[][2] = { { 100, 200 } };
+    static const uint32_t blocks2[][2] = { { 300, 400 }, { 100, 200 } };
+    static const unsigned exp[] = { 0, 2 };
+
+    TEST_ASSERT(_send());
+    _ack(_seg(0), blocks1, ARRAY_SIZE(blocks1));
+    _ack(_seg(0), blocks1, ARRAY_SIZE(blocks1));
+    /* SACKs before the third duplicate ACK retransmit nothing */
+    TEST_ASSERT(_sent_segs(NULL, 0));
+    TEST_ASSERT(_tcb.rtx[1].sacked);
+    TEST_ASSERT(!(_tcb.status & STATUS_FAST_RECOVERY));
+    /* the oldest segment and the hole below the last SACKed segment */
+    _ack(_seg(0), blocks2, ARRAY_SIZE(blocks2));
+    TEST_ASSERT(_tcb.status & STATUS_FAST_RECOVERY);
+    TEST_ASSERT(_sent_segs(exp, ARRAY_SIZE(exp)));
+    TEST_ASSERT(_tcb.rtx[3].sacked);
+}
+
+static void test_fsm_rcvd_pkt__sack_retransmit_once(void)
+{
+    static const uint32_t blocks[][2] = { { 300, 400 }, { 100, 200 } };
+    static const unsigned exp[] = { 0, 2 };
+
+    TEST_ASSERT(_send());
+    _dup_acks(blocks, ARRAY_SIZE(blocks));
+    TEST_ASSERT(_sent_segs(exp, ARRAY_SIZE(exp)));
+    _ack(_seg(0), blocks, ARRAY_SIZE(blocks));
+    TEST_ASSERT(_sent_segs(NULL, 0));
+    /* partial acknowledgments keep the recovery going without retransmissions */
+    _ack(_seg(1), NULL, 0);
+    TEST_ASSERT_EQUAL_INT(SEGS - 1, _tcb.rtx_num);
+    TEST_ASSERT(_sent_segs(NULL, 0));
+    _ack(_seg(3), NULL, 0);
+    TEST_ASSERT_EQUAL_INT(1, _tcb.rtx_num);
+    TEST_ASSERT(_sent_segs(NULL, 0));
+}
+
+static void test_fsm_rcvd_pkt__sack_during_recovery(void)
+{
+    static const uint32_t blocks1[][2] = { { 100, 200 } };
+    static const uint32_t blocks2[][2] = { { 300, 400 }, { 100, 200 } };
+    static const unsigned exp1[] = { 0 };
+    static const unsigned exp2[] = { 2 };
+
+    TEST_ASSERT(_send());
+    _dup_acks(blocks1, ARRAY_SIZE(blocks1));
+    TEST_ASSERT(_sent_segs(exp1, ARRAY_SIZE(exp1)));
+    /* a new SACK block reveals another hole */
+    _ack(_seg(0), blocks2, ARRAY_SIZE(blocks2));
+    TEST_ASSERT(_sent_segs(exp2, ARRAY_SIZE(exp2)));
+}
+
+static void test_fsm_rcvd_pkt__sack_partial_segment(void)
+{
+    static const uint32_t blocks[][2] = { { 300, 400 }, { 100, 150 } };
+    static const unsigned exp[] = { 0, 1, 2 };
+
+    TEST_ASSERT(_send());
+    _dup_acks(blocks, ARRAY_SIZE(blocks));
+    /* a segment counts as received only if a block covers all of it */
+    TEST_ASSERT(!_tcb.rtx[1].sacked);
+    TEST_ASSERT(_sent_segs(exp, ARRAY_SIZE(exp)));
+}
+
+static void test_fsm_rcvd_pkt__sack_not_permitted(void)
+{
+    static const uint32_t blocks[][2] = { { 300, 400 }, { 100, 200 } };
+    static const unsigned exp[] = { 0 };
+
+    _tcb.status &= ~STATUS_SACK_PERM;
+    TEST_ASSERT(_send());
+    _dup_acks(blocks, ARRAY_SIZE(blocks));
+    TEST_ASSERT(!_tcb.rtx[1].sacked);
+    TEST_ASSERT(!_tcb.rtx[3].sacked);
+    TEST_ASSERT(_sent_segs(exp, ARRAY_SIZE(exp)));
+}
+
+static void test_fsm_timeout_retransmit(void)
+{
+    static const unsigned exp[] = { 0 };
+
+    TEST_ASSERT(_send());
+    TEST_ASSERT_EQUAL_INT(0, _fsm(&_tcb, FSM_EVENT_TIMEOUT_RETRANSMIT, NULL, NULL, 0));
+    TEST_ASSERT_EQUAL_INT(MSS, _tcb.cwnd);
+    TEST_ASSERT(_sent_segs(exp, ARRAY_SIZE(exp)));
+}
+
+static void test_fsm_timeout_retransmit__sack(void)
+{
+    static const uint32_t blocks[][2] = { { 300, 400 }, { 100, 200 } };
+    static const unsigned exp[] = { 0, 2 };
+
+    TEST_ASSERT(_send());
+    _ack(_seg(0), blocks, ARRAY_SIZE(blocks));
+    TEST_ASSERT(_sent_segs(NULL, 0));
+    /* SACKed segments are not retransmitted after a timeout */
+    TEST_ASSERT_EQUAL_INT(0, _fsm(&_tcb, FSM_EVENT_TIMEOUT_RETRANSMIT, NULL, NULL, 0));
+    TEST_ASSERT(_sent_segs(exp, ARRAY_SIZE(exp)));
+}
+
+Test *tests_gnrc_tcp_fsm_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_fsm_call_send),
+        new_TestFixture(test_fsm_rcvd_pkt__sack_fast_retransmit),
+        new_TestFixture(test_fsm_rcvd_pkt__sack_retransmit_once),
+        new_TestFixture(test_fsm_rcvd_pkt__sack_during_recovery),
+        new_TestFixture(test_fsm_rcvd_pkt__sack_partial_segment),
+        new_TestFixture(test_fsm_rcvd_pkt__sack_not_permitted),
+        new_TestFixture(test_fsm_timeout_retransmit),
+        new_TestFixture(test_fsm_timeout_retransmit__sack),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_fsm_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_fsm_tests;
+}
+/** @} */
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the option parsing of GNRC TCP
+ */
+
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+#include "net/gnrc/tcp.h"
+#include "net/tcp.h"
+
+#include "internal/common.h"
+#include "internal/option.h"
+
+#include "tests-gnrc_tcp.h"
+
+static gnrc_tcp_tcb_t _tcb;
+static union {
+    tcp_hdr_t hdr;
+    uint8_t raw[sizeof(tcp_hdr_t) + 40];
+} _seg;
+
+/* sets up the header with the given options, which are padded to full words */
+static tcp_hdr_t *_hdr(uint16_t ctl, const uint8_t *opts, size_t opts_len)
+{
+    memset(&_seg, 0, sizeof(_seg));
+    memcpy(_seg.raw + sizeof(tcp_hdr_t), opts, opts_len);
+    _seg.hdr.off_ctl = byteorder_htons(
+        _option_build_offset_control(TCP_HDR_OFFSET_MIN + (opts_len + 3) / 4, ctl));
+    return &_seg.hdr;
+}
+
+static void set_up(void)
+{
+    gnrc_tcp_tcb_init(&_tcb);
+}
+
+static void test_option_parse__no_options(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_SYN, (uint8_t *)"", 0)));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.mss);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.status);
+}
+
+static void test_option_parse__mss(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_MSS, TCP_OPTION_LENGTH_MSS,
+                                    0x05, 0xb4 };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_SYN, opts, sizeof(opts))));
+    TEST_ASSERT_EQUAL_INT(1460, _tcb.mss);
+}
+
+static void test_option_parse__mss_malformed(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_MSS, 3, 0x05,
+                                    TCP_OPTION_KIND_EOL };
+
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_SYN, opts, sizeof(opts))));
+}
+
+static void test_option_parse__ws(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_WS,
+                                    TCP_OPTION_LENGTH_WS, 7 };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_SYN, opts, sizeof(opts))));
+    TEST_ASSERT_EQUAL_INT(7, _tcb.snd_wnd_shift);
+    TEST_ASSERT(_tcb.status & STATUS_WND_SCALE);
+}
+
+static void test_option_parse__ws_shift_too_large(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_WS,
+                                    TCP_OPTION_LENGTH_WS, 15 };
+
+    /* shift counts above the maximum are treated as the maximum (RFC 7323, 2.3) */
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_SYN_ACK, opts, sizeof(opts))));
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_WS_SHIFT_MAX, _tcb.snd_wnd_shift);
+}
+
+static void test_option_parse__ws_not_syn(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_WS,
+                                    TCP_OPTION_LENGTH_WS, 7 };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_ACK, opts, sizeof(opts))));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.snd_wnd_shift);
+    TEST_ASSERT(!(_tcb.status & STATUS_WND_SCALE));
+}
+
+static void test_option_parse__ws_malformed(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_WS, 4, 7, 0 };
+
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_SYN, opts, sizeof(opts))));
+    TEST_ASSERT(!(_tcb.status & STATUS_WND_SCALE));
+}
+
+static void test_option_parse__sack_perm(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                                    TCP_OPTION_KIND_SACK_PERM,
+                                    TCP_OPTION_LENGTH_SACK_PERM };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_ACK, opts, sizeof(opts))));
+    TEST_ASSERT(!(_tcb.status & STATUS_SACK_PERM));
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_SYN, opts, sizeof(opts))));
+    TEST_ASSERT(_tcb.status & STATUS_SACK_PERM);
+}
+
+static void test_option_parse__sack_perm_malformed(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_SACK_PERM, 3, 0,
+                                    TCP_OPTION_KIND_EOL };
+
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_SYN, opts, sizeof(opts))));
+    TEST_ASSERT(!(_tcb.status & STATUS_SACK_PERM));
+}
+
+static void test_option_parse__all_syn_options(void)
+{
+    /* as sent by _pkt_build() */
+    network_uint32_t opts[] = {
+        byteorder_htonl(_option_build_mss(1220)),
+        byteorder_htonl(_option_build_ws(3)),
+        byteorder_htonl(_option_build_sack_perm()),
+    };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_SYN, (uint8_t *)opts,
+                                                       sizeof(opts))));
+    TEST_ASSERT_EQUAL_INT(1220, _tcb.mss);
+    TEST_ASSERT_EQUAL_INT(3, _tcb.snd_wnd_shift);
+    TEST_ASSERT(_tcb.status & STATUS_WND_SCALE);
+    TEST_ASSERT(_tcb.status & STATUS_SACK_PERM);
+}
+
+static void test_option_parse__sack(void)
+{
+    uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2];
+    static const uint8_t opts[] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + 2 * TCP_OPTION_LENGTH_SACK_BLOCK,
+        0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00,
+        0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x01, 0x00,
+    };
+    tcp_hdr_t *hdr = _hdr(MSK_ACK, opts, sizeof(opts));
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, hdr));
+    TEST_ASSERT_EQUAL_INT(2, _option_parse_sack(hdr, blocks));
+    TEST_ASSERT_EQUAL_INT(0x1000, blocks[0][0]);
+    TEST_ASSERT_EQUAL_INT(0x2000, blocks[0][1]);
+    /* a block may wrap around */
+    TEST_ASSERT_EQUAL_INT(0xffffff00, blocks[1][0]);
+    TEST_ASSERT_EQUAL_INT(0x100, blocks[1][1]);
+}
+
+static void test_option_parse__sack_max_blocks(void)
+{
+    uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2];
+    uint8_t opts[2 + TCP_OPTION_LENGTH_MIN +
+                 TCP_OPTION_SACK_BLOCKS_MAX * TCP_OPTION_LENGTH_SACK_BLOCK] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + TCP_OPTION_SACK_BLOCKS_MAX * TCP_OPTION_LENGTH_SACK_BLOCK,
+    };
+
+    for (unsigned i = 0; i < 2 * TCP_OPTION_SACK_BLOCKS_MAX; i++) {
+        /* edges 1, 2, ... in network byte order */
+        opts[4 + (4 * i) + 3] = i + 1;
+    }
+    tcp_hdr_t *hdr = _hdr(MSK_ACK, opts, sizeof(opts));
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, hdr));
+    TEST_ASSERT_EQUAL_INT(TCP_OPTION_SACK_BLOCKS_MAX, _option_parse_sack(hdr, blocks));
+    for (unsigned i = 0; i < TCP_OPTION_SACK_BLOCKS_MAX; i++) {
+        TEST_ASSERT_EQUAL_INT(2 * i + 1, blocks[i][0]);
+        TEST_ASSERT_EQUAL_INT(2 * i + 2, blocks[i][1]);
+    }
+}
+
+static void test_option_parse__sack_too_many_blocks(void)
+{
+    /* 5 blocks need 42 bytes, more than the option space of 40 bytes */
+    uint8_t opts[40] = {
+        TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + 5 * TCP_OPTION_LENGTH_SACK_BLOCK,
+    };
+
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_ACK, opts, sizeof(opts))));
+}
+
+static void test_option_parse__sack_malformed(void)
+{
+    /* no block */
+    static const uint8_t empty[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                                     TCP_OPTION_KIND_SACK, TCP_OPTION_LENGTH_MIN };
+    /* partial block */
+    static const uint8_t partial[] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK + 4,
+        0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00,
+        0x00, 0x00, 0x30, 0x00,
+    };
+    /* longer than the options */
+    static const uint8_t truncated[] = {
+        TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + 2 * TCP_OPTION_LENGTH_SACK_BLOCK,
+        0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00,
+    };
+
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_ACK, empty, sizeof(empty))));
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_ACK, partial, sizeof(partial))));
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_ACK, truncated,
+                                                        sizeof(truncated))));
+}
+
+static void test_option_parse__sack_after_eol(void)
+{
+    uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2];
+    static const uint8_t opts[] = {
+        TCP_OPTION_KIND_EOL, TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_SACK,
+        TCP_OPTION_LENGTH_MIN + TCP_OPTION_LENGTH_SACK_BLOCK,
+        0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x20, 0x00,
+    };
+    tcp_hdr_t *hdr = _hdr(MSK_ACK, opts, sizeof(opts));
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, hdr));
+    TEST_ASSERT_EQUAL_INT(0, _option_parse_sack(hdr, blocks));
+}
+
+static void test_option_parse__unknown(void)
+{
+    /* timestamps are skipped */
+    static const uint8_t opts[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                                    8, 10, 0, 0, 0, 1, 0, 0, 0, 2 };
+
+    TEST_ASSERT_EQUAL_INT(0, _option_parse(&_tcb, _hdr(MSK_ACK, opts, sizeof(opts))));
+}
+
+static void test_option_parse__length_too_small(void)
+{
+    static const uint8_t zero[] = { 8, 0, 0, 0 };
+    static const uint8_t one[] = { 8, 1, 0, 0 };
+
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_ACK, zero, sizeof(zero))));
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_ACK, one, sizeof(one))));
+}
+
+static void test_option_parse__length_too_large(void)
+{
+    static const uint8_t opts[] = { TCP_OPTION_KIND_NOP, TCP_OPTION_KIND_NOP,
+                                    8, 10 };
+
+    TEST_ASSERT_EQUAL_INT(-1, _option_parse(&_tcb, _hdr(MSK_ACK, opts, sizeof(opts))));
+}
+
+Test *tests_gnrc_tcp_option_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_option_parse__no_options),
+        new_TestFixture(test_option_parse__mss),
+        new_TestFixture(test_option_parse__mss_malformed),
+        new_TestFixture(test_option_parse__ws),
+        new_TestFixture(test_option_parse__ws_shift_too_large),
+        new_TestFixture(test_option_parse__ws_not_syn),
+        new_TestFixture(test_option_parse__ws_malformed),
+        new_TestFixture(test_option_parse__sack_perm),
+        new_TestFixture(test_option_parse__sack_perm_malformed),
+        new_TestFixture(test_option_parse__all_syn_options),
+        new_TestFixture(test_option_parse__sack),
+        new_TestFixture(test_option_parse__sack_max_blocks),
+        new_TestFixture(test_option_parse__sack_too_many_blocks),
+        new_TestFixture(test_option_parse__sack_malformed),
+        new_TestFixture(test_option_parse__sack_after_eol),
+        new_TestFixture(test_option_parse__unknown),
+        new_TestFixture(test_option_parse__length_too_small),
+        new_TestFixture(test_option_parse__length_too_large),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_option_tests, set_up, NULL, fixtures);
+
+    return (Test *)&gnrc_tcp_option_tests;
+}
+/** @} */
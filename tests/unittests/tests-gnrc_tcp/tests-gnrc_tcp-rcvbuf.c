@@ -0,0 +1,357 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the receive buffer of GNRC TCP
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "embUnit/embUnit.h"
+#include "net/gnrc/pktbuf.h"
+#include "net/gnrc/tcp.h"
+#include "net/tcp.h"
+
+#include "internal/common.h"
+#include "internal/rcvbuf.h"
+
+#include "tests-gnrc_tcp.h"
+
+/* the data wraps around the sequence number space after 128 bytes */
+#define ISN             (0xffffff80U)
+#define SEG_SIZE        (100U)
+
+static gnrc_tcp_tcb_t _tcb;
+
+static uint8_t _data(uint32_t offset)
+{
+    return offset % 251;
+}
+
+/* passes a segment with the data at offset from ISN to the receive buffer */
+static uint32_t _add(uint32_t offset, uint32_t len)
+{
+    tcp_hdr_t hdr = { .seq_num = byteorder_htonl(ISN + offset) };
+    gnrc_pktsnip_t *tcp = gnrc_pktbuf_add(NULL, &hdr, sizeof(hdr), GNRC_NETTYPE_TCP);
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(tcp, NULL, len, GNRC_NETTYPE_UNDEF);
+    uint32_t res;
+
+    for (uint32_t i = 0; i < len; i++) {
+        ((uint8_t *)pkt->data)[i] = _data(offset + i);
+    }
+    res = _rcvbuf_add(&_tcb, pkt, ISN + offset, len);
+    gnrc_pktbuf_release(pkt);
+    return res;
+}
+
+/* checks if the receive buffer holds exactly the data up to offset */
+static bool _received(uint32_t offset)
+{
+    uint8_t byte;
+
+    if ((_tcb.rcv_nxt != ISN + offset) ||
+        (ringbuffer_get_free(&_tcb.rcv_buf) != _tcb.rcv_wnd)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < offset; i++) {
+        if ((ringbuffer_get_one(&_tcb.rcv_buf) != _data(i))) {
+            return false;
+        }
+    }
+    return ringbuffer_get(&_tcb.rcv_buf, (char *)&byte, 1) == 0;
+}
+
+/* checks if the ranks are the order of reception without gaps */
+static bool _ranks_valid(void)
+{
+    unsigned seen = 0;
+
+    for (unsigned i = 0; i < _tcb.ooo_num; i++) {
+        if ((_tcb.ooo[i].rank >= _tcb.ooo_num) ||
+            (seen & (1U << _tcb.ooo[i].rank))) {
+            return false;
+        }
+        seen |= 1U << _tcb.ooo[i].rank;
+    }
+    return true;
+}
+
+/* checks the SACK blocks for the data kept out of order, given as offsets */
+static bool _sack_blocks(const uint32_t (*exp)[2], unsigned exp_num)
+{
+    uint32_t blocks[TCP_OPTION_SACK_BLOCKS_MAX][2];
+
+    if (!_ranks_valid() || (_rcvbuf_sack_blocks(&_tcb, blocks) != exp_num)) {
+        return false;
+    }
+    for (unsigned i = 0; i < exp_num; i++) {
+        if ((blocks[i][0] != ISN + exp[i][0]) || (blocks[i][1] != ISN + exp[i][1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void set_up(void)
+{
+    gnrc_pktbuf_init();
+    _rcvbuf_init();
+    gnrc_tcp_tcb_init(&_tcb);
+    _rcvbuf_get_buffer(&_tcb);
+    _tcb.rcv_nxt = ISN;
+    _tcb.rcv_wnd = ringbuffer_get_free(&_tcb.rcv_buf);
+}
+
+static void tear_down(void)
+{
+    _rcvbuf_release_buffer(&_tcb);
+}
+
+static void test_rcvbuf_get_buffer(void)
+{
+    gnrc_tcp_tcb_t tcb;
+
+    TEST_ASSERT_NOT_NULL(_tcb.rcv_buf_raw);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, _tcb.rcv_wnd);
+    /* the pool holds a single buffer */
+    gnrc_tcp_tcb_init(&tcb);
+    TEST_ASSERT_EQUAL_INT(-ENOMEM, _rcvbuf_get_buffer(&tcb));
+    _rcvbuf_release_buffer(&_tcb);
+    TEST_ASSERT_NULL(_tcb.rcv_buf_raw);
+    TEST_ASSERT_EQUAL_INT(0, _rcvbuf_get_buffer(&tcb));
+    _rcvbuf_release_buffer(&tcb);
+}
+
+static void test_rcvbuf_add__in_order(void)
+{
+    TEST_ASSERT_EQUAL_INT(SEG_SIZE, _add(0, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(SEG_SIZE, _add(SEG_SIZE, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE - 2 * SEG_SIZE, _tcb.rcv_wnd);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.ooo_num);
+    TEST_ASSERT(_received(2 * SEG_SIZE));
+}
+
+static void test_rcvbuf_add__received_already(void)
+{
+    TEST_ASSERT_EQUAL_INT(SEG_SIZE, _add(0, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _add(0, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _add(10, 20));
+    /* only the new part of a partial retransmission is added */
+    TEST_ASSERT_EQUAL_INT(50, _add(50, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.ooo_num);
+    TEST_ASSERT(_received(SEG_SIZE + 50));
+}
+
+static void test_rcvbuf_add__out_of_order(void)
+{
+    static const uint32_t offsets[] = { 3 * SEG_SIZE, SEG_SIZE, 5 * SEG_SIZE, 2 * SEG_SIZE };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(offsets); i++) {
+        TEST_ASSERT_EQUAL_INT(0, _add(offsets[i], SEG_SIZE));
+    }
+    /* kept sorted by sequence number, nothing is received yet */
+    TEST_ASSERT_EQUAL_INT(4, _tcb.ooo_num);
+    TEST_ASSERT_EQUAL_INT(ISN + SEG_SIZE, _tcb.ooo[0].seq);
+    TEST_ASSERT_EQUAL_INT(ISN + 2 * SEG_SIZE, _tcb.ooo[1].seq);
+    TEST_ASSERT_EQUAL_INT(ISN + 3 * SEG_SIZE, _tcb.ooo[2].seq);
+    TEST_ASSERT_EQUAL_INT(ISN + 5 * SEG_SIZE, _tcb.ooo[3].seq);
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_BUF_SIZE, _tcb.rcv_wnd);
+    TEST_ASSERT(_received(0));
+}
+
+static void test_rcvbuf_add__out_of_order_received_already(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(SEG_SIZE, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _add(SEG_SIZE, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _add(SEG_SIZE, 50));
+    TEST_ASSERT_EQUAL_INT(0, _add(SEG_SIZE + 20, 50));
+    TEST_ASSERT_EQUAL_INT(1, _tcb.ooo_num);
+}
+
+static void test_rcvbuf_add__out_of_order_beyond_window(void)
+{
+    uint32_t wnd = _tcb.rcv_wnd;
+
+    TEST_ASSERT_EQUAL_INT(0, _add(wnd - SEG_SIZE + 1, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.ooo_num);
+    TEST_ASSERT_EQUAL_INT(0, _add(wnd - SEG_SIZE, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, _tcb.ooo_num);
+}
+
+static void test_rcvbuf_add__out_of_order_full(void)
+{
+    for (unsigned i = 0; i <= GNRC_TCP_RCV_OOO_SEGMENTS; i++) {
+        TEST_ASSERT_EQUAL_INT(0, _add((2 * i + 1) * 10, 10));
+    }
+    TEST_ASSERT_EQUAL_INT(GNRC_TCP_RCV_OOO_SEGMENTS, _tcb.ooo_num);
+    TEST_ASSERT_EQUAL_INT(ISN + (2 * GNRC_TCP_RCV_OOO_SEGMENTS - 1) * 10,
+                          _tcb.ooo[GNRC_TCP_RCV_OOO_SEGMENTS - 1].seq);
+}
+
+static void test_rcvbuf_add__fill_gap(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(2 * SEG_SIZE, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _add(SEG_SIZE, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(3 * SEG_SIZE, _add(0, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _tcb.ooo_num);
+    TEST_ASSERT(_received(3 * SEG_SIZE));
+}
+
+static void test_rcvbuf_add__fill_gap_overlapping(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(80, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _add(150, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(0, _add(400, SEG_SIZE));
+    /* [0, 100) + [100, 180) + [180, 250) */
+    TEST_ASSERT_EQUAL_INT(250, _add(0, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, _tcb.ooo_num);
+    TEST_ASSERT_EQUAL_INT(ISN + 400, _tcb.ooo[0].seq);
+    TEST_ASSERT(_ranks_valid());
+    TEST_ASSERT(_received(250));
+}
+
+static void test_rcvbuf_add__fill_gap_partially(void)
+{
+    TEST_ASSERT_EQUAL_INT(0, _add(2 * SEG_SIZE, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(SEG_SIZE, _add(0, SEG_SIZE));
+    TEST_ASSERT_EQUAL_INT(1, _tcb.ooo_num);
+    TEST_ASSERT(_received(SEG_SIZE));
+}
+
+static void test_rcvbuf_sack_blocks__none(void)
+{
+    TEST_ASSERT(_sack_blocks(NULL, 0));
+    TEST_ASSERT_EQUAL_INT(SEG_SIZE, _add(0, SEG_SIZE));
+    TEST_ASSERT(_sack_blocks(NULL, 0));
+}
+
+static void test_rcvbuf_sack_blocks__merge(void)
+{
+    static const uint32_t exp[][2] = { { 100, 300 }, { 400, 500 } };
+
+    _add(400, 100);
+    _add(100, 100);
+    _add(200, 100);
+    TEST_ASSERT(_sack_blocks(exp, ARRAY_SIZE(exp)));
+}
+
+static void test_rcvbuf_sack_blocks__merge_overlapping(void)
+{
+    static const uint32_t exp[][2] = { { 100, 250 }, { 300, 350 } };
+
+    _add(100, 100);
+    _add(300, 50);
+    _add(150, 100);
+    TEST_ASSERT(_sack_blocks(exp, ARRAY_SIZE(exp)));
+}
+
+static void test_rcvbuf_sack_blocks__most_recent_first(void)
+{
+    static const uint32_t exp1[][2] = { { 500, 600 }, { 300, 400 }, { 100, 200 } };
+    static const uint32_t exp2[][2] = { { 100, 200 }, { 500, 600 }, { 300, 400 } };
+    static const uint32_t exp3[][2] = { { 300, 400 }, { 100, 200 }, { 500, 600 } };
+
+    _add(100, 100);
+    _add(300, 100);
+    _add(500, 100);
+    TEST_ASSERT(_sack_blocks(exp1, ARRAY_SIZE(exp1)));
+    /* segments received again count as received most recently */
+    _add(100, 100);
+    TEST_ASSERT(_sack_blocks(exp2, ARRAY_SIZE(exp2)));
+    _add(350, 30);
+    TEST_ASSERT(_sack_blocks(exp3, ARRAY_SIZE(exp3)));
+    TEST_ASSERT_EQUAL_INT(3, _tcb.ooo_num);
+}
+
+static void test_rcvbuf_sack_blocks__most_recent_first_merged(void)
+{
+    static const uint32_t exp1[][2] = { { 400, 500 }, { 100, 200 } };
+    static const uint32_t exp2[][2] = { { 100, 300 }, { 400, 500 } };
+
+    _add(100, 100);
+    _add(400, 100);
+    TEST_ASSERT(_sack_blocks(exp1, ARRAY_SIZE(exp1)));
+    /* the block extended by the most recent segment moves to the front */
+    _add(200, 100);
+    TEST_ASSERT(_sack_blocks(exp2, ARRAY_SIZE(exp2)));
+}
+
+static void test_rcvbuf_sack_blocks__max(void)
+{
+    static const uint32_t offsets[] = { 900, 100, 1100, 300, 700, 500 };
+    static const uint32_t exp[][2] = {
+        { 500, 550 }, { 700, 750 }, { 300, 350 }, { 1100, 1150 },
+    };
+
+    for (unsigned i = 0; i < ARRAY_SIZE(offsets); i++) {
+        _add(offsets[i], 50);
+    }
+    TEST_ASSERT_EQUAL_INT(ARRAY_SIZE(offsets), _tcb.ooo_num);
+    /* only the most recent blocks fit into the option */
+    TEST_ASSERT(_sack_blocks(exp, TCP_OPTION_SACK_BLOCKS_MAX));
+}
+
+static void test_rcvbuf_sack_blocks__after_fill_gap(void)
+{
+    static const uint32_t exp1[][2] = { { 500, 600 }, { 300, 400 } };
+    static const uint32_t exp2[][2] = { { 700, 800 }, { 500, 600 }, { 300, 400 } };
+    static const uint32_t exp3[][2] = { { 300, 400 }, { 700, 800 }, { 500, 600 } };
+
+    _add(300, 100);
+    _add(100, 100);
+    _add(500, 100);
+    TEST_ASSERT_EQUAL_INT(200, _add(0, 100));
+    TEST_ASSERT(_sack_blocks(exp1, ARRAY_SIZE(exp1)));
+    _add(700, 100);
+    TEST_ASSERT(_sack_blocks(exp2, ARRAY_SIZE(exp2)));
+    _add(300, 100);
+    TEST_ASSERT(_sack_blocks(exp3, ARRAY_SIZE(exp3)));
+}
+
+static void test_rcvbuf_release_buffer(void)
+{
+    _add(100, 100);
+    _add(300, 100);
+    _rcvbuf_release_buffer(&_tcb);
+    TEST_ASSERT_EQUAL_INT(0, _tcb.ooo_num);
+    TEST_ASSERT_NULL(_tcb.rcv_buf_raw);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+Test *tests_gnrc_tcp_rcvbuf_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_rcvbuf_get_buffer),
+        new_TestFixture(test_rcvbuf_add__in_order),
+        new_TestFixture(test_rcvbuf_add__received_already),
+        new_TestFixture(test_rcvbuf_add__out_of_order),
+        new_TestFixture(test_rcvbuf_add__out_of_order_received_already),
+        new_TestFixture(test_rcvbuf_add__out_of_order_beyond_window),
+        new_TestFixture(test_rcvbuf_add__out_of_order_full),
+        new_TestFixture(test_rcvbuf_add__fill_gap),
+        new_TestFixture(test_rcvbuf_add__fill_gap_overlapping),
+        new_TestFixture(test_rcvbuf_add__fill_gap_partially),
+        new_TestFixture(test_rcvbuf_sack_blocks__none),
+        new_TestFixture(test_rcvbuf_sack_blocks__merge),
+        new_TestFixture(test_rcvbuf_sack_blocks__merge_overlapping),
+        new_TestFixture(test_rcvbuf_sack_blocks__most_recent_first),
+        new_TestFixture(test_rcvbuf_sack_blocks__most_recent_first_merged),
+        new_TestFixture(test_rcvbuf_sack_blocks__max),
+        new_TestFixture(test_rcvbuf_sack_blocks__after_fill_gap),
+        new_TestFixture(test_rcvbuf_release_buffer),
+    };
+
+    EMB_UNIT_TESTCALLER(gnrc_tcp_rcvbuf_tests, set_up, tear_down, fixtures);
+
+    return (Test *)&gnrc_tcp_rcvbuf_tests;
+}
+/** @} */
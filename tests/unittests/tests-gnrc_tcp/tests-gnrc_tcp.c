@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittest entry point for the GNRC TCP test group
+ */
+
+#include "embUnit/embUnit.h"
+#include "msg.h"
+#include "xtimer.h"
+
+#include "tests-gnrc_tcp.h"
+
+#define TEST_MSG_QUEUE_SIZE (8U)
+
+static msg_t _msg_queue[TEST_MSG_QUEUE_SIZE];
+
+Test *tests_gnrc_tcp_option_tests(void);
+Test *tests_gnrc_tcp_rcvbuf_tests(void);
+Test *tests_gnrc_tcp_fsm_tests(void);
+
+void tests_gnrc_tcp(void)
+{
+    /* segments sent by the FSM are queued for the test thread */
+    xtimer_init();
+    msg_init_queue(_msg_queue, TEST_MSG_QUEUE_SIZE);
+    TESTS_RUN(tests_gnrc_tcp_option_tests());
+    TESTS_RUN(tests_gnrc_tcp_rcvbuf_tests());
+    TESTS_RUN(tests_gnrc_tcp_fsm_tests());
+}
+/** @} */
@@ -13,6 +13,7 @@
  */
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "embUnit.h"
 
@@ -165,6 +166,101 @@ static void test_inet_csum__empty_app_buffer(void)
     TEST_ASSERT_EQUAL_INT(hdr_expected, pyld_sum);
 }
 
+/* byte-wise reference of inet_csum_slice() */
+static uint16_t _csum_slice_ref(uint16_t sum, const uint8_t *buf, uint16_t len,
+                                size_t accum_len)
+{
+    uint32_t csum = sum;
+
+    if (len == 0) {
+        return csum;
+    }
+    if (accum_len & 1) {
+        csum += *buf;
+        buf++;
+        len--;
+        accum_len++;
+    }
+    for (unsigned i = 0; i < (len >> 1); buf += 2, i++) {
+        csum += (uint16_t)(*buf << 8) + *(buf + 1);
+    }
+    if ((accum_len + len) & 1) {
+        csum += (uint16_t)(*buf << 8);
+    }
+    while (csum >> 16) {
+        csum = (csum & 0xffff) + (csum >> 16);
+    }
+    return csum;
+}
+
+static uint32_t _xorshift(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+static void test_inet_csum__random(void)
+{
+    uint8_t data[160];
+    uint32_t state = 0x5eed;
+
+    for (unsigned i = 0; i < 1024; i++) {
+        /* cover all alignments, odd and even lengths and offsets */
+        unsigned offset = _xorshift(&state) % 8;
+        uint16_t len = _xorshift(&state) % (sizeof(data) - offset);
+        size_t accum_len = _xorshift(&state) % 2;
+        uint16_t sum = (i & 1) ? (uint16_t)_xorshift(&state) : 0;
+
+        for (unsigned j = 0; j < sizeof(data); j++) {
+            /* all ones exercise the carries */
+            data[j] = (i % 8) ? (uint8_t)_xorshift(&state) : 0xff;
+        }
+        TEST_ASSERT_EQUAL_INT(_csum_slice_ref(sum, &data[offset], len, accum_len),
+                              inet_csum_slice(sum, &data[offset], len, accum_len));
+    }
+}
+
+static void test_inet_csum__update(void)
+{
+    uint8_t data[64];
+    uint32_t state = 0x5eed;
+
+    for (unsigned i = 0; i < 256; i++) {
+        uint8_t old_data[8];
+        /* changed field at an even offset */
+        unsigned offset = (_xorshift(&state) % (sizeof(data) / 2)) * 2;
+        uint16_t len = 2 + (_xorshift(&state) % 4) * 2;
+        uint16_t csum;
+
+        if ((offset + len) > sizeof(data)) {
+            offset = sizeof(data) - len;
+        }
+        for (unsigned j = 0; j < sizeof(data); j++) {
+            data[j] = (uint8_t)_xorshift(&state);
+        }
+        csum = ~inet_csum(0, data, sizeof(data));
+        memcpy(old_data, &data[offset], len);
+        for (unsigned j = 0; j < len; j++) {
+            data[offset + j] = (uint8_t)_xorshift(&state);
+        }
+        TEST_ASSERT_EQUAL_INT((uint16_t)~inet_csum(0, data, sizeof(data)),
+                              inet_csum_update(csum, old_data, &data[offset],
+                                               len));
+        TEST_ASSERT_EQUAL_INT(
+            inet_csum_update(csum, old_data, &data[offset], 2),
+            inet_csum_update16(csum, (old_data[0] << 8) | old_data[1],
+                               (data[offset] << 8) | data[offset + 1]));
+    }
+}
+
+static void test_inet_csum__update16_rfc_example(void)
+{
+    /* source: https://tools.ietf.org/html/rfc1624#section-4 */
+    TEST_ASSERT_EQUAL_INT(0x0000, inet_csum_update16(0xdd2f, 0x5555, 0x3285));
+}
+
 Test *tests_inet_csum_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -176,6 +272,9 @@ Test *tests_inet_csum_tests(void)
         new_TestFixture(test_inet_csum__odd_len),
         new_TestFixture(test_inet_csum__two_app_snips),
         new_TestFixture(test_inet_csum__empty_app_buffer),
+        new_TestFixture(test_inet_csum__random),
+        new_TestFixture(test_inet_csum__update),
+        new_TestFixture(test_inet_csum__update16_rfc_example),
     };
 
     EMB_UNIT_TESTCALLER(inet_csum_tests, NULL, NULL, fixtures);
@@ -553,6 +553,53 @@ static void test_ipv6_addr_match_prefix_same_pointer(void)
     TEST_ASSERT_EQUAL_INT(128, ipv6_addr_match_prefix(&a, &a));
 }
 
+/* byte-wise reference of ipv6_addr_match_prefix() */
+static uint8_t _match_prefix_ref(const ipv6_addr_t *a, const ipv6_addr_t *b)
+{
+    uint8_t prefix_len = 0;
+
+    for (int i = 0; i < 16; i++) {
+        uint8_t xor = (a->u8[i] ^ b->u8[i]);
+
+        for (int j = 7; j >= 0; j--) {
+            if (xor & (1 << j)) {
+                return prefix_len;
+            }
+            prefix_len++;
+        }
+    }
+    return prefix_len;
+}
+
+static void test_ipv6_addr_match_prefix_random(void)
+{
+    uint32_t state = 0x5eed;
+
+    for (unsigned i = 0; i < 1024; i++) {
+        ipv6_addr_t a, b;
+        unsigned bit;
+
+        for (unsigned j = 0; j < sizeof(a); j++) {
+            /* xorshift32 */
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            a.u8[j] = (uint8_t)state;
+        }
+        /* flip one bit to get a known common prefix, and possibly some more
+         * behind it */
+        b = a;
+        bit = state % 129;
+        if (bit < 128) {
+            b.u8[bit / 8] ^= 0x80 >> (bit % 8);
+            b.u8[15] ^= (uint8_t)(state >> 8) & ((bit < 120) ? 0xff : 0);
+        }
+        TEST_ASSERT_EQUAL_INT(_match_prefix_ref(&a, &b),
+                              ipv6_addr_match_prefix(&a, &b));
+        TEST_ASSERT_EQUAL_INT(bit, ipv6_addr_match_prefix(&a, &b));
+    }
+}
+
 static void test_ipv6_addr_init_prefix(void)
 {
     ipv6_addr_t a = { {
@@ -1106,6 +1153,7 @@ Test *tests_ipv6_addr_tests(void)
         new_TestFixture(test_ipv6_addr_match_prefix_match_127),
         new_TestFixture(test_ipv6_addr_match_prefix_match_128),
         new_TestFixture(test_ipv6_addr_match_prefix_same_pointer),
+        new_TestFixture(test_ipv6_addr_match_prefix_random),
         new_TestFixture(test_ipv6_addr_init_prefix),
         new_TestFixture(test_ipv6_addr_init_iid),
         new_TestFixture(test_ipv6_addr_set_unspecified),
@@ -18,6 +18,7 @@
 #include <stdio.h>
 
 #include "embUnit.h"
+#include "kernel_defines.h"
 
 #include "net/nanocoap.h"
 
@@ -713,6 +714,84 @@ static void test_nanocoap__options_get_opaque(void)
     TEST_ASSERT_EQUAL_INT(-ENOENT, optlen);
 }
 
+/*
+ * Tests coap_find_resource() for exact and subtree matches, and method
+ * mismatch. Resources are sorted by path, as required.
+ */
+static void test_nanocoap__find_resource(void)
+{
+    static const coap_resource_t resources[] = {
+        { "/a",        COAP_GET | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/a/b",      COAP_GET | COAP_POST,          NULL, NULL },
+        { "/a/b",      COAP_PUT,                      NULL, NULL },
+        { "/ab",       COAP_GET | COAP_PUT,           NULL, NULL },
+        { "/log",      COAP_POST | COAP_MATCH_SUBTREE, NULL, NULL },
+        { "/log/x",    COAP_GET,                      NULL, NULL },
+        { "/sensor",   COAP_GET,                      NULL, NULL },
+        { "/sensors",  COAP_GET,                      NULL, NULL },
+    };
+    const coap_resource_t *res = NULL;
+
+    /* first resource with a matching method wins, even if a subtree */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources,
+                                                ARRAY_SIZE(resources),
+                                                (uint8_t *)"/a/b", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[0]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources,
+                                                ARRAY_SIZE(resources),
+                                                (uint8_t *)"/a/b", COAP_PUT,
+                                                &res));
+    TEST_ASSERT(res == &resources[2]);
+    /* subtree matches on the path as string prefix, like coap_match_path() */
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources,
+                                                ARRAY_SIZE(resources),
+                                                (uint8_t *)"/ab", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[0]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources,
+                                                ARRAY_SIZE(resources),
+                                                (uint8_t *)"/ab", COAP_PUT,
+                                                &res));
+    TEST_ASSERT(res == &resources[3]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources,
+                                                ARRAY_SIZE(resources),
+                                                (uint8_t *)"/log/x", COAP_POST,
+                                                &res));
+    TEST_ASSERT(res == &resources[4]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources,
+                                                ARRAY_SIZE(resources),
+                                                (uint8_t *)"/log/x", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[5]);
+    TEST_ASSERT_EQUAL_INT(0, coap_find_resource(resources,
+                                                ARRAY_SIZE(resources),
+                                                (uint8_t *)"/sensors", COAP_GET,
+                                                &res));
+    TEST_ASSERT(res == &resources[7]);
+
+    TEST_ASSERT_EQUAL_INT(-EPERM, coap_find_resource(resources,
+                                                     ARRAY_SIZE(resources),
+                                                     (uint8_t *)"/log/y",
+                                                     COAP_GET, &res));
+    TEST_ASSERT_EQUAL_INT(-EPERM, coap_find_resource(resources,
+                                                     ARRAY_SIZE(resources),
+                                                     (uint8_t *)"/sensor",
+                                                     COAP_PUT, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(resources,
+                                                      ARRAY_SIZE(resources),
+                                                      (uint8_t *)"/sens",
+                                                      COAP_GET, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(resources,
+                                                      ARRAY_SIZE(resources),
+                                                      (uint8_t *)"/b",
+                                                      COAP_GET, &res));
+    TEST_ASSERT_EQUAL_INT(-ENOENT, coap_find_resource(resources,
+                                                      ARRAY_SIZE(resources),
+                                                      (uint8_t *)"/", COAP_GET,
+                                                      &res));
+}
+
 Test *tests_nanocoap_tests(void)
 {
     EMB_UNIT_TESTFIXTURES(fixtures) {
@@ -730,6 +809,7 @@ Test *tests_nanocoap_tests(void)
         new_TestFixture(test_nanocoap__option_add_buffer_max),
         new_TestFixture(test_nanocoap__options_get_opaque),
         new_TestFixture(test_nanocoap__options_iterate),
+        new_TestFixture(test_nanocoap__find_resource),
         new_TestFixture(test_nanocoap__server_get_req),
         new_TestFixture(test_nanocoap__server_reply_simple),
         new_TestFixture(test_nanocoap__server_get_req_con),
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the open addressing index
+ */
+
+#include <stdbool.h>
+
+#include "kernel_defines.h"
+#include "oaindex.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-oaindex.h"
+
+#define ENTRIES         (4U)
+#define SLOTS           (2 * ENTRIES)
+#define FREE            (-1)
+
+static uint32_t _hash(unsigned entry);
+
+/* the hash of each entry, set by the tests */
+static uint32_t _hashes[ENTRIES];
+static uint16_t _slots[SLOTS];
+static const oaindex_t _idx = OAINDEX_INIT(_slots, _hash);
+
+static uint32_t _hash(unsigned entry)
+{
+    return _hashes[entry];
+}
+
+static int _at(unsigned slot)
+{
+    return oaindex_free(&_idx, slot) ? FREE : (int)oaindex_entry(&_idx, slot);
+}
+
+/* checks if entry is found on the probe sequence of its hash */
+static bool _found(unsigned entry)
+{
+    for (unsigned slot = oaindex_first(&_idx, _hashes[entry]);
+         !oaindex_free(&_idx, slot);
+         slot = oaindex_next(&_idx, slot)) {
+        if (oaindex_entry(&_idx, slot) == entry) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _add(uint32_t hash0, uint32_t hash1, uint32_t hash2,
+                 uint32_t hash3)
+{
+    _hashes[0] = hash0;
+    _hashes[1] = hash1;
+    _hashes[2] = hash2;
+    _hashes[3] = hash3;
+    for (unsigned i = 0; i < ENTRIES; i++) {
+        oaindex_add(&_idx, i);
+    }
+}
+
+static void set_up(void)
+{
+    oaindex_clear(&_idx);
+}
+
+static void test_oaindex_init(void)
+{
+    TEST_ASSERT_EQUAL_INT(SLOTS, _idx.size);
+    for (unsigned i = 0; i < SLOTS; i++) {
+        TEST_ASSERT_EQUAL_INT(FREE, _at(i));
+    }
+}
+
+static void test_oaindex_add(void)
+{
+    /* the hash is reduced modulo the number of slots */
+    _add(2, 5, SLOTS, 3 * SLOTS + 7);
+    TEST_ASSERT_EQUAL_INT(2, _at(0));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(1));
+    TEST_ASSERT_EQUAL_INT(0, _at(2));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(3));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(4));
+    TEST_ASSERT_EQUAL_INT(1, _at(5));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(6));
+    TEST_ASSERT_EQUAL_INT(3, _at(7));
+}
+
+static void test_oaindex_add_twice(void)
+{
+    _hashes[1] = 3;
+    oaindex_add(&_idx, 1);
+    oaindex_add(&_idx, 1);
+    TEST_ASSERT_EQUAL_INT(1, _at(3));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(4));
+}
+
+static void test_oaindex_add_collision(void)
+{
+    _add(3, 3, 4, 3);
+    TEST_ASSERT_EQUAL_INT(0, _at(3));
+    TEST_ASSERT_EQUAL_INT(1, _at(4));
+    TEST_ASSERT_EQUAL_INT(2, _at(5));
+    TEST_ASSERT_EQUAL_INT(3, _at(6));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(7));
+    for (unsigned i = 0; i < ENTRIES; i++) {
+        TEST_ASSERT(_found(i));
+    }
+}
+
+static void test_oaindex_add_wrap_around(void)
+{
+    _add(SLOTS - 1, SLOTS - 1, 0, SLOTS - 2);
+    TEST_ASSERT_EQUAL_INT(0, _at(SLOTS - 1));
+    TEST_ASSERT_EQUAL_INT(1, _at(0));
+    TEST_ASSERT_EQUAL_INT(2, _at(1));
+    TEST_ASSERT_EQUAL_INT(3, _at(SLOTS - 2));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(2));
+    for (unsigned i = 0; i < ENTRIES; i++) {
+        TEST_ASSERT(_found(i));
+    }
+}
+
+static void test_oaindex_del(void)
+{
+    _add(1, 3, 5, 7);
+    oaindex_del(&_idx, 2);
+    TEST_ASSERT_EQUAL_INT(FREE, _at(5));
+    TEST_ASSERT(_found(0));
+    TEST_ASSERT(_found(1));
+    TEST_ASSERT(!_found(2));
+    TEST_ASSERT(_found(3));
+    /* deleting an entry not in the index does nothing */
+    oaindex_del(&_idx, 2);
+    TEST_ASSERT_EQUAL_INT(0, _at(1));
+    TEST_ASSERT_EQUAL_INT(1, _at(3));
+    TEST_ASSERT_EQUAL_INT(3, _at(7));
+}
+
+static void test_oaindex_del_shift(void)
+{
+    /* 1 and 2 move back, as their home slots are not after the freed one */
+    _add(3, 3, 4, 6);
+    oaindex_del(&_idx, 0);
+    TEST_ASSERT_EQUAL_INT(1, _at(3));
+    TEST_ASSERT_EQUAL_INT(2, _at(4));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(5));
+    TEST_ASSERT_EQUAL_INT(3, _at(6));
+    for (unsigned i = 1; i < ENTRIES; i++) {
+        TEST_ASSERT(_found(i));
+    }
+}
+
+static void test_oaindex_del_shift_skip(void)
+{
+    /* 2 is in its home slot already, so 3 moves over it */
+    _add(3, 3, 5, 4);
+    TEST_ASSERT_EQUAL_INT(3, _at(6));
+    oaindex_del(&_idx, 0);
+    TEST_ASSERT_EQUAL_INT(1, _at(3));
+    TEST_ASSERT_EQUAL_INT(3, _at(4));
+    TEST_ASSERT_EQUAL_INT(2, _at(5));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(6));
+    for (unsigned i = 1; i < ENTRIES; i++) {
+        TEST_ASSERT(_found(i));
+    }
+}
+
+static void test_oaindex_del_shift_wrap_around(void)
+{
+    _add(SLOTS - 2, SLOTS - 1, SLOTS - 1, 0);
+    TEST_ASSERT_EQUAL_INT(2, _at(0));
+    TEST_ASSERT_EQUAL_INT(3, _at(1));
+    /* nothing after the freed slot has its home slot before it */
+    oaindex_del(&_idx, 0);
+    TEST_ASSERT_EQUAL_INT(FREE, _at(SLOTS - 2));
+    TEST_ASSERT_EQUAL_INT(1, _at(SLOTS - 1));
+    TEST_ASSERT_EQUAL_INT(2, _at(0));
+    TEST_ASSERT_EQUAL_INT(3, _at(1));
+    /* both move back across the end of the slots */
+    oaindex_del(&_idx, 1);
+    TEST_ASSERT_EQUAL_INT(2, _at(SLOTS - 1));
+    TEST_ASSERT_EQUAL_INT(3, _at(0));
+    TEST_ASSERT_EQUAL_INT(FREE, _at(1));
+    TEST_ASSERT(_found(2));
+    TEST_ASSERT(_found(3));
+}
+
+static void test_oaindex_add_del_sequence(void)
+{
+    uint32_t state = 1;
+    bool added[ENTRIES] = { false };
+
+    /* every entry stays reachable over random additions and deletions with
+     * many collisions */
+    for (unsigned i = 0; i < 1000; i++) {
+        state = (state * 1103515245U) + 12345U;
+        unsigned entry = (state >> 16) % ENTRIES;
+
+        if (added[entry]) {
+            oaindex_del(&_idx, entry);
+        }
+        else {
+            _hashes[entry] = (state >> 8) % (SLOTS / 2);
+            oaindex_add(&_idx, entry);
+        }
+        added[entry] = !added[entry];
+        unsigned used = 0;
+        for (unsigned j = 0; j < SLOTS; j++) {
+            used += !oaindex_free(&_idx, j);
+        }
+        for (unsigned j = 0; j < ENTRIES; j++) {
+            TEST_ASSERT_EQUAL_INT(added[j], _found(j));
+            used -= added[j];
+        }
+        TEST_ASSERT_EQUAL_INT(0, used);
+    }
+}
+
+static void test_oaindex_clear(void)
+{
+    _add(0, 0, 1, 2);
+    oaindex_clear(&_idx);
+    for (unsigned i = 0; i < SLOTS; i++) {
+        TEST_ASSERT_EQUAL_INT(FREE, _at(i));
+    }
+}
+
+static Test *tests_oaindex_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_oaindex_init),
+        new_TestFixture(test_oaindex_add),
+        new_TestFixture(test_oaindex_add_twice),
+        new_TestFixture(test_oaindex_add_collision),
+        new_TestFixture(test_oaindex_add_wrap_around),
+        new_TestFixture(test_oaindex_del),
+        new_TestFixture(test_oaindex_del_shift),
+        new_TestFixture(test_oaindex_del_shift_skip),
+        new_TestFixture(test_oaindex_del_shift_wrap_around),
+        new_TestFixture(test_oaindex_add_del_sequence),
+        new_TestFixture(test_oaindex_clear),
+    };
+
+    EMB_UNIT_TESTCALLER(oaindex_tests, set_up, NULL, fixtures);
+
+    return (Test *)&oaindex_tests;
+}
+
+void tests_oaindex(void)
+{
+    TESTS_RUN(tests_oaindex_tests());
+}
+/** @} */
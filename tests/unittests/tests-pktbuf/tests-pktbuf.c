@@ -14,6 +14,7 @@
  */
 #include <errno.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/uio.h>
 
 #include "embUnit.h"
@@ -202,6 +203,34 @@ static void test_pktbuf_add__memfull(void)
 }
 #endif
 
+#ifdef MODULE_GNRC_PKTBUF_SLAB
+/* packets that large take a run of pages each, leaving space for the pages
+ * holding the snips, which are filled from the end of the buffer */
+static void test_pktbuf_add__success(void)
+{
+    gnrc_pktsnip_t *pkt, *pkt_prev = NULL;
+    const size_t size = GNRC_PKTBUF_SLAB_PAGE_SIZE + 4;
+    const unsigned numof = (GNRC_PKTBUF_SIZE / GNRC_PKTBUF_SLAB_PAGE_SIZE) / 2 - 1;
+
+    for (unsigned i = 0; i < numof; i++) {
+        pkt = gnrc_pktbuf_add(NULL, NULL, size, GNRC_NETTYPE_TEST);
+
+        TEST_ASSERT_NOT_NULL(pkt);
+        TEST_ASSERT_NULL(pkt->next);
+        TEST_ASSERT_NOT_NULL(pkt->data);
+        TEST_ASSERT_EQUAL_INT(size, pkt->size);
+        TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_TEST, pkt->type);
+        TEST_ASSERT_EQUAL_INT(1, pkt->users);
+
+        if (pkt_prev != NULL) {
+            TEST_ASSERT(pkt_prev->data < pkt->data);
+        }
+
+        pkt_prev = pkt;
+    }
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+}
+#else
 static void test_pktbuf_add__success(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_prev = NULL;
@@ -225,6 +254,7 @@ static void test_pktbuf_add__success(void)
     }
     TEST_ASSERT(gnrc_pktbuf_is_sane());
 }
+#endif
 
 static void test_pktbuf_add__packed_struct(void)
 {
@@ -245,7 +275,32 @@ static void test_pktbuf_add__packed_struct(void)
     TEST_ASSERT_EQUAL_INT(data.s64, data_cpy->s64);
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC   /* alignment-handling left to malloc, so no certainty here */
+#if defined(MODULE_GNRC_PKTBUF_SLAB)
+/* blocks of a slab are reused independently of the allocation's size, but
+ * stay aligned */
+static void test_pktbuf_add__unaligned_in_aligned_hole(void)
+{
+    gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *pkt2 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *pkt3 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
+    gnrc_pktsnip_t *pkt4;
+    void *tmp_data2 = pkt2->data;
+    void *tmp_pkt2 = pkt2;
+
+    gnrc_pktbuf_release(pkt2);
+    pkt4 = gnrc_pktbuf_add(NULL, TEST_STRING12, 9, GNRC_NETTYPE_TEST);
+
+    TEST_ASSERT((pkt4->data == tmp_data2) || (pkt4->data == tmp_pkt2));
+    TEST_ASSERT_EQUAL_INT(0, (uintptr_t)pkt4->data % sizeof(uint64_t));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(TEST_STRING12, pkt4->data, 9));
+
+    gnrc_pktbuf_release(pkt1);
+    gnrc_pktbuf_release(pkt3);
+    gnrc_pktbuf_release(pkt4);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#elif !defined(MODULE_GNRC_PKTBUF_MALLOC)
+/* alignment-handling left to malloc, so no certainty here */
 static void test_pktbuf_add__unaligned_in_aligned_hole(void)
 {
     gnrc_pktsnip_t *pkt1 = gnrc_pktbuf_add(NULL, NULL, 8, GNRC_NETTYPE_TEST);
@@ -496,6 +551,108 @@ static void test_pktbuf_mark__success_equally_sized(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
+static unsigned _ext_released;
+
+static void _ext_release(void *arg, void *data)
+{
+    TEST_ASSERT(arg == &_ext_released);
+    TEST_ASSERT_NOT_NULL(data);
+    _ext_released++;
+}
+
+static void test_pktbuf_add_ext__success(void)
+{
+    uint8_t data[sizeof(TEST_STRING16)];
+    gnrc_pktsnip_t *pkt;
+
+    memcpy(data, TEST_STRING16, sizeof(data));
+    _ext_released = 0;
+    pkt = gnrc_pktbuf_add_ext(NULL, data, sizeof(data), GNRC_NETTYPE_TEST,
+                              _ext_release, &_ext_released);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT(pkt->data == data);
+    TEST_ASSERT_EQUAL_INT(sizeof(data), pkt->size);
+    TEST_ASSERT_EQUAL_INT(GNRC_NETTYPE_TEST, pkt->type);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _ext_released);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_ext__full(void)
+{
+    uint8_t data[GNRC_PKTBUF_EXT_NUMOF + 1][8];
+    gnrc_pktsnip_t *pkt = NULL;
+
+    _ext_released = 0;
+    for (unsigned i = 0; i < GNRC_PKTBUF_EXT_NUMOF; i++) {
+        pkt = gnrc_pktbuf_add_ext(pkt, data[i], sizeof(data[i]),
+                                  GNRC_NETTYPE_TEST, _ext_release,
+                                  &_ext_released);
+        TEST_ASSERT_NOT_NULL(pkt);
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_add_ext(pkt, data[GNRC_PKTBUF_EXT_NUMOF], 8,
+                                         GNRC_NETTYPE_TEST, _ext_release,
+                                         &_ext_released));
+    TEST_ASSERT_EQUAL_INT(0, _ext_released);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(GNRC_PKTBUF_EXT_NUMOF, _ext_released);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_ext__mark(void)
+{
+    uint8_t data[sizeof(TEST_STRING16)];
+    gnrc_pktsnip_t *pkt, *hdr1, *hdr2;
+
+    memcpy(data, TEST_STRING16, sizeof(data));
+    _ext_released = 0;
+    pkt = gnrc_pktbuf_add_ext(NULL, data, sizeof(data), GNRC_NETTYPE_TEST,
+                              _ext_release, &_ext_released);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* small marks must not move the data out of the external buffer */
+    hdr1 = gnrc_pktbuf_mark(pkt, 1, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr1);
+    hdr2 = gnrc_pktbuf_mark(pkt, 4, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(hdr2);
+    TEST_ASSERT(hdr1->data == &data[0]);
+    TEST_ASSERT(hdr2->data == &data[1]);
+    TEST_ASSERT(pkt->data == &data[5]);
+    TEST_ASSERT_EQUAL_INT(sizeof(data) - 5, pkt->size);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    /* buffer is still referenced by the remaining snips */
+    gnrc_pktbuf_remove_snip(pkt, hdr1);
+    TEST_ASSERT_EQUAL_INT(0, _ext_released);
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _ext_released);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
+static void test_pktbuf_add_ext__realloc_data(void)
+{
+    uint8_t data[sizeof(TEST_STRING8)];
+    gnrc_pktsnip_t *pkt;
+
+    memcpy(data, TEST_STRING8, sizeof(data));
+    _ext_released = 0;
+    pkt = gnrc_pktbuf_add_ext(NULL, data, sizeof(data), GNRC_NETTYPE_TEST,
+                              _ext_release, &_ext_released);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* shrinking keeps the data in place */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, 4));
+    TEST_ASSERT(pkt->data == data);
+    TEST_ASSERT_EQUAL_INT(0, _ext_released);
+    /* growing moves the data into the packet buffer */
+    TEST_ASSERT_EQUAL_INT(0, gnrc_pktbuf_realloc_data(pkt, sizeof(data) + 8));
+    TEST_ASSERT(pkt->data != data);
+    TEST_ASSERT_EQUAL_INT(0, memcmp(pkt->data, TEST_STRING8, 4));
+    TEST_ASSERT_EQUAL_INT(1, _ext_released);
+    TEST_ASSERT(gnrc_pktbuf_is_sane());
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT_EQUAL_INT(1, _ext_released);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+
 static void test_pktbuf_realloc_data__size_0(void)
 {
     gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, sizeof(TEST_STRING8), GNRC_NETTYPE_TEST);
@@ -653,7 +810,22 @@ static void test_pktbuf_realloc_data__success3(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if defined(MODULE_GNRC_PKTBUF_SLAB)
+/* both snips fit, as their pages don't need to be consecutive, but not their
+ * merged data */
+static void test_pktbuf_merge_data__memfull(void)
+{
+    gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 3),
+                                          GNRC_NETTYPE_TEST);
+
+    pkt = gnrc_pktbuf_add(pkt, NULL, (GNRC_PKTBUF_SIZE / 3),
+                          GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    TEST_ASSERT_EQUAL_INT(ENOMEM, gnrc_pktbuf_merge(pkt));
+    gnrc_pktbuf_release(pkt);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#elif !defined(MODULE_GNRC_PKTBUF_MALLOC)
 static void test_pktbuf_merge_data__memfull(void)
 {
     gnrc_pktsnip_t *pkt = gnrc_pktbuf_add(NULL, NULL, (GNRC_PKTBUF_SIZE / 4),
@@ -665,7 +837,7 @@ static void test_pktbuf_merge_data__memfull(void)
     gnrc_pktbuf_release(pkt);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif
 
 static void test_pktbuf_merge_data__success1(void)
 {
@@ -813,7 +985,34 @@ static void test_pktbuf_start_write__pkt_users_2(void)
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
 
-#ifndef MODULE_GNRC_PKTBUF_MALLOC
+#if defined(MODULE_GNRC_PKTBUF_SLAB)
+static void test_pktbuf_reverse_snips__too_full(void)
+{
+    gnrc_pktsnip_t *pkt, *pkt_next, *pkt_huge, *tmp;
+    /* all pages but the one holding the snips */
+    const size_t pkt_huge_size = ((GNRC_PKTBUF_SIZE / GNRC_PKTBUF_SLAB_PAGE_SIZE) - 1) *
+                                 GNRC_PKTBUF_SLAB_PAGE_SIZE;
+
+    pkt_next = gnrc_pktbuf_add(NULL, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt_next);
+    /* hold to enforce duplication */
+    gnrc_pktbuf_hold(pkt_next, 1);
+    pkt = gnrc_pktbuf_add(pkt_next, TEST_STRING8, 8, GNRC_NETTYPE_TEST);
+    TEST_ASSERT_NOT_NULL(pkt);
+    /* filling up rest of packet buffer */
+    pkt_huge = gnrc_pktbuf_add(NULL, NULL, pkt_huge_size, GNRC_NETTYPE_UNDEF);
+    TEST_ASSERT_NOT_NULL(pkt_huge);
+    /* and the blocks left in the page holding the snips */
+    while ((tmp = gnrc_pktbuf_add(pkt_huge, NULL, 1, GNRC_NETTYPE_UNDEF)) != NULL) {
+        pkt_huge = tmp;
+    }
+    TEST_ASSERT_NULL(gnrc_pktbuf_reverse_snips(pkt));
+    gnrc_pktbuf_release(pkt_huge);
+    /* release because of hold above */
+    gnrc_pktbuf_release(pkt_next);
+    TEST_ASSERT(gnrc_pktbuf_is_empty());
+}
+#elif !defined(MODULE_GNRC_PKTBUF_MALLOC)
 static void test_pktbuf_reverse_snips__too_full(void)
 {
     gnrc_pktsnip_t *pkt, *pkt_next, *pkt_huge;
@@ -835,7 +1034,7 @@ static void test_pktbuf_reverse_snips__too_full(void)
     gnrc_pktbuf_release(pkt_next);
     TEST_ASSERT(gnrc_pktbuf_is_empty());
 }
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif
 
 static void test_pktbuf_reverse_snips__success(void)
 {
@@ -881,6 +1080,10 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_mark__success_aligned),
         new_TestFixture(test_pktbuf_mark__success_small),
         new_TestFixture(test_pktbuf_mark__success_equally_sized),
+        new_TestFixture(test_pktbuf_add_ext__success),
+        new_TestFixture(test_pktbuf_add_ext__full),
+        new_TestFixture(test_pktbuf_add_ext__mark),
+        new_TestFixture(test_pktbuf_add_ext__realloc_data),
         new_TestFixture(test_pktbuf_realloc_data__size_0),
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
         new_TestFixture(test_pktbuf_realloc_data__memfull),
@@ -894,7 +1097,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_realloc_data__success3),
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
         new_TestFixture(test_pktbuf_merge_data__memfull),
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif
         new_TestFixture(test_pktbuf_merge_data__success1),
         new_TestFixture(test_pktbuf_merge_data__success2),
         new_TestFixture(test_pktbuf_hold__pkt_null),
@@ -908,7 +1111,7 @@ Test *tests_pktbuf_tests(void)
         new_TestFixture(test_pktbuf_start_write__pkt_users_2),
 #ifndef MODULE_GNRC_PKTBUF_MALLOC
         new_TestFixture(test_pktbuf_reverse_snips__too_full),
-#endif /* MODULE_GNRC_PKTBUF_MALLOC */
+#endif
         new_TestFixture(test_pktbuf_reverse_snips__success),
     };
 
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for timer coalescing of ztimer
+ */
+
+#include <stdbool.h>
+
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer_slack.h"
+
+typedef struct {
+    ztimer_t timer;
+    uint32_t fired_at;
+    unsigned fired;
+} _timer_t;
+
+static ztimer_mock_t _zmock;
+static ztimer_clock_t *_z = &_zmock.super;
+
+static void _cb(void *arg)
+{
+    _timer_t *t = arg;
+
+    t->fired_at = ztimer_now(_z);
+    t->fired++;
+}
+
+static void _init(_timer_t *t)
+{
+    *t = (_timer_t){ .timer = { .callback = _cb, .arg = t } };
+}
+
+/* advances tick by tick, so the time of each wakeup is exact */
+static void _advance_to(uint32_t now)
+{
+    while (ztimer_now(_z) < now) {
+        ztimer_mock_advance(&_zmock, 1);
+    }
+}
+
+static bool _fired_within(const _timer_t *t, uint32_t target, uint32_t slack)
+{
+    return (t->fired == 1) && (t->fired_at >= target) &&
+           (t->fired_at <= target + slack);
+}
+
+static void set_up(void)
+{
+    ztimer_mock_init(&_zmock, 32);
+}
+
+/**
+ * @brief   Timers with overlapping windows fire on one wakeup
+ */
+static void test_ztimer_slack_overlapping(void)
+{
+    _timer_t t1, t2;
+
+    _init(&t1);
+    _init(&t2);
+    ztimer_set_slack(_z, &t1.timer, 100, 50);
+    ztimer_set_slack(_z, &t2.timer, 120, 40);
+    _advance_to(99);
+    TEST_ASSERT_EQUAL_INT(0, t1.fired + t2.fired);
+    _advance_to(160);
+    TEST_ASSERT(_fired_within(&t1, 100, 50));
+    TEST_ASSERT(_fired_within(&t2, 120, 40));
+    TEST_ASSERT_EQUAL_INT(1, ztimer_wakeups(_z));
+}
+
+/**
+ * @brief   Timers with disjoint windows fire on separate wakeups
+ */
+static void test_ztimer_slack_disjoint(void)
+{
+    _timer_t t1, t2;
+
+    _init(&t1);
+    _init(&t2);
+    ztimer_set_slack(_z, &t2.timer, 200, 10);
+    ztimer_set_slack(_z, &t1.timer, 100, 10);
+    _advance_to(210);
+    TEST_ASSERT(_fired_within(&t1, 100, 10));
+    TEST_ASSERT(_fired_within(&t2, 200, 10));
+}
+
+/**
+ * @brief   Setting the first timer again never fires the next one early
+ */
+static void test_ztimer_slack_set_first_again(void)
+{
+    _timer_t t1, t2;
+
+    _init(&t1);
+    _init(&t2);
+    ztimer_set_slack(_z, &t1.timer, 100, 50);
+    ztimer_set_slack(_z, &t2.timer, 200, 60);
+    ztimer_set_slack(_z, &t1.timer, 300, 50);
+    _advance_to(350);
+    TEST_ASSERT(_fired_within(&t2, 200, 60));
+    TEST_ASSERT(_fired_within(&t1, 300, 50));
+}
+
+/**
+ * @brief   Removing a timer keeps the others within their windows
+ */
+static void test_ztimer_slack_remove(void)
+{
+    _timer_t t1, t2;
+
+    _init(&t1);
+    _init(&t2);
+    ztimer_set_slack(_z, &t1.timer, 100, 50);
+    ztimer_set_slack(_z, &t2.timer, 120, 80);
+    ztimer_remove(_z, &t1.timer);
+    _advance_to(200);
+    TEST_ASSERT_EQUAL_INT(0, t1.fired);
+    TEST_ASSERT(_fired_within(&t2, 120, 80));
+}
+
+#if !MODULE_ZTIMER_WHEEL
+/**
+ * @brief   The armed wakeup is kept for timers whose windows contain it or
+ *          which are due after it
+ */
+static void test_ztimer_slack_keep_armed(void)
+{
+    _timer_t t1, t2, t3;
+
+    _init(&t1);
+    _init(&t2);
+    _init(&t3);
+    ztimer_set_slack(_z, &t1.timer, 100, 50);
+    unsigned set = _zmock.calls.set;
+    ztimer_set_slack(_z, &t2.timer, 120, 40);
+    ztimer_set_slack(_z, &t3.timer, 200, 100);
+    TEST_ASSERT_EQUAL_INT(set, _zmock.calls.set);
+    _advance_to(300);
+    TEST_ASSERT_EQUAL_INT(150, t1.fired_at);
+    TEST_ASSERT_EQUAL_INT(150, t2.fired_at);
+    TEST_ASSERT(_fired_within(&t3, 200, 100));
+    TEST_ASSERT_EQUAL_INT(2, ztimer_wakeups(_z));
+}
+
+/**
+ * @brief   The wakeup is reprogrammed for a timer whose window ends before it
+ */
+static void test_ztimer_slack_rearm(void)
+{
+    _timer_t t1, t2, t3;
+
+    _init(&t1);
+    _init(&t2);
+    _init(&t3);
+    ztimer_set_slack(_z, &t1.timer, 100, 50);
+    unsigned set = _zmock.calls.set;
+    /* due before the armed wakeup, but not first */
+    ztimer_set_slack(_z, &t2.timer, 120, 10);
+    TEST_ASSERT_EQUAL_INT(set + 1, _zmock.calls.set);
+    /* first */
+    ztimer_set_slack(_z, &t3.timer, 20, 10);
+    TEST_ASSERT_EQUAL_INT(set + 2, _zmock.calls.set);
+    _advance_to(150);
+    TEST_ASSERT(_fired_within(&t3, 20, 10));
+    TEST_ASSERT_EQUAL_INT(130, t1.fired_at);
+    TEST_ASSERT_EQUAL_INT(130, t2.fired_at);
+    TEST_ASSERT_EQUAL_INT(2, ztimer_wakeups(_z));
+}
+#endif
+
+static Test *tests_ztimer_slack_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_slack_overlapping),
+        new_TestFixture(test_ztimer_slack_disjoint),
+        new_TestFixture(test_ztimer_slack_set_first_again),
+        new_TestFixture(test_ztimer_slack_remove),
+#if !MODULE_ZTIMER_WHEEL
+        new_TestFixture(test_ztimer_slack_keep_armed),
+        new_TestFixture(test_ztimer_slack_rearm),
+#endif
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_slack_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ztimer_slack_tests;
+}
+
+void tests_ztimer_slack(void)
+{
+    TESTS_RUN(tests_ztimer_slack_tests());
+}
+/** @} */
@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2020 Freie Universität Berlin
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @{
+ *
+ * @file
+ * @brief       Unittests for the timer wheel of ztimer
+ */
+
+#include <stdbool.h>
+
+#include "kernel_defines.h"
+#include "ztimer.h"
+#include "ztimer/mock.h"
+
+#include "embUnit/embUnit.h"
+
+#include "tests-ztimer_wheel.h"
+
+/* ticks covered by a slot of the given level */
+#define SLOT(level)     (1LU << ((level) * ZTIMER_WHEEL_BITS))
+
+typedef struct {
+    ztimer_t timer;
+    ztimer_clock_t *clock;
+    uint32_t fired_at;
+    unsigned fired;
+    unsigned order;
+} _timer_t;
+
+static ztimer_mock_t _zmock;
+static ztimer_clock_t *_z = &_zmock.super;
+static unsigned _fired;
+
+static void _cb(void *arg)
+{
+    _timer_t *t = arg;
+
+    t->fired_at = ztimer_now(t->clock);
+    t->fired++;
+    t->order = _fired++;
+}
+
+static void _init(_timer_t *t)
+{
+    *t = (_timer_t){
+        .timer = { .callback = _cb, .arg = t },
+        .clock = _z,
+    };
+}
+
+static bool _wheel_empty(void)
+{
+    for (unsigned l = 0; l < ZTIMER_WHEEL_LEVELS; l++) {
+        if (_z->wheel_map[l]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void set_up(void)
+{
+    ztimer_mock_init(&_zmock, 32);
+    _fired = 0;
+}
+
+/**
+ * @brief   Timers on all levels fire in order of their targets
+ */
+static void test_ztimer_wheel_fire_order(void)
+{
+    /* sorted, one or more timers per level, on both sides of slot and level
+     * boundaries */
+    static const uint32_t targets[] = {
+        1, SLOT(1) - 1, SLOT(1), SLOT(1) + 1, 3 * SLOT(1) + 7,
+        SLOT(2) - 1, SLOT(2), 5 * SLOT(2) + 3 * SLOT(1), SLOT(3) + 2,
+        SLOT(5) + SLOT(4) + SLOT(1), SLOT(7) + 1,
+    };
+    /* order in which the timers are set */
+    static const unsigned set_order[] = { 7, 0, 10, 3, 5, 9, 1, 6, 8, 2, 4 };
+    _timer_t timers[ARRAY_SIZE(targets)];
+
+    for (unsigned i = 0; i < ARRAY_SIZE(set_order); i++) {
+        unsigned idx = set_order[i];
+
+        _init(&timers[idx]);
+        ztimer_set(_z, &timers[idx].timer, targets[idx]);
+    }
+    ztimer_mock_advance(&_zmock, SLOT(7) + SLOT(1));
+    for (unsigned i = 0; i < ARRAY_SIZE(targets); i++) {
+        TEST_ASSERT_EQUAL_INT(1, timers[i].fired);
+        TEST_ASSERT_EQUAL_INT(i, timers[i].order);
+        TEST_ASSERT_EQUAL_INT(targets[i], timers[i].fired_at);
+    }
+    TEST_ASSERT(_wheel_empty());
+    TEST_ASSERT_EQUAL_INT(0, _zmock.armed);
+}
+
+/**
+ * @brief   A timer moves down one level at every slot boundary it reaches
+ */
+static void test_ztimer_wheel_cascade(void)
+{
+    const uint32_t target = SLOT(2) + 2 * SLOT(1) + 3;
+    _timer_t t;
+
+    _init(&t);
+    ztimer_set(_z, &t.timer, target);
+    TEST_ASSERT_EQUAL_INT(1U << 1, _z->wheel_map[2]);
+    /* the first wakeup is at the start of the level 2 slot */
+    TEST_ASSERT_EQUAL_INT(1, _zmock.armed);
+    TEST_ASSERT_EQUAL_INT(SLOT(2), _zmock.target);
+    ztimer_mock_advance(&_zmock, SLOT(2));
+    TEST_ASSERT_EQUAL_INT(0, t.fired);
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel_map[2]);
+    TEST_ASSERT_EQUAL_INT(1U << 2, _z->wheel_map[1]);
+    /* then at the start of the level 1 slot */
+    TEST_ASSERT_EQUAL_INT(2 * SLOT(1), _zmock.target);
+    ztimer_mock_advance(&_zmock, 2 * SLOT(1));
+    TEST_ASSERT_EQUAL_INT(0, t.fired);
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel_map[1]);
+    TEST_ASSERT_EQUAL_INT(1U << 3, _z->wheel_map[0]);
+    TEST_ASSERT_EQUAL_INT(3, _zmock.target);
+    ztimer_mock_advance(&_zmock, 3);
+    TEST_ASSERT_EQUAL_INT(1, t.fired);
+    TEST_ASSERT_EQUAL_INT(target, t.fired_at);
+    TEST_ASSERT_EQUAL_INT(3, ztimer_wakeups(_z));
+    TEST_ASSERT(_wheel_empty());
+}
+
+/**
+ * @brief   Cascading across the wrap around of the clock
+ */
+static void test_ztimer_wheel_cascade_wrap(void)
+{
+    const uint32_t start = UINT32_MAX - SLOT(1) + 1;
+    _timer_t t;
+
+    ztimer_mock_jump(&_zmock, start);
+    /* the wheel catches up with the jump on the next set */
+    _init(&t);
+    ztimer_set(_z, &t.timer, SLOT(1) + 5);
+    ztimer_mock_advance(&_zmock, SLOT(1) + 4);
+    TEST_ASSERT_EQUAL_INT(0, t.fired);
+    ztimer_mock_advance(&_zmock, 1);
+    TEST_ASSERT_EQUAL_INT(1, t.fired);
+    TEST_ASSERT_EQUAL_INT((uint32_t)(start + SLOT(1) + 5), t.fired_at);
+    TEST_ASSERT(_wheel_empty());
+}
+
+/**
+ * @brief   Removing a timer not cascaded yet
+ */
+static void test_ztimer_wheel_remove_pending(void)
+{
+    _timer_t a, b, c;
+
+    _init(&a);
+    _init(&b);
+    _init(&c);
+    /* a and b share their level 1 slot */
+    ztimer_set(_z, &a.timer, 5 * SLOT(1) + 1);
+    ztimer_set(_z, &b.timer, 5 * SLOT(1) + 2);
+    ztimer_set(_z, &c.timer, SLOT(3));
+    ztimer_remove(_z, &a.timer);
+    TEST_ASSERT_EQUAL_INT(1U << 5, _z->wheel_map[1]);
+    ztimer_remove(_z, &b.timer);
+    /* the slot is empty now, the next wakeup is for c */
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel_map[1]);
+    TEST_ASSERT_EQUAL_INT(SLOT(3), _zmock.target);
+    /* removing a timer that is not set does nothing */
+    ztimer_remove(_z, &a.timer);
+    ztimer_mock_advance(&_zmock, SLOT(3));
+    TEST_ASSERT_EQUAL_INT(0, a.fired);
+    TEST_ASSERT_EQUAL_INT(0, b.fired);
+    TEST_ASSERT_EQUAL_INT(1, c.fired);
+    TEST_ASSERT(_wheel_empty());
+    TEST_ASSERT_EQUAL_INT(0, _zmock.armed);
+}
+
+/**
+ * @brief   Removing a timer after it was cascaded to a lower level
+ */
+static void test_ztimer_wheel_remove_cascaded(void)
+{
+    _timer_t a, b;
+
+    _init(&a);
+    _init(&b);
+    ztimer_set(_z, &a.timer, 2 * SLOT(2) + SLOT(1));
+    ztimer_set(_z, &b.timer, 2 * SLOT(2) + 3 * SLOT(1));
+    ztimer_mock_advance(&_zmock, 2 * SLOT(2));
+    /* both are on level 1 now */
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel_map[2]);
+    TEST_ASSERT_EQUAL_INT((1U << 1) | (1U << 3), _z->wheel_map[1]);
+    ztimer_remove(_z, &a.timer);
+    TEST_ASSERT_EQUAL_INT(1U << 3, _z->wheel_map[1]);
+    TEST_ASSERT_EQUAL_INT(3 * SLOT(1), _zmock.target);
+    ztimer_remove(_z, &b.timer);
+    TEST_ASSERT(_wheel_empty());
+    TEST_ASSERT_EQUAL_INT(0, _zmock.armed);
+    ztimer_mock_advance(&_zmock, SLOT(3));
+    TEST_ASSERT_EQUAL_INT(0, a.fired);
+    TEST_ASSERT_EQUAL_INT(0, b.fired);
+}
+
+/**
+ * @brief   Setting a timer that is already set moves it
+ */
+static void test_ztimer_wheel_reset(void)
+{
+    _timer_t t;
+
+    _init(&t);
+    /* earlier */
+    ztimer_set(_z, &t.timer, SLOT(2));
+    ztimer_set(_z, &t.timer, 7);
+    TEST_ASSERT_EQUAL_INT(0, _z->wheel_map[2]);
+    ztimer_mock_advance(&_zmock, 7);
+    TEST_ASSERT_EQUAL_INT(1, t.fired);
+    TEST_ASSERT_EQUAL_INT(7, t.fired_at);
+    /* later */
+    ztimer_set(_z, &t.timer, 3);
+    ztimer_set(_z, &t.timer, SLOT(1) + 3);
+    ztimer_mock_advance(&_zmock, 3);
+    TEST_ASSERT_EQUAL_INT(1, t.fired);
+    ztimer_mock_advance(&_zmock, SLOT(1));
+    TEST_ASSERT_EQUAL_INT(2, t.fired);
+    TEST_ASSERT_EQUAL_INT(7 + 3 + SLOT(1), t.fired_at);
+    /* after it was cascaded */
+    ztimer_set(_z, &t.timer, SLOT(3) + SLOT(2));
+    ztimer_mock_advance(&_zmock, SLOT(3));
+    TEST_ASSERT_EQUAL_INT(2, t.fired);
+    ztimer_set(_z, &t.timer, 1);
+    TEST_ASSERT_EQUAL_INT(1, _zmock.target);
+    ztimer_mock_advance(&_zmock, SLOT(3));
+    TEST_ASSERT_EQUAL_INT(3, t.fired);
+    TEST_ASSERT_EQUAL_INT(7 + 3 + SLOT(1) + SLOT(3) + 1, t.fired_at);
+    TEST_ASSERT(_wheel_empty());
+}
+
+/**
+ * @brief   A callback may set its own timer again
+ */
+static void _cb_rearm(void *arg)
+{
+    _timer_t *t = arg;
+
+    _cb(arg);
+    if (t->fired < 3) {
+        ztimer_set(t->clock, &t->timer, SLOT(1));
+    }
+}
+
+static void test_ztimer_wheel_rearm_in_callback(void)
+{
+    _timer_t t;
+
+    _init(&t);
+    t.timer.callback = _cb_rearm;
+    ztimer_set(_z, &t.timer, SLOT(1));
+    ztimer_mock_advance(&_zmock, 10 * SLOT(1));
+    TEST_ASSERT_EQUAL_INT(3, t.fired);
+    TEST_ASSERT_EQUAL_INT(3 * SLOT(1), t.fired_at);
+    TEST_ASSERT(_wheel_empty());
+}
+
+static Test *tests_ztimer_wheel_tests(void)
+{
+    EMB_UNIT_TESTFIXTURES(fixtures) {
+        new_TestFixture(test_ztimer_wheel_fire_order),
+        new_TestFixture(test_ztimer_wheel_cascade),
+        new_TestFixture(test_ztimer_wheel_cascade_wrap),
+        new_TestFixture(test_ztimer_wheel_remove_pending),
+        new_TestFixture(test_ztimer_wheel_remove_cascaded),
+        new_TestFixture(test_ztimer_wheel_reset),
+        new_TestFixture(test_ztimer_wheel_rearm_in_callback),
+    };
+
+    EMB_UNIT_TESTCALLER(ztimer_wheel_tests, set_up, NULL, fixtures);
+
+    return (Test *)&ztimer_wheel_tests;
+}
+
+void tests_ztimer_wheel(void)
+{
+    TESTS_RUN(tests_ztimer_wheel_tests());
+}
+/** @} */